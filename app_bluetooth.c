@@ -32,27 +32,46 @@
 //                                   Includes
 // -----------------------------------------------------------------------------
 #include <stdbool.h>
+#include "em_core.h"
 #include "sl_bluetooth.h"
+#include "sl_bluetooth_connection_config.h"
 #include "gatt_db.h"
 #include "sl_simple_led_instances.h"
 #include "app_assert.h"
 #include "app_log.h"
 #include "sl_light_switch.h"
+#include "app_latency.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
-#define MAX_INDICATION_DATA_LENGTH_BYTE         (8)
+// sequence number (2 bytes, little endian), light state, trigger source,
+// source address (8 bytes), lamp states and changed lamps (4 bytes each,
+// little endian)
+#define LIGHT_STATUS_LENGTH_BYTE                (20)
+#define MAX_INDICATION_DATA_LENGTH_BYTE         (LIGHT_STATUS_LENGTH_BYTE)
 // gattdb_light_state_connect
 // gattdb_trigger_source_connect
 // gattdb_source_address_connect
-#define SL_USED_CHARACTERISTIC_INDICATION_COUNT  (16)
+// gattdb_light_status_connect
+#define SL_INDICATED_CHARACTERISTIC_COUNT        (4)
+// with latest-value-wins, a connection holds at most one indication under way
+// and one waiting indication per characteristic
+#define SL_USED_CHARACTERISTIC_INDICATION_COUNT  (2 * SL_INDICATED_CHARACTERISTIC_COUNT)
+// characteristic handles are 8 bit wide
+#define SL_CHARACTERISTIC_HANDLE_COUNT           (256)
+// the characteristic is not indicated / has no queued indication
+#define SL_INDICATION_NOT_QUEUED                 (0xFF)
+// delay before sending again an indication the stack did not accept
+#define SL_INDICATION_RETRY_DELAY_MS             (20)
 
 typedef struct {
-  // ble characteristic
-  uint8_t characteristic;
-  //notification sending can be enabled
-  bool enabled;
+  // client configuration of the characteristic: sl_bt_gatt_notification,
+  // sl_bt_gatt_indication or 0
+  uint8_t client_config;
+  // index of the queued indication of the characteristic or
+  // SL_INDICATION_NOT_QUEUED
+  uint8_t queued_index;
 } sl_indication_setting_t;
 
 typedef struct {
@@ -65,49 +84,120 @@ typedef struct {
 
 /// queue for the outgoing indications
 typedef struct {
-  // indication array for the ble actions
+  // ring of indications for the ble actions
   sl_indication_t indication[SL_USED_CHARACTERISTIC_INDICATION_COUNT];
+  // index of the oldest indication
+  uint8_t head;
   // number of indications
   uint8_t count_of_indications;
 } sl_indicaton_queue_t;
 
+/// state kept for every open connection
+typedef struct {
+  // the entry is used by an open connection
+  bool in_use;
+  // handle of the connection
+  uint8_t handle;
+  // address of the connected device
+  uint8_t address[8];
+  // an indication was sent and is not confirmed yet
+  bool indication_is_under_way;
+  // the indication under way carries a traced light state change
+  bool trace_under_way;
+  // time the switch frame of the traced change was received
+  uint32_t trace_received_tick;
+  // time the traced indication was sent
+  uint32_t trace_sent_tick;
+  // indication settings, indexed by indicated characteristic
+  sl_indication_setting_t settings[SL_INDICATED_CHARACTERISTIC_COUNT];
+  // outgoing indications
+  sl_indicaton_queue_t queue;
+} sl_ble_connection_t;
+
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
 /*******************************************************************************
  * Remove the oldest indication request, but check if this was really answered
  *
+ * @param connection: the connection the indication was sent on
  * @param characteristic: the answered indication
  * @return None
  ******************************************************************************/
-static void sl_remove_last_indication (uint8_t characteristic);
+static void sl_remove_last_indication (sl_ble_connection_t *connection, uint8_t characteristic);
 
 /*******************************************************************************
- * Checks that this indication is enabled for the gatt characteristic
+ * Update the client configuration of the selected characteristic
  *
+ * @param connection: the connection of the client
  * @param characteristic: which characteristic needed indication
- * @return bool: true if indications are allowed
+ * @param client_config: notifications, indications or none
+ * @return None
  ******************************************************************************/
-static bool sl_is_indication_enabled (uint8_t characteristic);
+static void sl_update_client_config (sl_ble_connection_t *connection, uint8_t characteristic, uint8_t client_config);
 
 /*******************************************************************************
- * Update the setting of the indication of the selected characteristic
+ * Get the client configuration of the selected characteristic
  *
- * @param characteristic: which characteristic needed indication
- * @param enabled: is it on or off
+ * @param connection: the connection of the client
+ * @param characteristic: the characteristic
+ * @return notifications, indications or none
+ ******************************************************************************/
+static uint8_t sl_get_client_config (sl_ble_connection_t *connection, uint8_t characteristic);
+
+/*******************************************************************************
+ * Drop the oldest queued indication, from an atomic section
+ *
+ * @param connection: the connection of the queue
+ * @return None
+ ******************************************************************************/
+static void sl_pop_indication (sl_ble_connection_t *connection);
+
+/*******************************************************************************
+ * Drop every connection with its queued indications and client settings
+ *
+ * @param None
  * @return None
  ******************************************************************************/
-static void sl_update_indication_enabled (uint8_t characteristic, bool enabled);
+static void sl_reset_indications (void);
 
 /*******************************************************************************
- * Add a characteristic indication to the queue
+ * Add a characteristic indication to the queue of every connection that
+ * enabled it
  *
  * @param characteristic
  * @return None
  ******************************************************************************/
 static void sl_add_bluetooth_indication (uint8_t characteristic, void * pData, uint8_t data_length_byte);
 
+/*******************************************************************************
+ * Add a characteristic indication to the queue of one connection
+ *
+ * @param connection: the connection to indicate the value to
+ * @param characteristic
+ * @return false if the queue of the connection is full
+ ******************************************************************************/
+static bool sl_queue_indication (sl_ble_connection_t *connection, uint8_t characteristic, void * pData, uint8_t data_length_byte);
+
+/*******************************************************************************
+ * Look up the state of an open connection
+ *
+ * @param handle: handle of the connection
+ * @return the connection, NULL if it is not open
+ ******************************************************************************/
+static sl_ble_connection_t *sl_find_connection (uint8_t handle);
+
+/*******************************************************************************
+ * Start advertising, unless it is running or the connection limit is reached
+ *
+ * @param None
+ * @return None
+ ******************************************************************************/
+static void sl_start_advertising (void);
+
 extern void toggle_light_state(void);
+extern void activate_state_machine(void);
+extern void activate_state_machine_delayed(uint32_t delay_ms);
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
@@ -117,33 +207,77 @@ extern void toggle_light_state(void);
 // -----------------------------------------------------------------------------
 /// The advertising set handle allocated from Bluetooth stack
 static uint8_t advertising_set_handle = 0xFF;
-/// Address of the mobile device
-static uint8_t device_address_display[8] = { 0 };
-/// Flag to schedule the indication sending
-static bool indication_is_under_way = false;
-/// Indication settings
-static sl_indication_setting_t sl_indication_settings[SL_USED_CHARACTERISTIC_INDICATION_COUNT] = { 0 };
-/// Indication queue
-static sl_indicaton_queue_t indicatons_queue = { 0 };
-/// handle of the connected device
-static uint8_t connected_device_handle;
+/// Advertising is running
+static bool advertising = false;
+/// Number of open connections
+static uint8_t connection_count = 0;
+/// State of the open connections
+static sl_ble_connection_t connections[SL_BT_CONFIG_MAX_CONNECTIONS];
+/// Connection served first by the next sl_send_bluetooth_indications() call
+static uint8_t next_connection_to_serve = 0;
+/// Indicated characteristics, the position is the index in the settings
+static const uint8_t indicated_characteristics[SL_INDICATED_CHARACTERISTIC_COUNT] = {
+  gattdb_light_state_connect,
+  gattdb_trigger_source_connect,
+  gattdb_source_address_connect,
+  gattdb_light_status_connect,
+};
+/// Index of the indicated characteristics by characteristic handle
+static uint8_t indicated_characteristic_index[SL_CHARACTERISTIC_HANDLE_COUNT];
 /// Information used by the mobile device
 static sl_direction_t direction = SL_DIRECTION_PROPRIETARY;
-/// address of the connected mobile device
+/// address of the last mobile device that changed the light state
 static uint8_t ble_device_address[8] = { 0 };
+/// value of the light status characteristic
+static uint8_t light_status[LIGHT_STATUS_LENGTH_BYTE] = { 0 };
+/// sequence number of the last light status
+static uint16_t light_status_sequence = 0;
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
 // -----------------------------------------------------------------------------
 /**************************************************************************//**
- * Notify the connected mobile device about any change within the characteristics
+ * Notify the connected mobile devices about any change within the characteristics
+ * Called from both the Connect and the Bluetooth task
  *****************************************************************************/
-void notify_connected_ble_device(sl_direction_t in_direction, uint8_t* address)
+void notify_connected_ble_device(sl_direction_t in_direction,
+                                 uint8_t* address,
+                                 sl_lamp_mask_t changed_lamps)
 {
-  direction = in_direction;
   demo_light_t light_state = sl_get_light_state();
+  sl_lamp_mask_t lamp_states = sl_get_lamp_states();
+  uint8_t status[LIGHT_STATUS_LENGTH_BYTE];
+  uint8_t source = (uint8_t)in_direction;
+  uint16_t sequence;
+  CORE_DECLARE_IRQ_STATE;
+
+  // The light status carries the three values below and the state of every
+  // lamp in one indication, the sequence number lets clients spot missed
+  // updates
+  status[2] = (uint8_t)light_state;
+  status[3] = source;
+  memcpy(&status[4], address, 8);
+  for (uint8_t i = 0; i < sizeof(sl_lamp_mask_t); i++) {
+    status[12 + i] = (uint8_t)(lamp_states >> (8 * i));
+    status[16 + i] = (uint8_t)(changed_lamps >> (8 * i));
+  }
+
+  // The sequence number and the values read back by the clients change
+  // together
+  CORE_ENTER_ATOMIC();
+  sequence = ++light_status_sequence;
+  status[0] = (uint8_t)(sequence & 0xFF);
+  status[1] = (uint8_t)(sequence >> 8);
+  memcpy(light_status, status, sizeof(light_status));
+  direction = in_direction;
+  CORE_EXIT_ATOMIC();
+
+  sl_add_bluetooth_indication(gattdb_light_status_connect, status, sizeof(status));
+
   sl_add_bluetooth_indication(gattdb_light_state_connect, &light_state, sizeof(uint8_t));
-  sl_add_bluetooth_indication(gattdb_trigger_source_connect, &direction, sizeof(uint8_t));
+  sl_add_bluetooth_indication(gattdb_trigger_source_connect, &source, sizeof(uint8_t));
   sl_add_bluetooth_indication(gattdb_source_address_connect, address, 8);
+  // The indications are sent from the state machine
+  activate_state_machine();
 }
 
 /*********************************** ***************************************//**
@@ -159,6 +293,9 @@ sl_bt_on_event(sl_bt_msg_t *evt)
   sl_status_t bt_status = 0;
   /// Length of the received message
   uint16_t sent_len = 0;
+  /// The connection the event belongs to
+  sl_ble_connection_t *connection = NULL;
+  CORE_DECLARE_IRQ_STATE;
 
   // Handle stack events
   switch (SL_BT_MSG_ID(evt->header)) {
@@ -167,6 +304,7 @@ sl_bt_on_event(sl_bt_msg_t *evt)
     // Do not call any stack command before receiving this boot event!       //
     ///////////////////////////////////////////////////////////////////////////
     case sl_bt_evt_system_boot_id:
+      sl_reset_indications();
 
       // Create Advertising Set
       bt_status = sl_bt_advertiser_create_set(&advertising_set_handle);
@@ -189,22 +327,27 @@ sl_bt_on_event(sl_bt_msg_t *evt)
       bt_status = sl_bt_advertiser_set_timing(0, 160, 160, 0, 0);
 
       // Start general advertising and enable connections.
-      bt_status = sl_bt_legacy_advertiser_start(advertising_set_handle,
-                                                sl_bt_legacy_advertiser_connectable);
+      sl_start_advertising();
       break;
 
     ///////////////////////////////////////////////////////////////////////////
     // This event indicates that a connection was closed.                    //
     ///////////////////////////////////////////////////////////////////////////
     case sl_bt_evt_connection_closed_id:
+      connection = sl_find_connection(evt->data.evt_connection_closed.connection);
+      if (connection != NULL) {
+        CORE_ENTER_ATOMIC();
+        connection->in_use = false;
+        connection_count--;
+        CORE_EXIT_ATOMIC();
+      }
       // Check if need to boot to OTA DFU mode
       if (boot_to_dfu) {
         // Enter to OTA DFU mode
         sl_bt_system_reset(2);
       } else {
-        // Restart advertising after client has disconnected
-        bt_status = sl_bt_legacy_advertiser_start(0,
-                                                  sl_bt_legacy_advertiser_connectable);
+        // Restart advertising if it stopped at the connection limit
+        sl_start_advertising();
       }
       break;
 
@@ -214,15 +357,36 @@ sl_bt_on_event(sl_bt_msg_t *evt)
     case sl_bt_evt_connection_opened_id:
 
       app_log_info("Mobile device connected\n");
-      // Save the address of the android device
-      memcpy(device_address_display,
-             evt->data.evt_connection_opened.address.addr,
-             sizeof(evt->data.evt_connection_opened.address.addr));
-
-      memcpy(ble_device_address, evt->data.evt_connection_opened.address.addr, sizeof(evt->data.evt_connection_opened.address.addr));
-      connected_device_handle = evt->data.evt_connection_opened.connection;
-      // Send notification data about the light-state
-      notify_connected_ble_device(SL_DIRECTION_BLUETOOTH, ble_device_address);
+      // Connectable advertising stops when a connection is opened
+      advertising = false;
+      for (uint8_t i = 0; i < SL_BT_CONFIG_MAX_CONNECTIONS; i++) {
+        if (!connections[i].in_use) {
+          connection = &connections[i];
+          break;
+        }
+      }
+      if (connection != NULL) {
+        CORE_ENTER_ATOMIC();
+        memset(connection, 0, sizeof(*connection));
+        for (uint8_t i = 0; i < SL_INDICATED_CHARACTERISTIC_COUNT; i++) {
+          connection->settings[i].queued_index = SL_INDICATION_NOT_QUEUED;
+        }
+        connection->handle = evt->data.evt_connection_opened.connection;
+        // Save the address of the android device
+        memcpy(connection->address,
+               evt->data.evt_connection_opened.address.addr,
+               sizeof(evt->data.evt_connection_opened.address.addr));
+        connection->in_use = true;
+        connection_count++;
+        CORE_EXIT_ATOMIC();
+        memcpy(ble_device_address, connection->address, sizeof(connection->address));
+        // Send notification data about the light-state
+        notify_connected_ble_device(SL_DIRECTION_BLUETOOTH, ble_device_address, 0);
+      } else {
+        app_log_error("No free connection entry\n");
+      }
+      // Keep advertising while more connections are allowed
+      sl_start_advertising();
       break;
 
     ///////////////////////////////////////////////////////////////////////////
@@ -244,8 +408,12 @@ sl_bt_on_event(sl_bt_msg_t *evt)
           "[E: 0x%04x] Failed to send_user_write_response gattdb_light_state_connect\n",
           (int )bt_status);
 
+        connection = sl_find_connection(evt->data.evt_gatt_server_user_write_request.connection);
+        if (connection != NULL) {
+          memcpy(ble_device_address, connection->address, sizeof(connection->address));
+        }
         /* Send notification/indication data */
-        notify_connected_ble_device(SL_DIRECTION_BLUETOOTH, ble_device_address);
+        notify_connected_ble_device(SL_DIRECTION_BLUETOOTH, ble_device_address, 0x01);
         app_log_info("Toggle message from mobile device, light is %s\n",
                      (sl_get_light_state() == DEMO_LIGHT_ON) ? "on" : "off");
       }
@@ -274,10 +442,12 @@ sl_bt_on_event(sl_bt_msg_t *evt)
         // read request of the trigger source
       } else if (gattdb_trigger_source_connect
                  == evt->data.evt_gatt_server_user_read_request.characteristic) {
+        uint8_t source = (uint8_t)direction;
+
         bt_status = sl_bt_gatt_server_send_user_read_response(
           evt->data.evt_gatt_server_user_read_request.connection,
           gattdb_trigger_source_connect,
-          0, sizeof(direction), (uint8_t*) &direction, &sent_len);
+          0, sizeof(source), &source, &sent_len);
 
         app_assert_status_f(
           bt_status,
@@ -297,20 +467,55 @@ sl_bt_on_event(sl_bt_msg_t *evt)
           bt_status,
           "[E: 0x%04x] Failed to send user read response SOURCE_ADDRESS_GATTDB\n",
           (int )bt_status);
+
+        // read request of the light status
+      } else if (gattdb_light_status_connect
+                 == evt->data.evt_gatt_server_user_read_request.characteristic) {
+        uint8_t status[LIGHT_STATUS_LENGTH_BYTE];
+
+        // The Connect task may update the light status meanwhile
+        CORE_ENTER_ATOMIC();
+        memcpy(status, light_status, sizeof(status));
+        CORE_EXIT_ATOMIC();
+        bt_status = sl_bt_gatt_server_send_user_read_response(
+          evt->data.evt_gatt_server_user_read_request.connection,
+          gattdb_light_status_connect,
+          0, sizeof(status),
+          status, &sent_len);
+
+        app_assert_status_f(
+          bt_status,
+          "[E: 0x%04x] Failed to send user read response LIGHT_STATUS_GATTDB\n",
+          (int )bt_status);
       }
       break;
 
     case sl_bt_evt_gatt_server_characteristic_status_id:
+      connection = sl_find_connection(evt->data.evt_gatt_server_characteristic_status.connection);
+      if (connection == NULL) {
+        break;
+      }
       if (gatt_server_confirmation
           == evt->data.evt_gatt_server_characteristic_status.status_flags) {
+        CORE_ENTER_ATOMIC();
+        if (connection->trace_under_way) {
+          uint32_t now = latency_now();
+          latency_record(LATENCY_STAGE_CONFIRM, connection->trace_sent_tick, now);
+          latency_record(LATENCY_STAGE_TOTAL, connection->trace_received_tick, now);
+          connection->trace_under_way = false;
+        }
+        CORE_EXIT_ATOMIC();
         sl_remove_last_indication(
+          connection,
           evt->data.evt_gatt_server_characteristic_status.characteristic);
-        indication_is_under_way = false;
+        // Send the next queued indication, if any
+        activate_state_machine();
       } else if (gatt_server_client_config
                  == evt->data.evt_gatt_server_characteristic_status.status_flags) {
-        sl_update_indication_enabled(
+        sl_update_client_config(
+          connection,
           evt->data.evt_gatt_server_characteristic_status.characteristic,
-          true);
+          (uint8_t)evt->data.evt_gatt_server_characteristic_status.client_config_flags);
       }
       break;
 
@@ -327,36 +532,35 @@ sl_bt_on_event(sl_bt_msg_t *evt)
 }
 
 /*******************************************************************************
- * Add a characteristic indication to the queue
+ * Add a characteristic indication to the queue of every connection that
+ * enabled it. Clients subscribed to the light status get everything from it,
+ * the individual characteristics are only indicated to the other clients.
  ******************************************************************************/
 static void sl_add_bluetooth_indication(uint8_t characteristic, void * pData, uint8_t data_length_byte)
 {
-  if (advertising_set_handle != 0xFF) {
-    if (sl_is_indication_enabled(characteristic)) {
-      if (indicatons_queue.count_of_indications < SL_USED_CHARACTERISTIC_INDICATION_COUNT) {
-        for (int i = 0; i < indicatons_queue.count_of_indications; i++) {
-          if (indicatons_queue.indication[i].characteristic == characteristic) {
-            return;
-          }
-        }
-        indicatons_queue.count_of_indications++;
-        indicatons_queue.indication[(indicatons_queue.count_of_indications - 1)].characteristic = characteristic;
-        indicatons_queue.indication[(indicatons_queue.count_of_indications - 1)].data_size = 0;
-        if ((pData != NULL) && (data_length_byte <= MAX_INDICATION_DATA_LENGTH_BYTE)) {
-          memcpy(indicatons_queue.indication[(indicatons_queue.count_of_indications - 1)].data,
-                 pData,
-                 data_length_byte);
-          indicatons_queue.indication[(indicatons_queue.count_of_indications - 1)].data_size = data_length_byte;
-        }
-      } else {
-        app_log_info("Indication queue is full\n");
-      }
+  if (advertising_set_handle == 0xFF) {
+    return;
+  }
+
+  for (uint8_t i = 0; i < SL_BT_CONFIG_MAX_CONNECTIONS; i++) {
+    if (!connections[i].in_use
+        || ((characteristic != gattdb_light_status_connect)
+            && (sl_get_client_config(&connections[i], gattdb_light_status_connect) != 0))) {
+      continue;
+    }
+    if (!sl_queue_indication(&connections[i], characteristic, pData, data_length_byte)) {
+      app_log_info("Indication queue is full\n");
     }
   }
 }
 
 /*******************************************************************************
- * Send the first indication in the queue
+ * Send the queued indications of every connection that has no indication under
+ * way: notifications are sent until the first indication, which then waits
+ * for its confirmation. The connection served first rotates from call to call,
+ * so that no connection always gets the Bluetooth buffers first; each
+ * connection waits for its own confirmations only, so a slow peer does not
+ * hold back the others.
  *
  * @param None
  * @return None
@@ -364,37 +568,94 @@ static void sl_add_bluetooth_indication(uint8_t characteristic, void * pData, ui
 void sl_send_bluetooth_indications(void)
 {
   sl_status_t bt_status   = SL_STATUS_OK;
-  sl_indication_t* indication = NULL;
-  if (advertising_set_handle != 0xFF) {
-    if (!indication_is_under_way) {
-      if (indicatons_queue.count_of_indications > 0) {
-        indication = &indicatons_queue.indication[0];
-        if (indication != NULL) {
-          switch (indication->characteristic) {
-            case gattdb_source_address_connect: /*Intentional fall through*/
-            case gattdb_trigger_source_connect:
-            case gattdb_light_state_connect:
-            {
-              bt_status =
-                sl_bt_gatt_server_send_indication(
-                  connected_device_handle,
-                  indication->characteristic,
-                  indication->data_size,
-                  indication->data);
-              if (bt_status != SL_STATUS_OK) {
-                app_log_error("sl_bt_gatt_server_send_indication failed with 0x%04X\n",
-                              bt_status);
-              }
-              indication_is_under_way = true;
-            }
-            break;
-            default:
-              break;
+  sl_ble_connection_t *connection;
+  sl_indication_t indication;
+  uint8_t connection_handle = 0;
+  bool send;
+  bool notify = false;
+  CORE_DECLARE_IRQ_STATE;
+
+  if (advertising_set_handle == 0xFF) {
+    return;
+  }
+
+  for (uint8_t i = 0; i < SL_BT_CONFIG_MAX_CONNECTIONS; i++) {
+    connection = &connections[(next_connection_to_serve + i) % SL_BT_CONFIG_MAX_CONNECTIONS];
+
+    do {
+      send = false;
+      // Take a copy of the indication, the queue may change once the atomic
+      // section is left. The head is marked under way in both cases, so that
+      // it is not updated in place while being sent.
+      CORE_ENTER_ATOMIC();
+      if (connection->in_use
+          && !connection->indication_is_under_way
+          && (connection->queue.count_of_indications > 0)) {
+        indication = connection->queue.indication[connection->queue.head];
+        connection_handle = connection->handle;
+        notify = ((sl_get_client_config(connection, indication.characteristic)
+                   & sl_bt_gatt_indication) == 0);
+        connection->indication_is_under_way = true;
+        send = true;
+        // Trace the first update of the light state sent after a change
+        if (((indication.characteristic == gattdb_light_status_connect)
+             || (indication.characteristic == gattdb_light_state_connect))
+            && latency_update_sent(&connection->trace_received_tick)) {
+          connection->trace_sent_tick = latency_now();
+          connection->trace_under_way = true;
+        }
+      }
+      CORE_EXIT_ATOMIC();
+
+      if (!send) {
+        break;
+      }
+
+      if (notify) {
+        bt_status =
+          sl_bt_gatt_server_send_notification(
+            connection_handle,
+            indication.characteristic,
+            indication.data_size,
+            indication.data);
+      } else {
+        bt_status =
+          sl_bt_gatt_server_send_indication(
+            connection_handle,
+            indication.characteristic,
+            indication.data_size,
+            indication.data);
+      }
+      if (bt_status != SL_STATUS_OK) {
+        // Keep the indication queued and retry once the stack had time to
+        // free its buffers
+        app_log_error("sl_bt_gatt_server_send_%s failed with 0x%04X\n",
+                      notify ? "notification" : "indication",
+                      bt_status);
+        activate_state_machine_delayed(SL_INDICATION_RETRY_DELAY_MS);
+      }
+
+      CORE_ENTER_ATOMIC();
+      if (connection->in_use && (connection->handle == connection_handle)) {
+        if (notify && (bt_status == SL_STATUS_OK)) {
+          // Notifications are not confirmed
+          sl_pop_indication(connection);
+        }
+        if (notify || (bt_status != SL_STATUS_OK)) {
+          if (connection->trace_under_way && (bt_status == SL_STATUS_OK)) {
+            latency_record(LATENCY_STAGE_TOTAL,
+                           connection->trace_received_tick,
+                           latency_now());
           }
+          connection->trace_under_way = false;
+          connection->indication_is_under_way = false;
         }
       }
-    }
+      CORE_EXIT_ATOMIC();
+    } while (notify && (bt_status == SL_STATUS_OK));
   }
+
+  next_connection_to_serve = (next_connection_to_serve + 1) % SL_BT_CONFIG_MAX_CONNECTIONS;
 }
 
 // -----------------------------------------------------------------------------
@@ -402,65 +663,168 @@ void sl_send_bluetooth_indications(void)
 // -----------------------------------------------------------------------------
 
 /*******************************************************************************
- * Remove the oldest indication request, but check if this was really answered
+ * Add a characteristic indication to the queue of one connection. If the
+ * characteristic already waits in the queue, its value is replaced: only the
+ * latest value is worth indicating.
  ******************************************************************************/
-static void sl_remove_last_indication(uint8_t characteristic)
+static bool sl_queue_indication(sl_ble_connection_t *connection, uint8_t characteristic, void * pData, uint8_t data_length_byte)
 {
-  if (indicatons_queue.count_of_indications > 0) {
-    if (characteristic == indicatons_queue.indication[0].characteristic) {
-      indicatons_queue.count_of_indications--;
-      for (uint8_t i = 0; i < SL_USED_CHARACTERISTIC_INDICATION_COUNT - 1; i++) {
-        memcpy(&indicatons_queue.indication[i], &indicatons_queue.indication[i + 1], sizeof(sl_indication_t));
-
-        if (i >= indicatons_queue.count_of_indications) {
-          memset(&indicatons_queue.indication[i], 0, sizeof(sl_indication_t));
-          break;
-        }
-      }
-    } else {
-      app_log_info("Not correct indication\n");
+  sl_indication_t *indication = NULL;
+  sl_indication_setting_t *setting;
+  uint8_t characteristic_index = indicated_characteristic_index[characteristic];
+  uint8_t index;
+  bool queued = true;
+  CORE_DECLARE_IRQ_STATE;
+
+  if ((characteristic_index == SL_INDICATION_NOT_QUEUED)
+      || (connection->settings[characteristic_index].client_config == 0)) {
+    return true;
+  }
+  setting = &connection->settings[characteristic_index];
+
+  CORE_ENTER_ATOMIC();
+  index = setting->queued_index;
+  // The indication under way was already handed to the stack, it must not be
+  // modified.
+  if ((index != SL_INDICATION_NOT_QUEUED)
+      && !(connection->indication_is_under_way && (index == connection->queue.head))) {
+    indication = &connection->queue.indication[index];
+  } else if (connection->queue.count_of_indications < SL_USED_CHARACTERISTIC_INDICATION_COUNT) {
+    index = (connection->queue.head + connection->queue.count_of_indications)
+            % SL_USED_CHARACTERISTIC_INDICATION_COUNT;
+    connection->queue.count_of_indications++;
+    setting->queued_index = index;
+    indication = &connection->queue.indication[index];
+    indication->characteristic = characteristic;
+  } else {
+    queued = false;
+  }
+  if (indication != NULL) {
+    indication->data_size = 0;
+    if ((pData != NULL) && (data_length_byte <= MAX_INDICATION_DATA_LENGTH_BYTE)) {
+      memcpy(indication->data, pData, data_length_byte);
+      indication->data_size = data_length_byte;
     }
   }
+  CORE_EXIT_ATOMIC();
+
+  return queued;
 }
 
 /*******************************************************************************
- * Checks that this indication is enabled for the gatt characteristic
+ * Remove the oldest indication request, but check if this was really answered
  ******************************************************************************/
-static bool sl_is_indication_enabled(uint8_t characteristic)
+static void sl_remove_last_indication(sl_ble_connection_t *connection, uint8_t characteristic)
 {
-  bool enabled = false;
-  for (uint8_t indication = 0; indication < SL_USED_CHARACTERISTIC_INDICATION_COUNT; indication++) {
-    if (characteristic == sl_indication_settings[indication].characteristic) {
-      enabled = sl_indication_settings[indication].enabled;
-      break;
-    }
+  sl_indicaton_queue_t *queue = &connection->queue;
+  bool removed = false;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if ((queue->count_of_indications > 0)
+      && (characteristic == queue->indication[queue->head].characteristic)) {
+    sl_pop_indication(connection);
+    removed = true;
+  }
+  connection->indication_is_under_way = false;
+  CORE_EXIT_ATOMIC();
+
+  if (!removed) {
+    app_log_info("Not correct indication\n");
   }
-  return enabled;
 }
 
 /*******************************************************************************
- * Update the setting of the indication of the selected characteristic
+ * Drop the oldest queued indication, from an atomic section
  ******************************************************************************/
-static void sl_update_indication_enabled(uint8_t characteristic, bool enabled)
+static void sl_pop_indication(sl_ble_connection_t *connection)
 {
-  uint8_t first_blank    = 0;
-  bool first_blank_found = false;
-  bool updated           = false;
-
-  for (uint8_t indication = 0; indication < SL_USED_CHARACTERISTIC_INDICATION_COUNT; indication++) {
-    if ((0 == sl_indication_settings[indication].characteristic) && !first_blank_found) {
-      first_blank = indication;
-      first_blank_found = true;
-    }
-    if (characteristic == sl_indication_settings[indication].characteristic) {
-      sl_indication_settings[indication].enabled = enabled;
-      updated = true;
-      break;
+  sl_indicaton_queue_t *queue = &connection->queue;
+  uint8_t characteristic_index =
+    indicated_characteristic_index[queue->indication[queue->head].characteristic];
+
+  // A newer value of the characteristic may be queued behind the dropped one,
+  // it stays the one to update.
+  if (connection->settings[characteristic_index].queued_index == queue->head) {
+    connection->settings[characteristic_index].queued_index = SL_INDICATION_NOT_QUEUED;
+  }
+  queue->head = (queue->head + 1) % SL_USED_CHARACTERISTIC_INDICATION_COUNT;
+  queue->count_of_indications--;
+}
+
+/*******************************************************************************
+ * Update the client configuration of the selected characteristic
+ ******************************************************************************/
+static void sl_update_client_config(sl_ble_connection_t *connection, uint8_t characteristic, uint8_t client_config)
+{
+  uint8_t characteristic_index = indicated_characteristic_index[characteristic];
+
+  if (characteristic_index != SL_INDICATION_NOT_QUEUED) {
+    connection->settings[characteristic_index].client_config = client_config;
+  }
+}
+
+/*******************************************************************************
+ * Get the client configuration of the selected characteristic
+ ******************************************************************************/
+static uint8_t sl_get_client_config(sl_ble_connection_t *connection, uint8_t characteristic)
+{
+  uint8_t characteristic_index = indicated_characteristic_index[characteristic];
+
+  if (characteristic_index == SL_INDICATION_NOT_QUEUED) {
+    return 0;
+  }
+  return connection->settings[characteristic_index].client_config;
+}
+
+/*******************************************************************************
+ * Drop every connection with its queued indications and client settings
+ ******************************************************************************/
+static void sl_reset_indications(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  memset(connections, 0, sizeof(connections));
+  connection_count = 0;
+  next_connection_to_serve = 0;
+  advertising = false;
+  memset(indicated_characteristic_index, SL_INDICATION_NOT_QUEUED, sizeof(indicated_characteristic_index));
+  for (uint8_t i = 0; i < SL_INDICATED_CHARACTERISTIC_COUNT; i++) {
+    indicated_characteristic_index[indicated_characteristics[i]] = i;
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+/*******************************************************************************
+ * Look up the state of an open connection
+ ******************************************************************************/
+static sl_ble_connection_t *sl_find_connection(uint8_t handle)
+{
+  for (uint8_t i = 0; i < SL_BT_CONFIG_MAX_CONNECTIONS; i++) {
+    if (connections[i].in_use && (connections[i].handle == handle)) {
+      return &connections[i];
     }
   }
+  return NULL;
+}
+
+/*******************************************************************************
+ * Start advertising, unless it is running or the connection limit is reached
+ ******************************************************************************/
+static void sl_start_advertising(void)
+{
+  sl_status_t bt_status;
+
+  if (advertising || (connection_count >= SL_BT_CONFIG_MAX_CONNECTIONS)) {
+    return;
+  }
 
-  if (!updated) {
-    sl_indication_settings[first_blank].characteristic = characteristic;
-    sl_indication_settings[first_blank].enabled = enabled;
+  bt_status = sl_bt_legacy_advertiser_start(advertising_set_handle,
+                                            sl_bt_legacy_advertiser_connectable);
+  if (bt_status == SL_STATUS_OK) {
+    advertising = true;
+  } else {
+    app_log_error("Failed to start advertising: 0x%04X\n", (int)bt_status);
   }
 }
@@ -40,6 +40,10 @@
 #include "app_log.h"
 #include "app_process.h"
 #include "sl_light_switch.h"
+#include "sl_sleeptimer.h"
+#include "cmsis-rtos-ipc-stats.h"
+#include "app_latency.h"
+#include "app_framework_event_profiler.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
@@ -50,6 +54,10 @@
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
 // -----------------------------------------------------------------------------
+static void print_histogram(const char *name,
+                            const uint16_t *histogram,
+                            uint8_t bucket_count);
+static uint32_t ticks_to_us(uint32_t ticks);
 // Connect Tx options
 extern volatile EmberMessageOptions tx_options;
 /// Connect security key id
@@ -77,6 +85,7 @@ void cli_form(sl_cli_command_arg_t *arguments)
 {
   (void) arguments;
   state_machine_flags.form_network_request = true;
+  activate_state_machine();
 }
 
 /******************************************************************************
@@ -87,6 +96,7 @@ void cli_leave(sl_cli_command_arg_t *arguments)
   (void) arguments;
   emberResetNetworkState();
   state_machine_flags.leave_request = true;
+  activate_state_machine();
 }
 
 /******************************************************************************
@@ -95,7 +105,7 @@ void cli_leave(sl_cli_command_arg_t *arguments)
 void cli_reset(sl_cli_command_arg_t *arguments)
 {
   (void) arguments;
-  halReboot();
+  light_reboot();
 }
 
 /******************************************************************************
@@ -118,6 +128,35 @@ void cli_info(sl_cli_command_arg_t *arguments)
   app_log_info("        Channel: %d\n", (uint16_t)emberGetRadioChannel());
   app_log_info("          Power: %d\n", (int16_t)emberGetRadioPower());
   app_log_info("     TX options: MAC acks %s, security %s, priority %s\n", is_ack, is_security, is_high_prio);
+  app_log_info("Dropped toggles: %lu\n", get_switch_command_overflow_count());
+}
+
+/******************************************************************************
+ * CLI - switches command
+ * Lists the switches the light received frames from
+ *****************************************************************************/
+void cli_switches(sl_cli_command_arg_t *arguments)
+{
+  (void) arguments;
+  uint32_t now_ms = halCommonGetInt32uMillisecondTick();
+
+  app_log_info("Switches:\n");
+  for (uint8_t i = 0; i < SWITCH_TABLE_SIZE; i++) {
+    const switch_entry_t *entry = get_switch_entry(i);
+    if (entry == NULL) {
+      continue;
+    }
+    app_log_info("  ");
+    for (uint8_t j = 0; j < EUI64_SIZE; j++) {
+      app_log_append("%02X", entry->display_address[j]);
+    }
+    app_log_append(" node 0x%04X, rssi %d, accepted %lu, duplicates %lu, seen %lu ms ago\n",
+                   entry->source,
+                   entry->last_rssi,
+                   entry->accepted_count,
+                   entry->duplicate_count,
+                   now_ms - entry->last_seen_ms);
+  }
 }
 
 /******************************************************************************
@@ -192,3 +231,152 @@ void cli_unset_security_key(sl_cli_command_arg_t *arguments)
   app_log_info("Security key unset successful\n");
   #endif
 }
+
+/******************************************************************************
+ * CLI - ipc_stats command
+ * Prints the IPC latency histograms of every command ID seen since the last
+ * reset
+ *****************************************************************************/
+void cli_ipc_stats(sl_cli_command_arg_t *arguments)
+{
+  (void)arguments;
+  EmberAfPluginCmsisRtosIpcStats stats;
+  uint8_t index = 0;
+
+  app_log_info("IPC stats (bucket upper bound in us: count):\n");
+  while (emberAfPluginCmsisRtosGetIpcStats(index++, &stats)) {
+    app_log_info("  Command 0x%04X, count %lu\n", stats.commandId, stats.count);
+    print_histogram("queue", stats.histograms[CMSIS_RTOS_IPC_STATS_QUEUE],
+                    CMSIS_RTOS_IPC_STATS_BUCKET_COUNT);
+    print_histogram("service", stats.histograms[CMSIS_RTOS_IPC_STATS_SERVICE],
+                    CMSIS_RTOS_IPC_STATS_BUCKET_COUNT);
+    print_histogram("round trip", stats.histograms[CMSIS_RTOS_IPC_STATS_ROUND_TRIP],
+                    CMSIS_RTOS_IPC_STATS_BUCKET_COUNT);
+  }
+  app_log_info("  Untracked samples: %lu\n", emberAfPluginCmsisRtosGetIpcStatsUntracked());
+}
+
+/******************************************************************************
+ * CLI - ipc_stats_reset command
+ *****************************************************************************/
+void cli_ipc_stats_reset(sl_cli_command_arg_t *arguments)
+{
+  (void)arguments;
+  emberAfPluginCmsisRtosResetIpcStats();
+  app_log_info("IPC stats reset\n");
+}
+
+/******************************************************************************
+ * CLI - latency command
+ * Prints the histograms of the stages a switch toggle goes through until the
+ * Bluetooth clients are updated
+ *****************************************************************************/
+void cli_latency(sl_cli_command_arg_t *arguments)
+{
+  (void)arguments;
+  uint16_t histogram[LATENCY_BUCKET_COUNT];
+
+  app_log_info("Toggle latency (bucket upper bound in us: count):\n");
+  for (uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+    uint32_t count = latency_get_histogram((latency_stage_t)stage, histogram);
+    app_log_info("  %s, count %lu\n", latency_stage_name((latency_stage_t)stage), count);
+    print_histogram("duration", histogram, LATENCY_BUCKET_COUNT);
+  }
+}
+
+/******************************************************************************
+ * CLI - latency_reset command
+ *****************************************************************************/
+void cli_latency_reset(sl_cli_command_arg_t *arguments)
+{
+  (void)arguments;
+  latency_reset();
+  app_log_info("Toggle latency reset\n");
+}
+
+/******************************************************************************
+ * CLI - event_profile command
+ * Prints the run time, lateness and interval histograms of every application
+ * event that ran since the last reset
+ *****************************************************************************/
+void cli_event_profile(sl_cli_command_arg_t *arguments)
+{
+  (void)arguments;
+  EmberAfEventProfile profile;
+  uint8_t index = 0;
+
+  app_log_info("Event profiles over %lu ms (bucket upper bound in us: count):\n",
+               emberAfGetEventProfileElapsedMs());
+  while (emberAfGetEventProfile(index++, &profile)) {
+    if (profile.handler == NULL) {
+      continue;
+    }
+    app_log_info("  Event %u, handler 0x%08lX, context 0x%08lX, count %lu, max run %lu us, max late %lu ms\n",
+                 index - 1,
+                 (uint32_t)(uintptr_t)profile.handler,
+                 (uint32_t)(uintptr_t)profile.context,
+                 profile.count,
+                 ticks_to_us(profile.maxRunTimeTicks),
+                 profile.maxLatenessMs);
+    print_histogram("run time", profile.histograms[EMBER_AF_EVENT_PROFILE_RUN_TIME],
+                    EMBER_AF_EVENT_PROFILE_BUCKET_COUNT);
+    print_histogram("lateness", profile.histograms[EMBER_AF_EVENT_PROFILE_LATENESS],
+                    EMBER_AF_EVENT_PROFILE_BUCKET_COUNT);
+    print_histogram("interval", profile.histograms[EMBER_AF_EVENT_PROFILE_INTERVAL],
+                    EMBER_AF_EVENT_PROFILE_BUCKET_COUNT);
+  }
+}
+
+/******************************************************************************
+ * CLI - event_profile_reset command
+ *****************************************************************************/
+void cli_event_profile_reset(sl_cli_command_arg_t *arguments)
+{
+  (void)arguments;
+  emberAfResetEventProfiles();
+  app_log_info("Event profiles reset\n");
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+/**************************************************************************//**
+ * Print the non empty buckets of one log2 latency histogram on a single line.
+ *
+ * @param name The name of the measured duration
+ * @param histogram bucket_count counters, bucket N counting durations shorter
+ *                  than 2^N sleeptimer ticks
+ * @param bucket_count Number of buckets, the last one counts every duration
+ *                     of at least 2^(bucket_count - 2) ticks
+ *****************************************************************************/
+static void print_histogram(const char *name,
+                            const uint16_t *histogram,
+                            uint8_t bucket_count)
+{
+  bool empty = true;
+
+  app_log_info("    %s:", name);
+  for (uint8_t bucket = 0; bucket < bucket_count; bucket++) {
+    if (histogram[bucket] > 0) {
+      // Bucket N holds durations shorter than 2^N ticks, the last one the
+      // durations of at least 2^(N-1) ticks.
+      bool last = (bucket == bucket_count - 1);
+      uint32_t bound_us = ticks_to_us((uint32_t)1 << (last ? bucket - 1 : bucket));
+      app_log_append(" %s%lu:%u",
+                     last ? ">=" : "<",
+                     bound_us,
+                     histogram[bucket]);
+      empty = false;
+    }
+  }
+  app_log_append("%s\n", empty ? " -" : "");
+}
+
+/**************************************************************************//**
+ * Convert a sleeptimer tick duration to microseconds.
+ *****************************************************************************/
+static uint32_t ticks_to_us(uint32_t ticks)
+{
+  return (uint32_t)(((uint64_t)ticks * 1000000) / sl_sleeptimer_get_timer_frequency());
+}
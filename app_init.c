@@ -54,6 +54,7 @@
 // -----------------------------------------------------------------------------
 /// The event handler signal of the state machine
 extern EmberEventControl *state_machine_event;
+extern EmberEventControl *light_settings_persist_event;
 ///This structure contains all the flags used in the state machine
 extern light_application_flags_t state_machine_flags;
 
@@ -85,7 +86,7 @@ void emberAfInitCallback(void)
   psa_crypto_init();
 
   emberAfAllocateEvent(&state_machine_event, &state_machine_handler);
-  emberEventControlSetDelayMS(*state_machine_event, 100);
+  emberAfAllocateEvent(&light_settings_persist_event, &light_settings_persist_handler);
   // CLI info message
   app_log_info("\nLight DMP\n");
 
@@ -94,9 +95,16 @@ void emberAfInitCallback(void)
   // set the default communication channel, it can be changed with CLI
   app_log_info("Deafult channel> %d\n", emberGetDefaultChannel());
   sl_set_channel(emberGetDefaultChannel());
+  // the settings of the previous run replace the defaults
+  if (sl_light_switch_restore_settings()) {
+    app_log_info("Settings restored, PAN ID: 0x%04X channel: %d\n",
+                 sl_get_pan_id(), sl_get_channel());
+  }
+  apply_lamp_changes(0x01);
 
   emberNetworkInit();
   state_machine_flags.init_success = true;
+  activate_state_machine();
 
 #if defined(EMBER_AF_PLUGIN_BLE)
   bleConnectionInfoTableInit();
@@ -0,0 +1,203 @@
+/***************************************************************************//**
+ * @file
+ * @brief app_latency.c
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <string.h>
+#include PLATFORM_HEADER
+#include "em_core.h"
+#include "sl_sleeptimer.h"
+#include "app_latency.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+/// Durations recorded for a stage
+typedef struct {
+  uint32_t count;
+  uint16_t histogram[LATENCY_BUCKET_COUNT];
+} latency_stage_stats_t;
+
+// -----------------------------------------------------------------------------
+//                          Static Function Declarations
+// -----------------------------------------------------------------------------
+
+/**************************************************************************//**
+ * Get the histogram bucket of a duration
+ *
+ * @param ticks The duration
+ * @returns the bucket
+ *****************************************************************************/
+static uint8_t get_bucket(uint32_t ticks);
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+/// Durations per stage, only accessed inside an atomic section
+static latency_stage_stats_t latency_stats[LATENCY_STAGE_COUNT];
+/// A light state change waits to be sent to a Bluetooth client
+static bool update_pending = false;
+/// Time the oldest switch frame of the pending change was received
+static uint32_t update_received_tick;
+/// Time the lamps were updated with the pending change
+static uint32_t update_applied_tick;
+/// Names of the stages, printed by the CLI
+static const char *const latency_stage_names[LATENCY_STAGE_COUNT] = {
+  "radio",
+  "queue",
+  "apply",
+  "send",
+  "confirm",
+  "total",
+};
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+
+/**************************************************************************//**
+ * Get the current time of the latency traces
+ *****************************************************************************/
+uint32_t latency_now(void)
+{
+  return sl_sleeptimer_get_tick_count();
+}
+
+/**************************************************************************//**
+ * Add the duration of a stage to its histogram
+ *****************************************************************************/
+void latency_record(latency_stage_t stage, uint32_t start_tick, uint32_t end_tick)
+{
+  // unsigned arithmetic takes care of the tick counter wrapping
+  uint8_t bucket = get_bucket(end_tick - start_tick);
+  CORE_DECLARE_IRQ_STATE;
+
+  if (stage >= LATENCY_STAGE_COUNT) {
+    return;
+  }
+  CORE_ENTER_ATOMIC();
+  latency_stats[stage].count++;
+  if (latency_stats[stage].histogram[bucket] < 0xFFFF) {
+    latency_stats[stage].histogram[bucket]++;
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+/**************************************************************************//**
+ * Remember a light state change until a Bluetooth client is updated with it
+ *****************************************************************************/
+void latency_update_applied(uint32_t received_tick, uint32_t applied_tick)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if (!update_pending) {
+    update_received_tick = received_tick;
+    update_applied_tick = applied_tick;
+    update_pending = true;
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+/**************************************************************************//**
+ * Take the light state change waiting to be sent to a Bluetooth client
+ *****************************************************************************/
+bool latency_update_sent(uint32_t *received_tick)
+{
+  uint32_t applied_tick;
+  bool pending;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  pending = update_pending;
+  *received_tick = update_received_tick;
+  applied_tick = update_applied_tick;
+  update_pending = false;
+  CORE_EXIT_ATOMIC();
+
+  if (pending) {
+    latency_record(LATENCY_STAGE_SEND, applied_tick, latency_now());
+  }
+  return pending;
+}
+
+/**************************************************************************//**
+ * Copy the histogram of a stage
+ *****************************************************************************/
+uint32_t latency_get_histogram(latency_stage_t stage, uint16_t *histogram)
+{
+  uint32_t count;
+  CORE_DECLARE_IRQ_STATE;
+
+  if (stage >= LATENCY_STAGE_COUNT) {
+    return 0;
+  }
+  CORE_ENTER_ATOMIC();
+  memcpy(histogram, latency_stats[stage].histogram, sizeof(latency_stats[stage].histogram));
+  count = latency_stats[stage].count;
+  CORE_EXIT_ATOMIC();
+  return count;
+}
+
+/**************************************************************************//**
+ * Get the name of a stage
+ *****************************************************************************/
+const char *latency_stage_name(latency_stage_t stage)
+{
+  return (stage < LATENCY_STAGE_COUNT) ? latency_stage_names[stage] : "?";
+}
+
+/**************************************************************************//**
+ * Clear every histogram
+ *****************************************************************************/
+void latency_reset(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  memset(latency_stats, 0, sizeof(latency_stats));
+  update_pending = false;
+  CORE_EXIT_ATOMIC();
+}
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+
+/**************************************************************************//**
+ * Get the histogram bucket of a duration
+ *****************************************************************************/
+static uint8_t get_bucket(uint32_t ticks)
+{
+  uint8_t bucket = (ticks == 0) ? 0 : (32 - __CLZ(ticks));
+
+  return (bucket < LATENCY_BUCKET_COUNT) ? bucket : (LATENCY_BUCKET_COUNT - 1);
+}
@@ -0,0 +1,135 @@
+/***************************************************************************//**
+ * @file
+ * @brief app_latency.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef APP_LATENCY_H
+#define APP_LATENCY_H
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include PLATFORM_HEADER
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+/// Bucket 0 counts durations of 0 sleeptimer ticks, bucket N durations of
+/// 2^(N-1) to 2^N - 1 ticks. The last bucket also counts everything longer.
+#define LATENCY_BUCKET_COUNT              (20)
+
+/// Stages of a switch toggle, from the radio to the phone
+typedef enum {
+  /// Sync word of the switch frame to the incoming message callback: stack
+  /// task and IPC bridge, millisecond resolution
+  LATENCY_STAGE_RADIO,
+  /// Incoming message callback to process_message(): command queue and state
+  /// machine scheduling
+  LATENCY_STAGE_QUEUE,
+  /// process_message() of the first command of a batch to the lamps and LED
+  /// updated
+  LATENCY_STAGE_APPLY,
+  /// Lamps updated to the Bluetooth indication or notification sent
+  LATENCY_STAGE_SEND,
+  /// Indication sent to the gatt_server_confirmation event: connection
+  /// interval and phone
+  LATENCY_STAGE_CONFIRM,
+  /// Incoming message callback to the confirmation, or to the notification
+  /// sent
+  LATENCY_STAGE_TOTAL,
+  LATENCY_STAGE_COUNT,
+} latency_stage_t;
+
+// -----------------------------------------------------------------------------
+//                          Public Function Declarations
+// -----------------------------------------------------------------------------
+
+/**************************************************************************//**
+ * Get the current time of the latency traces
+ *
+ * @param None
+ * @returns sleeptimer tick count
+ *****************************************************************************/
+uint32_t latency_now(void);
+
+/**************************************************************************//**
+ * Add the duration of a stage to its histogram. Can be called from any task.
+ *
+ * @param stage The stage the duration belongs to
+ * @param start_tick Start of the stage, from latency_now()
+ * @param end_tick End of the stage, from latency_now()
+ * @returns None
+ *****************************************************************************/
+void latency_record(latency_stage_t stage, uint32_t start_tick, uint32_t end_tick);
+
+/**************************************************************************//**
+ * Remember a light state change until a Bluetooth client is updated with it.
+ * Changes made before the previous one was sent are merged into it, the
+ * oldest start time is kept.
+ *
+ * @param received_tick Time the oldest switch frame of the change was received
+ * @param applied_tick Time the lamps were updated
+ * @returns None
+ *****************************************************************************/
+void latency_update_applied(uint32_t received_tick, uint32_t applied_tick);
+
+/**************************************************************************//**
+ * Take the light state change waiting to be sent to a Bluetooth client and
+ * record its send stage
+ *
+ * @param received_tick Set to the time its oldest switch frame was received
+ * @returns true if a change was waiting
+ *****************************************************************************/
+bool latency_update_sent(uint32_t *received_tick);
+
+/**************************************************************************//**
+ * Copy the histogram of a stage
+ *
+ * @param stage The stage
+ * @param histogram Filled with LATENCY_BUCKET_COUNT counters, saturated at
+ *                  0xFFFF
+ * @returns number of durations recorded for the stage
+ *****************************************************************************/
+uint32_t latency_get_histogram(latency_stage_t stage, uint16_t *histogram);
+
+/**************************************************************************//**
+ * Get the name of a stage
+ *
+ * @param stage The stage
+ * @returns the name
+ *****************************************************************************/
+const char *latency_stage_name(latency_stage_t stage);
+
+/**************************************************************************//**
+ * Clear every histogram
+ *
+ * @param None
+ * @returns None
+ *****************************************************************************/
+void latency_reset(void);
+
+#endif // APP_LATENCY_H
@@ -43,11 +43,20 @@
 #include "gatt_db.h"
 #include "stack-info.h"
 #include "sl_light_switch.h"
+#include "cmsis-rtos-support.h"
+#include "sl_sleeptimer.h"
+#include "app_latency.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
 #define SL_EXPECTED_SWITCH_PAYLOAD_LENGHT_BYTE (9)
+/// Length of a lamp mask or lamp states field in the switch payload
+#define SL_SWITCH_LAMP_FIELD_LENGTH_BYTE       (4)
+
+#if (SWITCH_TABLE_SIZE & (SWITCH_TABLE_SIZE - 1)) != 0
+#error "SWITCH_TABLE_SIZE must be a power of two"
+#endif
 
 // -----------------------------------------------------------------------------
 //                          Static Function Declarations
@@ -62,12 +71,61 @@
 static void handle_network_form(void);
 
 /**************************************************************************//**
- * Process the incoming message
+ * Process a received switch command
+ *
+ * @param command The command to process
+ * @returns None
+ *****************************************************************************/
+static sl_lamp_mask_t process_message(const switch_command_t *command);
+
+/**************************************************************************//**
+ * Parse a switch payload into a command
+ *
+ * @param command The command to fill
+ * @param payload The received payload
+ * @param length The length of the payload
+ * @returns true if the payload holds a complete command
+ *****************************************************************************/
+static bool parse_switch_payload(switch_command_t *command,
+                                 const uint8_t *payload,
+                                 uint8_t length);
+
+/**************************************************************************//**
+ * Find the entry of a switch, or make room for it in the switch table
+ *
+ * @param eui Connect EUI of the switch, as carried in the payload
+ * @returns the entry of the switch
+ *****************************************************************************/
+static switch_entry_t *find_switch_entry(const uint8_t *eui);
+
+/**************************************************************************//**
+ * Check whether a frame repeats one already accepted from the same switch
+ *
+ * @param entry The entry of the switch
+ * @param command The command parsed from the frame
+ * @param payload_hash Hash of the frame payload
+ * @returns true if the frame must be dropped
+ *****************************************************************************/
+static bool is_duplicate_switch_frame(const switch_entry_t *entry,
+                                      const switch_command_t *command,
+                                      uint32_t payload_hash);
+
+/**************************************************************************//**
+ * Hash a byte string (32-bit FNV-1a)
+ *
+ * @param data The bytes to hash
+ * @param length The number of bytes
+ * @returns the hash
+ *****************************************************************************/
+static uint32_t switch_hash(const uint8_t *data, uint8_t length);
+
+/**************************************************************************//**
+ * Perform at most one state transition based on the current flags
  *
  * @param None
  * @returns None
  *****************************************************************************/
-static void process_message(void);
+static void state_machine_step(void);
 
 /*******************************************************************************
  * Send the first indication in the queue
@@ -77,7 +135,9 @@ extern void sl_send_bluetooth_indications (void);
 /*******************************************************************************
  * Notify the connected mobile device about the characteristic changes
  ******************************************************************************/
-extern void notify_connected_ble_device(sl_direction_t in_direction, uint8_t* address);
+extern void notify_connected_ble_device(sl_direction_t in_direction,
+                                        uint8_t* address,
+                                        sl_lamp_mask_t changed_lamps);
 
 // -----------------------------------------------------------------------------
 //                                Global Variables
@@ -85,6 +145,8 @@ extern void notify_connected_ble_device(sl_direction_t in_direction, uint8_t* ad
 
 /// The event handler signal of the state machine
 EmberEventControl *state_machine_event;
+/// The event writing the changed light settings to flash
+EmberEventControl *light_settings_persist_event;
 /// In the starting state, the switch tries to connect to a network
 light_switch_state_machine_t state = S_INIT;
 /// TX options set up for the network
@@ -96,14 +158,22 @@ light_application_flags_t state_machine_flags = { false };
 // -----------------------------------------------------------------------------
 //                                Static Variables
 // -----------------------------------------------------------------------------
-/// Indicates when new message has income
-static bool is_there_new_message = false;
 /// Store the Connect's status
 static EmberStatus stack_status;
-/// Data buffer for the incoming messages
-static EmberIncomingMessage incoming_message;
-/// message from the connected switch device
-static uint8_t message_from_connect[SL_EXPECTED_SWITCH_PAYLOAD_LENGHT_BYTE] = { 0 };
+/// Switch commands received and not processed by the state machine yet. Both
+/// the incoming message callback and the state machine run on the application
+/// framework task, so the queue needs no locking.
+static switch_command_t switch_commands[SWITCH_COMMAND_QUEUE_SIZE];
+/// Index of the oldest queued switch command
+static uint8_t switch_command_head = 0;
+/// Number of queued switch commands
+static uint8_t switch_command_count = 0;
+/// Number of switch commands dropped because the queue was full
+static uint32_t switch_command_overflow_count = 0;
+/// Switches the light received frames from, open addressed by EUI hash
+static switch_entry_t switch_table[SWITCH_TABLE_SIZE];
+/// Millisecond tick of the last light settings write
+static uint32_t light_settings_persist_ms = 0;
 
 // -----------------------------------------------------------------------------
 //                          Public Function Definitions
@@ -114,10 +184,18 @@ static uint8_t message_from_connect[SL_EXPECTED_SWITCH_PAYLOAD_LENGHT_BYTE] = {
  *****************************************************************************/
 void toggle_light_state(void)
 {
-  (sl_get_light_state() == DEMO_LIGHT_ON) ? sl_led_led0.turn_off(sl_led_led0.context)
-  : sl_led_led0.turn_on(sl_led_led0.context);
-  (sl_get_light_state() == DEMO_LIGHT_ON) ? (sl_set_light_state(DEMO_LIGHT_OFF))
-  : (sl_set_light_state(DEMO_LIGHT_ON));
+  apply_lamp_changes(sl_toggle_lamps(0x01));
+}
+
+/**************************************************************************//**
+ * Update the LED on the board after lamps changed state, the LED shows lamp 0
+ *****************************************************************************/
+void apply_lamp_changes(sl_lamp_mask_t changed)
+{
+  if (changed & 0x01) {
+    (sl_get_light_state() == DEMO_LIGHT_ON) ? sl_led_led0.turn_on(sl_led_led0.context)
+    : sl_led_led0.turn_off(sl_led_led0.context);
+  }
 }
 
 /******************************************************************************
@@ -137,10 +215,72 @@ void app_process_action(void)
  *****************************************************************************/
 void emberAfIncomingMessageCallback(EmberIncomingMessage *message)
 {
-  is_there_new_message = true;
-  if ((message->endpoint == LIGHT_SWITCH_ENDPOINT) && (message != NULL)) {
-    memcpy(&message_from_connect, message->payload, sizeof(message_from_connect));
+  switch_command_t command;
+  switch_entry_t *entry;
+  uint32_t payload_hash;
+  uint32_t radio_ticks;
+
+  if ((message == NULL)
+      || (message->endpoint != LIGHT_SWITCH_ENDPOINT)
+      || (message->length < SL_EXPECTED_SWITCH_PAYLOAD_LENGHT_BYTE)
+      || !parse_switch_payload(&command, message->payload, message->length)) {
+    return;
   }
+  command.source = message->source;
+  command.rssi = message->rssi;
+  command.timestamp = message->timestamp;
+  command.received_tick = latency_now();
+
+  entry = find_switch_entry(&message->payload[LIGHT_SWITCH_MESSAGE_CONTROL_BYTE + 1]);
+  entry->source = message->source;
+  entry->last_rssi = message->rssi;
+  payload_hash = switch_hash(message->payload, message->length);
+  if (is_duplicate_switch_frame(entry, &command, payload_hash)) {
+    entry->duplicate_count++;
+    return;
+  }
+
+  if (switch_command_count == SWITCH_COMMAND_QUEUE_SIZE) {
+    switch_command_overflow_count++;
+    return;
+  }
+
+  entry->has_sequence = ((command.control & LIGHT_SWITCH_CONTROL_SEQUENCE) != 0);
+  entry->last_sequence = command.sequence;
+  entry->last_seen_ms = command.timestamp;
+  entry->last_payload_hash = payload_hash;
+  entry->accepted_count++;
+  memcpy(command.display_address, entry->display_address, EUI64_SIZE);
+  if (sl_sleeptimer_ms32_to_tick(halCommonGetInt32uMillisecondTick() - command.timestamp,
+                                 &radio_ticks) == SL_STATUS_OK) {
+    latency_record(LATENCY_STAGE_RADIO,
+                   command.received_tick - radio_ticks,
+                   command.received_tick);
+  }
+  switch_commands[(switch_command_head + switch_command_count)
+                  % SWITCH_COMMAND_QUEUE_SIZE] = command;
+  switch_command_count++;
+  activate_state_machine();
+}
+
+/**************************************************************************//**
+ * Number of switch commands dropped because they arrived faster than the
+ * state machine processed them.
+ *****************************************************************************/
+uint32_t get_switch_command_overflow_count(void)
+{
+  return switch_command_overflow_count;
+}
+
+/**************************************************************************//**
+ * Get an entry of the switch table
+ *****************************************************************************/
+const switch_entry_t *get_switch_entry(uint8_t index)
+{
+  if ((index >= SWITCH_TABLE_SIZE) || !switch_table[index].in_use) {
+    return NULL;
+  }
+  return &switch_table[index];
 }
 
 /**************************************************************************//**
@@ -163,6 +303,7 @@ void emberAfMessageSentCallback(EmberStatus status,
 void emberAfStackStatusCallback(EmberStatus status)
 {
   stack_status = status;
+  activate_state_machine();
   switch (status) {
     case EMBER_NETWORK_UP:
       state_machine_flags.network_formed = true;
@@ -179,75 +320,91 @@ void emberAfStackStatusCallback(EmberStatus status)
 }
 
 /**************************************************************************//**
- * This function handles the main state machine
+ * Run the state machine at the next opportunity. The state machine has no
+ * periodic pass, so anything that sets one of its flags, queues a switch
+ * command or a Bluetooth indication must call this. It can be called from any
+ * task.
  *****************************************************************************/
-void state_machine_handler(void)
+void activate_state_machine(void)
 {
-  emberEventControlSetInactive(*state_machine_event);
-  switch (state) {
-    case S_INIT:
-      if (state_machine_flags.init_success) {
-        state = S_STANDBY;
-      } else if (state_machine_flags.error_detected) {
-        state = S_ERROR;
-      }
-
-      break;
-    case S_STANDBY:
-      if (state_machine_flags.form_network_request == true) {
-        state_machine_flags.form_network_request = false;
-        // Start the network connection process
-        handle_network_form();
-        state = S_NETWORK;
-      } else if (stack_status == EMBER_NETWORK_UP) {
-        state = S_OPERATE;
-        sl_set_light_state(DEMO_LIGHT_OFF);
-        app_log_info("After powerup, start to operate\n");
-      } else if (state_machine_flags.error_detected) {
-        state_machine_flags.error_detected = false;
-        state = S_ERROR;
-      }
+  if (state_machine_event != NULL) {
+    emberEventControlSetActive(*state_machine_event);
+    // The application framework task may be waiting for its next event or a
+    // stack callback, wake it up to have the event run now.
+    emAfPluginCmsisRtosWakeUpAppFrameworkTask();
+  }
+}
 
-      break;
-    case S_NETWORK:
-      // Wait until the device is manage to connect to the network
-      if (state_machine_flags.network_formed) {
-        state_machine_flags.network_formed = false;
-        state = S_OPERATE;
-      } else if (state_machine_flags.error_detected) {
-        state_machine_flags.error_detected = false;
-        state = S_ERROR;
-      }
+/**************************************************************************//**
+ * Run the state machine after a delay, to retry what failed on this pass.
+ * Called from the application framework task only.
+ *****************************************************************************/
+void activate_state_machine_delayed(uint32_t delay_ms)
+{
+  if ((state_machine_event != NULL)
+      && !emberEventControlGetActive(*state_machine_event)) {
+    emberEventControlSetDelayMS(*state_machine_event, delay_ms);
+  }
+}
 
-      break;
-    case S_OPERATE:
-      if (is_there_new_message) {
-        is_there_new_message = false;
-        //process the incoming message
-        process_message();
-      }
-      if (state_machine_flags.leave_request) {
-        state_machine_flags.leave_request = false;
-        state = S_STANDBY;
-      } else if (state_machine_flags.error_detected) {
-        state_machine_flags.error_detected = false;
-        state = S_ERROR;
-      }
+/**************************************************************************//**
+ * Schedule writing the light settings to flash. Called by sl_light_switch on
+ * every change, from any task.
+ *****************************************************************************/
+void sl_light_switch_settings_changed_callback(void)
+{
+  if (light_settings_persist_event != NULL) {
+    emberEventControlSetActive(*light_settings_persist_event);
+    emAfPluginCmsisRtosWakeUpAppFrameworkTask();
+  }
+}
 
-      break;
-    case S_ERROR:
-      app_log_error("Error occurred\n");
-      halReboot();
-      break;
+/**************************************************************************//**
+ * Write the changed light settings to flash, at most once per
+ * SL_LIGHT_SWITCH_PERSIST_INTERVAL_MS. The changes made in between are written
+ * together at the end of the interval.
+ *****************************************************************************/
+void light_settings_persist_handler(void)
+{
+  uint32_t elapsed_ms = halCommonGetInt32uMillisecondTick() - light_settings_persist_ms;
 
-    default:
-      app_log_warning("Invalid state\n");
-      state = S_ERROR;
-      break;
+  if (elapsed_ms < SL_LIGHT_SWITCH_PERSIST_INTERVAL_MS) {
+    emberEventControlSetDelayMS(*light_settings_persist_event,
+                                SL_LIGHT_SWITCH_PERSIST_INTERVAL_MS - elapsed_ms);
+    return;
+  }
+  emberEventControlSetInactive(*light_settings_persist_event);
+  light_settings_persist_ms = halCommonGetInt32uMillisecondTick();
+  if (!sl_light_switch_store_settings()) {
+    app_log_error("Light settings write failed\n");
   }
+}
+
+/**************************************************************************//**
+ * Write the pending light settings changes to flash and reboot
+ *****************************************************************************/
+void light_reboot(void)
+{
+  (void)sl_light_switch_store_settings();
+  halReboot();
+}
+
+/**************************************************************************//**
+ * This function handles the main state machine
+ *****************************************************************************/
+void state_machine_handler(void)
+{
+  light_switch_state_machine_t previous_state;
+
+  emberEventControlSetInactive(*state_machine_event);
+  // Evaluate the new state right away after a transition: nothing else would
+  // run the state machine again if no further event comes.
+  do {
+    previous_state = state;
+    state_machine_step();
+  } while (state != previous_state);
 
   sl_send_bluetooth_indications();
-  emberEventControlSetDelayMS(*state_machine_event, 100);
 }
 
 bool set_security_key(uint8_t* key, size_t key_length)
@@ -307,6 +464,100 @@ bool set_security_key(uint8_t* key, size_t key_length)
 //                          Static Function Definitions
 // -----------------------------------------------------------------------------s
 
+/**************************************************************************//**
+ * Perform at most one state transition based on the current flags
+ *****************************************************************************/
+static void state_machine_step(void)
+{
+  switch (state) {
+    case S_INIT:
+      if (state_machine_flags.init_success) {
+        state = S_STANDBY;
+      } else if (state_machine_flags.error_detected) {
+        state = S_ERROR;
+      }
+
+      break;
+    case S_STANDBY:
+      if (state_machine_flags.form_network_request == true) {
+        state_machine_flags.form_network_request = false;
+        // Start the network connection process
+        handle_network_form();
+        state = S_NETWORK;
+      } else if (stack_status == EMBER_NETWORK_UP) {
+        // the lamps keep the states restored from flash
+        state = S_OPERATE;
+        app_log_info("After powerup, start to operate\n");
+      } else if (state_machine_flags.error_detected) {
+        state_machine_flags.error_detected = false;
+        state = S_ERROR;
+      }
+
+      break;
+    case S_NETWORK:
+      // Wait until the device is manage to connect to the network
+      if (state_machine_flags.network_formed) {
+        state_machine_flags.network_formed = false;
+        state = S_OPERATE;
+      } else if (state_machine_flags.error_detected) {
+        state_machine_flags.error_detected = false;
+        state = S_ERROR;
+      }
+
+      break;
+    case S_OPERATE:
+      // process every switch command received since the last pass, and
+      // report the lamps they changed in a single Bluetooth update
+      if (switch_command_count > 0) {
+        sl_lamp_mask_t changed_lamps = 0;
+        uint8_t switch_id[EUI64_SIZE];
+        uint32_t batch_received_tick = switch_commands[switch_command_head].received_tick;
+        uint32_t batch_start_tick = latency_now();
+
+        while (switch_command_count > 0) {
+          changed_lamps |= process_message(&switch_commands[switch_command_head]);
+          memcpy(switch_id, switch_commands[switch_command_head].display_address,
+                 EUI64_SIZE);
+          switch_command_head = (switch_command_head + 1) % SWITCH_COMMAND_QUEUE_SIZE;
+          switch_command_count--;
+        }
+        if (changed_lamps != 0) {
+          uint32_t applied_tick;
+
+          apply_lamp_changes(changed_lamps);
+          applied_tick = latency_now();
+          latency_record(LATENCY_STAGE_APPLY, batch_start_tick, applied_tick);
+          latency_update_applied(batch_received_tick, applied_tick);
+          notify_connected_ble_device(SL_DIRECTION_PROPRIETARY, switch_id, changed_lamps);
+        }
+      }
+      if (state_machine_flags.leave_request) {
+        state_machine_flags.leave_request = false;
+        // The network down status is still on its way from the stack task,
+        // S_STANDBY must not see the network up anymore
+        stack_status = EMBER_NETWORK_DOWN;
+        state = S_STANDBY;
+      } else if (stack_status != EMBER_NETWORK_UP) {
+        // The network went down without a leave request
+        state = S_STANDBY;
+      } else if (state_machine_flags.error_detected) {
+        state_machine_flags.error_detected = false;
+        state = S_ERROR;
+      }
+
+      break;
+    case S_ERROR:
+      app_log_error("Error occurred\n");
+      light_reboot();
+      break;
+
+    default:
+      app_log_warning("Invalid state\n");
+      state = S_ERROR;
+      break;
+  }
+}
+
 /**************************************************************************//**
  * Handle the tasks in relation with connecting to a network
  *****************************************************************************/
@@ -328,22 +579,159 @@ static void handle_network_form(void)
 }
 
 /**************************************************************************//**
- * Process the incoming message
+ * Parse a switch payload into a command
  *****************************************************************************/
-static void process_message(void)
+static bool parse_switch_payload(switch_command_t *command,
+                                 const uint8_t *payload,
+                                 uint8_t length)
 {
-  if (message_from_connect[LIGHT_SWITCH_MESSAGE_CONTROL_BYTE] & 0x01) {
-    toggle_light_state();
-    uint8_t switch_endianness_switch_id[8] = { 0 };
+  const uint8_t *parameters = &payload[SL_EXPECTED_SWITCH_PAYLOAD_LENGHT_BYTE];
+  uint8_t expected_length = SL_EXPECTED_SWITCH_PAYLOAD_LENGHT_BYTE;
+
+  command->control = payload[LIGHT_SWITCH_MESSAGE_CONTROL_BYTE];
+  command->sequence = 0;
+  if (command->control & LIGHT_SWITCH_CONTROL_SEQUENCE) {
+    if (length <= expected_length) {
+      return false;
+    }
+    command->sequence = *parameters++;
+    expected_length++;
+  }
+  command->lamp_mask = 0;
+  command->lamp_states = 0;
+  command->scene = 0;
+  if (command->control & (LIGHT_SWITCH_CONTROL_SCENE_STORE
+                          | LIGHT_SWITCH_CONTROL_SCENE_RECALL)) {
+    expected_length += 1;
+  } else if (command->control & LIGHT_SWITCH_CONTROL_GROUP_SET) {
+    expected_length += 2 * SL_SWITCH_LAMP_FIELD_LENGTH_BYTE;
+  } else if (command->control & LIGHT_SWITCH_CONTROL_GROUP_TOGGLE) {
+    expected_length += SL_SWITCH_LAMP_FIELD_LENGTH_BYTE;
+  }
+  if (length < expected_length) {
+    return false;
+  }
 
-    // change the endianness of the received switch connect id
-    for (uint8_t i = 0; i < (SL_EXPECTED_SWITCH_PAYLOAD_LENGHT_BYTE - 1); i++ ) {
-      switch_endianness_switch_id[i] = ((message_from_connect[i + 1] >> 4) & 0x0F) | ((message_from_connect[i + 1] << 4) & 0xF0);
+  if (command->control & (LIGHT_SWITCH_CONTROL_SCENE_STORE
+                          | LIGHT_SWITCH_CONTROL_SCENE_RECALL)) {
+    command->scene = parameters[0];
+  } else if (command->control & (LIGHT_SWITCH_CONTROL_GROUP_SET
+                                 | LIGHT_SWITCH_CONTROL_GROUP_TOGGLE)) {
+    command->lamp_mask = emberFetchLowHighInt32u(parameters);
+    if (command->control & LIGHT_SWITCH_CONTROL_GROUP_SET) {
+      command->lamp_states = emberFetchLowHighInt32u(parameters
+                                                     + SL_SWITCH_LAMP_FIELD_LENGTH_BYTE);
     }
-    notify_connected_ble_device(SL_DIRECTION_PROPRIETARY, &switch_endianness_switch_id[0]);
-    app_log_info("Toggle message from node: %d, light is %s\n", incoming_message.source,
+  } else {
+    command->lamp_mask = 0x01;
+  }
+  return true;
+}
+
+/**************************************************************************//**
+ * Process a received switch command
+ *****************************************************************************/
+static sl_lamp_mask_t process_message(const switch_command_t *command)
+{
+  sl_lamp_mask_t changed_lamps = 0;
+
+  latency_record(LATENCY_STAGE_QUEUE, command->received_tick, latency_now());
+
+  if (command->control & LIGHT_SWITCH_CONTROL_SCENE_STORE) {
+    app_log_info("Scene %u store from node: 0x%04X%s\n", command->scene,
+                 command->source,
+                 sl_store_scene(command->scene) ? "" : " rejected");
+  } else if (command->control & LIGHT_SWITCH_CONTROL_SCENE_RECALL) {
+    changed_lamps = sl_recall_scene(command->scene);
+    app_log_info("Scene %u recall from node: 0x%04X, lamps changed: 0x%08lX\n",
+                 command->scene, command->source, changed_lamps);
+  } else if (command->control & LIGHT_SWITCH_CONTROL_GROUP_SET) {
+    changed_lamps = sl_set_lamp_states(command->lamp_mask, command->lamp_states);
+    app_log_info("Group set from node: 0x%04X, lamps changed: 0x%08lX\n",
+                 command->source, changed_lamps);
+  } else if (command->control & LIGHT_SWITCH_CONTROL_GROUP_TOGGLE) {
+    changed_lamps = sl_toggle_lamps(command->lamp_mask);
+    app_log_info("Group toggle from node: 0x%04X, lamps changed: 0x%08lX\n",
+                 command->source, changed_lamps);
+  } else if (command->control & LIGHT_SWITCH_CONTROL_TOGGLE) {
+    changed_lamps = sl_toggle_lamps(command->lamp_mask);
+    app_log_info("Toggle message from node: 0x%04X, light is %s\n", command->source,
                  (sl_get_light_state() == DEMO_LIGHT_ON)
                  ? "on"
                  : "off");
   }
+  return changed_lamps;
+}
+
+/**************************************************************************//**
+ * Find the entry of a switch, or make room for it in the switch table. A
+ * switch is placed in one of the SWITCH_TABLE_MAX_PROBES slots following its
+ * hash and never moves, so lookups stop at the first free slot. When all those
+ * slots are taken, the switch silent for the longest time is forgotten.
+ *****************************************************************************/
+static switch_entry_t *find_switch_entry(const uint8_t *eui)
+{
+  uint32_t now_ms = halCommonGetInt32uMillisecondTick();
+  uint8_t index = switch_hash(eui, EUI64_SIZE) & (SWITCH_TABLE_SIZE - 1);
+  switch_entry_t *entry = NULL;
+
+  for (uint8_t i = 0; i < SWITCH_TABLE_MAX_PROBES; i++) {
+    switch_entry_t *slot = &switch_table[(index + i) & (SWITCH_TABLE_SIZE - 1)];
+    if (!slot->in_use) {
+      entry = slot;
+      break;
+    }
+    if (memcmp(slot->eui, eui, EUI64_SIZE) == 0) {
+      return slot;
+    }
+    if ((entry == NULL)
+        || ((now_ms - slot->last_seen_ms) > (now_ms - entry->last_seen_ms))) {
+      entry = slot;
+    }
+  }
+
+  memset(entry, 0, sizeof(*entry));
+  memcpy(entry->eui, eui, EUI64_SIZE);
+  // change the endianness of the received switch connect id
+  for (uint8_t i = 0; i < EUI64_SIZE; i++) {
+    entry->display_address[i] = ((eui[i] >> 4) & 0x0F) | ((eui[i] << 4) & 0xF0);
+  }
+  entry->last_seen_ms = now_ms;
+  entry->in_use = true;
+  return entry;
+}
+
+/**************************************************************************//**
+ * Check whether a frame repeats one already accepted from the same switch
+ *****************************************************************************/
+static bool is_duplicate_switch_frame(const switch_entry_t *entry,
+                                      const switch_command_t *command,
+                                      uint32_t payload_hash)
+{
+  uint32_t elapsed_ms = command->timestamp - entry->last_seen_ms;
+
+  if (entry->accepted_count == 0) {
+    return false;
+  }
+  if ((command->control & LIGHT_SWITCH_CONTROL_SEQUENCE) && entry->has_sequence) {
+    // Sequence numbers up to half the range behind the last one are old
+    uint8_t distance = (uint8_t)(command->sequence - entry->last_sequence);
+    return (elapsed_ms < SWITCH_DUPLICATE_WINDOW_MS)
+           && ((distance == 0) || (distance >= 0x80));
+  }
+  return (elapsed_ms < SWITCH_UNSEQUENCED_DUPLICATE_WINDOW_MS)
+         && (payload_hash == entry->last_payload_hash);
+}
+
+/**************************************************************************//**
+ * Hash a byte string (32-bit FNV-1a)
+ *****************************************************************************/
+static uint32_t switch_hash(const uint8_t *data, uint8_t length)
+{
+  uint32_t hash = 2166136261UL;
+
+  for (uint8_t i = 0; i < length; i++) {
+    hash = (hash ^ data[i]) * 16777619UL;
+  }
+  return hash;
 }
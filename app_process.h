@@ -40,8 +40,69 @@
 
 /// End nodes have unlimited time for connecting, after the light formed the network
 #define UNLIMETED_CONNECTION_TIME         (0xFF)
-/// 100ms timer for the state machine
-#define STATE_MACHINE_TIMER_MS            (100)
+/// Number of received switch commands buffered until the state machine runs
+#define SWITCH_COMMAND_QUEUE_SIZE         (16)
+
+/// Number of switches the light remembers, a power of two
+#define SWITCH_TABLE_SIZE                 (32)
+/// Number of slots probed to find or place a switch in the table
+#define SWITCH_TABLE_MAX_PROBES           (4)
+/// Frames of a switch whose sequence number is not newer than the one of its
+/// last accepted frame are dropped as duplicates or replays within this window
+#define SWITCH_DUPLICATE_WINDOW_MS        (2000)
+/// Frames without sequence number are dropped if they repeat the previous
+/// frame of the switch within this window, i.e. MAC retransmissions
+#define SWITCH_UNSEQUENCED_DUPLICATE_WINDOW_MS (100)
+
+/// A switch the light received frames from
+typedef struct {
+  /// Connect EUI of the switch, as carried in the payload
+  uint8_t eui[EUI64_SIZE];
+  /// EUI of the switch in the byte order shown to the Bluetooth clients
+  uint8_t display_address[EUI64_SIZE];
+  /// The entry holds a switch
+  bool in_use;
+  /// The last accepted frame carried a sequence number
+  bool has_sequence;
+  /// Sequence number of the last accepted frame
+  uint8_t last_sequence;
+  /// Short address of the switch at its last frame
+  EmberNodeId source;
+  /// RSSI of the last frame
+  int8_t last_rssi;
+  /// Reception time of the last accepted frame
+  uint32_t last_seen_ms;
+  /// Hash of the last accepted payload, to spot unsequenced retransmissions
+  uint32_t last_payload_hash;
+  /// Number of frames accepted from the switch
+  uint32_t accepted_count;
+  /// Number of duplicate or replayed frames dropped
+  uint32_t duplicate_count;
+} switch_entry_t;
+
+/// A switch command received over Connect, parsed from the message payload
+typedef struct {
+  /// Short address of the sending switch
+  EmberNodeId source;
+  /// EUI of the switch in the byte order shown to the Bluetooth clients
+  uint8_t display_address[EUI64_SIZE];
+  /// Control byte, one of the LIGHT_SWITCH_CONTROL_ flags
+  uint8_t control;
+  /// Sequence number, valid if control has LIGHT_SWITCH_CONTROL_SEQUENCE set
+  uint8_t sequence;
+  /// Lamps addressed by the command, lamp 0 for a legacy toggle
+  sl_lamp_mask_t lamp_mask;
+  /// New lamp states of a group set command
+  sl_lamp_mask_t lamp_states;
+  /// Scene of a scene recall or store command
+  uint8_t scene;
+  /// RSSI of the received message
+  int8_t rssi;
+  /// Reception timestamp of the message
+  uint32_t timestamp;
+  /// Time the incoming message callback got the message, from latency_now()
+  uint32_t received_tick;
+} switch_command_t;
 
 // -----------------------------------------------------------------------------
 //                                Global Variables
@@ -69,6 +130,32 @@ void app_process_action(void);
  *****************************************************************************/
 void state_machine_handler(void);
 
+void activate_state_machine(void);
+
+/**************************************************************************//**
+ * Run the state machine after a delay, unless it is due to run already
+ *
+ * @param delay_ms Delay in milliseconds
+ * @returns None
+ *****************************************************************************/
+void activate_state_machine_delayed(uint32_t delay_ms);
+
+/**************************************************************************//**
+ * Write the changed light settings to flash, rate limited
+ *
+ * @param None
+ * @returns None
+ *****************************************************************************/
+void light_settings_persist_handler(void);
+
+/**************************************************************************//**
+ * Write the pending light settings changes to flash and reboot
+ *
+ * @param None
+ * @returns None
+ *****************************************************************************/
+void light_reboot(void);
+
 /**************************************************************************//**
  * Toggle the light state, and blink the LED on the board
  *
@@ -77,6 +164,24 @@ void state_machine_handler(void);
  *****************************************************************************/
 void toggle_light_state(void);
 
+/**************************************************************************//**
+ * Update the LED on the board after lamps changed state
+ *
+ * @param changed mask of the lamps whose state changed
+ * @returns None
+ *****************************************************************************/
+void apply_lamp_changes(sl_lamp_mask_t changed);
+
 bool set_security_key(uint8_t* key, size_t key_length);
 
+uint32_t get_switch_command_overflow_count(void);
+
+/**************************************************************************//**
+ * Get an entry of the switch table
+ *
+ * @param index entry index, below SWITCH_TABLE_SIZE
+ * @returns the entry, or NULL if it holds no switch
+ *****************************************************************************/
+const switch_entry_t *get_switch_entry(uint8_t index);
+
 #endif // APP_PROCESS_H
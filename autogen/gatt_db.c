@@ -27,6 +27,7 @@ GATT_DATA(const uint8_t gattdb_uuidtable_128_map[]) =
   0xd9, 0x2a, 0x49, 0xe6, 0x78, 0xe2, 0x4c, 0x9c, 0xd7, 0x49, 0x5f, 0xb1, 0xac, 0x37, 0xe1, 0x76, 
   0x15, 0xae, 0xdb, 0x1f, 0x14, 0xa5, 0xd4, 0x85, 0x97, 0x45, 0xfd, 0x0b, 0x52, 0xee, 0x16, 0x2f, 
   0x1b, 0x9a, 0xab, 0x8b, 0xf7, 0x34, 0x34, 0xba, 0x9c, 0x4c, 0x21, 0x39, 0x54, 0xcb, 0xa1, 0x82, 
+  0x7a, 0xf4, 0x10, 0x6c, 0x9e, 0x3b, 0xd2, 0xa8, 0x61, 0x4f, 0x3b, 0x7e, 0x12, 0x9d, 0x4a, 0x5c, 
 };
 GATT_DATA(const sli_bt_gattdb_value_t gattdb_attribute_field_18) = {
   .len = 16,
@@ -107,19 +108,22 @@ GATT_DATA(const sli_bt_gattdb_attribute_t gattdb_attributes_map[]) = {
   { .handle = 0x1a, .uuid = 0x0002, .permissions = 0x801, .caps = 0xffff, .state = 0x00, .datatype = 0x05, .characteristic = { .properties = 0x3a, .char_uuid = 0x8002 } },
   { .handle = 0x1b, .uuid = 0x8002, .permissions = 0x803, .caps = 0xffff, .state = 0x00, .datatype = 0x07, .dynamicdata = NULL },
   { .handle = 0x1c, .uuid = 0x000a, .permissions = 0x803, .caps = 0xffff, .state = 0x00, .datatype = 0x03, .configdata = { .flags = 0x03, .clientconfig_index = 0x03 } },
+  { .handle = 0x1d, .uuid = 0x0002, .permissions = 0x801, .caps = 0xffff, .state = 0x00, .datatype = 0x05, .characteristic = { .properties = 0x32, .char_uuid = 0x8003 } },
+  { .handle = 0x1e, .uuid = 0x8003, .permissions = 0x801, .caps = 0xffff, .state = 0x00, .datatype = 0x07, .dynamicdata = NULL },
+  { .handle = 0x1f, .uuid = 0x000a, .permissions = 0x803, .caps = 0xffff, .state = 0x00, .datatype = 0x03, .configdata = { .flags = 0x03, .clientconfig_index = 0x04 } },
 };
 
 GATT_HEADER(const sli_bt_gattdb_t gattdb) = {
   .attributes = gattdb_attributes_map,
-  .attribute_table_size = 28,
-  .attribute_num = 28,
+  .attribute_table_size = 31,
+  .attribute_num = 31,
   .uuid16 = gattdb_uuidtable_16_map,
   .uuid16_table_size = 11,
   .uuid16_num = 11,
   .uuid128 = gattdb_uuidtable_128_map,
-  .uuid128_table_size = 3,
-  .uuid128_num = 3,
-  .num_ccfg = 4,
+  .uuid128_table_size = 4,
+  .uuid128_num = 4,
+  .num_ccfg = 5,
   .caps_mask = 0xffff,
   .enabled_caps = 0xffff,
 };
@@ -20,6 +20,7 @@ extern const sli_bt_gattdb_t gattdb;
 #define gattdb_light_state_connect            21
 #define gattdb_trigger_source_connect         24
 #define gattdb_source_address_connect         27
+#define gattdb_light_status_connect           30
 
 
 #endif // __GATT_DB_H
@@ -138,6 +138,13 @@ void cli_set_channel(sl_cli_command_arg_t *arguments);
 void cli_set_tx_option(sl_cli_command_arg_t *arguments);
 void cli_set_security_key(sl_cli_command_arg_t *arguments);
 void cli_unset_security_key(sl_cli_command_arg_t *arguments);
+void cli_ipc_stats(sl_cli_command_arg_t *arguments);
+void cli_ipc_stats_reset(sl_cli_command_arg_t *arguments);
+void cli_switches(sl_cli_command_arg_t *arguments);
+void cli_latency(sl_cli_command_arg_t *arguments);
+void cli_latency_reset(sl_cli_command_arg_t *arguments);
+void cli_event_profile(sl_cli_command_arg_t *arguments);
+void cli_event_profile_reset(sl_cli_command_arg_t *arguments);
 
 // Command structs. Names are in the format : cli_cmd_{command group name}_{command name}
 // In order to support hyphen in command and group name, every occurence of it while
@@ -238,6 +245,48 @@ static const sl_cli_command_info_t cli_cmd__unset_key = \
                   "",
                  {SL_CLI_ARG_END, });
 
+static const sl_cli_command_info_t cli_cmd__ipc_stats = \
+  SL_CLI_COMMAND(cli_ipc_stats,
+                 "Print IPC latency histograms",
+                  "",
+                 {SL_CLI_ARG_END, });
+
+static const sl_cli_command_info_t cli_cmd__ipc_stats_reset = \
+  SL_CLI_COMMAND(cli_ipc_stats_reset,
+                 "Reset IPC latency histograms",
+                  "",
+                 {SL_CLI_ARG_END, });
+
+static const sl_cli_command_info_t cli_cmd__switches = \
+  SL_CLI_COMMAND(cli_switches,
+                 "List the switches the light received frames from",
+                  "",
+                 {SL_CLI_ARG_END, });
+
+static const sl_cli_command_info_t cli_cmd__latency = \
+  SL_CLI_COMMAND(cli_latency,
+                 "Print toggle to Bluetooth update latency histograms",
+                  "",
+                 {SL_CLI_ARG_END, });
+
+static const sl_cli_command_info_t cli_cmd__latency_reset = \
+  SL_CLI_COMMAND(cli_latency_reset,
+                 "Reset toggle latency histograms",
+                  "",
+                 {SL_CLI_ARG_END, });
+
+static const sl_cli_command_info_t cli_cmd__event_profile = \
+  SL_CLI_COMMAND(cli_event_profile,
+                 "Print application event run time and lateness histograms",
+                  "",
+                 {SL_CLI_ARG_END, });
+
+static const sl_cli_command_info_t cli_cmd__event_profile_reset = \
+  SL_CLI_COMMAND(cli_event_profile_reset,
+                 "Reset application event profiles",
+                  "",
+                 {SL_CLI_ARG_END, });
+
 
 // Create group command tables and structs if cli_groups given
 // in template. Group name is suffixed with _group_table for tables
@@ -260,6 +309,13 @@ const sl_cli_command_entry_t sl_cli_default_command_table[] = {
   { "set_tx_options", &cli_cmd__set_tx_options, false },
   { "set_key", &cli_cmd__set_key, false },
   { "unset_key", &cli_cmd__unset_key, false },
+  { "ipc_stats", &cli_cmd__ipc_stats, false },
+  { "ipc_stats_reset", &cli_cmd__ipc_stats_reset, false },
+  { "switches", &cli_cmd__switches, false },
+  { "latency", &cli_cmd__latency, false },
+  { "latency_reset", &cli_cmd__latency_reset, false },
+  { "event_profile", &cli_cmd__event_profile, false },
+  { "event_profile_reset", &cli_cmd__event_profile_reset, false },
   { NULL, NULL, false },
 };
 
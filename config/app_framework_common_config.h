@@ -0,0 +1,47 @@
+/***************************************************************************//**
+ * @brief Connect Application Framework Common component configuration header.
+ *
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2020 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <h>Connect Application Framework configuration
+
+// <o EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS> Max application events <8-127>
+// <i> Default: 32
+// <i> The number of application events the framework can schedule, the events of the generated event table included. The remaining ones form the pool emberAfAllocateEvent() and emberAfEventRegister() draw from.
+#define EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS                (32)
+
+// <q EMBER_AF_EVENT_PROFILER> Application event profiler
+// <i> Default: 0
+// <i> If this option is enabled, the run time, the lateness relative to the scheduled time and the interval between runs of every application event are recorded in per event histograms.
+#define EMBER_AF_EVENT_PROFILER                            (0)
+
+// </h>
+
+// <<< end of configuration section >>>
@@ -67,6 +67,61 @@
 // <i> The maximum number of simultaneous callback messages from the stack task to the application tasks.
 #define EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE        (10)
 
+#define CMSIS_RTOS_CALLBACK_DROP_NEWEST                           0
+#define CMSIS_RTOS_CALLBACK_DROP_OLDEST                           1
+#define CMSIS_RTOS_CALLBACK_COALESCE                              2
+
+// <o EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_OVERFLOW_POLICY> Callback queue overflow policy
+//   <CMSIS_RTOS_CALLBACK_DROP_NEWEST=> Drop the new callback
+//   <CMSIS_RTOS_CALLBACK_DROP_OLDEST=> Drop the oldest queued callback
+//   <CMSIS_RTOS_CALLBACK_COALESCE=> Replace the latest queued callback of the same type
+// <i> Default: CMSIS_RTOS_CALLBACK_DROP_NEWEST
+// <i> Which incoming traffic callback is lost when the callback queue is full. Stack status, message sent and the other high priority callbacks always take over the slot of the oldest incoming traffic callback.
+#define EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_OVERFLOW_POLICY       CMSIS_RTOS_CALLBACK_DROP_NEWEST
+
+// <o EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_FULL_WAIT_MS> Callback queue full wait <0-100>
+// <i> Default: 0
+// <i> How long in milliseconds the Connect task waits for the application framework task to free a callback slot before applying the overflow policy. 0 never blocks the Connect task.
+#define EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_FULL_WAIT_MS          (0)
+
+// <o EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_SUBSCRIBERS> Max callback subscriptions <1-16>
+// <i> Default: 4
+// <i> The maximum number of (callback, queue) subscriptions application tasks can register to receive stack callbacks on their own queue.
+#define EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_SUBSCRIBERS       (4)
+
+// <q EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS> IPC latency statistics
+// <i> Default: 1
+// <i> If this option is enabled, the queuing, service and round trip times of every API command and stack callback crossing tasks are recorded in per command histograms.
+#define EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS                      (1)
+
+// <o EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS_MAX_COMMANDS> Max command IDs with IPC statistics <1-64>
+// <i> Default: 16
+// <i> The number of distinct API command and callback IDs the IPC latency statistics keep track of. Samples of further IDs are only counted.
+#define EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS_MAX_COMMANDS         (16)
+
+// <o EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS> Max concurrent blocking API commands <1-16>
+// <i> Default: 2
+// <i> The maximum number of application tasks that can have a blocking API command in flight with the Connect task at the same time.
+#define EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS           (2)
+
+// <o EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS> Max pending asynchronous commands <1-32>
+// <i> Default: 8
+// <i> The maximum number of asynchronous API commands posted by the application tasks and not yet completed.
+#define EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS             (8)
+
+#define CMSIS_RTOS_STACK_STATE_NETWORK_STATE                      0x01
+#define CMSIS_RTOS_STACK_STATE_STACK_IS_UP                        0x02
+#define CMSIS_RTOS_STACK_STATE_RADIO_CHANNEL                      0x04
+#define CMSIS_RTOS_STACK_STATE_RADIO_POWER                        0x08
+#define CMSIS_RTOS_STACK_STATE_NODE_ID                            0x10
+#define CMSIS_RTOS_STACK_STATE_PAN_ID                             0x20
+#define CMSIS_RTOS_STACK_STATE_NODE_TYPE                          0x40
+
+// <o EMBER_AF_PLUGIN_CMSIS_RTOS_STACK_STATE_GETTERS> Getters served from the stack state snapshot <0x00-0x7F>
+// <i> Default: 0x7F
+// <i> Bitmask of CMSIS_RTOS_STACK_STATE_ values selecting which getters application tasks serve from the snapshot published by the Connect task instead of a blocking API command. Getters left out always take the blocking path.
+#define EMBER_AF_PLUGIN_CMSIS_RTOS_STACK_STATE_GETTERS            (0x7F)
+
 // </h>
 
 // <<< end of configuration section >>>
@@ -0,0 +1,62 @@
+/***************************************************************************//**
+ * @file
+ * @brief Light Switch Configuration
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SL_LIGHT_SWITCH_CONFIG_H
+#define SL_LIGHT_SWITCH_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <h> Light Switch configuration
+
+// <o SL_LIGHT_SWITCH_LAMP_COUNT> Number of lamps <1-32>
+// <i> Default: 32
+// <i> The number of lamps (channels) the light drives. Lamp 0 is the one legacy toggle commands and the on-board LED use.
+#define SL_LIGHT_SWITCH_LAMP_COUNT        (32)
+
+// <o SL_LIGHT_SWITCH_SCENE_COUNT> Number of scenes <1-16>
+// <i> Default: 8
+// <i> The number of lamp scenes the light can store and recall.
+#define SL_LIGHT_SWITCH_SCENE_COUNT       (8)
+
+// <o SL_LIGHT_SWITCH_PERSIST_INTERVAL_MS> Minimum time between two settings writes to flash [ms] <100-3600000>
+// <i> Default: 10000
+// <i> The lamp states, scenes, PAN ID and channel are written to NVM3 at most once per interval. Changes made in between are written together at the end of the interval.
+#define SL_LIGHT_SWITCH_PERSIST_INTERVAL_MS (10000)
+
+// <o SL_LIGHT_SWITCH_NVM3_KEY> NVM3 object key of the settings <0x0-0xFFFF>
+// <i> Default: 0x0100
+// <i> Key of the settings object in the user domain of the default NVM3 instance.
+#define SL_LIGHT_SWITCH_NVM3_KEY          (0x0100)
+
+// </h>
+
+// <<< end of configuration section >>>
+
+#endif // SL_LIGHT_SWITCH_CONFIG_H
@@ -77,6 +77,16 @@
 // <i> Default: 0
 #define SL_SLEEPTIMER_DEBUGRUN  0
 
+// <q SL_SLEEPTIMER_TIMING_WHEEL> Keep running timers in a hierarchical timing wheel instead of a delta list.
+// <i> Starting a timer no longer walks the list of running timers, and the comparator is only set for the next occupied slot.
+// <i> Default: 0
+#define SL_SLEEPTIMER_TIMING_WHEEL  0
+
+// <o SL_SLEEPTIMER_SLACK_TIMER_COUNT> Maximum number of timers running with a slack <0-255>
+// <i> Timers started with a slack expire along with earlier timers once their timeout elapsed, instead of waking the system up on their own.
+// <i> Default: 8
+#define SL_SLEEPTIMER_SLACK_TIMER_COUNT  8
+
 #endif /* SLEEPTIMER_CONFIG_H */
 
 // <<< end of configuration section >>>
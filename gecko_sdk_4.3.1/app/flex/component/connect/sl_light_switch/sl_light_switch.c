@@ -31,20 +31,34 @@
 // -----------------------------------------------------------------------------
 //                                   Includes
 // -----------------------------------------------------------------------------
+#include <string.h>
+#include "sl_common.h"
+#include "nvm3_default.h"
 #include "sl_light_switch.h"
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
 // -----------------------------------------------------------------------------
+/// The settings kept in flash, as one NVM3 object
+typedef struct {
+  sl_lamp_mask_t lamp_states;
+  sl_lamp_mask_t scenes[SL_LIGHT_SWITCH_SCENE_COUNT];
+  uint16_t pan_id;
+  uint16_t channel;
+} light_switch_settings_t;
 
 // -----------------------------------------------------------------------------
 //                                Global Variables
 // -----------------------------------------------------------------------------
-/// This variable indicates the actual light state
-static demo_light_t light_state = DEMO_LIGHT_OFF;
+/// State of the lamps, lamp 0 is the light of the single lamp API
+static sl_lamp_mask_t lamp_states = 0;
+/// Lamp states stored in the scenes
+static sl_lamp_mask_t scenes[SL_LIGHT_SWITCH_SCENE_COUNT] = { 0 };
 // PAN ID of the device
 static uint16_t pan_id;
 // Communication channel of the device
 static uint16_t channel;
+/// The settings as last read from or written to flash
+static light_switch_settings_t persisted_settings;
 // -----------------------------------------------------------------------------
 //                          Public Function Declarations
 // -----------------------------------------------------------------------------
@@ -54,7 +68,7 @@ static uint16_t channel;
  *****************************************************************************/
 demo_light_t sl_get_light_state(void)
 {
-  return light_state;
+  return (lamp_states & 0x01) ? DEMO_LIGHT_ON : DEMO_LIGHT_OFF;
 }
 
 /**************************************************************************//**
@@ -62,7 +76,69 @@ demo_light_t sl_get_light_state(void)
  *****************************************************************************/
 void sl_set_light_state(demo_light_t new_state)
 {
-  light_state = new_state;
+  (void)sl_set_lamp_states(0x01, (new_state == DEMO_LIGHT_ON) ? 0x01 : 0x00);
+}
+
+/**************************************************************************//**
+ * Get the state of all lamps
+ *****************************************************************************/
+sl_lamp_mask_t sl_get_lamp_states(void)
+{
+  return lamp_states;
+}
+
+/**************************************************************************//**
+ * Set the state of several lamps
+ *****************************************************************************/
+sl_lamp_mask_t sl_set_lamp_states(sl_lamp_mask_t mask, sl_lamp_mask_t states)
+{
+  sl_lamp_mask_t previous_states = lamp_states;
+
+  mask &= SL_LIGHT_SWITCH_ALL_LAMPS;
+  lamp_states = (lamp_states & ~mask) | (states & mask);
+  if (lamp_states != previous_states) {
+    sl_light_switch_settings_changed_callback();
+  }
+  return lamp_states ^ previous_states;
+}
+
+/**************************************************************************//**
+ * Toggle several lamps
+ *****************************************************************************/
+sl_lamp_mask_t sl_toggle_lamps(sl_lamp_mask_t mask)
+{
+  mask &= SL_LIGHT_SWITCH_ALL_LAMPS;
+  lamp_states ^= mask;
+  if (mask != 0) {
+    sl_light_switch_settings_changed_callback();
+  }
+  return mask;
+}
+
+/**************************************************************************//**
+ * Store the state of all lamps in a scene
+ *****************************************************************************/
+bool sl_store_scene(uint8_t scene)
+{
+  if (scene >= SL_LIGHT_SWITCH_SCENE_COUNT) {
+    return false;
+  }
+  if (scenes[scene] != lamp_states) {
+    scenes[scene] = lamp_states;
+    sl_light_switch_settings_changed_callback();
+  }
+  return true;
+}
+
+/**************************************************************************//**
+ * Restore the state of all lamps from a scene
+ *****************************************************************************/
+sl_lamp_mask_t sl_recall_scene(uint8_t scene)
+{
+  if (scene >= SL_LIGHT_SWITCH_SCENE_COUNT) {
+    return 0;
+  }
+  return sl_set_lamp_states(SL_LIGHT_SWITCH_ALL_LAMPS, scenes[scene]);
 }
 
 /**************************************************************************//**
@@ -70,7 +146,10 @@ void sl_set_light_state(demo_light_t new_state)
  *****************************************************************************/
 void sl_set_pan_id(uint16_t new_id)
 {
-  pan_id = new_id;
+  if (pan_id != new_id) {
+    pan_id = new_id;
+    sl_light_switch_settings_changed_callback();
+  }
 }
 
 /**************************************************************************//**
@@ -86,7 +165,10 @@ uint16_t sl_get_pan_id(void)
  *****************************************************************************/
 void sl_set_channel(uint16_t new_channel)
 {
-  channel = new_channel;
+  if (channel != new_channel) {
+    channel = new_channel;
+    sl_light_switch_settings_changed_callback();
+  }
 }
 
 /**************************************************************************//**
@@ -96,3 +178,60 @@ uint16_t sl_get_channel(void)
 {
   return channel;
 }
+
+/**************************************************************************//**
+ * Load the lamp states, scenes, PAN ID and channel from flash
+ *****************************************************************************/
+bool sl_light_switch_restore_settings(void)
+{
+  light_switch_settings_t settings;
+
+  // A settings object of another layout, e.g. written with another scene
+  // count, fails the size check and is ignored
+  if (nvm3_readData(nvm3_defaultHandle,
+                    SL_LIGHT_SWITCH_NVM3_KEY,
+                    &settings,
+                    sizeof(settings)) != ECODE_NVM3_OK) {
+    return false;
+  }
+  lamp_states = settings.lamp_states & SL_LIGHT_SWITCH_ALL_LAMPS;
+  memcpy(scenes, settings.scenes, sizeof(scenes));
+  pan_id = settings.pan_id;
+  channel = settings.channel;
+  persisted_settings = settings;
+  return true;
+}
+
+/**************************************************************************//**
+ * Write the lamp states, scenes, PAN ID and channel to flash if they changed
+ *****************************************************************************/
+bool sl_light_switch_store_settings(void)
+{
+  light_switch_settings_t settings;
+
+  memset(&settings, 0, sizeof(settings));
+  settings.lamp_states = lamp_states;
+  memcpy(settings.scenes, scenes, sizeof(settings.scenes));
+  settings.pan_id = pan_id;
+  settings.channel = channel;
+  // Toggling a lamp back and forth between two writes costs no flash write
+  if (memcmp(&settings, &persisted_settings, sizeof(settings)) == 0) {
+    return true;
+  }
+  if (nvm3_writeData(nvm3_defaultHandle,
+                     SL_LIGHT_SWITCH_NVM3_KEY,
+                     &settings,
+                     sizeof(settings)) != ECODE_NVM3_OK) {
+    return false;
+  }
+  persisted_settings = settings;
+  return true;
+}
+
+/**************************************************************************//**
+ * Called when a setting is changed, the application overrides it to schedule
+ * the settings write
+ *****************************************************************************/
+SL_WEAK void sl_light_switch_settings_changed_callback(void)
+{
+}
@@ -34,6 +34,7 @@
 //                                   Includes
 // -----------------------------------------------------------------------------
 #include PLATFORM_HEADER
+#include "sl_light_switch_config.h"
 
 // -----------------------------------------------------------------------------
 //                              Macros and Typedefs
@@ -47,6 +48,34 @@
 /// Default PAN ID (Personal Area Network ID) used as an address between the nodes
 #define DEFAULT_LIGHT_SWITCH_PAN_ID       (0xBEEF)
 
+/// Control byte flags, the highest set command flag selects the command. The
+/// legacy toggle only carries the switch EUI after the control byte, the other
+/// commands append their parameters after it, multi-byte fields little endian.
+/// A sequence number byte follows the EUI
+#define LIGHT_SWITCH_CONTROL_SEQUENCE     (0x80)
+/// Toggle lamp 0
+#define LIGHT_SWITCH_CONTROL_TOGGLE       (0x01)
+/// Toggle the lamps of a 32-bit lamp mask
+#define LIGHT_SWITCH_CONTROL_GROUP_TOGGLE (0x02)
+/// Set the lamps of a 32-bit lamp mask to the matching bits of a 32-bit state
+#define LIGHT_SWITCH_CONTROL_GROUP_SET    (0x04)
+/// Recall the lamp states of a scene, identified by one byte
+#define LIGHT_SWITCH_CONTROL_SCENE_RECALL (0x08)
+/// Store the current lamp states in a scene, identified by one byte
+#define LIGHT_SWITCH_CONTROL_SCENE_STORE  (0x10)
+
+/// Mask of the lamps driven by the light
+#if (SL_LIGHT_SWITCH_LAMP_COUNT < 1) || (SL_LIGHT_SWITCH_LAMP_COUNT > 32)
+#error "SL_LIGHT_SWITCH_LAMP_COUNT must be between 1 and 32"
+#elif SL_LIGHT_SWITCH_LAMP_COUNT == 32
+#define SL_LIGHT_SWITCH_ALL_LAMPS         (0xFFFFFFFFUL)
+#else
+#define SL_LIGHT_SWITCH_ALL_LAMPS         ((1UL << SL_LIGHT_SWITCH_LAMP_COUNT) - 1UL)
+#endif
+
+/// One bit per lamp, bit n is lamp n, set when the lamp is on
+typedef uint32_t sl_lamp_mask_t;
+
 /// State machine states
 typedef enum  {
   S_INIT,
@@ -151,4 +180,72 @@ void sl_set_channel(uint16_t new_channel);
  *****************************************************************************/
 uint16_t sl_get_channel(void);
 
+/**************************************************************************//**
+ * Get the state of all lamps
+ *
+ * @param None
+ * @returns lamp mask, the bits of the lamps that are on are set
+ *****************************************************************************/
+sl_lamp_mask_t sl_get_lamp_states(void);
+
+/**************************************************************************//**
+ * Set the state of several lamps
+ *
+ * @param mask lamps to set, bits of lamps beyond SL_LIGHT_SWITCH_LAMP_COUNT
+ *             are ignored
+ * @param states new state of the lamps selected by mask
+ * @returns mask of the lamps whose state changed
+ *****************************************************************************/
+sl_lamp_mask_t sl_set_lamp_states(sl_lamp_mask_t mask, sl_lamp_mask_t states);
+
+/**************************************************************************//**
+ * Toggle several lamps
+ *
+ * @param mask lamps to toggle
+ * @returns mask of the lamps whose state changed
+ *****************************************************************************/
+sl_lamp_mask_t sl_toggle_lamps(sl_lamp_mask_t mask);
+
+/**************************************************************************//**
+ * Store the state of all lamps in a scene
+ *
+ * @param scene scene identifier, below SL_LIGHT_SWITCH_SCENE_COUNT
+ * @returns true if the scene was stored
+ *****************************************************************************/
+bool sl_store_scene(uint8_t scene);
+
+/**************************************************************************//**
+ * Restore the state of all lamps from a scene
+ *
+ * @param scene scene identifier, below SL_LIGHT_SWITCH_SCENE_COUNT
+ * @returns mask of the lamps whose state changed
+ *****************************************************************************/
+sl_lamp_mask_t sl_recall_scene(uint8_t scene);
+
+/**************************************************************************//**
+ * Load the lamp states, scenes, PAN ID and channel from flash
+ *
+ * @param None
+ * @returns true if settings were found, otherwise the current values are kept
+ *****************************************************************************/
+bool sl_light_switch_restore_settings(void);
+
+/**************************************************************************//**
+ * Write the lamp states, scenes, PAN ID and channel to flash if they changed
+ * since they were last restored or stored
+ *
+ * @param None
+ * @returns true if the settings in flash are up to date
+ *****************************************************************************/
+bool sl_light_switch_store_settings(void);
+
+/**************************************************************************//**
+ * Called when a setting is changed, to let the application schedule a
+ * sl_light_switch_store_settings() call. Can be called from any task.
+ *
+ * @param None
+ * @returns None
+ *****************************************************************************/
+void sl_light_switch_settings_changed_callback(void);
+
 #endif //SL_LIGHT_SWITCH_H
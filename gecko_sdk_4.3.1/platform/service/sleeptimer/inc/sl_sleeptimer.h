@@ -231,6 +231,71 @@ sl_status_t sl_sleeptimer_restart_periodic_timer(sl_sleeptimer_timer_handle_t *h
                                                  uint8_t priority,
                                                  uint16_t option_flags);
 
+/***************************************************************************//**
+ * Starts a 32 bits timer that can expire up to a given slack late.
+ *
+ * The timer expires at the latest once its timeout and slack elapsed. If the
+ * sleeptimer interrupt occurs for another timer after the timeout elapsed,
+ * the timer expires during that same interrupt. Timers whose windows overlap
+ * therefore share a single wake-up.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param timeout Timer timeout, in timer ticks.
+ * @param slack Maximum expiration delay past the timeout, in timer ticks.
+ * @param callback Callback function that will be called when
+ *        initial/periodic timeout expires.
+ * @param callback_data Pointer to user data that will be passed to callback.
+ * @param priority Priority of callback. Useful in case multiple timer expire
+ *        at the same time. 0 = highest priority.
+ * @param option_flags Bit array of option flags for the timer.
+ *        Valid bit-wise OR of one or more of the following:
+ *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *        or 0 for not flags.
+ *
+ * @return 0 if successful. Error code otherwise.
+ *
+ * @note At most SL_SLEEPTIMER_SLACK_TIMER_COUNT timers have a slack at a time.
+ *       Other timers are started without slack.
+ ******************************************************************************/
+sl_status_t sl_sleeptimer_start_timer_with_slack(sl_sleeptimer_timer_handle_t *handle,
+                                                 uint32_t timeout,
+                                                 uint32_t slack,
+                                                 sl_sleeptimer_timer_callback_t callback,
+                                                 void *callback_data,
+                                                 uint8_t priority,
+                                                 uint16_t option_flags);
+
+/***************************************************************************//**
+ * Starts a 32 bits periodic timer that can expire up to a given slack late.
+ *
+ * Every period behaves as a timer started with
+ * sl_sleeptimer_start_timer_with_slack(). Periods are counted from the
+ * timeouts, so expiring late does not make the timer drift.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param timeout Timer periodic timeout, in timer ticks.
+ * @param slack Maximum expiration delay past each timeout, in timer ticks.
+ *        Must be smaller than the timeout.
+ * @param callback Callback function that will be called when
+ *        initial/periodic timeout expires.
+ * @param callback_data Pointer to user data that will be passed to callback.
+ * @param priority Priority of callback. Useful in case multiple timer expire
+ *        at the same time. 0 = highest priority.
+ * @param option_flags Bit array of option flags for the timer.
+ *        Valid bit-wise OR of one or more of the following:
+ *          - SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+ *        or 0 for not flags.
+ *
+ * @return 0 if successful. Error code otherwise.
+ ******************************************************************************/
+sl_status_t sl_sleeptimer_start_periodic_timer_with_slack(sl_sleeptimer_timer_handle_t *handle,
+                                                          uint32_t timeout,
+                                                          uint32_t slack,
+                                                          sl_sleeptimer_timer_callback_t callback,
+                                                          void *callback_data,
+                                                          uint8_t priority,
+                                                          uint16_t option_flags);
+
 /***************************************************************************//**
  * Stops a timer.
  *
@@ -45,6 +45,14 @@
 #include "sli_power_manager.h"
 #endif
 
+#if !defined(SL_SLEEPTIMER_TIMING_WHEEL)
+#define SL_SLEEPTIMER_TIMING_WHEEL  0
+#endif
+
+#if !defined(SL_SLEEPTIMER_SLACK_TIMER_COUNT)
+#define SL_SLEEPTIMER_SLACK_TIMER_COUNT  0
+#endif
+
 #define TIME_UNIX_EPOCH                         (1970u)
 #define TIME_NTP_EPOCH                          (1900u)
 #define TIME_ZIGBEE_EPOCH                       (2000u)
@@ -70,6 +78,30 @@
 // The difference should be null or of few ticks since the counter never stop.
 #define MIN_DIFF_BETWEEN_COUNT_AND_EXPIRATION  2
 
+#if SL_SLEEPTIMER_TIMING_WHEEL
+// Instead of the delta list, running timers are kept in a hierarchical timing
+// wheel. Level N has WHEEL_SLOT_COUNT slots of 2^(N * WHEEL_SLOT_BITS) ticks.
+// A timer is linked in the lowest level whose span covers its remaining time,
+// and moved down the wheel (cascaded) once the wheel reaches the start of its
+// slot. Timers that reach level 0 expire when the wheel reaches their slot and
+// wait in the expired list for their callback. One bit per slot tells which
+// slots are occupied, so that catching up with the counter skips empty slots.
+// Cascades happen lazily while catching up: the comparator is programmed for
+// the timer expiring first. The timer expiring first in each level is kept up
+// to date as timers are linked, cascaded, expire and stop: the head of a slot
+// is its timer expiring first, so the head of the first occupied slot the wheel
+// reaches is the one of the level. The first timer of the wheel and the next
+// slot to process are then taken from the levels, without walking any slot.
+// The delta field of a handle holds the list the timer is linked in, and its
+// timeout_expected_tc field the tick count it expires at.
+#define WHEEL_SLOT_BITS                        5u   // One bit per slot in a 32 bits word.
+#define WHEEL_SLOT_COUNT                       (1u << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK                        (WHEEL_SLOT_COUNT - 1u)
+#define WHEEL_LEVEL_COUNT                      ((32u + WHEEL_SLOT_BITS - 1u) / WHEEL_SLOT_BITS)
+#define WHEEL_EXPIRED_LIST                     (WHEEL_LEVEL_COUNT * WHEEL_SLOT_COUNT)
+#define WHEEL_NO_LIST                          UINT32_MAX
+#endif
+
 /// @brief Time Format.
 SLEEPTIMER_ENUM(sl_sleeptimer_time_format_t) {
   TIME_FORMAT_UNIX = 0,           ///< Number of seconds since January 1, 1970, 00:00. Type is signed, so represented on 31 bit.
@@ -81,6 +113,38 @@ SLEEPTIMER_ENUM(sl_sleeptimer_time_format_t) {
 // tick_count, it can wrap around.
 typedef uint32_t sl_sleeptimer_tick_count_t;
 
+#if SL_SLEEPTIMER_TIMING_WHEEL
+// Timer of the wheel expiring first, only searched for again once it leaves
+// the wheel. It may be restricted to the timers with a given set of flags.
+typedef struct {
+  bool valid;                            // false when it must be searched for.
+  bool match_flags;                      // Only timers with option_flags count.
+  uint16_t option_flags;                 // Option flags of the timers counted.
+  sl_sleeptimer_timer_handle_t *handle;  // NULL if no such timer is running.
+  sl_sleeptimer_tick_count_t link_tc;    // Tick count the timer expires at.
+} wheel_first_timer_t;
+
+// Timer expiring first in a level of the wheel.
+typedef struct {
+  sl_sleeptimer_timer_handle_t *handle;  // NULL if the level is empty.
+  sl_sleeptimer_tick_count_t link_tc;    // Tick count the timer expires at.
+} wheel_level_first_t;
+#endif
+
+#if SL_SLEEPTIMER_SLACK_TIMER_COUNT > 0
+// A timer started with a slack is linked in the timer list at the end of its
+// window, and expires earlier if a compare match occurs once its window opened.
+// The timer handle layout is fixed, so the window is kept aside. The window
+// start is kept as a distance from the list update it was inserted at, which
+// holds for any timeout, like the distances of the wheel to wheel_time.
+typedef struct {
+  sl_sleeptimer_timer_handle_t *handle;
+  sl_sleeptimer_tick_count_t slack;      // Length of the window, in ticks.
+  sl_sleeptimer_tick_count_t insert_tc;  // List update the timer was inserted at.
+  sl_sleeptimer_tick_count_t timeout;    // Ticks from insert_tc to the window.
+} slack_timer_t;
+#endif
+
 // Overflow counter used to provide 64-bits tick count.
 static volatile uint16_t overflow_counter;
 
@@ -100,8 +164,46 @@ static uint32_t calculated_sec_count = 0;
 // Timer frequency in Hz.
 static uint32_t timer_frequency;
 
+#if SL_SLEEPTIMER_TIMING_WHEEL
+// Heads of the timer lists of every slot of the wheel.
+static sl_sleeptimer_timer_handle_t *wheel_slots[WHEEL_LEVEL_COUNT][WHEEL_SLOT_COUNT];
+
+// Bit N of a level is set when slot N holds timers.
+static uint32_t wheel_occupied[WHEEL_LEVEL_COUNT];
+
+// Next tick the wheel has to process.
+static sl_sleeptimer_tick_count_t wheel_time;
+
+// Number of timers in the slots of the wheel.
+static uint32_t wheel_timer_count;
+
+// Head of the list of expired timers whose callback is pending.
+static sl_sleeptimer_timer_handle_t *expired_head;
+
+// Timer expiring first in each level.
+static wheel_level_first_t wheel_level_first[WHEEL_LEVEL_COUNT];
+
+// Timer of the wheel expiring first.
+static wheel_first_timer_t wheel_first;
+
+// Timer of the wheel with the flags last asked for expiring first.
+static wheel_first_timer_t wheel_first_flagged = { .match_flags = true };
+
+// Expected tick count of the power manager's timer, when it expires next.
+static sl_sleeptimer_tick_count_t power_manager_timer_expected_tc;
+#else
 // Head of timer list.
 static sl_sleeptimer_timer_handle_t *timer_head;
+#endif
+
+#if SL_SLEEPTIMER_SLACK_TIMER_COUNT > 0
+// Windows of the timers started with a slack.
+static slack_timer_t slack_timers[SL_SLEEPTIMER_SLACK_TIMER_COUNT];
+
+// Number of slack_timers entries in use. The lookups, done each time a timer
+// is linked or an interrupt is handled, are skipped while it is 0.
+static uint32_t slack_timer_count;
+#endif
 
 // Count at last update of delta of first timer.
 static volatile sl_sleeptimer_tick_count_t last_delta_update_count;
@@ -118,14 +220,70 @@ static uint32_t max_millisecond_conversion;
 // Sleep on ISR exit flag.
 static bool sleep_on_isr_exit = false;
 
+static void insert_timer(sl_sleeptimer_timer_handle_t *handle,
+                         sl_sleeptimer_tick_count_t timeout);
+
+static sl_status_t remove_timer(sl_sleeptimer_timer_handle_t *handle);
+
+static void update_timer_list(void);
+
+static bool is_timer_list_empty(void);
+
+static bool is_first_timer(sl_sleeptimer_timer_handle_t *handle);
+
+static sl_sleeptimer_timer_handle_t *get_next_expired_timer(void);
+
+static void set_timer_slack(sl_sleeptimer_timer_handle_t *handle,
+                            sl_sleeptimer_tick_count_t slack);
+
+static sl_sleeptimer_tick_count_t get_timer_slack(sl_sleeptimer_timer_handle_t *handle);
+
+static void expire_slack_timers(void);
+
+#if SL_SLEEPTIMER_TIMING_WHEEL
+static void wheel_insert_timer(sl_sleeptimer_timer_handle_t *handle,
+                               sl_sleeptimer_tick_count_t timeout);
+
+static sl_status_t wheel_remove_timer(sl_sleeptimer_timer_handle_t *handle);
+
+static sl_sleeptimer_timer_handle_t **wheel_find_timer(sl_sleeptimer_timer_handle_t *handle);
+
+static void wheel_link_timer(sl_sleeptimer_timer_handle_t *handle,
+                             sl_sleeptimer_tick_count_t origin);
+
+static void wheel_expire_timer(sl_sleeptimer_timer_handle_t *handle);
+
+static void wheel_move_slot_first_timer(sl_sleeptimer_timer_handle_t **slot_head);
+
+static bool wheel_get_next_event(sl_sleeptimer_tick_count_t *event_tc);
+
+static void wheel_update_level_first(uint32_t level,
+                                     sl_sleeptimer_tick_count_t origin);
+
+static void wheel_track_first_timer(wheel_first_timer_t *first,
+                                    sl_sleeptimer_timer_handle_t *handle,
+                                    sl_sleeptimer_tick_count_t link_tc);
+
+static void wheel_untrack_first_timer(sl_sleeptimer_timer_handle_t *handle);
+
+static sl_sleeptimer_timer_handle_t *wheel_get_first_timer(wheel_first_timer_t *first);
+
+static void wheel_process_tick(sl_sleeptimer_tick_count_t tick);
+
+static void wheel_update(void);
+
+static bool wheel_get_first_timer_time(uint16_t option_flags,
+                                       uint32_t *time);
+#else
 static void delta_list_insert_timer(sl_sleeptimer_timer_handle_t *handle,
                                     sl_sleeptimer_tick_count_t timeout);
 
 static sl_status_t delta_list_remove_timer(sl_sleeptimer_timer_handle_t *handle);
 
-static void set_comparator_for_next_timer(void);
-
 static void update_delta_list(void);
+#endif
+
+static void set_comparator_for_next_timer(void);
 
 __STATIC_INLINE uint32_t div_to_log2(uint32_t div);
 
@@ -137,7 +295,8 @@ static sl_status_t create_timer(sl_sleeptimer_timer_handle_t *handle,
                                 sl_sleeptimer_timer_callback_t callback,
                                 void *callback_data,
                                 uint8_t priority,
-                                uint16_t option_flags);
+                                uint16_t option_flags,
+                                sl_sleeptimer_tick_count_t slack);
 
 static void update_next_timer_to_expire_is_power_manager(void);
 
@@ -180,7 +339,12 @@ sl_status_t sl_sleeptimer_init(void)
 
   CORE_ENTER_ATOMIC();
   if (!is_sleeptimer_initialized) {
+#if SL_SLEEPTIMER_TIMING_WHEEL
+    wheel_time = 0u;
+    expired_head = NULL;
+#else
     timer_head  = NULL;
+#endif
     last_delta_update_count = 0u;
     overflow_counter = 0u;
     sleeptimer_hal_init_timer();
@@ -234,7 +398,8 @@ sl_status_t sl_sleeptimer_start_timer(sl_sleeptimer_timer_handle_t *handle,
                       callback,
                       callback_data,
                       priority,
-                      option_flags);
+                      option_flags,
+                      0u);
 }
 
 /**************************************************************************//**
@@ -264,7 +429,8 @@ sl_status_t sl_sleeptimer_restart_timer(sl_sleeptimer_timer_handle_t *handle,
                       callback,
                       callback_data,
                       priority,
-                      option_flags);
+                      option_flags,
+                      0u);
 }
 
 /**************************************************************************//**
@@ -297,7 +463,8 @@ sl_status_t sl_sleeptimer_start_periodic_timer(sl_sleeptimer_timer_handle_t *han
                       callback,
                       callback_data,
                       priority,
-                      option_flags);
+                      option_flags,
+                      0u);
 }
 
 /**************************************************************************//**
@@ -346,7 +513,8 @@ sl_status_t sl_sleeptimer_start_periodic_timer_ms(sl_sleeptimer_timer_handle_t *
                       callback,
                       callback_data,
                       priority,
-                      option_flags);
+                      option_flags,
+                      0u);
 }
 
 /**************************************************************************//**
@@ -376,7 +544,8 @@ sl_status_t sl_sleeptimer_restart_periodic_timer(sl_sleeptimer_timer_handle_t *h
                       callback,
                       callback_data,
                       priority,
-                      option_flags);
+                      option_flags,
+                      0u);
 }
 
 /**************************************************************************//**
@@ -424,7 +593,87 @@ sl_status_t sl_sleeptimer_restart_periodic_timer_ms(sl_sleeptimer_timer_handle_t
                       callback,
                       callback_data,
                       priority,
-                      option_flags);
+                      option_flags,
+                      0u);
+}
+
+/**************************************************************************//**
+ * Starts a 32 bits timer that can expire up to a given slack late.
+ *****************************************************************************/
+sl_status_t sl_sleeptimer_start_timer_with_slack(sl_sleeptimer_timer_handle_t *handle,
+                                                 uint32_t timeout,
+                                                 uint32_t slack,
+                                                 sl_sleeptimer_timer_callback_t callback,
+                                                 void *callback_data,
+                                                 uint8_t priority,
+                                                 uint16_t option_flags)
+{
+  bool is_running = false;
+
+  if (handle == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (slack > (UINT32_MAX - timeout)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  handle->conversion_error = 0;
+  handle->accumulated_error = 0;
+
+  sl_sleeptimer_is_timer_running(handle, &is_running);
+  if (is_running == true) {
+    return SL_STATUS_NOT_READY;
+  }
+
+  return create_timer(handle,
+                      timeout,
+                      0,
+                      callback,
+                      callback_data,
+                      priority,
+                      option_flags,
+                      slack);
+}
+
+/**************************************************************************//**
+ * Starts a 32 bits periodic timer that can expire up to a given slack late.
+ *****************************************************************************/
+sl_status_t sl_sleeptimer_start_periodic_timer_with_slack(sl_sleeptimer_timer_handle_t *handle,
+                                                          uint32_t timeout,
+                                                          uint32_t slack,
+                                                          sl_sleeptimer_timer_callback_t callback,
+                                                          void *callback_data,
+                                                          uint8_t priority,
+                                                          uint16_t option_flags)
+{
+  bool is_running = false;
+
+  if (handle == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  // A slack of a whole period would let the callback run twice in a row.
+  if ((slack != 0u) && (slack >= timeout)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  handle->conversion_error = 0;
+  handle->accumulated_error = 0;
+
+  sl_sleeptimer_is_timer_running(handle, &is_running);
+  if (is_running == true) {
+    return SL_STATUS_INVALID_STATE;
+  }
+
+  return create_timer(handle,
+                      timeout,
+                      timeout,
+                      callback,
+                      callback_data,
+                      priority,
+                      option_flags,
+                      slack);
 }
 
 /**************************************************************************//**
@@ -441,23 +690,24 @@ sl_status_t sl_sleeptimer_stop_timer(sl_sleeptimer_timer_handle_t *handle)
   }
 
   CORE_ENTER_CRITICAL();
-  update_delta_list();
+  update_timer_list();
 
   // If first timer in list, update timer comparator.
-  if (timer_head == handle) {
+  if (is_first_timer(handle)) {
     set_comparator = true;
   }
 
-  error = delta_list_remove_timer(handle);
+  error = remove_timer(handle);
   if (error != SL_STATUS_OK) {
     CORE_EXIT_CRITICAL();
 
     return error;
   }
+  set_timer_slack(handle, 0u);
 
-  if (set_comparator && timer_head) {
+  if (set_comparator && !is_timer_list_empty()) {
     set_comparator_for_next_timer();
-  } else if (!timer_head) {
+  } else if (is_timer_list_empty()) {
     sleeptimer_hal_disable_int(SLEEPTIMER_EVENT_COMP);
   }
 
@@ -480,6 +730,10 @@ sl_status_t sl_sleeptimer_is_timer_running(sl_sleeptimer_timer_handle_t *handle,
   } else {
     *running = false;
     CORE_ENTER_ATOMIC();
+#if SL_SLEEPTIMER_TIMING_WHEEL
+    (void)current;
+    *running = (wheel_find_timer(handle) != NULL);
+#else
     current = timer_head;
     while (current != NULL && !*running) {
       if (current == handle) {
@@ -488,6 +742,7 @@ sl_status_t sl_sleeptimer_is_timer_running(sl_sleeptimer_timer_handle_t *handle,
         current = current->next;
       }
     }
+#endif
     CORE_EXIT_ATOMIC();
   }
   return SL_STATUS_OK;
@@ -508,7 +763,23 @@ sl_status_t sl_sleeptimer_get_timer_time_remaining(sl_sleeptimer_timer_handle_t
 
   CORE_ENTER_ATOMIC();
 
-  update_delta_list();
+  update_timer_list();
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  (void)current;
+  if (wheel_find_timer(handle) == NULL) {
+    CORE_EXIT_ATOMIC();
+
+    return SL_STATUS_NOT_READY;
+  }
+
+  // Expired timers only wait for their callback. Like in the delta list,
+  // timers with a slack are counted up to the end of their window.
+  if (handle->delta == WHEEL_EXPIRED_LIST) {
+    *time = 0u;
+  } else {
+    *time = handle->timeout_expected_tc + get_timer_slack(handle) - last_delta_update_count;
+  }
+#else
   *time  = handle->delta;
 
   // Retrieve timer in list and add the deltas.
@@ -523,6 +794,7 @@ sl_status_t sl_sleeptimer_get_timer_time_remaining(sl_sleeptimer_timer_handle_t
 
     return SL_STATUS_NOT_READY;
   }
+#endif
 
   // Substract time since last compare match.
   if (*time > sleeptimer_hal_get_counter() - last_delta_update_count) {
@@ -548,6 +820,21 @@ sl_status_t sl_sleeptimer_get_remaining_time_of_first_timer(uint16_t option_flag
   uint32_t time = 0;
 
   CORE_ENTER_ATOMIC();
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  (void)current;
+  if (wheel_get_first_timer_time(option_flags, &time)) {
+    // Substract time since last compare match.
+    if (time > (sleeptimer_hal_get_counter() - last_delta_update_count)) {
+      time -= (sleeptimer_hal_get_counter() - last_delta_update_count);
+    } else {
+      time = 0;
+    }
+    *time_remaining = time;
+    CORE_EXIT_ATOMIC();
+
+    return SL_STATUS_OK;
+  }
+#else
   // parse list and retrieve first timer with HF requirement.
   current = timer_head;
   while (current != NULL) {
@@ -568,6 +855,7 @@ sl_status_t sl_sleeptimer_get_remaining_time_of_first_timer(uint16_t option_flag
     }
     current = current->next;
   }
+#endif
   CORE_EXIT_ATOMIC();
 
   return SL_STATUS_EMPTY;
@@ -595,8 +883,13 @@ bool sli_sleeptimer_is_power_manager_timer_next_to_expire(void)
 
   // Make sure that the Power Manager Sleeptimer is actually expired in addition
   // to being the next timer.
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  if ((next_timer_is_power_manager)
+      && ((sl_sleeptimer_get_tick_count() - power_manager_timer_expected_tc) > MIN_DIFF_BETWEEN_COUNT_AND_EXPIRATION)) {
+#else
   if ((next_timer_is_power_manager)
       && ((sl_sleeptimer_get_tick_count() - timer_head->timeout_expected_tc) > MIN_DIFF_BETWEEN_COUNT_AND_EXPIRATION)) {
+#endif
     next_timer_is_power_manager = false;
   }
 
@@ -1251,9 +1544,9 @@ void process_timer_irq(uint8_t local_flag)
 #endif
     overflow_counter++;
 
-    update_delta_list();
+    update_timer_list();
 
-    if (timer_head) {
+    if (!is_timer_list_empty()) {
       set_comparator_for_next_timer();
     }
   }
@@ -1266,23 +1559,15 @@ void process_timer_irq(uint8_t local_flag)
 
     CORE_ENTER_ATOMIC();
     // Make sure the timers list is up to date with the time elapsed since the last update
-    update_delta_list();
+    update_timer_list();
+    expire_slack_timers();
 
-    // Process all timers that have expired.
-    while ((timer_head) && (timer_head->delta == 0)) {
-      sl_sleeptimer_timer_handle_t *temp = timer_head;
-      current = timer_head;
+    // Process all timers that have expired, timers with higher priority first.
+    while ((current = get_next_expired_timer()) != NULL) {
       int32_t periodic_correction = 0u;
       int64_t timeout_temp = 0;
       bool skip_remove = false;
 
-      // Process timers with higher priority first
-      while ((temp != NULL) && (temp->delta == 0)) {
-        if (current->priority > temp->priority) {
-          current = temp;
-        }
-        temp = temp->next;
-      }
       CORE_EXIT_ATOMIC();
 
       // Check if current periodic timer was delayed more than its actual timeout value
@@ -1302,10 +1587,35 @@ void process_timer_irq(uint8_t local_flag)
       // that was intentionally kept at the head of the timers list.
       if (skip_remove != true) {
         CORE_ENTER_ATOMIC();
-        delta_list_remove_timer(current);
+        remove_timer(current);
+        if (current->timeout_periodic == 0u) {
+          set_timer_slack(current, 0u);
+        }
         CORE_EXIT_ATOMIC();
       }
 
+#if SL_SLEEPTIMER_TIMING_WHEEL
+      // Re-insert periodic timer that was previsouly removed from the list.
+      // The wheel keeps the expected tick count of every timer, so the next
+      // period starts where the previous one was expected to end and no
+      // deviation accumulates.
+      if (current->timeout_periodic != 0u && skip_remove != true) {
+        current->timeout_expected_tc += current->timeout_periodic;
+        // Compensate for drift caused by ms to ticks conversion
+        if (current->conversion_error > 0) {
+          current->accumulated_error += current->conversion_error;
+          if (current->accumulated_error >= 1000) {
+            current->accumulated_error -= 1000;
+            current->timeout_expected_tc -= 1;
+          }
+        }
+        CORE_ENTER_ATOMIC();
+        timeout_temp = (int32_t)(current->timeout_expected_tc - last_delta_update_count);
+        EFM_ASSERT(timeout_temp >= 0);
+        insert_timer(current, (timeout_temp > 0) ? (sl_sleeptimer_tick_count_t)timeout_temp : 0u);
+        CORE_EXIT_ATOMIC();
+      }
+#else
       // Re-insert periodic timer that was previsouly removed from the list
       // and compensate for any deviation from the periodic timer frequency.
       if (current->timeout_periodic != 0u && skip_remove != true) {
@@ -1324,10 +1634,11 @@ void process_timer_irq(uint8_t local_flag)
           }
         }
         CORE_ENTER_ATOMIC();
-        delta_list_insert_timer(current, (sl_sleeptimer_tick_count_t)timeout_temp);
+        insert_timer(current, (sl_sleeptimer_tick_count_t)timeout_temp);
         current->timeout_expected_tc += current->timeout_periodic;
         CORE_EXIT_ATOMIC();
       }
+#endif
 
       // Save current option flag and the number of timers that expired.
       option_flags = current->option_flags;
@@ -1341,7 +1652,8 @@ void process_timer_irq(uint8_t local_flag)
       CORE_ENTER_ATOMIC();
 
       // Re-update the list to account for delays during timer's callback.
-      update_delta_list();
+      update_timer_list();
+      expire_slack_timers();
     }
 
     // If the only timer expired is the internal Power Manager one,
@@ -1353,7 +1665,7 @@ void process_timer_irq(uint8_t local_flag)
       }
     }
 
-    if (timer_head) {
+    if (!is_timer_list_empty()) {
       set_comparator_for_next_timer();
     } else {
       sleeptimer_hal_disable_int(SLEEPTIMER_EVENT_COMP);
@@ -1379,16 +1691,14 @@ static void delay_callback(sl_sleeptimer_timer_handle_t *handle,
 }
 
 /*******************************************************************************
- * Inserts a timer in the delta list.
+ * Inserts a timer in the timer list.
  *
  * @param handle Pointer to handle to timer.
- * @param timeout Timer timeout, in ticks.
+ * @param timeout Timer timeout, in ticks, from the last timer list update.
  ******************************************************************************/
-static void delta_list_insert_timer(sl_sleeptimer_timer_handle_t *handle,
-                                    sl_sleeptimer_tick_count_t timeout)
+static void insert_timer(sl_sleeptimer_timer_handle_t *handle,
+                         sl_sleeptimer_tick_count_t timeout)
 {
-  sl_sleeptimer_tick_count_t local_handle_delta = timeout;
-
 #ifdef SL_CATALOG_POWER_MANAGER_PRESENT
   // If Power Manager is present, it's possible that a clock restore is needed right away
   // if we are in the context of a deepsleep and the timeout value is smaller than the restore time.
@@ -1397,13 +1707,695 @@ static void delta_list_insert_timer(sl_sleeptimer_timer_handle_t *handle,
   if (handle->option_flags == 0) {
     uint32_t wakeup_delay = sli_power_manager_get_restore_delay();
 
-    if (local_handle_delta < wakeup_delay) {
-      local_handle_delta = wakeup_delay;
+    if (timeout < wakeup_delay) {
+      timeout = wakeup_delay;
       sli_power_manager_initiate_restore();
     }
   }
 #endif
 
+#if SL_SLEEPTIMER_SLACK_TIMER_COUNT > 0
+  uint32_t i;
+
+  for (i = 0u; (i < SL_SLEEPTIMER_SLACK_TIMER_COUNT) && (slack_timer_count != 0u); i++) {
+    if (slack_timers[i].handle == handle) {
+      slack_timers[i].insert_tc = last_delta_update_count;
+      slack_timers[i].timeout = timeout;
+    }
+  }
+#endif
+
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  // The wheel links the timer at the end of its window by itself.
+  wheel_insert_timer(handle, timeout);
+#else
+  delta_list_insert_timer(handle, timeout + get_timer_slack(handle));
+#endif
+}
+
+/*******************************************************************************
+ * Removes a timer from the timer list.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return 0 if successful. Error code otherwise.
+ ******************************************************************************/
+static sl_status_t remove_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  return wheel_remove_timer(handle);
+#else
+  return delta_list_remove_timer(handle);
+#endif
+}
+
+/*******************************************************************************
+ * Updates the timer list with the time elapsed since the last update.
+ ******************************************************************************/
+static void update_timer_list(void)
+{
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  wheel_update();
+#else
+  update_delta_list();
+#endif
+}
+
+/*******************************************************************************
+ * Determines if no timer is running.
+ *
+ * @return true if the timer list is empty, false otherwise.
+ ******************************************************************************/
+static bool is_timer_list_empty(void)
+{
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  return (wheel_timer_count == 0u) && (expired_head == NULL);
+#else
+  return (timer_head == NULL);
+#endif
+}
+
+/*******************************************************************************
+ * Determines if a timer is the one the comparator is set for.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return true if the comparator must be updated when this timer is started
+ *         or stopped, false otherwise.
+ ******************************************************************************/
+static bool is_first_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  // Expired timers trigger the comparator right away. While the first timer
+  // is not known, update the comparator anyway.
+  return !wheel_first.valid
+         || (wheel_first.handle == handle)
+         || (handle->delta == WHEEL_EXPIRED_LIST);
+#else
+  return (timer_head == handle);
+#endif
+}
+
+/*******************************************************************************
+ * Gets the expired timer to process next.
+ *
+ * @return Pointer to handle to the expired timer with the highest priority,
+ *         NULL if no timer expired.
+ ******************************************************************************/
+static sl_sleeptimer_timer_handle_t *get_next_expired_timer(void)
+{
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  sl_sleeptimer_timer_handle_t *current = expired_head;
+  sl_sleeptimer_timer_handle_t *temp = expired_head;
+
+  // Timers are pushed at the head of the expired list, so among timers of
+  // the same priority the last one found expired first.
+  while (temp != NULL) {
+    if (current->priority >= temp->priority) {
+      current = temp;
+    }
+    temp = temp->next;
+  }
+
+  return current;
+#else
+  sl_sleeptimer_timer_handle_t *current = timer_head;
+  sl_sleeptimer_timer_handle_t *temp = timer_head;
+
+  if ((timer_head == NULL) || (timer_head->delta != 0)) {
+    return NULL;
+  }
+
+  while ((temp != NULL) && (temp->delta == 0)) {
+    if (current->priority > temp->priority) {
+      current = temp;
+    }
+    temp = temp->next;
+  }
+
+  return current;
+#endif
+}
+
+/*******************************************************************************
+ * Sets the slack of a timer.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param slack Ticks the timer can expire late by, 0 for none. The timer gets
+ *        no slack if too many timers already have one.
+ ******************************************************************************/
+static void set_timer_slack(sl_sleeptimer_timer_handle_t *handle,
+                            sl_sleeptimer_tick_count_t slack)
+{
+#if SL_SLEEPTIMER_SLACK_TIMER_COUNT > 0
+  slack_timer_t *entry = NULL;
+  uint32_t i;
+
+  if ((slack == 0u) && (slack_timer_count == 0u)) {
+    return;
+  }
+
+  for (i = 0u; i < SL_SLEEPTIMER_SLACK_TIMER_COUNT; i++) {
+    if (slack_timers[i].handle == handle) {
+      entry = &slack_timers[i];
+      break;
+    }
+    if ((entry == NULL) && (slack_timers[i].handle == NULL)) {
+      entry = &slack_timers[i];
+    }
+  }
+
+  if (slack == 0u) {
+    if ((entry != NULL) && (entry->handle == handle)) {
+      entry->handle = NULL;
+      slack_timer_count--;
+    }
+  } else if (entry != NULL) {
+    if (entry->handle == NULL) {
+      slack_timer_count++;
+    }
+    entry->handle = handle;
+    entry->slack = slack;
+  }
+#else
+  (void)handle;
+  (void)slack;
+#endif
+}
+
+/*******************************************************************************
+ * Gets the slack of a timer.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return Ticks the timer can expire late by.
+ ******************************************************************************/
+static sl_sleeptimer_tick_count_t get_timer_slack(sl_sleeptimer_timer_handle_t *handle)
+{
+#if SL_SLEEPTIMER_SLACK_TIMER_COUNT > 0
+  uint32_t i;
+
+  for (i = 0u; (i < SL_SLEEPTIMER_SLACK_TIMER_COUNT) && (slack_timer_count != 0u); i++) {
+    if (slack_timers[i].handle == handle) {
+      return slack_timers[i].slack;
+    }
+  }
+#else
+  (void)handle;
+#endif
+
+  return 0u;
+}
+
+/*******************************************************************************
+ * Expires the timers whose window opened, so that they are processed during
+ * the same interrupt as the timer that woke the system up.
+ ******************************************************************************/
+static void expire_slack_timers(void)
+{
+#if SL_SLEEPTIMER_SLACK_TIMER_COUNT > 0
+  uint32_t i;
+
+  for (i = 0u; (i < SL_SLEEPTIMER_SLACK_TIMER_COUNT) && (slack_timer_count != 0u); i++) {
+    sl_sleeptimer_timer_handle_t *handle = slack_timers[i].handle;
+
+    if ((handle != NULL)
+        && ((last_delta_update_count - slack_timers[i].insert_tc) >= slack_timers[i].timeout)) {
+      if (remove_timer(handle) == SL_STATUS_OK) {
+#if SL_SLEEPTIMER_TIMING_WHEEL
+        wheel_expire_timer(handle);
+#else
+        delta_list_insert_timer(handle, 0u);
+#endif
+      } else {
+        // The timer is not running anymore.
+        slack_timers[i].handle = NULL;
+        slack_timer_count--;
+      }
+    }
+  }
+#endif
+}
+
+#if SL_SLEEPTIMER_TIMING_WHEEL
+/*******************************************************************************
+ * Inserts a timer in the timing wheel.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param timeout Timer timeout, in ticks, from the last wheel update.
+ ******************************************************************************/
+static void wheel_insert_timer(sl_sleeptimer_timer_handle_t *handle,
+                               sl_sleeptimer_tick_count_t timeout)
+{
+  handle->timeout_expected_tc = last_delta_update_count + timeout;
+
+  if (timeout == 0u) {
+    wheel_expire_timer(handle);
+  } else {
+    wheel_link_timer(handle, wheel_time);
+  }
+}
+
+/*******************************************************************************
+ * Removes a timer from the timing wheel.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return 0 if successful. Error code otherwise.
+ ******************************************************************************/
+static sl_status_t wheel_remove_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+  sl_sleeptimer_timer_handle_t **link = wheel_find_timer(handle);
+  uint32_t level = handle->delta >> WHEEL_SLOT_BITS;
+  uint32_t slot = handle->delta & WHEEL_SLOT_MASK;
+
+  if (link == NULL) {
+    return SL_STATUS_INVALID_STATE;
+  }
+
+  *link = handle->next;
+
+  if (handle->delta != WHEEL_EXPIRED_LIST) {
+    wheel_timer_count--;
+    wheel_untrack_first_timer(handle);
+    if (wheel_slots[level][slot] == NULL) {
+      wheel_occupied[level] &= ~(1UL << slot);
+    } else if (link == &wheel_slots[level][slot]) {
+      wheel_move_slot_first_timer(link);
+    }
+    if (wheel_level_first[level].handle == handle) {
+      wheel_update_level_first(level, wheel_time);
+    }
+  }
+  handle->delta = WHEEL_NO_LIST;
+
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Retrieves a timer in the list its delta field designates. Only the timers
+ * sharing that list are walked.
+ *
+ * @param handle Pointer to handle to timer.
+ *
+ * @return Pointer to the link to the timer in its list, NULL if the timer is
+ *         not running.
+ ******************************************************************************/
+static sl_sleeptimer_timer_handle_t **wheel_find_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+  sl_sleeptimer_timer_handle_t **link;
+
+  if (handle->delta == WHEEL_EXPIRED_LIST) {
+    link = &expired_head;
+  } else if (handle->delta < WHEEL_EXPIRED_LIST) {
+    link = &wheel_slots[handle->delta >> WHEEL_SLOT_BITS][handle->delta & WHEEL_SLOT_MASK];
+  } else {
+    return NULL;
+  }
+
+  while (*link != NULL) {
+    if (*link == handle) {
+      return link;
+    }
+    link = &(*link)->next;
+  }
+
+  return NULL;
+}
+
+/*******************************************************************************
+ * Links a timer in the slot of the lowest level covering its expiration.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param origin Tick count the wheel is at, the timer must not expire before.
+ ******************************************************************************/
+static void wheel_link_timer(sl_sleeptimer_timer_handle_t *handle,
+                             sl_sleeptimer_tick_count_t origin)
+{
+  // Timers started with a slack expire at the end of their window.
+  sl_sleeptimer_tick_count_t link_tc = handle->timeout_expected_tc + get_timer_slack(handle);
+  sl_sleeptimer_tick_count_t distance = link_tc - origin;
+  sl_sleeptimer_timer_handle_t *head;
+  uint32_t level = 0u;
+  uint32_t slot;
+
+  if (distance != 0u) {
+    level = (31UL - __CLZ(distance)) / WHEEL_SLOT_BITS;
+  }
+  slot = (link_tc >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+
+  wheel_track_first_timer(&wheel_first, handle, link_tc);
+  wheel_track_first_timer(&wheel_first_flagged, handle, link_tc);
+
+  handle->delta = (level << WHEEL_SLOT_BITS) | slot;
+  head = wheel_slots[level][slot];
+  // The head of a slot is the timer of the slot expiring first.
+  if ((head == NULL)
+      || ((link_tc - wheel_time)
+          < (head->timeout_expected_tc + get_timer_slack(head) - wheel_time))) {
+    handle->next = head;
+    wheel_slots[level][slot] = handle;
+  } else {
+    handle->next = head->next;
+    head->next = handle;
+  }
+  wheel_occupied[level] |= (1UL << slot);
+  wheel_timer_count++;
+
+  if ((wheel_level_first[level].handle == NULL)
+      || ((link_tc - wheel_time) < (wheel_level_first[level].link_tc - wheel_time))) {
+    wheel_level_first[level].handle = handle;
+    wheel_level_first[level].link_tc = link_tc;
+  }
+}
+
+/*******************************************************************************
+ * Moves the timer of a slot expiring first to the head of the slot, once the
+ * previous head left it.
+ *
+ * @param slot_head Pointer to the head of the slot.
+ ******************************************************************************/
+static void wheel_move_slot_first_timer(sl_sleeptimer_timer_handle_t **slot_head)
+{
+  sl_sleeptimer_timer_handle_t **first_link = slot_head;
+  sl_sleeptimer_timer_handle_t **link;
+  sl_sleeptimer_tick_count_t first_distance = (*slot_head)->timeout_expected_tc
+                                              + get_timer_slack(*slot_head) - wheel_time;
+
+  for (link = &(*slot_head)->next; *link != NULL; link = &(*link)->next) {
+    sl_sleeptimer_tick_count_t distance = (*link)->timeout_expected_tc
+                                          + get_timer_slack(*link) - wheel_time;
+
+    if (distance < first_distance) {
+      first_distance = distance;
+      first_link = link;
+    }
+  }
+
+  if (first_link != slot_head) {
+    sl_sleeptimer_timer_handle_t *first = *first_link;
+
+    *first_link = first->next;
+    first->next = *slot_head;
+    *slot_head = first;
+  }
+}
+
+/*******************************************************************************
+ * Moves a timer to the expired list.
+ *
+ * @param handle Pointer to handle to timer.
+ ******************************************************************************/
+static void wheel_expire_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+  handle->delta = WHEEL_EXPIRED_LIST;
+  handle->next = expired_head;
+  expired_head = handle;
+}
+
+/*******************************************************************************
+ * Gets the next tick the wheel has to process, i.e. the start of the first
+ * occupied slot the wheel did not reach yet. That is the start of the slot of
+ * the first timer of one of the levels.
+ *
+ * @param event_tc Pointer to the tick count of the next event.
+ *
+ * @return true if the wheel holds timers, false otherwise.
+ ******************************************************************************/
+static bool wheel_get_next_event(sl_sleeptimer_tick_count_t *event_tc)
+{
+  bool found = false;
+  uint32_t level;
+
+  for (level = 0u; level < WHEEL_LEVEL_COUNT; level++) {
+    if (wheel_level_first[level].handle != NULL) {
+      uint32_t shift = level * WHEEL_SLOT_BITS;
+      sl_sleeptimer_tick_count_t slot_tc = wheel_level_first[level].link_tc & ~((1UL << shift) - 1u);
+
+      if (!found || ((slot_tc - wheel_time) < (*event_tc - wheel_time))) {
+        *event_tc = slot_tc;
+        found = true;
+      }
+    }
+  }
+
+  return found;
+}
+
+/*******************************************************************************
+ * Finds the timer expiring first in a level, once the previous one left it.
+ * It is the head of the first occupied slot the wheel reaches.
+ *
+ * @param level Level of the wheel.
+ * @param origin Tick count the wheel is at.
+ ******************************************************************************/
+static void wheel_update_level_first(uint32_t level,
+                                     sl_sleeptimer_tick_count_t origin)
+{
+  uint32_t occupied = wheel_occupied[level];
+  uint32_t shift = level * WHEEL_SLOT_BITS;
+  // Start of the first slot of this level at or after the origin.
+  sl_sleeptimer_tick_count_t slot_tc = origin + ((0u - origin) & ((1UL << shift) - 1u));
+  uint32_t start = (slot_tc >> shift) & WHEEL_SLOT_MASK;
+  sl_sleeptimer_timer_handle_t *head;
+
+  if (occupied == 0u) {
+    wheel_level_first[level].handle = NULL;
+    return;
+  }
+
+  // Rotate the occupied slots so that bit 0 is the slot at slot_tc, the
+  // lowest bit set is then the number of slots to skip.
+  if (start != 0u) {
+    occupied = (occupied >> start) | (occupied << (WHEEL_SLOT_COUNT - start));
+  }
+  head = wheel_slots[level][(start + (31UL - __CLZ(occupied & (0u - occupied)))) & WHEEL_SLOT_MASK];
+  wheel_level_first[level].handle = head;
+  wheel_level_first[level].link_tc = head->timeout_expected_tc + get_timer_slack(head);
+}
+
+/*******************************************************************************
+ * Keeps track of the timer expiring first as a timer is linked in the wheel.
+ *
+ * @param first Pointer to the timer expiring first.
+ * @param handle Pointer to handle to the timer being linked.
+ * @param link_tc Tick count the timer expires at.
+ ******************************************************************************/
+static void wheel_track_first_timer(wheel_first_timer_t *first,
+                                    sl_sleeptimer_timer_handle_t *handle,
+                                    sl_sleeptimer_tick_count_t link_tc)
+{
+  if (first->match_flags && (handle->option_flags != first->option_flags)) {
+    return;
+  }
+
+  // Timers of the wheel never expire before the wheel time.
+  if (first->valid
+      && ((first->handle == NULL)
+          || ((link_tc - wheel_time) < (first->link_tc - wheel_time)))) {
+    first->handle = handle;
+    first->link_tc = link_tc;
+  }
+}
+
+/*******************************************************************************
+ * Forgets the timer expiring first when it leaves the wheel.
+ *
+ * @param handle Pointer to handle to the timer leaving the wheel.
+ ******************************************************************************/
+static void wheel_untrack_first_timer(sl_sleeptimer_timer_handle_t *handle)
+{
+  if (wheel_first.handle == handle) {
+    wheel_first.valid = false;
+  }
+  if (wheel_first_flagged.handle == handle) {
+    wheel_first_flagged.valid = false;
+  }
+}
+
+/*******************************************************************************
+ * Gets the timer of the wheel expiring first. If it is not known anymore, it
+ * is the first of the timers expiring first in each level. Restricted to
+ * timers with given flags, the occupied slots of each level are searched in
+ * the order the wheel reaches them, up to the first one holding a timer that
+ * counts. The head of a slot expires first in the slot, so the rest of it is
+ * only walked when the head does not count.
+ *
+ * @param first Pointer to the timer expiring first.
+ *
+ * @return Pointer to handle to the timer, NULL if the wheel is empty.
+ ******************************************************************************/
+static sl_sleeptimer_timer_handle_t *wheel_get_first_timer(wheel_first_timer_t *first)
+{
+  uint32_t level;
+
+  if (first->valid) {
+    return first->handle;
+  }
+
+  first->valid = true;
+  first->handle = NULL;
+
+  if (!first->match_flags) {
+    for (level = 0u; level < WHEEL_LEVEL_COUNT; level++) {
+      if (wheel_level_first[level].handle != NULL) {
+        wheel_track_first_timer(first,
+                                wheel_level_first[level].handle,
+                                wheel_level_first[level].link_tc);
+      }
+    }
+    return first->handle;
+  }
+
+  for (level = 0u; level < WHEEL_LEVEL_COUNT; level++) {
+    uint32_t occupied = wheel_occupied[level];
+    uint32_t shift = level * WHEEL_SLOT_BITS;
+    sl_sleeptimer_tick_count_t slot_tc = wheel_time + ((0u - wheel_time) & ((1UL << shift) - 1u));
+    uint32_t start = (slot_tc >> shift) & WHEEL_SLOT_MASK;
+    sl_sleeptimer_timer_handle_t *level_first = first->handle;
+
+    // Rotate the occupied bits so that bit 0 is the slot reached next.
+    if (start != 0u) {
+      occupied = (occupied >> start) | (occupied << (WHEEL_SLOT_COUNT - start));
+    }
+
+    while ((occupied != 0u) && (first->handle == level_first)) {
+      uint32_t offset = 31UL - __CLZ(occupied & (0u - occupied));
+      sl_sleeptimer_timer_handle_t *current;
+
+      occupied &= occupied - 1u;
+      current = wheel_slots[level][(start + offset) & WHEEL_SLOT_MASK];
+      if (current->option_flags == first->option_flags) {
+        wheel_track_first_timer(first,
+                                current,
+                                current->timeout_expected_tc + get_timer_slack(current));
+      } else {
+        for (; current != NULL; current = current->next) {
+          wheel_track_first_timer(first,
+                                  current,
+                                  current->timeout_expected_tc + get_timer_slack(current));
+        }
+      }
+    }
+  }
+
+  return first->handle;
+}
+
+/*******************************************************************************
+ * Processes the slots starting at a given tick. Timers of the upper levels
+ * are moved down the wheel, timers of level 0 expire.
+ *
+ * @param tick Tick count to process.
+ ******************************************************************************/
+static void wheel_process_tick(sl_sleeptimer_tick_count_t tick)
+{
+  sl_sleeptimer_timer_handle_t *current;
+  sl_sleeptimer_timer_handle_t *next;
+  uint32_t level;
+  uint32_t slot;
+
+  for (level = WHEEL_LEVEL_COUNT - 1u; level > 0u; level--) {
+    uint32_t shift = level * WHEEL_SLOT_BITS;
+
+    if ((tick & ((1UL << shift) - 1u)) == 0u) {
+      slot = (tick >> shift) & WHEEL_SLOT_MASK;
+      current = wheel_slots[level][slot];
+      wheel_slots[level][slot] = NULL;
+      wheel_occupied[level] &= ~(1UL << slot);
+      wheel_update_level_first(level, tick);
+      while (current != NULL) {
+        next = current->next;
+        wheel_timer_count--;
+        wheel_link_timer(current, tick);
+        current = next;
+      }
+    }
+  }
+
+  slot = tick & WHEEL_SLOT_MASK;
+  current = wheel_slots[0][slot];
+  wheel_slots[0][slot] = NULL;
+  wheel_occupied[0] &= ~(1UL << slot);
+  wheel_update_level_first(0u, tick);
+  while (current != NULL) {
+    next = current->next;
+    wheel_timer_count--;
+    wheel_untrack_first_timer(current);
+    wheel_expire_timer(current);
+    current = next;
+  }
+}
+
+/*******************************************************************************
+ * Advances the wheel up to the current tick count. Only the ticks starting
+ * an occupied slot are processed.
+ ******************************************************************************/
+static void wheel_update(void)
+{
+  sl_sleeptimer_tick_count_t current_cnt = sleeptimer_hal_get_counter();
+  sl_sleeptimer_tick_count_t tick_count = current_cnt + 1u - wheel_time;
+  sl_sleeptimer_tick_count_t event_tc = 0u;
+
+  while (wheel_get_next_event(&event_tc)
+         && ((event_tc - wheel_time) < tick_count)) {
+    tick_count -= event_tc + 1u - wheel_time;
+    wheel_process_tick(event_tc);
+    wheel_time = event_tc + 1u;
+  }
+
+  wheel_time = current_cnt + 1u;
+  last_delta_update_count = current_cnt;
+}
+
+/*******************************************************************************
+ * Gets the time remaining until the first timer with the given option flags
+ * expires. That timer is kept track of like the first timer of the wheel,
+ * so the wheel is only searched once it left.
+ *
+ * @param option_flags Option flags of the timer.
+ * @param time Pointer to the time remaining, in ticks, from the last update.
+ *
+ * @return true if such a timer is running, false otherwise.
+ ******************************************************************************/
+static bool wheel_get_first_timer_time(uint16_t option_flags,
+                                       uint32_t *time)
+{
+  sl_sleeptimer_timer_handle_t *current;
+
+  for (current = expired_head; current != NULL; current = current->next) {
+    if (current->option_flags == option_flags) {
+      *time = 0u;
+      return true;
+    }
+  }
+
+  // The same flags are asked for over and over, by the power manager.
+  if (wheel_first_flagged.option_flags != option_flags) {
+    wheel_first_flagged.option_flags = option_flags;
+    wheel_first_flagged.valid = false;
+  }
+
+  if (wheel_get_first_timer(&wheel_first_flagged) == NULL) {
+    return false;
+  }
+
+  *time = wheel_first_flagged.link_tc - last_delta_update_count;
+
+  return true;
+}
+#else
+/*******************************************************************************
+ * Inserts a timer in the delta list.
+ *
+ * @param handle Pointer to handle to timer.
+ * @param timeout Timer timeout, in ticks.
+ ******************************************************************************/
+static void delta_list_insert_timer(sl_sleeptimer_timer_handle_t *handle,
+                                    sl_sleeptimer_tick_count_t timeout)
+{
+  sl_sleeptimer_tick_count_t local_handle_delta = timeout;
+
   handle->delta = local_handle_delta;
 
   if (timer_head != NULL) {
@@ -1472,28 +2464,6 @@ static sl_status_t delta_list_remove_timer(sl_sleeptimer_timer_handle_t *handle)
   return SL_STATUS_OK;
 }
 
-/*******************************************************************************
- * Sets comparator for next timer.
- ******************************************************************************/
-static void set_comparator_for_next_timer(void)
-{
-  if (timer_head->delta > 0) {
-    sl_sleeptimer_tick_count_t compare_value;
-
-    compare_value = last_delta_update_count + timer_head->delta;
-
-    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
-    sleeptimer_hal_set_compare(compare_value);
-  } else {
-    // In case timer has already expire, don't attempt to set comparator. Just
-    // trigger compare match interrupt.
-    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
-    sleeptimer_hal_set_int(SLEEPTIMER_EVENT_COMP);
-  }
-
-  update_next_timer_to_expire_is_power_manager();
-}
-
 /*******************************************************************************
  * Updates timer list's deltas.
  ******************************************************************************/
@@ -1518,6 +2488,43 @@ static void update_delta_list(void)
 
   last_delta_update_count = current_cnt;
 }
+#endif
+
+/*******************************************************************************
+ * Sets comparator for next timer.
+ ******************************************************************************/
+static void set_comparator_for_next_timer(void)
+{
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  if ((expired_head == NULL) && (wheel_get_first_timer(&wheel_first) != NULL)) {
+    // Only wake up when the first timer expires, timers that must move down
+    // the wheel before then are cascaded when the wheel catches up.
+    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
+    sleeptimer_hal_set_compare(wheel_first.link_tc);
+  } else {
+    // In case timer has already expire, don't attempt to set comparator. Just
+    // trigger compare match interrupt.
+    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
+    sleeptimer_hal_set_int(SLEEPTIMER_EVENT_COMP);
+  }
+#else
+  if (timer_head->delta > 0) {
+    sl_sleeptimer_tick_count_t compare_value;
+
+    compare_value = last_delta_update_count + timer_head->delta;
+
+    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
+    sleeptimer_hal_set_compare(compare_value);
+  } else {
+    // In case timer has already expire, don't attempt to set comparator. Just
+    // trigger compare match interrupt.
+    sleeptimer_hal_enable_int(SLEEPTIMER_EVENT_COMP);
+    sleeptimer_hal_set_int(SLEEPTIMER_EVENT_COMP);
+  }
+#endif
+
+  update_next_timer_to_expire_is_power_manager();
+}
 
 /*******************************************************************************
  * Creates and start a 32 bits timer.
@@ -1532,6 +2539,7 @@ static void update_delta_list(void)
  * @param callback_data Pointer to user data that will be passed to callback.
  * @param priority Priority of callback. Useful in case multiple timer expire
  *        at the same time. 0 = highest priority.
+ * @param slack Ticks the timer can expire late by, 0 for none.
  *
  * @return 0 if successful. Error code otherwise.
  ******************************************************************************/
@@ -1541,7 +2549,8 @@ static sl_status_t create_timer(sl_sleeptimer_timer_handle_t *handle,
                                 sl_sleeptimer_timer_callback_t callback,
                                 void *callback_data,
                                 uint8_t priority,
-                                uint16_t option_flags)
+                                uint16_t option_flags,
+                                sl_sleeptimer_tick_count_t slack)
 {
   CORE_DECLARE_IRQ_STATE;
 
@@ -1578,11 +2587,12 @@ static sl_status_t create_timer(sl_sleeptimer_timer_handle_t *handle,
 #endif
 
   CORE_ENTER_CRITICAL();
-  update_delta_list();
-  delta_list_insert_timer(handle, timeout_initial);
+  set_timer_slack(handle, slack);
+  update_timer_list();
+  insert_timer(handle, timeout_initial);
 
   // If first timer, update timer comparator.
-  if (timer_head == handle) {
+  if (is_first_timer(handle)) {
     set_comparator_for_next_timer();
   }
 
@@ -1597,6 +2607,29 @@ static sl_status_t create_timer(sl_sleeptimer_timer_handle_t *handle,
  ******************************************************************************/
 static void update_next_timer_to_expire_is_power_manager(void)
 {
+#if SL_SLEEPTIMER_TIMING_WHEEL
+  sl_sleeptimer_timer_handle_t *current;
+
+  next_timer_to_expire_is_power_manager = false;
+
+  if (expired_head != NULL) {
+    for (current = expired_head; current != NULL; current = current->next) {
+      if (current->option_flags & SLI_SLEEPTIMER_POWER_MANAGER_EARLY_WAKEUP_TIMER_FLAG) {
+        next_timer_to_expire_is_power_manager = true;
+        power_manager_timer_expected_tc = current->timeout_expected_tc;
+        return;
+      }
+    }
+    return;
+  }
+
+  current = wheel_get_first_timer(&wheel_first);
+  if ((current != NULL)
+      && (current->option_flags & SLI_SLEEPTIMER_POWER_MANAGER_EARLY_WAKEUP_TIMER_FLAG)) {
+    next_timer_to_expire_is_power_manager = true;
+    power_manager_timer_expected_tc = current->timeout_expected_tc;
+  }
+#else
   sl_sleeptimer_timer_handle_t *current = timer_head;
   uint32_t delta_diff_with_first = 0;
 
@@ -1615,6 +2648,7 @@ static void update_next_timer_to_expire_is_power_manager(void)
 
     delta_diff_with_first += current->delta;
   }
+#endif
 }
 
 /**************************************************************************//**
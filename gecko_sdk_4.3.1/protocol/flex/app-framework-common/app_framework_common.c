@@ -29,6 +29,7 @@
 
 #include "callback_dispatcher.h"
 #include "app_framework_callback.h"
+#include "app_framework_common.h"
 #include "hal.h"
 
 #include "sl_component_catalog.h"
@@ -45,9 +46,8 @@ extern void emApiTick(void);
 
 EmberTaskId emAppTask;
 extern const EmberEventData emAppEvents[];
-extern void(*emAppEventsHandlerPtrTable[])(void);
+// Number of events of the table ahead of the allocateEventN placeholders.
 extern const uint8_t emAfEventTableOffset;
-extern uint8_t emAfEventTableHandleIndex;
 
 void connect_standard_phy_2_4g(void)
 {
@@ -70,6 +70,7 @@ void connect_app_framework_init(void)
 {
   // Init and register the application events.
   emAppTask = emberTaskInit(emAppEvents);
+  emAfEventSchedulerInit(emAppEvents, emAfEventTableOffset);
 
   // Call the init callback of plugins that subscribed to it.
   emberAfInit();
@@ -77,19 +78,6 @@ void connect_app_framework_init(void)
   emberAfInitCallback();
 }
 
-EmberStatus emberAfAllocateEvent(EmberEventControl **control, void (*handler)(void))
-{
-  if (emAppEvents[emAfEventTableHandleIndex + emAfEventTableOffset].control != NULL) {
-    *control = emAppEvents[emAfEventTableHandleIndex + emAfEventTableOffset].control;
-    emAppEventsHandlerPtrTable[emAfEventTableHandleIndex] = handler;
-    emAfEventTableHandleIndex++;
-    return EMBER_SUCCESS;
-  } else {
-    // table is full
-    return EMBER_TABLE_FULL;
-  }
-}
-
 void connect_stack_tick(void)
 {
   // Pet the watchdog.
@@ -106,6 +94,6 @@ void connect_app_framework_tick(void)
   emberAfTickCallback();
   // Call the tick callback of plugins that subscribed to it.
   emberAfTick();
-  // Run application events.
-  emberRunTask(emAppTask);
+  // Run application events that are due.
+  emAfRunEvents();
 }
@@ -44,14 +44,26 @@ bool connect_is_ok_to_sleep(void);
 
 void connect_standard_phy_2_4g(void);
 
+// Application event scheduler, see app_framework_event_scheduler.c.
+void emAfEventSchedulerInit(const EmberEventData *table, uint8_t tableSize);
+void emAfRunEvents(void);
+uint32_t emAfMsToNextEvent(uint32_t maxMs);
+
 /**
  * @addtogroup app_framework_common
  * @{
  */
 
+/**
+ * @brief Handler of an event registered with emberAfEventRegister().
+ *
+ * @param[in] context  The context passed at registration.
+ */
+typedef void (*EmberAfEventHandler)(void *context);
+
 /**
  *
- * @brief Allocate a new event to the app event table.
+ * @brief Allocate a new event from the app event pool.
  *
  *  @param[out] control   The EmberEventControl to allocate
  *
@@ -59,10 +71,47 @@ void connect_standard_phy_2_4g(void);
  *
  *  @return   An ::EmberStatus value of:
  *  - ::EMBER_SUCCESS if the event was successfully allocated.
+ *  - ::EMBER_BAD_ARGUMENT if control or handler is NULL.
  *  - ::EMBER_TABLE_FULL if no more event could be allocated.
- *  @sa emberAfAllocateEvent()
+ *  @sa emberAfEventRegister()
  */
 EmberStatus emberAfAllocateEvent(EmberEventControl **control, void (*handler)(void));
+
+/**
+ *
+ * @brief Register a new event from the app event pool, whose handler is
+ * called with a context. The event starts inactive.
+ *
+ *  @param[out] control   The EmberEventControl of the event
+ *
+ *  @param[in] handler   Pointer to the handler function associated to the event
+ *
+ *  @param[in] context   Passed to the handler each time the event fires
+ *
+ *  @return   An ::EmberStatus value of:
+ *  - ::EMBER_SUCCESS if the event was successfully registered.
+ *  - ::EMBER_BAD_ARGUMENT if control or handler is NULL.
+ *  - ::EMBER_TABLE_FULL if the pool is exhausted.
+ *  @sa emberAfEventUnregister()
+ */
+EmberStatus emberAfEventRegister(EmberEventControl **control,
+                                 EmberAfEventHandler handler,
+                                 void *context);
+
+/**
+ *
+ * @brief Cancel an event from the app event pool and give it back to the
+ * pool. The control must not be used afterwards. An event may unregister
+ * itself from its handler.
+ *
+ *  @param[in] control   The EmberEventControl of the event
+ *
+ *  @return   An ::EmberStatus value of:
+ *  - ::EMBER_SUCCESS if the event was unregistered.
+ *  - ::EMBER_INVALID_CALL if the control does not belong to the pool.
+ *  @sa emberAfEventRegister()
+ */
+EmberStatus emberAfEventUnregister(EmberEventControl *control);
 /**
  * @}
  */
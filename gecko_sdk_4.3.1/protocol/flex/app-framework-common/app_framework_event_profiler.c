@@ -0,0 +1,193 @@
+/***************************************************************************//**
+ * @brief Connect Application Framework event profiler.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2020 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+
+#include PLATFORM_HEADER
+#include "stack/include/ember.h"
+#include "hal.h"
+
+#include <em_core.h>
+#include "sl_sleeptimer.h"
+
+#include "app_framework_event_profiler.h"
+
+#if (EMBER_AF_EVENT_PROFILER == 1)
+
+// Indexed like the entries of the event scheduler. Only accessed inside an
+// atomic section.
+static EmberAfEventProfile eventProfiles[EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS];
+static uint32_t resetTimeMs;
+
+//------------------------------------------------------------------------------
+// Forward declarations
+
+static void recordSample(EmberAfEventProfile *profile,
+                         uint8_t type,
+                         uint32_t ticks);
+static uint8_t getBucket(uint32_t ticks);
+
+//------------------------------------------------------------------------------
+// Public APIs
+
+bool emberAfGetEventProfile(uint8_t index, EmberAfEventProfile *profile)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if (index >= EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS) {
+    return false;
+  }
+
+  CORE_ENTER_ATOMIC();
+  *profile = eventProfiles[index];
+  CORE_EXIT_ATOMIC();
+
+  return true;
+}
+
+uint32_t emberAfGetEventProfileElapsedMs(void)
+{
+  return halCommonGetInt32uMillisecondTick() - resetTimeMs;
+}
+
+void emberAfResetEventProfiles(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  MEMSET(eventProfiles, 0, sizeof(eventProfiles));
+  resetTimeMs = halCommonGetInt32uMillisecondTick();
+  CORE_EXIT_ATOMIC();
+}
+
+//------------------------------------------------------------------------------
+// Internal APIs
+
+uint32_t emAfEventProfilerNow(void)
+{
+  return sl_sleeptimer_get_tick_count();
+}
+
+void emAfEventProfilerRecord(uint8_t event,
+                             void (*handler)(void),
+                             void *context,
+                             uint32_t latenessMs,
+                             uint32_t startTick,
+                             uint32_t endTick)
+{
+  EmberAfEventProfile *profile;
+  uint32_t latenessTicks;
+  CORE_DECLARE_IRQ_STATE;
+
+  assert(event < EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS);
+
+  // Events set active from an interrupt may be picked up a bit before their
+  // millisecond expired.
+  if ((int32_t)latenessMs < 0) {
+    latenessMs = 0;
+  }
+  if (sl_sleeptimer_ms32_to_tick(latenessMs, &latenessTicks) != SL_STATUS_OK) {
+    latenessTicks = UINT32_MAX;
+  }
+
+  CORE_ENTER_ATOMIC();
+  profile = &eventProfiles[event];
+  profile->handler = handler;
+  profile->context = context;
+  // Unsigned arithmetic takes care of the tick counter wrapping.
+  recordSample(profile, EMBER_AF_EVENT_PROFILE_RUN_TIME, endTick - startTick);
+  recordSample(profile, EMBER_AF_EVENT_PROFILE_LATENESS, latenessTicks);
+  if (profile->count > 0) {
+    recordSample(profile,
+                 EMBER_AF_EVENT_PROFILE_INTERVAL,
+                 startTick - profile->lastRunTick);
+  }
+  if (endTick - startTick > profile->maxRunTimeTicks) {
+    profile->maxRunTimeTicks = endTick - startTick;
+  }
+  if (latenessMs > profile->maxLatenessMs) {
+    profile->maxLatenessMs = latenessMs;
+  }
+  profile->lastRunTick = startTick;
+  profile->count++;
+  CORE_EXIT_ATOMIC();
+}
+
+void emAfEventProfilerClear(uint8_t event)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  assert(event < EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS);
+
+  CORE_ENTER_ATOMIC();
+  MEMSET(&eventProfiles[event], 0, sizeof(EmberAfEventProfile));
+  CORE_EXIT_ATOMIC();
+}
+
+//------------------------------------------------------------------------------
+// Static functions
+
+static void recordSample(EmberAfEventProfile *profile,
+                         uint8_t type,
+                         uint32_t ticks)
+{
+  uint8_t bucket = getBucket(ticks);
+
+  if (profile->histograms[type][bucket] < 0xFFFF) {
+    profile->histograms[type][bucket]++;
+  }
+}
+
+static uint8_t getBucket(uint32_t ticks)
+{
+  uint8_t bucket = (ticks == 0) ? 0 : (32 - __CLZ(ticks));
+
+  return (bucket < EMBER_AF_EVENT_PROFILE_BUCKET_COUNT)
+         ? bucket
+         : (EMBER_AF_EVENT_PROFILE_BUCKET_COUNT - 1);
+}
+
+#else // EMBER_AF_EVENT_PROFILER
+
+bool emberAfGetEventProfile(uint8_t index, EmberAfEventProfile *profile)
+{
+  (void)index;
+  (void)profile;
+  return false;
+}
+
+uint32_t emberAfGetEventProfileElapsedMs(void)
+{
+  return 0;
+}
+
+void emberAfResetEventProfiles(void)
+{
+}
+
+#endif // EMBER_AF_EVENT_PROFILER
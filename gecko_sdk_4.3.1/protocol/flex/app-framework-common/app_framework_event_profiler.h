@@ -0,0 +1,115 @@
+/***************************************************************************//**
+ * @brief Connect Application Framework event profiler.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2020 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+
+#ifndef APP_FRAMEWORK_EVENT_PROFILER_H
+#define APP_FRAMEWORK_EVENT_PROFILER_H
+
+#include "stack/include/ember.h"
+#include "app_framework_common_config.h"
+
+// RUN_TIME is the time spent in the event handler, LATENESS the time from the
+// scheduled expiry of the event to its handler being called and INTERVAL the
+// time between two consecutive runs of the event.
+#define EMBER_AF_EVENT_PROFILE_RUN_TIME                 0
+#define EMBER_AF_EVENT_PROFILE_LATENESS                 1
+#define EMBER_AF_EVENT_PROFILE_INTERVAL                 2
+#define EMBER_AF_EVENT_PROFILE_TYPE_COUNT               3
+
+// Bucket 0 counts durations of 0 sleeptimer ticks, bucket N durations of
+// 2^(N-1) to 2^N - 1 ticks. The last bucket also counts everything longer.
+#define EMBER_AF_EVENT_PROFILE_BUCKET_COUNT             20
+
+typedef struct {
+  // Handler the event is dispatched to, NULL if the event did not run since
+  // the last reset. Handlers registered with emberAfEventRegister() are
+  // called with the context below.
+  void (*handler)(void);
+  void *context;
+  // Number of times the event ran.
+  uint32_t count;
+  uint32_t maxRunTimeTicks;
+  uint32_t maxLatenessMs;
+  // Counters saturate at 0xFFFF.
+  uint16_t histograms[EMBER_AF_EVENT_PROFILE_TYPE_COUNT][EMBER_AF_EVENT_PROFILE_BUCKET_COUNT];
+  uint32_t lastRunTick;
+} EmberAfEventProfile;
+
+//------------------------------------------------------------------------------
+// Public APIs
+
+/**
+ * Copy the profile of the index-th application event. Returns false once
+ * index is past the last event, or if EMBER_AF_EVENT_PROFILER is disabled.
+ */
+bool emberAfGetEventProfile(uint8_t index, EmberAfEventProfile *profile);
+
+/**
+ * Milliseconds elapsed since the profiles were last reset, to turn counts
+ * into rates.
+ */
+uint32_t emberAfGetEventProfileElapsedMs(void);
+
+void emberAfResetEventProfiles(void);
+
+//------------------------------------------------------------------------------
+// Internal APIs
+
+#if (EMBER_AF_EVENT_PROFILER == 1)
+
+uint32_t emAfEventProfilerNow(void);
+
+void emAfEventProfilerRecord(uint8_t event,
+                             void (*handler)(void),
+                             void *context,
+                             uint32_t latenessMs,
+                             uint32_t startTick,
+                             uint32_t endTick);
+
+// A pool event was allocated, its entry may have served another event.
+void emAfEventProfilerClear(uint8_t event);
+
+#define EVENT_PROFILER_NOW() emAfEventProfilerNow()
+#define EVENT_PROFILER_LATENESS_MS(expiryMs) \
+  (halCommonGetInt32uMillisecondTick() - (expiryMs))
+#define EVENT_PROFILER_RECORD(event, handler, context, latenessMs, startTick, endTick) \
+  emAfEventProfilerRecord((event), (handler), (context), (latenessMs), (startTick), (endTick))
+#define EVENT_PROFILER_CLEAR(event) emAfEventProfilerClear(event)
+
+#else
+
+#define EVENT_PROFILER_NOW() 0
+#define EVENT_PROFILER_LATENESS_MS(expiryMs) ((void)(expiryMs), 0)
+#define EVENT_PROFILER_RECORD(event, handler, context, latenessMs, startTick, endTick) \
+  ((void)(event), (void)(latenessMs), (void)(startTick))
+#define EVENT_PROFILER_CLEAR(event) ((void)(event))
+
+#endif // EMBER_AF_EVENT_PROFILER
+
+#endif // APP_FRAMEWORK_EVENT_PROFILER_H
@@ -0,0 +1,464 @@
+/***************************************************************************//**
+ * @brief Connect Application Framework event scheduler.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2020 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// The stack library walks the whole application event table each time the
+// application framework runs its events or computes how long it may idle.
+// Instead, the controls of the application events report every change to this
+// module (see emberEventControlSetDelayMS() and friends in event.h), which
+// keeps the scheduled events in a binary min-heap ordered by expiry time. The
+// next event is then found in constant time and is (re)scheduled in
+// logarithmic time, regardless of the size of the event table.
+//
+// Controls must therefore only change through the macros. Writing the status
+// or the expiry time of a control directly is not supported: this module never
+// learns about it, and the event does not run.
+//
+// Besides the events of the generated table, the same array serves as a pool
+// of events that are registered and unregistered at runtime. Those own their
+// control and are dispatched directly to their handler, with a context. The
+// generated table still ends with allocateEventN placeholders, which
+// emberAfAllocateEvent() no longer hands out: only the events ahead of them
+// are registered, and the placeholders take no entry.
+
+#include "app_framework_common.h"
+#include "app_framework_common_config.h"
+#include "app_framework_event_profiler.h"
+#include "hal.h"
+#include "em_core.h"
+
+#if (EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS > 127)
+#error "EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS must be less than 128"
+#endif
+
+// Open addressing table mapping a control to its event, kept at most half
+// full so that lookups from the event control macros stay short. Linear
+// probing lets entries be removed without tombstones.
+#define LOOKUP_TABLE_SIZE (2 * EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS)
+#define LOOKUP_EMPTY      0xFF
+#define NOT_QUEUED        0xFF
+
+typedef struct {
+  // NULL when the entry is free.
+  EmberEventControl *control;
+  // Only one of the two handlers is set.
+  void (*handler)(void);
+  EmberAfEventHandler contextHandler;
+  void *context;
+  // Control of the pool events.
+  EmberEventControl poolControl;
+  uint32_t expiryMs;
+  // Breaks ties between events expiring at the same time, so that they run in
+  // the order they were scheduled.
+  uint32_t sequence;
+  uint8_t heapIndex;
+} ScheduledEvent;
+
+//------------------------------------------------------------------------------
+// Static variables
+
+static ScheduledEvent events[EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS];
+static uint8_t lookupTable[LOOKUP_TABLE_SIZE];
+static uint8_t heap[EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS];
+static uint8_t heapSize = 0;
+static uint32_t nextSequence = 0;
+
+extern EmberTaskId emAppTask;
+
+//------------------------------------------------------------------------------
+// Forward declarations
+
+static EmberEventControl *allocatePoolEvent(void (*handler)(void),
+                                            EmberAfEventHandler contextHandler,
+                                            void *context);
+static uint8_t lookupHome(const EmberEventControl *control);
+static uint8_t lookupSlot(const EmberEventControl *control);
+static void lookupRemove(uint8_t slot);
+static bool expiresBefore(uint8_t a, uint8_t b);
+static void heapSwap(uint8_t i, uint8_t j);
+static void heapSiftUp(uint8_t index);
+static void heapSiftDown(uint8_t index);
+static void heapRemove(uint8_t index);
+static void scheduleEvent(uint8_t event, uint32_t expiryMs);
+
+//------------------------------------------------------------------------------
+// Internal APIs
+
+void emAfEventSchedulerInit(const EmberEventData *table, uint8_t tableSize)
+{
+  const EmberEventData *end = table + tableSize;
+  uint8_t eventCount = 0;
+  uint8_t slot;
+
+  heapSize = 0;
+  MEMSET(events, 0, sizeof(events));
+  MEMSET(lookupTable, LOOKUP_EMPTY, sizeof(lookupTable));
+
+  for (; (table < end) && (table->control != NULL); table++) {
+    assert(eventCount < EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS);
+    slot = lookupSlot(table->control);
+    if (lookupTable[slot] != LOOKUP_EMPTY) {
+      continue; // Listed twice, the first handler wins like in the stack.
+    }
+    events[eventCount].control = table->control;
+    events[eventCount].handler = table->handler;
+    events[eventCount].heapIndex = NOT_QUEUED;
+    lookupTable[slot] = eventCount;
+    // Events may have been scheduled before the table got registered.
+    if (table->control->status != EMBER_EVENT_INACTIVE) {
+      scheduleEvent(eventCount,
+                    halCommonGetInt32uMillisecondTick()
+                    + emberEventControlGetRemainingMS(*table->control));
+    }
+    eventCount++;
+  }
+}
+
+void emAfEventControlScheduled(EmberEventControl *control, uint32_t delayMs)
+{
+  uint32_t now = halCommonGetInt32uMillisecondTick();
+  uint8_t event;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  event = lookupTable[lookupSlot(control)];
+  if (event != LOOKUP_EMPTY) {
+    scheduleEvent(event, now + delayMs);
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+void emAfEventControlCancelled(EmberEventControl *control)
+{
+  uint8_t event;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  event = lookupTable[lookupSlot(control)];
+  if (event != LOOKUP_EMPTY && events[event].heapIndex != NOT_QUEUED) {
+    heapRemove(events[event].heapIndex);
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+void emAfRunEvents(void)
+{
+  uint32_t now = halCommonGetInt32uMillisecondTick();
+  uint32_t runSequence;
+  uint32_t expiryMs;
+  uint32_t latenessMs;
+  uint32_t startTick;
+  void (*handler)(void);
+  EmberAfEventHandler contextHandler;
+  void *context;
+  uint8_t event;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  runSequence = nextSequence;
+  CORE_EXIT_ATOMIC();
+
+  // Run every event that is due, each one at most once per call. An event
+  // stays active until its handler sets it inactive or reschedules it, so it
+  // is queued again right away and runs again on the next call, the same way
+  // emberRunTask() treats it.
+  while (true) {
+    CORE_ENTER_ATOMIC();
+    if (heapSize == 0) {
+      CORE_EXIT_ATOMIC();
+      break;
+    }
+    event = heap[0];
+    if ((int32_t)(events[event].expiryMs - now) > 0
+        || (int32_t)(events[event].sequence - runSequence) >= 0) {
+      CORE_EXIT_ATOMIC();
+      break;
+    }
+    // The control was cleared without going through the macros in event.h.
+    if (events[event].control->status == EMBER_EVENT_INACTIVE) {
+      heapRemove(0);
+      CORE_EXIT_ATOMIC();
+      continue;
+    }
+    expiryMs = events[event].expiryMs;
+    scheduleEvent(event, now);
+    handler = events[event].handler;
+    contextHandler = events[event].contextHandler;
+    context = events[event].context;
+    CORE_EXIT_ATOMIC();
+
+    latenessMs = EVENT_PROFILER_LATENESS_MS(expiryMs);
+    startTick = EVENT_PROFILER_NOW();
+    if (contextHandler != NULL) {
+      contextHandler(context);
+    } else {
+      handler();
+    }
+    EVENT_PROFILER_RECORD(event,
+                          (contextHandler != NULL)
+                          ? (void (*)(void))contextHandler
+                          : handler,
+                          context,
+                          latenessMs,
+                          startTick,
+                          EVENT_PROFILER_NOW());
+  }
+}
+
+uint32_t emAfMsToNextEvent(uint32_t maxMs)
+{
+  uint32_t now = halCommonGetInt32uMillisecondTick();
+  uint32_t result = maxMs;
+  int32_t remaining;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if (heapSize > 0) {
+    remaining = (int32_t)(events[heap[0]].expiryMs - now);
+    if (remaining <= 0) {
+      result = 0;
+    } else if ((uint32_t)remaining < maxMs) {
+      result = (uint32_t)remaining;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  return result;
+}
+
+//------------------------------------------------------------------------------
+// Public APIs
+
+EmberStatus emberAfAllocateEvent(EmberEventControl **control, void (*handler)(void))
+{
+  if (control == NULL || handler == NULL) {
+    return EMBER_BAD_ARGUMENT;
+  }
+
+  *control = allocatePoolEvent(handler, NULL, NULL);
+
+  return (*control != NULL) ? EMBER_SUCCESS : EMBER_TABLE_FULL;
+}
+
+EmberStatus emberAfEventRegister(EmberEventControl **control,
+                                 EmberAfEventHandler handler,
+                                 void *context)
+{
+  if (control == NULL || handler == NULL) {
+    return EMBER_BAD_ARGUMENT;
+  }
+
+  *control = allocatePoolEvent(NULL, handler, context);
+
+  return (*control != NULL) ? EMBER_SUCCESS : EMBER_TABLE_FULL;
+}
+
+EmberStatus emberAfEventUnregister(EmberEventControl *control)
+{
+  EmberStatus status = EMBER_INVALID_CALL;
+  uint8_t slot;
+  uint8_t event;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  slot = lookupSlot(control);
+  event = lookupTable[slot];
+  // Events of the generated table can't be given back.
+  if (event != LOOKUP_EMPTY && control == &events[event].poolControl) {
+    control->status = EMBER_EVENT_INACTIVE;
+    if (events[event].heapIndex != NOT_QUEUED) {
+      heapRemove(events[event].heapIndex);
+    }
+    lookupRemove(slot);
+    events[event].control = NULL;
+    status = EMBER_SUCCESS;
+  }
+  CORE_EXIT_ATOMIC();
+
+  return status;
+}
+
+//------------------------------------------------------------------------------
+// Static functions
+
+static EmberEventControl *allocatePoolEvent(void (*handler)(void),
+                                            EmberAfEventHandler contextHandler,
+                                            void *context)
+{
+  EmberEventControl *control = NULL;
+  uint8_t event;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  for (event = 0; event < EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS; event++) {
+    if (events[event].control == NULL) {
+      control = &events[event].poolControl;
+      control->status = EMBER_EVENT_INACTIVE;
+      control->taskid = emAppTask;
+      control->timeToExecute = 0;
+      events[event].control = control;
+      events[event].handler = handler;
+      events[event].contextHandler = contextHandler;
+      events[event].context = context;
+      events[event].heapIndex = NOT_QUEUED;
+      lookupTable[lookupSlot(control)] = event;
+      EVENT_PROFILER_CLEAR(event);
+      break;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  return control;
+}
+
+static uint8_t lookupHome(const EmberEventControl *control)
+{
+  uint32_t hash = (uint32_t)(uintptr_t)control;
+
+  hash = (hash >> 2) * 2654435761UL;
+  return (uint8_t)((hash >> 16) % LOOKUP_TABLE_SIZE);
+}
+
+// Returns the slot holding the control, or the empty slot where it belongs.
+static uint8_t lookupSlot(const EmberEventControl *control)
+{
+  uint8_t slot = lookupHome(control);
+
+  while (lookupTable[slot] != LOOKUP_EMPTY
+         && events[lookupTable[slot]].control != control) {
+    slot = (uint8_t)((slot + 1) % LOOKUP_TABLE_SIZE);
+  }
+
+  return slot;
+}
+
+// Empties the slot, then moves back the entries that follow it in the same
+// probe sequence so that lookups never stop short of them.
+static void lookupRemove(uint8_t slot)
+{
+  uint8_t next = slot;
+  uint8_t home;
+
+  lookupTable[slot] = LOOKUP_EMPTY;
+  while (true) {
+    next = (uint8_t)((next + 1) % LOOKUP_TABLE_SIZE);
+    if (lookupTable[next] == LOOKUP_EMPTY) {
+      break;
+    }
+    home = lookupHome(events[lookupTable[next]].control);
+    if ((next + LOOKUP_TABLE_SIZE - home) % LOOKUP_TABLE_SIZE
+        >= (next + LOOKUP_TABLE_SIZE - slot) % LOOKUP_TABLE_SIZE) {
+      lookupTable[slot] = lookupTable[next];
+      lookupTable[next] = LOOKUP_EMPTY;
+      slot = next;
+    }
+  }
+}
+
+// Expiry times are compared as differences so that they survive the
+// millisecond tick wrapping around.
+static bool expiresBefore(uint8_t a, uint8_t b)
+{
+  int32_t difference = (int32_t)(events[a].expiryMs - events[b].expiryMs);
+
+  if (difference != 0) {
+    return (difference < 0);
+  }
+  return ((int32_t)(events[a].sequence - events[b].sequence) < 0);
+}
+
+static void heapSwap(uint8_t i, uint8_t j)
+{
+  uint8_t event = heap[i];
+
+  heap[i] = heap[j];
+  heap[j] = event;
+  events[heap[i]].heapIndex = i;
+  events[heap[j]].heapIndex = j;
+}
+
+static void heapSiftUp(uint8_t index)
+{
+  uint8_t parent;
+
+  while (index > 0) {
+    parent = (uint8_t)((index - 1) / 2);
+    if (!expiresBefore(heap[index], heap[parent])) {
+      break;
+    }
+    heapSwap(index, parent);
+    index = parent;
+  }
+}
+
+static void heapSiftDown(uint8_t index)
+{
+  uint8_t child;
+
+  while ((child = (uint8_t)(2 * index + 1)) < heapSize) {
+    if (child + 1 < heapSize && expiresBefore(heap[child + 1], heap[child])) {
+      child++;
+    }
+    if (!expiresBefore(heap[child], heap[index])) {
+      break;
+    }
+    heapSwap(index, child);
+    index = child;
+  }
+}
+
+static void heapRemove(uint8_t index)
+{
+  uint8_t moved;
+
+  events[heap[index]].heapIndex = NOT_QUEUED;
+  heapSize--;
+  if (index < heapSize) {
+    moved = heap[heapSize];
+    heap[index] = moved;
+    events[moved].heapIndex = index;
+    heapSiftUp(index);
+    heapSiftDown(events[moved].heapIndex);
+  }
+}
+
+// Must be called within an atomic section.
+static void scheduleEvent(uint8_t event, uint32_t expiryMs)
+{
+  events[event].expiryMs = expiryMs;
+  events[event].sequence = nextSequence++;
+
+  if (events[event].heapIndex == NOT_QUEUED) {
+    events[event].heapIndex = heapSize;
+    heap[heapSize++] = event;
+    heapSiftUp(events[event].heapIndex);
+  } else {
+    heapSiftUp(events[event].heapIndex);
+    heapSiftDown(events[event].heapIndex);
+  }
+}
@@ -31,6 +31,7 @@
 
 #include "callback_dispatcher.h"
 #include "app_framework_callback.h"
+#include "app_framework_common.h"
 #include "hal.h"
 
 #include "sl_component_catalog.h"
@@ -73,7 +74,6 @@ static sl_power_manager_em_transition_event_info_t pm_event_info =
 
 static sl_sleeptimer_timer_handle_t wakeup_timer_id;
 
-extern const EmberEventData emAppEvents[];
 extern EmberTaskId emAppTask;
 
 #endif // SL_CATALOG_POWER_MANAGER_PRESENT
@@ -118,7 +118,7 @@ bool connect_is_ok_to_sleep(void)
     duration_ms = (emberOkToHibernate()
                    ? MAX_INT32U_VALUE
                    : emberMsToNextStackEvent());
-    duration_ms = emberMsToNextEvent(emAppEvents, duration_ms);
+    duration_ms = emAfMsToNextEvent(duration_ms);
 
     // If the sleep duration is below our minimum threshold, we don't bother
     // sleeping.  It takes time to shut everything down and bring everything
@@ -152,7 +152,7 @@ bool connect_is_ok_to_sleep(void)
     assert(em1_requirement_set);
 
     duration_ms = emberStackIdleTimeMs(NULL);
-    duration_ms = emberMsToNextEvent(emAppEvents, duration_ms);
+    duration_ms = emAfMsToNextEvent(duration_ms);
   }
 
   INTERRUPTS_ON();
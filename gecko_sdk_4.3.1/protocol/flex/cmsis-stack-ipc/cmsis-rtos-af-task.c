@@ -40,7 +40,6 @@
 static void appFrameworkTaskYield(void);
 
 extern EmberTaskId emAppTask;
-extern const EmberEventData emAppEvents[];
 
 extern osEventFlagsId_t emAfPluginCmsisRtosFlags;
 
@@ -76,8 +75,7 @@ void emAfPluginCmsisRtosWakeUpAppFrameworkTask(void)
 
 static void appFrameworkTaskYield(void)
 {
-  uint32_t idleTimeMs = emberMsToNextEvent(emAppEvents,
-                                           EMBER_AF_PLUGIN_CMSIS_RTOS_APP_FRAMEWORK_YIELD_TIMEOUT_MS);
+  uint32_t idleTimeMs = emAfMsToNextEvent(EMBER_AF_PLUGIN_CMSIS_RTOS_APP_FRAMEWORK_YIELD_TIMEOUT_MS);
 
   if (idleTimeMs > 0) {
     uint32_t yieldTimeTicks = (osKernelGetTickFreq() * idleTimeMs) / 1000;
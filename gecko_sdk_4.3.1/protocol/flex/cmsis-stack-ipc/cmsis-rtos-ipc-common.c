@@ -32,39 +32,202 @@
 
 #include "stack/include/ember.h"
 
+#include <em_core.h>
+
 #include "cmsis-rtos-support.h"
+#include "cmsis-rtos-ipc-stats.h"
 #include "csp-command-utils.h"
 #include "csp-format.h"
+#include "csp-api-enum-gen.h"
+#include "csp-stack-state.h"
+
+#if (EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS > 32)
+#error "At most 32 asynchronous command slots are supported"
+#endif
+
+// Each command slot has its own response flag, which must fit in the 24 bits
+// of an event flags object.
+#if (EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS > 16)
+#error "At most 16 command slots are supported"
+#endif
 
 // TODO: This is for IAR, for GCC it should be "unsigned long"
 typedef unsigned int PointerType;
 
 osEventFlagsId_t emAfPluginCmsisRtosFlags;
 
-osMutexId_t commandMutex;
-osMessageQueueId_t callbackQueue;
-static uint8_t apiCommandData[MAX_STACK_API_COMMAND_SIZE];
-static EmberBuffer callbackBuffer[EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE];
+// Blocking commands are formatted by application tasks into one of these
+// slots, so that several tasks can have a command in flight at the same time.
+// A task claims a slot in acquireCommandMutex() and keeps it until
+// releaseCommandMutex(), the semaphore counts the slots nobody holds.
+typedef struct {
+  osThreadId_t owner;
+  uint32_t postedTick;
+  uint8_t data[MAX_STACK_API_COMMAND_SIZE];
+} ApiCommandSlot;
+
+static ApiCommandSlot commandSlots[EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS];
+static osSemaphoreId_t commandSlotSemaphore;
+
+// The command buffer the stack task is currently servicing, either the data of
+// a command slot or of an asynchronous command slot.
+static uint8_t *stackCommandData;
+
+// Callback commands are serialized by the stack task directly into one of
+// these slots and handled in place by the app framework task. A slot is either
+// free, being formatted by the stack task, queued in one of the lanes or being
+// dispatched by the app framework task. Slot indexes move between the free
+// list and the lanes inside atomic sections only.
+//
+// Callbacks reporting incoming traffic go to the normal lane, all the others
+// (stack status, message sent, scan complete...) to the high priority lane,
+// which is always dispatched first.
+//
+// There is one slot more than the queue holds, so that the stack task always
+// has a slot to format into. Once a callback is formatted and its ID known,
+// sendCallbackCommand() checks whether the queue is full: a high priority
+// callback then takes over the queue entry of the oldest normal one, otherwise
+// the overflow policy decides which callback is lost. The slot of the lost
+// callback becomes the spare one.
+//
+// One more slot is reserved for stack status callbacks, so that a network
+// going down is reported even when the queue is full of other high priority
+// callbacks. Once the reserved slot is taken, a new stack status supersedes
+// the one still queued, and only then takes over the oldest other callback.
+//
+// Tasks subscribed to a callback get a reference to the very same slot on
+// their own queue. A slot holds one reference for the app framework task plus
+// one per subscriber it was delivered to, and goes back to the free list when
+// the last one is released. Only slots nobody but the app framework task
+// refers to can be taken over.
+#define CALLBACK_SLOT_COUNT EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE
+#define CALLBACK_SLOT_TOTAL (CALLBACK_SLOT_COUNT + 2)
+#define CALLBACK_SLOT_NONE  0xFF
+#define CALLBACK_ID_ANY     0xFFFF
+
+typedef struct {
+  uint16_t length;
+  uint8_t refCount;
+  uint32_t queuedTick;
+  uint8_t data[MAX_STACK_CALLBACK_COMMAND_SIZE];
+} CallbackCommandSlot;
+
+typedef struct {
+  uint8_t count;
+  uint8_t slots[CALLBACK_SLOT_COUNT + 1];
+} CallbackLane;
+
+typedef struct {
+  uint16_t commandId;
+  uint16_t count;
+} CallbackDropCounter;
+
+typedef struct {
+  uint16_t commandId;
+  osMessageQueueId_t queue;
+} CallbackSubscriber;
+
+static CallbackCommandSlot callbackSlots[CALLBACK_SLOT_TOTAL];
+static uint8_t freeCallbackSlots[CALLBACK_SLOT_TOTAL];
+static uint8_t freeCallbackSlotCount;
+static CallbackLane highPriorityLane;
+static CallbackLane normalLane;
+// The slot handed out by allocateCallbackCommandPointer() and not sent yet,
+// only accessed by the stack task.
+static uint8_t formattingCallbackSlot;
+// Set by the stack task while it waits for the queue to have room.
+static volatile bool callbackSlotWaiting;
+
+// One counter per callback ID that was dropped at least once, the number of
+// distinct stack callbacks is small.
+#define CALLBACK_DROP_COUNTER_COUNT 16
+static CallbackDropCounter callbackDropCounters[CALLBACK_DROP_COUNTER_COUNT];
+
+// Unused entries have a NULL queue. Only modified inside an atomic section.
+static CallbackSubscriber callbackSubscribers[EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_SUBSCRIBERS];
+
+// Asynchronous commands are formatted by application tasks into one of these
+// slots and return right away. The stack task executes them in the order they
+// were posted and hands the slot over to the app framework task, which runs
+// the completion callback and frees the slot. The ring holds slot indexes and
+// can never overflow since it has room for every slot.
+#define ASYNC_RING_SIZE (EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS + 1)
+
+typedef struct {
+  EmberAsyncCommandCompleteCallback complete;
+  EmberAsyncCommandToken token;
+  EmberStatus status;
+  uint8_t generation;
+  uint32_t postedTick;
+  uint8_t data[MAX_STACK_API_COMMAND_SIZE];
+} AsyncCommandSlot;
+
+static AsyncCommandSlot asyncSlots[EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS];
+// One bit per slot, only modified inside an atomic section.
+static uint32_t asyncSlotsInUse;
+
+// Commands posted to the stack task, blocking and asynchronous ones alike, in
+// the order they were posted. Entries with PENDING_COMMAND_ASYNC set are
+// indexes into asyncSlots, the others into commandSlots. Any application task
+// may post, inside an atomic section, only the stack task consumes.
+#define PENDING_COMMAND_ASYNC 0x80
+#define PENDING_RING_SIZE                               \
+  (EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS      \
+   + EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS + 1)
+
+static uint8_t pendingRing[PENDING_RING_SIZE];
+static volatile uint8_t pendingHead;
+static volatile uint8_t pendingTail;
+
+// Executed commands, from the stack task to the app framework task.
+static uint8_t asyncDoneRing[ASYNC_RING_SIZE];
+static volatile uint8_t asyncDoneHead;
+static volatile uint8_t asyncDoneTail;
 
 //------------------------------------------------------------------------------
 // Forward declarations
 
-static uint32_t pendCommandPendingFlag(void);
-static void postCommandPendingFlag(void);
-static void pendResponsePendingFlag(void);
-static void postResponsePendingFlag(void);
+static void pendResponsePendingFlag(uint8_t index);
+static void postResponsePendingFlag(uint8_t index);
 static void postCallbackPendingFlag(void);
+static void postCallbackSlotFreedFlag(void);
+static bool isHighPriorityCallback(uint16_t commandId);
+static uint8_t getReservedCallbackSlotCount(uint16_t commandId);
+static uint16_t getCallbackCommandId(uint8_t slot);
+static void pushCallbackLane(CallbackLane *lane, uint8_t slot);
+static uint8_t removeCallbackLane(CallbackLane *lane, uint8_t position);
+static uint8_t takeOverCallbackLane(CallbackLane *lane, uint16_t commandId);
+static uint8_t evictCallbackSlot(uint16_t commandId);
+static void freeCallbackSlot(uint8_t slot);
+static void releaseCallbackSlot(uint8_t slot);
+static void countDroppedCallback(uint16_t commandId);
+static uint8_t nextAsyncRingIndex(uint8_t index);
+static uint8_t nextPendingRingIndex(uint8_t index);
+static void postPendingCommand(uint8_t entry);
+static ApiCommandSlot *getOwnCommandSlot(void);
+static uint8_t getCommandSlotIndex(const uint8_t *apiCommandBuffer);
+static uint8_t getAsyncSlotIndex(const uint8_t *apiCommandBuffer);
+static void completeAsyncCommand(void);
 
 //------------------------------------------------------------------------------
 // Internal APIs
 
 void emAfPluginCmsisRtosIpcInit(void)
 {
-  uint8_t i;
+  uint8_t slot;
 
-  for (i = 0; i < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE; i++) {
-    callbackBuffer[i] = EMBER_NULL_BUFFER;
+  for (slot = 0; slot < CALLBACK_SLOT_TOTAL; slot++) {
+    freeCallbackSlots[slot] = slot;
   }
+  freeCallbackSlotCount = CALLBACK_SLOT_TOTAL;
+  highPriorityLane.count = 0;
+  normalLane.count = 0;
+  formattingCallbackSlot = CALLBACK_SLOT_NONE;
+  callbackSlotWaiting = false;
+
+  pendingHead = 0;
+  pendingTail = 0;
+  stackCommandData = NULL;
 
   const osEventFlagsAttr_t rtosFlagsAttr = {
     "RTOS Flags",
@@ -76,13 +239,11 @@ void emAfPluginCmsisRtosIpcInit(void)
   emAfPluginCmsisRtosFlags = osEventFlagsNew(&rtosFlagsAttr);
   assert(emAfPluginCmsisRtosFlags != NULL);
 
-  commandMutex = osMutexNew(NULL);
-  assert(commandMutex != NULL);
-
-  callbackQueue = osMessageQueueNew(EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE,
-                                    (sizeof(EmberBufferDesc) + 3) & (~3) /* align to 4 bytes */,
-                                    NULL);
-  assert(callbackQueue != NULL);
+  commandSlotSemaphore =
+    osSemaphoreNew(EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS,
+                   EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS,
+                   NULL);
+  assert(commandSlotSemaphore != NULL);
 }
 
 uint8_t *sendBlockingCommand(uint8_t *apiCommandBuffer)
@@ -91,125 +252,232 @@ uint8_t *sendBlockingCommand(uint8_t *apiCommandBuffer)
   // stack APIs directly).
   assert(!isCurrentTaskStackTask());
 
-  // Post the "command pending" flag, wake up the stack and pend for the
-  // "response" pending flag.
-  postCommandPendingFlag();
+  uint8_t index = getCommandSlotIndex(apiCommandBuffer);
+  assert(commandSlots[index].owner == osThreadGetId());
+
+  // Queue the command, wake up the stack and pend for the response flag of
+  // this slot. The response is formatted in place.
+  commandSlots[index].postedTick = CMSIS_RTOS_IPC_STATS_NOW();
+  postPendingCommand(index);
   emAfPluginCmsisRtosWakeUpConnectStackTask();
-  pendResponsePendingFlag();
-  return apiCommandData;
+  pendResponsePendingFlag(index);
+
+  CMSIS_RTOS_IPC_STATS_RECORD(emberFetchHighLowInt16u(apiCommandBuffer),
+                              CMSIS_RTOS_IPC_STATS_ROUND_TRIP,
+                              commandSlots[index].postedTick,
+                              CMSIS_RTOS_IPC_STATS_NOW());
+  return apiCommandBuffer;
 }
 
 void sendResponse(uint8_t *apiCommandBuffer, uint16_t commandLength)
 {
   // This API must be called from the stack task.
   assert(isCurrentTaskStackTask());
-  postResponsePendingFlag();
+
+  // Publish the new stack state before the app gets the response.
+  cspRefreshStackStateOnCommand(emberFetchHighLowInt16u(apiCommandBuffer));
+
+  uint8_t index = getCommandSlotIndex(apiCommandBuffer);
+  if (index < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS) {
+    postResponsePendingFlag(index);
+    return;
+  }
+
+  // Asynchronous commands only ever return a status.
+  index = getAsyncSlotIndex(apiCommandBuffer);
+  assert(index < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS);
+  assert(commandLength == sizeof(uint16_t) + 1);
+  cspFetchApiU(apiCommandBuffer,
+               &asyncSlots[index].status);
+
+  asyncDoneRing[asyncDoneHead] = index;
+  __DMB();
+  asyncDoneHead = nextAsyncRingIndex(asyncDoneHead);
+
+  // Wake up the AF task to run the completion callback.
+  postCallbackPendingFlag();
 }
 
 void emAfPluginCmsisRtosProcessIncomingApiCommand(void)
 {
-  uint32_t status = pendCommandPendingFlag();
-
   // This API must be called from the stack task.
   assert(isCurrentTaskStackTask());
 
-  /* Need to check that the pend did not result in an error
-   * and that the expected flag is present.
-   */
-  if (((status & CMSIS_RTOS_ERROR_MASK) == 0) && (status & FLAG_IPC_COMMAND_PENDING)) {
-    uint16_t commandId =
-      emberFetchHighLowInt16u(apiCommandData);
+  // Drain every command posted so far, in order.
+  while (pendingTail != pendingHead) {
+    uint8_t entry = pendingRing[pendingTail];
+    uint32_t postedTick;
+    uint32_t startTick = CMSIS_RTOS_IPC_STATS_NOW();
+    uint16_t commandId;
+    pendingTail = nextPendingRingIndex(pendingTail);
+
+    if (entry & PENDING_COMMAND_ASYNC) {
+      stackCommandData = asyncSlots[entry & ~PENDING_COMMAND_ASYNC].data;
+      postedTick = asyncSlots[entry & ~PENDING_COMMAND_ASYNC].postedTick;
+    } else {
+      stackCommandData = commandSlots[entry].data;
+      postedTick = commandSlots[entry].postedTick;
+    }
+
+    commandId = emberFetchHighLowInt16u(stackCommandData);
+    CMSIS_RTOS_IPC_STATS_RECORD(commandId,
+                                CMSIS_RTOS_IPC_STATS_QUEUE,
+                                postedTick,
+                                startTick);
+
+    handleIncomingApiCommand(commandId, stackCommandData);
 
-    handleIncomingApiCommand(commandId, apiCommandData);
+    CMSIS_RTOS_IPC_STATS_RECORD(commandId,
+                                CMSIS_RTOS_IPC_STATS_SERVICE,
+                                startTick,
+                                CMSIS_RTOS_IPC_STATS_NOW());
   }
+  stackCommandData = NULL;
 }
 
 void sendCallbackCommand(uint8_t *callbackCommandBuffer, uint16_t commandLength)
 {
+  uint8_t slot = formattingCallbackSlot;
+  uint8_t victim;
+  osMessageQueueId_t queues[EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_SUBSCRIBERS];
+  uint8_t queueCount = 0;
+  uint16_t commandId;
+  uint8_t reserved;
   uint8_t i;
-  EmberBufferDesc callbackBufferDescriptorPut = { NULL, 0 };
+  CORE_DECLARE_IRQ_STATE;
 
   // This API must be called from the stack task.
   assert(isCurrentTaskStackTask());
+  // The command must have been formatted in the slot handed out by
+  // allocateCallbackCommandPointer().
+  assert(slot != CALLBACK_SLOT_NONE);
+  assert(callbackCommandBuffer == callbackSlots[slot].data);
+  assert(commandLength <= MAX_STACK_CALLBACK_COMMAND_SIZE);
+
+  callbackSlots[slot].length = commandLength;
+  callbackSlots[slot].queuedTick = CMSIS_RTOS_IPC_STATS_NOW();
+  formattingCallbackSlot = CALLBACK_SLOT_NONE;
+  commandId = getCallbackCommandId(slot);
+  reserved = getReservedCallbackSlotCount(commandId);
+
+  // Publish the new stack state before the app gets to see the status change,
+  // even if the callback ends up being dropped.
+  cspRefreshStackStateOnCommand(commandId);
+
+#if (EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_FULL_WAIT_MS > 0)
+  // Give the app framework task a chance to catch up before losing anything.
+  // The flag is cleared and the queue checked again once the app framework
+  // task knows we are waiting, so that a slot freed in between is not missed.
+  if (freeCallbackSlotCount <= reserved) {
+    osEventFlagsClear(emAfPluginCmsisRtosFlags, FLAG_CALLBACK_SLOT_FREED);
+    callbackSlotWaiting = true;
+
+    if (freeCallbackSlotCount <= reserved) {
+      osEventFlagsWait(emAfPluginCmsisRtosFlags,
+                       FLAG_CALLBACK_SLOT_FREED,
+                       osFlagsWaitAny,
+                       (osKernelGetTickFreq()
+                        * EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_FULL_WAIT_MS) / 1000);
+    }
 
-  // Enqueing the callback in the app framework task queue.
-  emberAfPluginCmsisRtosAcquireBufferSystemMutex();
-  for (i = 0; i < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE; i++) {
-    if (callbackBuffer[i] == EMBER_NULL_BUFFER) {
-      callbackBuffer[i] = emberAllocateBuffer(commandLength);
-      break;
+    callbackSlotWaiting = false;
+  }
+#endif
+
+  CORE_ENTER_ATOMIC();
+  // With no slot left besides this one and the reserved ones, the queue is
+  // full.
+  if (freeCallbackSlotCount <= reserved) {
+    victim = evictCallbackSlot(commandId);
+    if (victim == CALLBACK_SLOT_NONE) {
+      countDroppedCallback(commandId);
+      freeCallbackSlot(slot);
+      CORE_EXIT_ATOMIC();
+      return;
     }
+    freeCallbackSlot(victim);
   }
-  emberAfPluginCmsisRtosReleaseBufferSystemMutex();
-
-  // Queue is full or no memory available: either way just return.
-  if (i >= EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE
-      || callbackBuffer[i] == EMBER_NULL_BUFFER) {
-    return;
+  for (i = 0; i < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_SUBSCRIBERS; i++) {
+    if (callbackSubscribers[i].queue != NULL
+        && callbackSubscribers[i].commandId == commandId) {
+      queues[queueCount++] = callbackSubscribers[i].queue;
+    }
+  }
+  // Take every reference up front, so that a subscriber releasing its
+  // reference early can not free the slot under our feet.
+  callbackSlots[slot].refCount = 1 + queueCount;
+  CORE_EXIT_ATOMIC();
+
+  for (i = 0; i < queueCount; i++) {
+    if (osMessageQueuePut(queues[i], &slot, 0, 0) != osOK) {
+      CORE_ENTER_ATOMIC();
+      countDroppedCallback(commandId);
+      CORE_EXIT_ATOMIC();
+      releaseCallbackSlot(slot);
+    }
   }
 
-  // Write the callback command to the callback buffer.
-  MEMCOPY(emberGetBufferPointer(callbackBuffer[i]), callbackCommandBuffer, commandLength);
-  free(callbackCommandBuffer);
-  callbackBufferDescriptorPut.buffer_addr = &callbackBuffer[i];
-  callbackBufferDescriptorPut.buffer_length = commandLength;
-
-  osMessageQueuePut(callbackQueue,
-                    (void *)&callbackBufferDescriptorPut,
-                    0, //TODO: priority ???
-                    0);
+  CORE_ENTER_ATOMIC();
+  pushCallbackLane(isHighPriorityCallback(commandId)
+                   ? &highPriorityLane
+                   : &normalLane,
+                   slot);
+  CORE_EXIT_ATOMIC();
 
   // Wake up the AF task.
   postCallbackPendingFlag();
-
-  // TODO: once we implement stack callback dispatching to custom application
-  // tasks, we should add the copy of the callback to the queue of every custom
-  // application task that chose to listen to this specific callback.
 }
 
 bool emAfPluginCmsisRtosProcessIncomingCallbackCommand(void)
 {
-  uint16_t messageLength;
-  EmberBuffer *callbackBufferPtr = NULL;
-  EmberBufferDesc callbackBufferDescriptorGet = { NULL, 0 };
-  uint8_t msgPrio;
+  uint8_t slot = CALLBACK_SLOT_NONE;
+  CORE_DECLARE_IRQ_STATE;
 
   // This API can not be called from the stack task (the stack task calls
   // stack APIs directly).
   assert(!isCurrentTaskStackTask());
 
-  osMessageQueueGet(callbackQueue,
-                    (void *)&callbackBufferDescriptorGet,
-                    &msgPrio,
-                    0);
+  // Completions of asynchronous commands never get dropped, so they are
+  // delivered ahead of the stack callbacks.
+  if (asyncDoneTail != asyncDoneHead) {
+    completeAsyncCommand();
+    return true;
+  }
 
-  callbackBufferPtr = callbackBufferDescriptorGet.buffer_addr;
-  messageLength = callbackBufferDescriptorGet.buffer_length;
+  CORE_ENTER_ATOMIC();
+  if (highPriorityLane.count > 0) {
+    slot = removeCallbackLane(&highPriorityLane, 0);
+  } else if (normalLane.count > 0) {
+    slot = removeCallbackLane(&normalLane, 0);
+  }
+  CORE_EXIT_ATOMIC();
 
-  if (callbackBufferPtr) {
-    uint8_t callbackData[MAX_STACK_CALLBACK_COMMAND_SIZE];
-    uint16_t commandId;
+  if (slot == CALLBACK_SLOT_NONE) {
+    return false;
+  }
 
-    // Lock the buffer system to prevent defragmentation while we access the
-    // buffer.
-    emberAfPluginCmsisRtosAcquireBufferSystemMutex();
-    MEMCOPY(callbackData,
-            emberGetBufferPointer(*callbackBufferPtr),
-            messageLength);
-    // This assignment is safe because the vNCP acquires the buffer system mutex
-    // before manipulating any entry in callbackBuffer[].
-    *callbackBufferPtr = EMBER_NULL_BUFFER;
-    emberAfPluginCmsisRtosReleaseBufferSystemMutex();
+  // The slot is out of the lanes, so the callback is dispatched straight from
+  // it without copying it.
+  uint16_t commandId = getCallbackCommandId(slot);
+  uint32_t startTick = CMSIS_RTOS_IPC_STATS_NOW();
+  CMSIS_RTOS_IPC_STATS_RECORD(commandId,
+                              CMSIS_RTOS_IPC_STATS_QUEUE,
+                              callbackSlots[slot].queuedTick,
+                              startTick);
 
-    commandId = emberFetchHighLowInt16u(callbackData);
+  handleIncomingCallbackCommand(commandId,
+                                callbackSlots[slot].data + 2);
 
-    handleIncomingCallbackCommand(commandId,
-                                  callbackData + 2);
+  CMSIS_RTOS_IPC_STATS_RECORD(commandId,
+                              CMSIS_RTOS_IPC_STATS_SERVICE,
+                              startTick,
+                              CMSIS_RTOS_IPC_STATS_NOW());
 
-    return true;
-  }
+  // Hand the slot back to the stack task only once the handlers are done with
+  // any pointer into it.
+  releaseCallbackSlot(slot);
 
-  return false;
+  return true;
 }
 
 bool isCurrentTaskStackTask(void)
@@ -219,69 +487,232 @@ bool isCurrentTaskStackTask(void)
 
 void acquireCommandMutex(void)
 {
+  osThreadId_t self = osThreadGetId();
+  uint8_t index;
+  CORE_DECLARE_IRQ_STATE;
+
   assert(!isCurrentTaskStackTask());
+  // A task can only hold one command slot at a time.
+  assert(getOwnCommandSlot() == NULL);
+
+  assert(osSemaphoreAcquire(commandSlotSemaphore, osWaitForever) == osOK);
 
-  assert(osMutexAcquire(commandMutex, osWaitForever) == osOK);
+  // The semaphore guarantees that one of the slots is free.
+  CORE_ENTER_ATOMIC();
+  for (index = 0; index < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS; index++) {
+    if (commandSlots[index].owner == NULL) {
+      commandSlots[index].owner = self;
+      break;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  assert(index < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS);
 }
 
 void releaseCommandMutex(void)
 {
+  ApiCommandSlot *slot = getOwnCommandSlot();
+
   assert(!isCurrentTaskStackTask());
+  assert(slot != NULL);
 
-  assert(osMutexRelease(commandMutex) == osOK);
+  slot->owner = NULL;
+  assert(osSemaphoreRelease(commandSlotSemaphore) == osOK);
 }
 
 uint8_t *getApiCommandPointer()
 {
-  return apiCommandData;
+  // Stack side handlers format their response into the command they are
+  // servicing.
+  if (isCurrentTaskStackTask()) {
+    assert(stackCommandData != NULL);
+    return stackCommandData;
+  }
+
+  ApiCommandSlot *slot = getOwnCommandSlot();
+  assert(slot != NULL);
+  return slot->data;
 }
 
-uint8_t *allocateCallbackCommandPointer()
+uint8_t *allocateCallbackCommandPointer(void)
 {
-  return (uint8_t *)malloc(MAX_STACK_API_COMMAND_SIZE);
+  uint8_t slot;
+  CORE_DECLARE_IRQ_STATE;
+
+  assert(isCurrentTaskStackTask());
+  assert(formattingCallbackSlot == CALLBACK_SLOT_NONE);
+
+  // The queue never holds more than CALLBACK_SLOT_COUNT slots plus a stack
+  // status, so there is always one left.
+  CORE_ENTER_ATOMIC();
+  assert(freeCallbackSlotCount > 0);
+  slot = freeCallbackSlots[--freeCallbackSlotCount];
+  CORE_EXIT_ATOMIC();
+
+  formattingCallbackSlot = slot;
+  return callbackSlots[slot].data;
+}
+
+uint8_t *allocateAsyncCommandPointer(EmberAsyncCommandCompleteCallback complete,
+                                     EmberAsyncCommandToken *token)
+{
+  AsyncCommandSlot *slot = NULL;
+  uint8_t index;
+  CORE_DECLARE_IRQ_STATE;
+
+  // This API can not be called from the stack task (the stack task calls
+  // stack APIs directly).
+  assert(!isCurrentTaskStackTask());
+
+  CORE_ENTER_ATOMIC();
+  for (index = 0; index < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS; index++) {
+    if ((asyncSlotsInUse & (1UL << index)) == 0) {
+      asyncSlotsInUse |= (1UL << index);
+      slot = &asyncSlots[index];
+      break;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  if (slot == NULL) {
+    return NULL;
+  }
+
+  // The generation tells apart successive commands posted in the same slot.
+  slot->generation++;
+  slot->token = (EmberAsyncCommandToken)((slot->generation << 8) | index);
+  slot->complete = complete;
+  if (token != NULL) {
+    *token = slot->token;
+  }
+
+  return slot->data;
+}
+
+void sendAsyncCommand(uint8_t *apiCommandBuffer)
+{
+  uint8_t index = getAsyncSlotIndex(apiCommandBuffer);
+
+  assert(!isCurrentTaskStackTask());
+  assert(index < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS);
+
+  asyncSlots[index].postedTick = CMSIS_RTOS_IPC_STATS_NOW();
+  postPendingCommand(index | PENDING_COMMAND_ASYNC);
+  emAfPluginCmsisRtosWakeUpConnectStackTask();
 }
 
 //------------------------------------------------------------------------------
-// Internal callbacks
+// Public APIs
 
-void emAfPluginCmsisRtosMarkBuffersCallback(void)
+uint16_t emberAfPluginCmsisRtosGetCallbackDropCount(uint16_t commandId)
+{
+  uint16_t count = 0;
+  uint8_t i;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  for (i = 0; i < CALLBACK_DROP_COUNTER_COUNT; i++) {
+    if (callbackDropCounters[i].count > 0
+        && callbackDropCounters[i].commandId == commandId) {
+      count = callbackDropCounters[i].count;
+      break;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  return count;
+}
+
+void emberAfPluginCmsisRtosClearCallbackDropCounts(void)
 {
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  MEMSET(callbackDropCounters, 0, sizeof(callbackDropCounters));
+  CORE_EXIT_ATOMIC();
+}
+
+EmberStatus emberAfPluginCmsisRtosSubscribeCallback(uint16_t commandId,
+                                                    osMessageQueueId_t queue)
+{
+  EmberStatus status = EMBER_TABLE_FULL;
   uint8_t i;
+  CORE_DECLARE_IRQ_STATE;
 
-  for (i = 0; i < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE; i++) {
-    emberMarkBuffer(&callbackBuffer[i]);
+  assert(queue != NULL);
+
+  CORE_ENTER_ATOMIC();
+  for (i = 0; i < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_SUBSCRIBERS; i++) {
+    if (callbackSubscribers[i].queue == NULL) {
+      callbackSubscribers[i].commandId = commandId;
+      callbackSubscribers[i].queue = queue;
+      status = EMBER_SUCCESS;
+      break;
+    }
   }
+  CORE_EXIT_ATOMIC();
+
+  return status;
 }
 
-//------------------------------------------------------------------------------
-// Static functions
+void emberAfPluginCmsisRtosUnsubscribeCallback(uint16_t commandId,
+                                               osMessageQueueId_t queue)
+{
+  uint8_t i;
+  CORE_DECLARE_IRQ_STATE;
 
-static uint32_t pendCommandPendingFlag(void)
+  CORE_ENTER_ATOMIC();
+  for (i = 0; i < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_SUBSCRIBERS; i++) {
+    if (callbackSubscribers[i].queue == queue
+        && callbackSubscribers[i].commandId == commandId) {
+      callbackSubscribers[i].queue = NULL;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+uint16_t emberAfPluginCmsisRtosGetCallbackCommandId(EmberAfPluginCmsisRtosCallbackRef ref)
 {
-  return osEventFlagsWait(emAfPluginCmsisRtosFlags,
-                          FLAG_IPC_COMMAND_PENDING,
-                          osFlagsWaitAny,
-                          0);
+  assert(ref < CALLBACK_SLOT_TOTAL && callbackSlots[ref].refCount > 0);
+  return getCallbackCommandId(ref);
 }
 
-static void postCommandPendingFlag(void)
+uint8_t *emberAfPluginCmsisRtosGetCallbackParams(EmberAfPluginCmsisRtosCallbackRef ref)
 {
-  assert((osEventFlagsSet(emAfPluginCmsisRtosFlags,
-                          FLAG_IPC_COMMAND_PENDING) & CMSIS_RTOS_ERROR_MASK) == 0);
+  assert(ref < CALLBACK_SLOT_TOTAL && callbackSlots[ref].refCount > 0);
+  return callbackSlots[ref].data + 2;
 }
 
-static void pendResponsePendingFlag(void)
+void emberAfPluginCmsisRtosReleaseCallback(EmberAfPluginCmsisRtosCallbackRef ref)
+{
+  assert(ref < CALLBACK_SLOT_TOTAL);
+  releaseCallbackSlot(ref);
+}
+
+//------------------------------------------------------------------------------
+// Internal callbacks
+
+void emAfPluginCmsisRtosMarkBuffersCallback(void)
+{
+  // Callback commands live in static slots, there is no buffer to mark.
+}
+
+//------------------------------------------------------------------------------
+// Static functions
+
+static void pendResponsePendingFlag(uint8_t index)
 {
   assert((osEventFlagsWait(emAfPluginCmsisRtosFlags,
-                           FLAG_IPC_RESPONSE_PENDING,
+                           FLAG_IPC_RESPONSE_PENDING << index,
                            osFlagsWaitAny,
                            osWaitForever) & CMSIS_RTOS_ERROR_MASK) == 0);
 }
 
-static void postResponsePendingFlag(void)
+static void postResponsePendingFlag(uint8_t index)
 {
   assert((osEventFlagsSet(emAfPluginCmsisRtosFlags,
-                          FLAG_IPC_RESPONSE_PENDING) & CMSIS_RTOS_ERROR_MASK) == 0);
+                          FLAG_IPC_RESPONSE_PENDING << index) & CMSIS_RTOS_ERROR_MASK) == 0);
 }
 
 static void postCallbackPendingFlag(void)
@@ -289,3 +720,265 @@ static void postCallbackPendingFlag(void)
   assert((osEventFlagsSet(emAfPluginCmsisRtosFlags,
                           FLAG_STACK_CALLBACK_PENDING) & CMSIS_RTOS_ERROR_MASK) == 0);
 }
+
+static void postCallbackSlotFreedFlag(void)
+{
+  assert((osEventFlagsSet(emAfPluginCmsisRtosFlags,
+                          FLAG_CALLBACK_SLOT_FREED) & CMSIS_RTOS_ERROR_MASK) == 0);
+}
+
+// Callbacks reporting incoming traffic can come in floods, everything else is
+// a response to something the application did or a network state change.
+static bool isHighPriorityCallback(uint16_t commandId)
+{
+  switch (commandId) {
+    case EMBER_INCOMING_MESSAGE_HANDLER_IPC_COMMAND_ID:
+    case EMBER_INCOMING_MAC_MESSAGE_HANDLER_IPC_COMMAND_ID:
+    case EMBER_INCOMING_BEACON_HANDLER_IPC_COMMAND_ID:
+      return false;
+    default:
+      return true;
+  }
+}
+
+// Free slots other callbacks must leave to stack status callbacks.
+static uint8_t getReservedCallbackSlotCount(uint16_t commandId)
+{
+  return (commandId == EMBER_STACK_STATUS_HANDLER_IPC_COMMAND_ID) ? 0 : 1;
+}
+
+static uint16_t getCallbackCommandId(uint8_t slot)
+{
+  return emberFetchHighLowInt16u(callbackSlots[slot].data);
+}
+
+// The functions below must be called inside an atomic section.
+
+static void pushCallbackLane(CallbackLane *lane, uint8_t slot)
+{
+  assert(lane->count < CALLBACK_SLOT_COUNT + 1);
+  lane->slots[lane->count++] = slot;
+}
+
+static uint8_t removeCallbackLane(CallbackLane *lane, uint8_t position)
+{
+  uint8_t slot = lane->slots[position];
+
+  lane->count--;
+  MEMMOVE(&lane->slots[position],
+          &lane->slots[position + 1],
+          lane->count - position);
+  return slot;
+}
+
+// Takes the oldest queued callback with the given ID, or with any ID for
+// CALLBACK_ID_ANY, that nobody else refers to out of a lane. Returns
+// CALLBACK_SLOT_NONE if there is none.
+static uint8_t takeOverCallbackLane(CallbackLane *lane, uint16_t commandId)
+{
+  uint8_t position;
+
+  for (position = 0; position < lane->count; position++) {
+    uint8_t slot = lane->slots[position];
+
+    if (callbackSlots[slot].refCount == 1
+        && (commandId == CALLBACK_ID_ANY
+            || getCallbackCommandId(slot) == commandId)) {
+      removeCallbackLane(lane, position);
+      countDroppedCallback(getCallbackCommandId(slot));
+      callbackSlots[slot].refCount = 0;
+      return slot;
+    }
+  }
+  return CALLBACK_SLOT_NONE;
+}
+
+// Takes a queued callback out of the full queue to make room for a new one,
+// or returns CALLBACK_SLOT_NONE if the new callback must be dropped. The
+// slot returned is no longer referenced.
+static uint8_t evictCallbackSlot(uint16_t commandId)
+{
+  uint8_t slot;
+
+  // The reserved slot is taken. The latest stack status supersedes the queued
+  // one, and is more important than any other callback.
+  if (commandId == EMBER_STACK_STATUS_HANDLER_IPC_COMMAND_ID) {
+    slot = takeOverCallbackLane(&highPriorityLane, commandId);
+    if (slot == CALLBACK_SLOT_NONE) {
+      slot = takeOverCallbackLane(&normalLane, CALLBACK_ID_ANY);
+    }
+    if (slot == CALLBACK_SLOT_NONE) {
+      slot = takeOverCallbackLane(&highPriorityLane, CALLBACK_ID_ANY);
+    }
+    return slot;
+  }
+
+  if (normalLane.count == 0) {
+    return CALLBACK_SLOT_NONE;
+  }
+
+  if (isHighPriorityCallback(commandId)
+      || (EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_OVERFLOW_POLICY
+          == CMSIS_RTOS_CALLBACK_DROP_OLDEST)) {
+    slot = takeOverCallbackLane(&normalLane, CALLBACK_ID_ANY);
+    if (slot != CALLBACK_SLOT_NONE) {
+      return slot;
+    }
+  }
+
+  if (EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_OVERFLOW_POLICY
+      == CMSIS_RTOS_CALLBACK_COALESCE) {
+    uint8_t position = normalLane.count;
+
+    // The new callback replaces the latest queued one of the same type.
+    while (position-- > 0) {
+      slot = normalLane.slots[position];
+      if (getCallbackCommandId(slot) == commandId
+          && callbackSlots[slot].refCount == 1) {
+        removeCallbackLane(&normalLane, position);
+        countDroppedCallback(commandId);
+        callbackSlots[slot].refCount = 0;
+        return slot;
+      }
+    }
+  }
+
+  return CALLBACK_SLOT_NONE;
+}
+
+static void freeCallbackSlot(uint8_t slot)
+{
+  assert(freeCallbackSlotCount < CALLBACK_SLOT_TOTAL);
+  freeCallbackSlots[freeCallbackSlotCount++] = slot;
+}
+
+// This one takes care of the atomic section itself.
+static void releaseCallbackSlot(uint8_t slot)
+{
+  bool freed;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  assert(callbackSlots[slot].refCount > 0);
+  freed = (--callbackSlots[slot].refCount == 0);
+  if (freed) {
+    freeCallbackSlot(slot);
+  }
+  CORE_EXIT_ATOMIC();
+
+  if (freed && callbackSlotWaiting) {
+    postCallbackSlotFreedFlag();
+  }
+}
+
+static void countDroppedCallback(uint16_t commandId)
+{
+  CallbackDropCounter *unused = NULL;
+  uint8_t i;
+
+  for (i = 0; i < CALLBACK_DROP_COUNTER_COUNT; i++) {
+    if (callbackDropCounters[i].count == 0) {
+      if (unused == NULL) {
+        unused = &callbackDropCounters[i];
+      }
+    } else if (callbackDropCounters[i].commandId == commandId) {
+      if (callbackDropCounters[i].count < 0xFFFF) {
+        callbackDropCounters[i].count++;
+      }
+      return;
+    }
+  }
+
+  if (unused != NULL) {
+    unused->commandId = commandId;
+    unused->count = 1;
+  }
+}
+
+static uint8_t nextAsyncRingIndex(uint8_t index)
+{
+  return (index + 1 < ASYNC_RING_SIZE) ? (index + 1) : 0;
+}
+
+static uint8_t nextPendingRingIndex(uint8_t index)
+{
+  return (index + 1 < PENDING_RING_SIZE) ? (index + 1) : 0;
+}
+
+static void postPendingCommand(uint8_t entry)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  pendingRing[pendingHead] = entry;
+  pendingHead = nextPendingRingIndex(pendingHead);
+  CORE_EXIT_ATOMIC();
+}
+
+static ApiCommandSlot *getOwnCommandSlot(void)
+{
+  osThreadId_t self = osThreadGetId();
+  uint8_t index;
+
+  for (index = 0; index < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS; index++) {
+    if (commandSlots[index].owner == self) {
+      return &commandSlots[index];
+    }
+  }
+  return NULL;
+}
+
+// Returns EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS if the buffer does
+// not belong to a command slot.
+static uint8_t getCommandSlotIndex(const uint8_t *apiCommandBuffer)
+{
+  uint8_t index;
+
+  for (index = 0; index < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS; index++) {
+    if (apiCommandBuffer == commandSlots[index].data) {
+      break;
+    }
+  }
+  return index;
+}
+
+// Returns EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS if the buffer does not
+// belong to an asynchronous command slot.
+static uint8_t getAsyncSlotIndex(const uint8_t *apiCommandBuffer)
+{
+  uint8_t index;
+
+  for (index = 0; index < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_ASYNC_COMMANDS; index++) {
+    if (apiCommandBuffer == asyncSlots[index].data) {
+      break;
+    }
+  }
+  return index;
+}
+
+static void completeAsyncCommand(void)
+{
+  uint8_t index = asyncDoneRing[asyncDoneTail];
+  AsyncCommandSlot *slot = &asyncSlots[index];
+  EmberAsyncCommandCompleteCallback complete = slot->complete;
+  EmberAsyncCommandToken token = slot->token;
+  EmberStatus status = slot->status;
+  CORE_DECLARE_IRQ_STATE;
+
+  asyncDoneTail = nextAsyncRingIndex(asyncDoneTail);
+
+  CMSIS_RTOS_IPC_STATS_RECORD(emberFetchHighLowInt16u(slot->data),
+                              CMSIS_RTOS_IPC_STATS_ROUND_TRIP,
+                              slot->postedTick,
+                              CMSIS_RTOS_IPC_STATS_NOW());
+
+  // Free the slot before running the completion, so that it can post the
+  // next command.
+  CORE_ENTER_ATOMIC();
+  asyncSlotsInUse &= ~(1UL << index);
+  CORE_EXIT_ATOMIC();
+
+  if (complete != NULL) {
+    complete(token, status);
+  }
+}
@@ -0,0 +1,173 @@
+/***************************************************************************//**
+ * @brief CMSIS RTOS IPC latency statistics.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include PLATFORM_HEADER
+#include "cmsis-rtos-ipc-config.h"
+
+#include "stack/include/ember.h"
+
+#include <em_core.h>
+#include "sl_sleeptimer.h"
+
+#include "cmsis-rtos-ipc-stats.h"
+
+#if (EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS == 1)
+
+// Entries are claimed in the order command IDs are first seen and never
+// released until the next reset. Only accessed inside an atomic section.
+static EmberAfPluginCmsisRtosIpcStats ipcStats[EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS_MAX_COMMANDS];
+static uint8_t ipcStatsCount;
+static uint32_t ipcStatsUntracked;
+
+//------------------------------------------------------------------------------
+// Forward declarations
+
+static EmberAfPluginCmsisRtosIpcStats *getIpcStats(uint16_t commandId);
+static uint8_t getBucket(uint32_t ticks);
+
+//------------------------------------------------------------------------------
+// Public APIs
+
+bool emberAfPluginCmsisRtosGetIpcStats(uint8_t index,
+                                       EmberAfPluginCmsisRtosIpcStats *stats)
+{
+  bool found = false;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if (index < ipcStatsCount) {
+    *stats = ipcStats[index];
+    found = true;
+  }
+  CORE_EXIT_ATOMIC();
+
+  return found;
+}
+
+uint32_t emberAfPluginCmsisRtosGetIpcStatsUntracked(void)
+{
+  return ipcStatsUntracked;
+}
+
+void emberAfPluginCmsisRtosResetIpcStats(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  ipcStatsCount = 0;
+  ipcStatsUntracked = 0;
+  CORE_EXIT_ATOMIC();
+}
+
+//------------------------------------------------------------------------------
+// Internal APIs
+
+uint32_t emAfPluginCmsisRtosIpcStatsNow(void)
+{
+  return sl_sleeptimer_get_tick_count();
+}
+
+void emAfPluginCmsisRtosIpcStatsRecord(uint16_t commandId,
+                                       uint8_t type,
+                                       uint32_t startTick,
+                                       uint32_t endTick)
+{
+  EmberAfPluginCmsisRtosIpcStats *stats;
+  // Unsigned arithmetic takes care of the tick counter wrapping.
+  uint8_t bucket = getBucket(endTick - startTick);
+  CORE_DECLARE_IRQ_STATE;
+
+  assert(type < CMSIS_RTOS_IPC_STATS_TYPE_COUNT);
+
+  CORE_ENTER_ATOMIC();
+  stats = getIpcStats(commandId);
+  if (stats == NULL) {
+    ipcStatsUntracked++;
+  } else {
+    if (stats->histograms[type][bucket] < 0xFFFF) {
+      stats->histograms[type][bucket]++;
+    }
+    if (type == CMSIS_RTOS_IPC_STATS_SERVICE) {
+      stats->count++;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+//------------------------------------------------------------------------------
+// Static functions
+
+static EmberAfPluginCmsisRtosIpcStats *getIpcStats(uint16_t commandId)
+{
+  uint8_t i;
+
+  for (i = 0; i < ipcStatsCount; i++) {
+    if (ipcStats[i].commandId == commandId) {
+      return &ipcStats[i];
+    }
+  }
+
+  if (ipcStatsCount == EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS_MAX_COMMANDS) {
+    return NULL;
+  }
+
+  MEMSET(&ipcStats[ipcStatsCount], 0, sizeof(EmberAfPluginCmsisRtosIpcStats));
+  ipcStats[ipcStatsCount].commandId = commandId;
+  return &ipcStats[ipcStatsCount++];
+}
+
+static uint8_t getBucket(uint32_t ticks)
+{
+  uint8_t bucket = (ticks == 0) ? 0 : (32 - __CLZ(ticks));
+
+  return (bucket < CMSIS_RTOS_IPC_STATS_BUCKET_COUNT)
+         ? bucket
+         : (CMSIS_RTOS_IPC_STATS_BUCKET_COUNT - 1);
+}
+
+#else // EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS
+
+bool emberAfPluginCmsisRtosGetIpcStats(uint8_t index,
+                                       EmberAfPluginCmsisRtosIpcStats *stats)
+{
+  (void)index;
+  (void)stats;
+  return false;
+}
+
+uint32_t emberAfPluginCmsisRtosGetIpcStatsUntracked(void)
+{
+  return 0;
+}
+
+void emberAfPluginCmsisRtosResetIpcStats(void)
+{
+}
+
+#endif // EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS
@@ -0,0 +1,101 @@
+/***************************************************************************//**
+ * @brief CMSIS RTOS IPC latency statistics.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef _CMSIS_RTOS_IPC_STATS_H_
+#define _CMSIS_RTOS_IPC_STATS_H_
+
+#include "cmsis-rtos-ipc-config.h"
+
+// For API commands, QUEUE is the time from the command being posted to the
+// stack task picking it up, SERVICE the time spent in the stack side handler
+// and ROUND_TRIP the time until the calling task gets the response (or the
+// completion callback runs, for asynchronous commands). For stack callbacks,
+// QUEUE is the time from the stack task queuing the callback to the app
+// framework task dispatching it and SERVICE the time spent in the dispatch.
+#define CMSIS_RTOS_IPC_STATS_QUEUE                      0
+#define CMSIS_RTOS_IPC_STATS_SERVICE                    1
+#define CMSIS_RTOS_IPC_STATS_ROUND_TRIP                 2
+#define CMSIS_RTOS_IPC_STATS_TYPE_COUNT                 3
+
+// Bucket 0 counts durations of 0 sleeptimer ticks, bucket N durations of
+// 2^(N-1) to 2^N - 1 ticks. The last bucket also counts everything longer.
+#define CMSIS_RTOS_IPC_STATS_BUCKET_COUNT               16
+
+typedef struct {
+  uint16_t commandId;
+  // Number of times the command was serviced.
+  uint32_t count;
+  // Counters saturate at 0xFFFF.
+  uint16_t histograms[CMSIS_RTOS_IPC_STATS_TYPE_COUNT][CMSIS_RTOS_IPC_STATS_BUCKET_COUNT];
+} EmberAfPluginCmsisRtosIpcStats;
+
+//------------------------------------------------------------------------------
+// Public APIs
+
+/**
+ * Copy the statistics of the index-th command ID seen since the last reset.
+ * Returns false once index is past the last tracked command ID, or if
+ * EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS is disabled.
+ */
+bool emberAfPluginCmsisRtosGetIpcStats(uint8_t index,
+                                       EmberAfPluginCmsisRtosIpcStats *stats);
+
+/**
+ * Number of samples that could not be recorded because the table was full of
+ * other command IDs.
+ */
+uint32_t emberAfPluginCmsisRtosGetIpcStatsUntracked(void);
+
+void emberAfPluginCmsisRtosResetIpcStats(void);
+
+//------------------------------------------------------------------------------
+// Internal APIs
+
+#if (EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS == 1)
+
+uint32_t emAfPluginCmsisRtosIpcStatsNow(void);
+
+void emAfPluginCmsisRtosIpcStatsRecord(uint16_t commandId,
+                                       uint8_t type,
+                                       uint32_t startTick,
+                                       uint32_t endTick);
+
+#define CMSIS_RTOS_IPC_STATS_NOW() emAfPluginCmsisRtosIpcStatsNow()
+#define CMSIS_RTOS_IPC_STATS_RECORD(commandId, type, startTick, endTick) \
+  emAfPluginCmsisRtosIpcStatsRecord((commandId), (type), (startTick), (endTick))
+
+#else
+
+#define CMSIS_RTOS_IPC_STATS_NOW() 0
+#define CMSIS_RTOS_IPC_STATS_RECORD(commandId, type, startTick, endTick) \
+  ((void)(commandId), (void)(startTick), (void)(endTick))
+
+#endif // EMBER_AF_PLUGIN_CMSIS_RTOS_IPC_STATS
+
+#endif // _CMSIS_RTOS_IPC_STATS_H_
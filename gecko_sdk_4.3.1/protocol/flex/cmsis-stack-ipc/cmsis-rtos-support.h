@@ -35,7 +35,8 @@
 
 #define FLAG_STACK_ACTION_PENDING                       0x01
 #define FLAG_STACK_CALLBACK_PENDING                     0x02
-#define FLAG_IPC_COMMAND_PENDING                        0x04
+#define FLAG_CALLBACK_SLOT_FREED                        0x04
+// Command slot N is signalled with (FLAG_IPC_RESPONSE_PENDING << N).
 #define FLAG_IPC_RESPONSE_PENDING                       0x08
 
 #define CMSIS_RTOS_ERROR_MASK                           0x80000000
@@ -49,6 +50,48 @@ void emberAfPluginCmsisRtosAcquireBufferSystemMutex(void);
 
 void emberAfPluginCmsisRtosReleaseBufferSystemMutex(void);
 
+/**
+ * Number of times a stack callback with this IPC command ID was lost because
+ * the callback queue was full, saturating at 0xFFFF.
+ */
+uint16_t emberAfPluginCmsisRtosGetCallbackDropCount(uint16_t commandId);
+
+void emberAfPluginCmsisRtosClearCallbackDropCounts(void);
+
+/**
+ * Reference to a stack callback delivered to a subscriber queue. The queue
+ * must be created with a message size of
+ * sizeof(EmberAfPluginCmsisRtosCallbackRef).
+ */
+typedef uint8_t EmberAfPluginCmsisRtosCallbackRef;
+
+/**
+ * Have every future stack callback with this IPC command ID posted to queue as
+ * well, in addition to its regular dispatch in the app framework task. Returns
+ * EMBER_TABLE_FULL if there are already
+ * EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_SUBSCRIBERS subscriptions.
+ */
+EmberStatus emberAfPluginCmsisRtosSubscribeCallback(uint16_t commandId,
+                                                    osMessageQueueId_t queue);
+
+void emberAfPluginCmsisRtosUnsubscribeCallback(uint16_t commandId,
+                                               osMessageQueueId_t queue);
+
+uint16_t emberAfPluginCmsisRtosGetCallbackCommandId(EmberAfPluginCmsisRtosCallbackRef ref);
+
+/**
+ * The callback parameters, serialized as in csp-command-callbacks.c. The
+ * buffer is shared with the other receivers of the callback and must not be
+ * modified. It stays valid until the reference is released.
+ */
+uint8_t *emberAfPluginCmsisRtosGetCallbackParams(EmberAfPluginCmsisRtosCallbackRef ref);
+
+/**
+ * Every reference received on a subscriber queue must be released once, the
+ * callback slot is held until then.
+ */
+void emberAfPluginCmsisRtosReleaseCallback(EmberAfPluginCmsisRtosCallbackRef ref);
+
 //------------------------------------------------------------------------------
 // Internal APIs - generic OS
 
@@ -0,0 +1,2359 @@
+/***************************************************************************//**
+ * @brief Specialized serializers and deserializers of the CSP commands.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+// *** Generated file. Do not edit! ***
+// Generated by csp-codec-gen.py from the command code and csp-api-enum-gen.h.
+
+#include PLATFORM_HEADER
+
+#include "stack/include/ember.h"
+
+#include "csp-codec-gen.h"
+
+//------------------------------------------------------------------------------
+// Field helpers, matching formatResponseCommandFromArgList() and fetchParams()
+// in csp-format.c character for character.
+
+static inline void packInt8u(uint8_t *finger, uint8_t value)
+{
+  finger[0] = value;
+}
+
+static inline void packInt8(uint8_t *finger, int8_t value)
+{
+  finger[0] = (uint8_t)value;
+}
+
+static inline void packInt16u(uint8_t *finger, uint16_t value)
+{
+  finger[0] = HIGH_BYTE(value);
+  finger[1] = LOW_BYTE(value);
+}
+
+static inline void packInt32u(uint8_t *finger, uint32_t value)
+{
+  finger[0] = (uint8_t)(value >> 24);
+  finger[1] = (uint8_t)(value >> 16);
+  finger[2] = (uint8_t)(value >> 8);
+  finger[3] = (uint8_t)value;
+}
+
+static uint8_t *packBlock(uint8_t *finger, const void *data, uint8_t dataSize)
+{
+  *finger++ = dataSize;
+  if (dataSize > 0) {
+    // A NULL block is sent as zeroes.
+    if (data != NULL) {
+      MEMCOPY(finger, data, dataSize);
+    } else {
+      MEMSET(finger, 0, dataSize);
+    }
+  }
+  return finger + dataSize;
+}
+
+static inline void fetchInt8u(const uint8_t *readPointer, void *realPointer)
+{
+  if (realPointer != NULL) {
+    *(uint8_t *)realPointer = readPointer[0];
+  }
+}
+
+static inline void fetchInt16u(const uint8_t *readPointer, void *realPointer)
+{
+  *(uint16_t *)realPointer = HIGH_LOW_TO_INT(readPointer[0], readPointer[1]);
+}
+
+static inline void fetchInt32u(const uint8_t *readPointer, void *realPointer)
+{
+  if (realPointer != NULL) {
+    *(uint32_t *)realPointer = (((uint32_t)readPointer[0] << 24)
+                                | ((uint32_t)readPointer[1] << 16)
+                                | ((uint32_t)readPointer[2] << 8)
+                                | readPointer[3]);
+  }
+}
+
+static uint8_t *fetchBlock(uint8_t *readPointer,
+                           void *realArray,
+                           uint8_t *lengthPointer,
+                           uint8_t bufferSize)
+{
+  uint8_t length = *readPointer++;
+
+  if (realArray != NULL) {
+    MEMMOVE(realArray, readPointer, (length <= bufferSize) ? length : bufferSize);
+  }
+  // Report the length actually copied, the read pointer skips the whole block.
+  *lengthPointer = (length <= bufferSize) ? length : bufferSize;
+  return readPointer + length;
+}
+
+static uint8_t *fetchPointer(uint8_t *readPointer,
+                             void *realPointer,
+                             uint8_t *lengthPointer)
+{
+  uint8_t length = *readPointer++;
+
+  *lengthPointer = length;
+  if (realPointer != NULL) {
+    *(uint8_t **)realPointer = readPointer;
+  }
+  return readPointer + length;
+}
+
+//------------------------------------------------------------------------------
+// Layouts
+
+// "", formatted by:
+//   EMBER_ACTIVE_SCAN_COMPLETE_HANDLER_IPC_COMMAND_ID
+//   EMBER_CALIBRATE_CURRENT_CHANNEL_IPC_COMMAND_ID
+//   EMBER_CLEAR_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID
+//   EMBER_CURRENT_STACK_TASKS_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_START_SERVER_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_STOP_IPC_COMMAND_ID
+//   EMBER_GET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID
+//   EMBER_GET_CAL_TYPE_IPC_COMMAND_ID
+//   EMBER_GET_DEFAULT_CHANNEL_IPC_COMMAND_ID
+//   EMBER_GET_EUI64_IPC_COMMAND_ID
+//   EMBER_GET_KEY_ID_IPC_COMMAND_ID
+//   EMBER_GET_NODE_ID_IPC_COMMAND_ID
+//   EMBER_GET_NODE_TYPE_IPC_COMMAND_ID
+//   EMBER_GET_PAN_ID_IPC_COMMAND_ID
+//   EMBER_GET_PARENT_ID_IPC_COMMAND_ID
+//   EMBER_GET_RADIO_CHANNEL_IPC_COMMAND_ID
+//   EMBER_GET_RADIO_POWER_IPC_COMMAND_ID
+//   EMBER_MAC_CLEAR_SHORT_TO_LONG_ADDRESS_MAPPINGS_IPC_COMMAND_ID
+//   EMBER_NETWORK_INIT_IPC_COMMAND_ID
+//   EMBER_NETWORK_LEAVE_IPC_COMMAND_ID
+//   EMBER_NETWORK_STATE_IPC_COMMAND_ID
+//   EMBER_OK_TO_HIBERNATE_IPC_COMMAND_ID
+//   EMBER_OK_TO_NAP_IPC_COMMAND_ID
+//   EMBER_POLL_FOR_DATA_IPC_COMMAND_ID
+//   EMBER_PURGE_INDIRECT_MESSAGES_IPC_COMMAND_ID
+//   EMBER_RADIO_NEEDS_CALIBRATING_HANDLER_IPC_COMMAND_ID
+//   EMBER_REMOVE_PSA_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_RESET_NETWORK_STATE_IPC_COMMAND_ID
+//   EMBER_STACK_IS_UP_IPC_COMMAND_ID
+//   EMBER_STOP_TX_STREAM_IPC_COMMAND_ID
+//   EMBER_TEMP_CALIBRATION_IPC_COMMAND_ID
+uint16_t cspFormatEmpty(uint8_t *buffer,
+                        uint16_t bufferSize,
+                        uint16_t identifier)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  length = (uint16_t)(finger - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "b", formatted by:
+//   EMBER_FREQUENCY_HOPPING_SET_CHANNEL_MASK_IPC_COMMAND_ID
+//   EMBER_GET_EUI64_IPC_COMMAND_ID
+//   EMBER_GET_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_IS_LOCAL_EUI64_IPC_COMMAND_ID
+//   EMBER_SET_APPLICATION_BEACON_PAYLOAD_IPC_COMMAND_ID
+//   EMBER_SET_NCP_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID
+uint16_t cspFormatB(uint8_t *buffer,
+                    uint16_t bufferSize,
+                    uint16_t identifier,
+                    const void *field0,
+                    uint8_t field0Length)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  finger = packBlock(finger, field0, field0Length);
+  length = (uint16_t)(finger - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "b", fetched by:
+//   EMBER_GET_EUI64_IPC_COMMAND_ID
+//   EMBER_GET_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_IS_LOCAL_EUI64_IPC_COMMAND_ID
+//   EMBER_SET_SECURITY_KEY_IPC_COMMAND_ID
+void cspFetchApiB(uint8_t *apiCommandData,
+                  void *field0,
+                  uint8_t *field0Length,
+                  uint8_t field0BufferSize)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchBlock(readPointer, field0, field0Length, field0BufferSize);
+}
+
+// "p", fetched by:
+//   EMBER_FREQUENCY_HOPPING_SET_CHANNEL_MASK_IPC_COMMAND_ID
+//   EMBER_SET_APPLICATION_BEACON_PAYLOAD_IPC_COMMAND_ID
+//   EMBER_SET_NCP_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID
+void cspFetchApiP(uint8_t *apiCommandData,
+                  void *field0,
+                  uint8_t *field0Length)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchPointer(readPointer, field0, field0Length);
+}
+
+// "suuuvvuwv", formatted by:
+//   EMBER_SET_MAC_PARAMS_IPC_COMMAND_ID
+uint16_t cspFormatSuuuvvuwv(uint8_t *buffer,
+                            uint16_t bufferSize,
+                            uint16_t identifier,
+                            int8_t field0,
+                            uint8_t field1,
+                            uint8_t field2,
+                            uint8_t field3,
+                            uint16_t field4,
+                            uint16_t field5,
+                            uint8_t field6,
+                            uint32_t field7,
+                            uint16_t field8)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8(finger, field0);
+  packInt8u(finger + 1, field1);
+  packInt8u(finger + 2, field2);
+  packInt8u(finger + 3, field3);
+  packInt16u(finger + 4, field4);
+  packInt16u(finger + 6, field5);
+  packInt8u(finger + 8, field6);
+  packInt32u(finger + 9, field7);
+  packInt16u(finger + 13, field8);
+  length = (uint16_t)(finger + 15 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "suuuvvuwv", fetched by:
+//   EMBER_SET_MAC_PARAMS_IPC_COMMAND_ID
+void cspFetchApiSuuuvvuwv(uint8_t *apiCommandData,
+                          void *field0,
+                          void *field1,
+                          void *field2,
+                          void *field3,
+                          void *field4,
+                          void *field5,
+                          void *field6,
+                          void *field7,
+                          void *field8)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt8u(readPointer + 1, field1);
+  fetchInt8u(readPointer + 2, field2);
+  fetchInt8u(readPointer + 3, field3);
+  fetchInt16u(readPointer + 4, field4);
+  fetchInt16u(readPointer + 6, field5);
+  fetchInt8u(readPointer + 8, field6);
+  fetchInt32u(readPointer + 9, field7);
+  fetchInt16u(readPointer + 13, field8);
+}
+
+// "u", formatted by:
+//   EMBER_APPLY_IR_CALIBRATION_IPC_COMMAND_ID
+//   EMBER_CALIBRATE_CURRENT_CHANNEL_IPC_COMMAND_ID
+//   EMBER_CLEAR_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID
+//   EMBER_FORM_NETWORK_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_SET_CHANNEL_MASK_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_START_CLIENT_COMPLETE_HANDLER_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_START_CLIENT_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_START_SERVER_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_STOP_IPC_COMMAND_ID
+//   EMBER_GET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID
+//   EMBER_GET_COUNTER_IPC_COMMAND_ID
+//   EMBER_GET_MAXIMUM_PAYLOAD_LENGTH_IPC_COMMAND_ID
+//   EMBER_GET_NODE_TYPE_IPC_COMMAND_ID
+//   EMBER_IS_LOCAL_EUI64_IPC_COMMAND_ID
+//   EMBER_JOIN_COMMISSIONED_IPC_COMMAND_ID
+//   EMBER_JOIN_NETWORK_EXTENDED_IPC_COMMAND_ID
+//   EMBER_JOIN_NETWORK_IPC_COMMAND_ID
+//   EMBER_MAC_ADD_SHORT_TO_LONG_ADDRESS_MAPPING_IPC_COMMAND_ID
+//   EMBER_MAC_CLEAR_SHORT_TO_LONG_ADDRESS_MAPPINGS_IPC_COMMAND_ID
+//   EMBER_MAC_FORM_NETWORK_IPC_COMMAND_ID
+//   EMBER_MAC_MESSAGE_SEND_IPC_COMMAND_ID
+//   EMBER_MAC_SET_PAN_COORDINATOR_IPC_COMMAND_ID
+//   EMBER_MESSAGE_SEND_IPC_COMMAND_ID
+//   EMBER_NETWORK_INIT_IPC_COMMAND_ID
+//   EMBER_NETWORK_LEAVE_IPC_COMMAND_ID
+//   EMBER_NETWORK_STATE_IPC_COMMAND_ID
+//   EMBER_OK_TO_HIBERNATE_IPC_COMMAND_ID
+//   EMBER_OK_TO_NAP_IPC_COMMAND_ID
+//   EMBER_PERMIT_JOINING_IPC_COMMAND_ID
+//   EMBER_POLL_FOR_DATA_IPC_COMMAND_ID
+//   EMBER_PURGE_INDIRECT_MESSAGES_IPC_COMMAND_ID
+//   EMBER_REMOVE_CHILD_IPC_COMMAND_ID
+//   EMBER_REMOVE_PSA_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID
+//   EMBER_SET_APPLICATION_BEACON_PAYLOAD_IPC_COMMAND_ID
+//   EMBER_SET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID
+//   EMBER_SET_INDIRECT_QUEUE_TIMEOUT_IPC_COMMAND_ID
+//   EMBER_SET_MAC_PARAMS_IPC_COMMAND_ID
+//   EMBER_SET_NCP_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_POLL_DESTINATION_ADDRESS_IPC_COMMAND_ID
+//   EMBER_SET_PSA_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_CHANNEL_EXTENDED_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_CHANNEL_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_POWER_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_POWER_MODE_IPC_COMMAND_ID
+//   EMBER_SET_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID
+//   EMBER_STACK_IS_UP_IPC_COMMAND_ID
+//   EMBER_STACK_STATUS_HANDLER_IPC_COMMAND_ID
+//   EMBER_START_ACTIVE_SCAN_IPC_COMMAND_ID
+//   EMBER_START_ENERGY_SCAN_IPC_COMMAND_ID
+//   EMBER_START_TX_STREAM_IPC_COMMAND_ID
+//   EMBER_STOP_TX_STREAM_IPC_COMMAND_ID
+//   EMBER_TEMP_CALIBRATION_IPC_COMMAND_ID
+uint16_t cspFormatU(uint8_t *buffer,
+                    uint16_t bufferSize,
+                    uint16_t identifier,
+                    uint8_t field0)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  length = (uint16_t)(finger + 1 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "u", fetched by:
+//   EMBER_APPLY_IR_CALIBRATION_IPC_COMMAND_ID
+//   EMBER_CALIBRATE_CURRENT_CHANNEL_IPC_COMMAND_ID
+//   EMBER_CLEAR_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID
+//   EMBER_FORM_NETWORK_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_SET_CHANNEL_MASK_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_START_CLIENT_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_START_SERVER_IPC_COMMAND_ID
+//   EMBER_FREQUENCY_HOPPING_STOP_IPC_COMMAND_ID
+//   EMBER_GET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID
+//   EMBER_GET_COUNTER_IPC_COMMAND_ID
+//   EMBER_GET_MAXIMUM_PAYLOAD_LENGTH_IPC_COMMAND_ID
+//   EMBER_GET_NODE_TYPE_IPC_COMMAND_ID
+//   EMBER_IS_LOCAL_EUI64_IPC_COMMAND_ID
+//   EMBER_JOIN_COMMISSIONED_IPC_COMMAND_ID
+//   EMBER_JOIN_NETWORK_EXTENDED_IPC_COMMAND_ID
+//   EMBER_JOIN_NETWORK_IPC_COMMAND_ID
+//   EMBER_MAC_ADD_SHORT_TO_LONG_ADDRESS_MAPPING_IPC_COMMAND_ID
+//   EMBER_MAC_CLEAR_SHORT_TO_LONG_ADDRESS_MAPPINGS_IPC_COMMAND_ID
+//   EMBER_MAC_FORM_NETWORK_IPC_COMMAND_ID
+//   EMBER_MAC_MESSAGE_SEND_IPC_COMMAND_ID
+//   EMBER_MAC_SET_PAN_COORDINATOR_IPC_COMMAND_ID
+//   EMBER_MESSAGE_SEND_IPC_COMMAND_ID
+//   EMBER_NETWORK_INIT_IPC_COMMAND_ID
+//   EMBER_NETWORK_LEAVE_IPC_COMMAND_ID
+//   EMBER_NETWORK_STATE_IPC_COMMAND_ID
+//   EMBER_OK_TO_HIBERNATE_IPC_COMMAND_ID
+//   EMBER_OK_TO_NAP_IPC_COMMAND_ID
+//   EMBER_PERMIT_JOINING_IPC_COMMAND_ID
+//   EMBER_POLL_FOR_DATA_IPC_COMMAND_ID
+//   EMBER_PURGE_INDIRECT_MESSAGES_IPC_COMMAND_ID
+//   EMBER_REMOVE_CHILD_IPC_COMMAND_ID
+//   EMBER_REMOVE_PSA_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID
+//   EMBER_SET_APPLICATION_BEACON_PAYLOAD_IPC_COMMAND_ID
+//   EMBER_SET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID
+//   EMBER_SET_INDIRECT_QUEUE_TIMEOUT_IPC_COMMAND_ID
+//   EMBER_SET_MAC_PARAMS_IPC_COMMAND_ID
+//   EMBER_SET_NCP_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_POLL_DESTINATION_ADDRESS_IPC_COMMAND_ID
+//   EMBER_SET_PSA_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_CHANNEL_EXTENDED_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_CHANNEL_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_POWER_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_POWER_MODE_IPC_COMMAND_ID
+//   EMBER_SET_SECURITY_KEY_IPC_COMMAND_ID
+//   EMBER_SET_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID
+//   EMBER_STACK_IS_UP_IPC_COMMAND_ID
+//   EMBER_START_ACTIVE_SCAN_IPC_COMMAND_ID
+//   EMBER_START_ENERGY_SCAN_IPC_COMMAND_ID
+//   EMBER_START_TX_STREAM_IPC_COMMAND_ID
+//   EMBER_STOP_TX_STREAM_IPC_COMMAND_ID
+//   EMBER_TEMP_CALIBRATION_IPC_COMMAND_ID
+//   sendResponse()
+void cspFetchApiU(uint8_t *apiCommandData,
+                  void *field0)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+}
+
+// "u", fetched by:
+//   EMBER_FREQUENCY_HOPPING_START_CLIENT_COMPLETE_HANDLER_IPC_COMMAND_ID
+//   EMBER_STACK_STATUS_HANDLER_IPC_COMMAND_ID
+void cspFetchCallbackU(uint8_t *callbackParams,
+                       void *field0)
+{
+  uint8_t *readPointer = callbackParams;
+
+  fetchInt8u(readPointer, field0);
+}
+
+// "ub", formatted by:
+//   EMBER_GET_SECURITY_KEY_IPC_COMMAND_ID
+uint16_t cspFormatUb(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint8_t field0,
+                     const void *field1,
+                     uint8_t field1Length)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  finger = packBlock(finger + 1, field1, field1Length);
+  length = (uint16_t)(finger - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "ub", fetched by:
+//   EMBER_GET_SECURITY_KEY_IPC_COMMAND_ID
+void cspFetchApiUb(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1,
+                   uint8_t *field1Length,
+                   uint8_t field1BufferSize)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchBlock(readPointer + 1, field1, field1Length, field1BufferSize);
+}
+
+// "uu", formatted by:
+//   EMBER_GET_CHILD_FLAGS_IPC_COMMAND_ID
+uint16_t cspFormatUu(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint8_t field0,
+                     uint8_t field1)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt8u(finger + 1, field1);
+  length = (uint16_t)(finger + 2 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uu", fetched by:
+//   EMBER_GET_CHILD_FLAGS_IPC_COMMAND_ID
+void cspFetchApiUu(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt8u(readPointer + 1, field1);
+}
+
+// "uuuu", formatted by:
+//   EMBER_GET_MAXIMUM_PAYLOAD_LENGTH_IPC_COMMAND_ID
+uint16_t cspFormatUuuu(uint8_t *buffer,
+                       uint16_t bufferSize,
+                       uint16_t identifier,
+                       uint8_t field0,
+                       uint8_t field1,
+                       uint8_t field2,
+                       uint8_t field3)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt8u(finger + 1, field1);
+  packInt8u(finger + 2, field2);
+  packInt8u(finger + 3, field3);
+  length = (uint16_t)(finger + 4 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uuuu", fetched by:
+//   EMBER_GET_MAXIMUM_PAYLOAD_LENGTH_IPC_COMMAND_ID
+void cspFetchApiUuuu(uint8_t *apiCommandData,
+                     void *field0,
+                     void *field1,
+                     void *field2,
+                     void *field3)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt8u(readPointer + 1, field1);
+  fetchInt8u(readPointer + 2, field2);
+  fetchInt8u(readPointer + 3, field3);
+}
+
+// "uuuv", formatted by:
+//   EMBER_ENERGY_SCAN_COMPLETE_HANDLER_IPC_COMMAND_ID
+uint16_t cspFormatUuuv(uint8_t *buffer,
+                       uint16_t bufferSize,
+                       uint16_t identifier,
+                       uint8_t field0,
+                       uint8_t field1,
+                       uint8_t field2,
+                       uint16_t field3)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt8u(finger + 1, field1);
+  packInt8u(finger + 2, field2);
+  packInt16u(finger + 3, field3);
+  length = (uint16_t)(finger + 5 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uuuv", fetched by:
+//   EMBER_ENERGY_SCAN_COMPLETE_HANDLER_IPC_COMMAND_ID
+void cspFetchCallbackUuuv(uint8_t *callbackParams,
+                          void *field0,
+                          void *field1,
+                          void *field2,
+                          void *field3)
+{
+  uint8_t *readPointer = callbackParams;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt8u(readPointer + 1, field1);
+  fetchInt8u(readPointer + 2, field2);
+  fetchInt16u(readPointer + 3, field3);
+}
+
+// "uuvbuvbuvvuuuwubuw", formatted by:
+//   EMBER_MAC_MESSAGE_SENT_HANDLER_IPC_COMMAND_ID
+uint16_t cspFormatUuvbuvbuvvuuuwubuw(uint8_t *buffer,
+                                     uint16_t bufferSize,
+                                     uint16_t identifier,
+                                     uint8_t field0,
+                                     uint8_t field1,
+                                     uint16_t field2,
+                                     const void *field3,
+                                     uint8_t field3Length,
+                                     uint8_t field4,
+                                     uint16_t field5,
+                                     const void *field6,
+                                     uint8_t field6Length,
+                                     uint8_t field7,
+                                     uint16_t field8,
+                                     uint16_t field9,
+                                     uint8_t field10,
+                                     uint8_t field11,
+                                     uint8_t field12,
+                                     uint32_t field13,
+                                     uint8_t field14,
+                                     const void *field15,
+                                     uint8_t field15Length,
+                                     uint8_t field16,
+                                     uint32_t field17)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt8u(finger + 1, field1);
+  packInt16u(finger + 2, field2);
+  finger = packBlock(finger + 4, field3, field3Length);
+  packInt8u(finger, field4);
+  packInt16u(finger + 1, field5);
+  finger = packBlock(finger + 3, field6, field6Length);
+  packInt8u(finger, field7);
+  packInt16u(finger + 1, field8);
+  packInt16u(finger + 3, field9);
+  packInt8u(finger + 5, field10);
+  packInt8u(finger + 6, field11);
+  packInt8u(finger + 7, field12);
+  packInt32u(finger + 8, field13);
+  packInt8u(finger + 12, field14);
+  finger = packBlock(finger + 13, field15, field15Length);
+  packInt8u(finger, field16);
+  packInt32u(finger + 1, field17);
+  length = (uint16_t)(finger + 5 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uuvbuvbuvvuuuwubuw", fetched by:
+//   EMBER_MAC_MESSAGE_SENT_HANDLER_IPC_COMMAND_ID
+void cspFetchCallbackUuvbuvbuvvuuuwubuw(uint8_t *callbackParams,
+                                        void *field0,
+                                        void *field1,
+                                        void *field2,
+                                        void *field3,
+                                        uint8_t *field3Length,
+                                        uint8_t field3BufferSize,
+                                        void *field4,
+                                        void *field5,
+                                        void *field6,
+                                        uint8_t *field6Length,
+                                        uint8_t field6BufferSize,
+                                        void *field7,
+                                        void *field8,
+                                        void *field9,
+                                        void *field10,
+                                        void *field11,
+                                        void *field12,
+                                        void *field13,
+                                        void *field14,
+                                        void *field15,
+                                        uint8_t *field15Length,
+                                        uint8_t field15BufferSize,
+                                        void *field16,
+                                        void *field17)
+{
+  uint8_t *readPointer = callbackParams;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt8u(readPointer + 1, field1);
+  fetchInt16u(readPointer + 2, field2);
+  readPointer = fetchBlock(readPointer + 4, field3, field3Length, field3BufferSize);
+  fetchInt8u(readPointer, field4);
+  fetchInt16u(readPointer + 1, field5);
+  readPointer = fetchBlock(readPointer + 3, field6, field6Length, field6BufferSize);
+  fetchInt8u(readPointer, field7);
+  fetchInt16u(readPointer + 1, field8);
+  fetchInt16u(readPointer + 3, field9);
+  fetchInt8u(readPointer + 5, field10);
+  fetchInt8u(readPointer + 6, field11);
+  fetchInt8u(readPointer + 7, field12);
+  fetchInt32u(readPointer + 8, field13);
+  fetchInt8u(readPointer + 12, field14);
+  readPointer = fetchBlock(readPointer + 13, field15, field15Length, field15BufferSize);
+  fetchInt8u(readPointer, field16);
+  fetchInt32u(readPointer + 1, field17);
+}
+
+// "uuvuuubuw", formatted by:
+//   EMBER_MESSAGE_SENT_HANDLER_IPC_COMMAND_ID
+uint16_t cspFormatUuvuuubuw(uint8_t *buffer,
+                            uint16_t bufferSize,
+                            uint16_t identifier,
+                            uint8_t field0,
+                            uint8_t field1,
+                            uint16_t field2,
+                            uint8_t field3,
+                            uint8_t field4,
+                            uint8_t field5,
+                            const void *field6,
+                            uint8_t field6Length,
+                            uint8_t field7,
+                            uint32_t field8)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt8u(finger + 1, field1);
+  packInt16u(finger + 2, field2);
+  packInt8u(finger + 4, field3);
+  packInt8u(finger + 5, field4);
+  packInt8u(finger + 6, field5);
+  finger = packBlock(finger + 7, field6, field6Length);
+  packInt8u(finger, field7);
+  packInt32u(finger + 1, field8);
+  length = (uint16_t)(finger + 5 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uuvuuubuw", fetched by:
+//   EMBER_MESSAGE_SENT_HANDLER_IPC_COMMAND_ID
+void cspFetchCallbackUuvuuubuw(uint8_t *callbackParams,
+                               void *field0,
+                               void *field1,
+                               void *field2,
+                               void *field3,
+                               void *field4,
+                               void *field5,
+                               void *field6,
+                               uint8_t *field6Length,
+                               uint8_t field6BufferSize,
+                               void *field7,
+                               void *field8)
+{
+  uint8_t *readPointer = callbackParams;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt8u(readPointer + 1, field1);
+  fetchInt16u(readPointer + 2, field2);
+  fetchInt8u(readPointer + 4, field3);
+  fetchInt8u(readPointer + 5, field4);
+  fetchInt8u(readPointer + 6, field5);
+  readPointer = fetchBlock(readPointer + 7, field6, field6Length, field6BufferSize);
+  fetchInt8u(readPointer, field7);
+  fetchInt32u(readPointer + 1, field8);
+}
+
+// "uv", formatted by:
+//   EMBER_CHILD_JOIN_HANDLER_IPC_COMMAND_ID
+//   EMBER_START_TX_STREAM_IPC_COMMAND_ID
+uint16_t cspFormatUv(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint8_t field0,
+                     uint16_t field1)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt16u(finger + 1, field1);
+  length = (uint16_t)(finger + 3 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uv", fetched by:
+//   EMBER_START_TX_STREAM_IPC_COMMAND_ID
+void cspFetchApiUv(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt16u(readPointer + 1, field1);
+}
+
+// "uv", fetched by:
+//   EMBER_CHILD_JOIN_HANDLER_IPC_COMMAND_ID
+void cspFetchCallbackUv(uint8_t *callbackParams,
+                        void *field0,
+                        void *field1)
+{
+  uint8_t *readPointer = callbackParams;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt16u(readPointer + 1, field1);
+}
+
+// "uvbu", formatted by:
+//   EMBER_MAC_GET_PARENT_ADDRESS_IPC_COMMAND_ID
+uint16_t cspFormatUvbu(uint8_t *buffer,
+                       uint16_t bufferSize,
+                       uint16_t identifier,
+                       uint8_t field0,
+                       uint16_t field1,
+                       const void *field2,
+                       uint8_t field2Length,
+                       uint8_t field3)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt16u(finger + 1, field1);
+  finger = packBlock(finger + 3, field2, field2Length);
+  packInt8u(finger, field3);
+  length = (uint16_t)(finger + 1 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uvbu", fetched by:
+//   EMBER_MAC_GET_PARENT_ADDRESS_IPC_COMMAND_ID
+void cspFetchApiUvbu(uint8_t *apiCommandData,
+                     void *field0,
+                     void *field1,
+                     void *field2,
+                     uint8_t *field2Length,
+                     uint8_t field2BufferSize,
+                     void *field3)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt16u(readPointer + 1, field1);
+  readPointer = fetchBlock(readPointer + 3, field2, field2Length, field2BufferSize);
+  fetchInt8u(readPointer, field3);
+}
+
+// "uvbuu", formatted by:
+//   EMBER_GET_CHILD_INFO_IPC_COMMAND_ID
+uint16_t cspFormatUvbuu(uint8_t *buffer,
+                        uint16_t bufferSize,
+                        uint16_t identifier,
+                        uint8_t field0,
+                        uint16_t field1,
+                        const void *field2,
+                        uint8_t field2Length,
+                        uint8_t field3,
+                        uint8_t field4)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt16u(finger + 1, field1);
+  finger = packBlock(finger + 3, field2, field2Length);
+  packInt8u(finger, field3);
+  packInt8u(finger + 1, field4);
+  length = (uint16_t)(finger + 2 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uvbuu", fetched by:
+//   EMBER_GET_CHILD_INFO_IPC_COMMAND_ID
+void cspFetchApiUvbuu(uint8_t *apiCommandData,
+                      void *field0,
+                      void *field1,
+                      void *field2,
+                      uint8_t *field2Length,
+                      uint8_t field2BufferSize,
+                      void *field3,
+                      void *field4)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt16u(readPointer + 1, field1);
+  readPointer = fetchBlock(readPointer + 3, field2, field2Length, field2BufferSize);
+  fetchInt8u(readPointer, field3);
+  fetchInt8u(readPointer + 1, field4);
+}
+
+// "uvbuvbuvvuuuuwubw", formatted by:
+//   EMBER_INCOMING_MAC_MESSAGE_HANDLER_IPC_COMMAND_ID
+uint16_t cspFormatUvbuvbuvvuuuuwubw(uint8_t *buffer,
+                                    uint16_t bufferSize,
+                                    uint16_t identifier,
+                                    uint8_t field0,
+                                    uint16_t field1,
+                                    const void *field2,
+                                    uint8_t field2Length,
+                                    uint8_t field3,
+                                    uint16_t field4,
+                                    const void *field5,
+                                    uint8_t field5Length,
+                                    uint8_t field6,
+                                    uint16_t field7,
+                                    uint16_t field8,
+                                    uint8_t field9,
+                                    uint8_t field10,
+                                    uint8_t field11,
+                                    uint8_t field12,
+                                    uint32_t field13,
+                                    uint8_t field14,
+                                    const void *field15,
+                                    uint8_t field15Length,
+                                    uint32_t field16)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt16u(finger + 1, field1);
+  finger = packBlock(finger + 3, field2, field2Length);
+  packInt8u(finger, field3);
+  packInt16u(finger + 1, field4);
+  finger = packBlock(finger + 3, field5, field5Length);
+  packInt8u(finger, field6);
+  packInt16u(finger + 1, field7);
+  packInt16u(finger + 3, field8);
+  packInt8u(finger + 5, field9);
+  packInt8u(finger + 6, field10);
+  packInt8u(finger + 7, field11);
+  packInt8u(finger + 8, field12);
+  packInt32u(finger + 9, field13);
+  packInt8u(finger + 13, field14);
+  finger = packBlock(finger + 14, field15, field15Length);
+  packInt32u(finger, field16);
+  length = (uint16_t)(finger + 4 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uvbuvbuvvuuuuwubw", fetched by:
+//   EMBER_INCOMING_MAC_MESSAGE_HANDLER_IPC_COMMAND_ID
+void cspFetchCallbackUvbuvbuvvuuuuwubw(uint8_t *callbackParams,
+                                       void *field0,
+                                       void *field1,
+                                       void *field2,
+                                       uint8_t *field2Length,
+                                       uint8_t field2BufferSize,
+                                       void *field3,
+                                       void *field4,
+                                       void *field5,
+                                       uint8_t *field5Length,
+                                       uint8_t field5BufferSize,
+                                       void *field6,
+                                       void *field7,
+                                       void *field8,
+                                       void *field9,
+                                       void *field10,
+                                       void *field11,
+                                       void *field12,
+                                       void *field13,
+                                       void *field14,
+                                       void *field15,
+                                       uint8_t *field15Length,
+                                       uint8_t field15BufferSize,
+                                       void *field16)
+{
+  uint8_t *readPointer = callbackParams;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt16u(readPointer + 1, field1);
+  readPointer = fetchBlock(readPointer + 3, field2, field2Length, field2BufferSize);
+  fetchInt8u(readPointer, field3);
+  fetchInt16u(readPointer + 1, field4);
+  readPointer = fetchBlock(readPointer + 3, field5, field5Length, field5BufferSize);
+  fetchInt8u(readPointer, field6);
+  fetchInt16u(readPointer + 1, field7);
+  fetchInt16u(readPointer + 3, field8);
+  fetchInt8u(readPointer + 5, field9);
+  fetchInt8u(readPointer + 6, field10);
+  fetchInt8u(readPointer + 7, field11);
+  fetchInt8u(readPointer + 8, field12);
+  fetchInt32u(readPointer + 9, field13);
+  fetchInt8u(readPointer + 13, field14);
+  readPointer = fetchBlock(readPointer + 14, field15, field15Length, field15BufferSize);
+  fetchInt32u(readPointer, field16);
+}
+
+// "uvuuubwu", formatted by:
+//   EMBER_INCOMING_MESSAGE_HANDLER_IPC_COMMAND_ID
+uint16_t cspFormatUvuuubwu(uint8_t *buffer,
+                           uint16_t bufferSize,
+                           uint16_t identifier,
+                           uint8_t field0,
+                           uint16_t field1,
+                           uint8_t field2,
+                           uint8_t field3,
+                           uint8_t field4,
+                           const void *field5,
+                           uint8_t field5Length,
+                           uint32_t field6,
+                           uint8_t field7)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt16u(finger + 1, field1);
+  packInt8u(finger + 3, field2);
+  packInt8u(finger + 4, field3);
+  packInt8u(finger + 5, field4);
+  finger = packBlock(finger + 6, field5, field5Length);
+  packInt32u(finger, field6);
+  packInt8u(finger + 4, field7);
+  length = (uint16_t)(finger + 5 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uvuuubwu", fetched by:
+//   EMBER_INCOMING_MESSAGE_HANDLER_IPC_COMMAND_ID
+void cspFetchCallbackUvuuubwu(uint8_t *callbackParams,
+                              void *field0,
+                              void *field1,
+                              void *field2,
+                              void *field3,
+                              void *field4,
+                              void *field5,
+                              uint8_t *field5Length,
+                              uint8_t field5BufferSize,
+                              void *field6,
+                              void *field7)
+{
+  uint8_t *readPointer = callbackParams;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt16u(readPointer + 1, field1);
+  fetchInt8u(readPointer + 3, field2);
+  fetchInt8u(readPointer + 4, field3);
+  fetchInt8u(readPointer + 5, field4);
+  readPointer = fetchBlock(readPointer + 6, field5, field5Length, field5BufferSize);
+  fetchInt32u(readPointer, field6);
+  fetchInt8u(readPointer + 4, field7);
+}
+
+// "uvvv", formatted by:
+//   EMBER_JOIN_NETWORK_IPC_COMMAND_ID
+uint16_t cspFormatUvvv(uint8_t *buffer,
+                       uint16_t bufferSize,
+                       uint16_t identifier,
+                       uint8_t field0,
+                       uint16_t field1,
+                       uint16_t field2,
+                       uint16_t field3)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt16u(finger + 1, field1);
+  packInt16u(finger + 3, field2);
+  packInt16u(finger + 5, field3);
+  length = (uint16_t)(finger + 7 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uvvv", fetched by:
+//   EMBER_JOIN_NETWORK_IPC_COMMAND_ID
+void cspFetchApiUvvv(uint8_t *apiCommandData,
+                     void *field0,
+                     void *field1,
+                     void *field2,
+                     void *field3)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt16u(readPointer + 1, field1);
+  fetchInt16u(readPointer + 3, field2);
+  fetchInt16u(readPointer + 5, field3);
+}
+
+// "uvvvv", formatted by:
+//   EMBER_JOIN_COMMISSIONED_IPC_COMMAND_ID
+//   EMBER_JOIN_NETWORK_EXTENDED_IPC_COMMAND_ID
+uint16_t cspFormatUvvvv(uint8_t *buffer,
+                        uint16_t bufferSize,
+                        uint16_t identifier,
+                        uint8_t field0,
+                        uint16_t field1,
+                        uint16_t field2,
+                        uint16_t field3,
+                        uint16_t field4)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt16u(finger + 1, field1);
+  packInt16u(finger + 3, field2);
+  packInt16u(finger + 5, field3);
+  packInt16u(finger + 7, field4);
+  length = (uint16_t)(finger + 9 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uvvvv", fetched by:
+//   EMBER_JOIN_COMMISSIONED_IPC_COMMAND_ID
+//   EMBER_JOIN_NETWORK_EXTENDED_IPC_COMMAND_ID
+void cspFetchApiUvvvv(uint8_t *apiCommandData,
+                      void *field0,
+                      void *field1,
+                      void *field2,
+                      void *field3,
+                      void *field4)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt16u(readPointer + 1, field1);
+  fetchInt16u(readPointer + 3, field2);
+  fetchInt16u(readPointer + 5, field3);
+  fetchInt16u(readPointer + 7, field4);
+}
+
+// "uw", formatted by:
+//   EMBER_CALIBRATE_CURRENT_CHANNEL_EXTENDED_IPC_COMMAND_ID
+//   EMBER_GET_COUNTER_IPC_COMMAND_ID
+uint16_t cspFormatUw(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint8_t field0,
+                     uint32_t field1)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt8u(finger, field0);
+  packInt32u(finger + 1, field1);
+  length = (uint16_t)(finger + 5 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "uw", fetched by:
+//   EMBER_CALIBRATE_CURRENT_CHANNEL_EXTENDED_IPC_COMMAND_ID
+//   EMBER_GET_COUNTER_IPC_COMMAND_ID
+void cspFetchApiUw(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt8u(readPointer, field0);
+  fetchInt32u(readPointer + 1, field1);
+}
+
+// "v", formatted by:
+//   EMBER_CURRENT_STACK_TASKS_IPC_COMMAND_ID
+//   EMBER_GET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID
+//   EMBER_GET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID
+//   EMBER_GET_DEFAULT_CHANNEL_IPC_COMMAND_ID
+//   EMBER_GET_NODE_ID_IPC_COMMAND_ID
+//   EMBER_GET_PAN_ID_IPC_COMMAND_ID
+//   EMBER_GET_PARENT_ID_IPC_COMMAND_ID
+//   EMBER_GET_RADIO_CHANNEL_IPC_COMMAND_ID
+//   EMBER_GET_RADIO_POWER_IPC_COMMAND_ID
+//   EMBER_SET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_CHANNEL_IPC_COMMAND_ID
+//   EMBER_START_ACTIVE_SCAN_IPC_COMMAND_ID
+uint16_t cspFormatV(uint8_t *buffer,
+                    uint16_t bufferSize,
+                    uint16_t identifier,
+                    uint16_t field0)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt16u(finger, field0);
+  length = (uint16_t)(finger + 2 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "v", fetched by:
+//   EMBER_CURRENT_STACK_TASKS_IPC_COMMAND_ID
+//   EMBER_GET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID
+//   EMBER_GET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID
+//   EMBER_GET_DEFAULT_CHANNEL_IPC_COMMAND_ID
+//   EMBER_GET_NODE_ID_IPC_COMMAND_ID
+//   EMBER_GET_PAN_ID_IPC_COMMAND_ID
+//   EMBER_GET_PARENT_ID_IPC_COMMAND_ID
+//   EMBER_GET_RADIO_CHANNEL_IPC_COMMAND_ID
+//   EMBER_GET_RADIO_POWER_IPC_COMMAND_ID
+//   EMBER_SET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_CHANNEL_IPC_COMMAND_ID
+//   EMBER_START_ACTIVE_SCAN_IPC_COMMAND_ID
+void cspFetchApiV(uint8_t *apiCommandData,
+                  void *field0)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt16u(readPointer, field0);
+}
+
+// "vb", formatted by:
+//   EMBER_MAC_ADD_SHORT_TO_LONG_ADDRESS_MAPPING_IPC_COMMAND_ID
+uint16_t cspFormatVb(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint16_t field0,
+                     const void *field1,
+                     uint8_t field1Length)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt16u(finger, field0);
+  finger = packBlock(finger + 2, field1, field1Length);
+  length = (uint16_t)(finger - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "vb", fetched by:
+//   EMBER_MAC_ADD_SHORT_TO_LONG_ADDRESS_MAPPING_IPC_COMMAND_ID
+void cspFetchApiVb(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1,
+                   uint8_t *field1Length,
+                   uint8_t field1BufferSize)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt16u(readPointer, field0);
+  fetchBlock(readPointer + 2, field1, field1Length, field1BufferSize);
+}
+
+// "vbu", formatted by:
+//   EMBER_GET_CHILD_FLAGS_IPC_COMMAND_ID
+//   EMBER_GET_CHILD_INFO_IPC_COMMAND_ID
+//   EMBER_MAC_GET_PARENT_ADDRESS_IPC_COMMAND_ID
+//   EMBER_REMOVE_CHILD_IPC_COMMAND_ID
+//   EMBER_SET_POLL_DESTINATION_ADDRESS_IPC_COMMAND_ID
+uint16_t cspFormatVbu(uint8_t *buffer,
+                      uint16_t bufferSize,
+                      uint16_t identifier,
+                      uint16_t field0,
+                      const void *field1,
+                      uint8_t field1Length,
+                      uint8_t field2)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt16u(finger, field0);
+  finger = packBlock(finger + 2, field1, field1Length);
+  packInt8u(finger, field2);
+  length = (uint16_t)(finger + 1 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "vbu", fetched by:
+//   EMBER_GET_CHILD_FLAGS_IPC_COMMAND_ID
+//   EMBER_GET_CHILD_INFO_IPC_COMMAND_ID
+//   EMBER_MAC_GET_PARENT_ADDRESS_IPC_COMMAND_ID
+//   EMBER_REMOVE_CHILD_IPC_COMMAND_ID
+//   EMBER_SET_POLL_DESTINATION_ADDRESS_IPC_COMMAND_ID
+void cspFetchApiVbu(uint8_t *apiCommandData,
+                    void *field0,
+                    void *field1,
+                    uint8_t *field1Length,
+                    uint8_t field1BufferSize,
+                    void *field2)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt16u(readPointer, field0);
+  readPointer = fetchBlock(readPointer + 2, field1, field1Length, field1BufferSize);
+  fetchInt8u(readPointer, field2);
+}
+
+// "vbuvbuvvuuuubu", formatted by:
+//   EMBER_MAC_MESSAGE_SEND_IPC_COMMAND_ID
+uint16_t cspFormatVbuvbuvvuuuubu(uint8_t *buffer,
+                                 uint16_t bufferSize,
+                                 uint16_t identifier,
+                                 uint16_t field0,
+                                 const void *field1,
+                                 uint8_t field1Length,
+                                 uint8_t field2,
+                                 uint16_t field3,
+                                 const void *field4,
+                                 uint8_t field4Length,
+                                 uint8_t field5,
+                                 uint16_t field6,
+                                 uint16_t field7,
+                                 uint8_t field8,
+                                 uint8_t field9,
+                                 uint8_t field10,
+                                 uint8_t field11,
+                                 const void *field12,
+                                 uint8_t field12Length,
+                                 uint8_t field13)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt16u(finger, field0);
+  finger = packBlock(finger + 2, field1, field1Length);
+  packInt8u(finger, field2);
+  packInt16u(finger + 1, field3);
+  finger = packBlock(finger + 3, field4, field4Length);
+  packInt8u(finger, field5);
+  packInt16u(finger + 1, field6);
+  packInt16u(finger + 3, field7);
+  packInt8u(finger + 5, field8);
+  packInt8u(finger + 6, field9);
+  packInt8u(finger + 7, field10);
+  packInt8u(finger + 8, field11);
+  finger = packBlock(finger + 9, field12, field12Length);
+  packInt8u(finger, field13);
+  length = (uint16_t)(finger + 1 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "vbuvbuvvuuuupu", fetched by:
+//   EMBER_MAC_MESSAGE_SEND_IPC_COMMAND_ID
+void cspFetchApiVbuvbuvvuuuupu(uint8_t *apiCommandData,
+                               void *field0,
+                               void *field1,
+                               uint8_t *field1Length,
+                               uint8_t field1BufferSize,
+                               void *field2,
+                               void *field3,
+                               void *field4,
+                               uint8_t *field4Length,
+                               uint8_t field4BufferSize,
+                               void *field5,
+                               void *field6,
+                               void *field7,
+                               void *field8,
+                               void *field9,
+                               void *field10,
+                               void *field11,
+                               void *field12,
+                               uint8_t *field12Length,
+                               void *field13)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt16u(readPointer, field0);
+  readPointer = fetchBlock(readPointer + 2, field1, field1Length, field1BufferSize);
+  fetchInt8u(readPointer, field2);
+  fetchInt16u(readPointer + 1, field3);
+  readPointer = fetchBlock(readPointer + 3, field4, field4Length, field4BufferSize);
+  fetchInt8u(readPointer, field5);
+  fetchInt16u(readPointer + 1, field6);
+  fetchInt16u(readPointer + 3, field7);
+  fetchInt8u(readPointer + 5, field8);
+  fetchInt8u(readPointer + 6, field9);
+  fetchInt8u(readPointer + 7, field10);
+  fetchInt8u(readPointer + 8, field11);
+  readPointer = fetchPointer(readPointer + 9, field12, field12Length);
+  fetchInt8u(readPointer, field13);
+}
+
+// "vu", formatted by:
+//   EMBER_SET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_CHANNEL_EXTENDED_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_POWER_IPC_COMMAND_ID
+//   EMBER_START_ENERGY_SCAN_IPC_COMMAND_ID
+uint16_t cspFormatVu(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint16_t field0,
+                     uint8_t field1)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt16u(finger, field0);
+  packInt8u(finger + 2, field1);
+  length = (uint16_t)(finger + 3 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "vu", fetched by:
+//   EMBER_SET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_CHANNEL_EXTENDED_IPC_COMMAND_ID
+//   EMBER_SET_RADIO_POWER_IPC_COMMAND_ID
+//   EMBER_START_ENERGY_SCAN_IPC_COMMAND_ID
+void cspFetchApiVu(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt16u(readPointer, field0);
+  fetchInt8u(readPointer + 2, field1);
+}
+
+// "vuuubu", formatted by:
+//   EMBER_MESSAGE_SEND_IPC_COMMAND_ID
+uint16_t cspFormatVuuubu(uint8_t *buffer,
+                         uint16_t bufferSize,
+                         uint16_t identifier,
+                         uint16_t field0,
+                         uint8_t field1,
+                         uint8_t field2,
+                         uint8_t field3,
+                         const void *field4,
+                         uint8_t field4Length,
+                         uint8_t field5)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt16u(finger, field0);
+  packInt8u(finger + 2, field1);
+  packInt8u(finger + 3, field2);
+  packInt8u(finger + 4, field3);
+  finger = packBlock(finger + 5, field4, field4Length);
+  packInt8u(finger, field5);
+  length = (uint16_t)(finger + 1 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "vuuupu", fetched by:
+//   EMBER_MESSAGE_SEND_IPC_COMMAND_ID
+void cspFetchApiVuuupu(uint8_t *apiCommandData,
+                       void *field0,
+                       void *field1,
+                       void *field2,
+                       void *field3,
+                       void *field4,
+                       uint8_t *field4Length,
+                       void *field5)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt16u(readPointer, field0);
+  fetchInt8u(readPointer + 2, field1);
+  fetchInt8u(readPointer + 3, field2);
+  fetchInt8u(readPointer + 4, field3);
+  readPointer = fetchPointer(readPointer + 5, field4, field4Length);
+  fetchInt8u(readPointer, field5);
+}
+
+// "vv", formatted by:
+//   EMBER_FREQUENCY_HOPPING_START_CLIENT_IPC_COMMAND_ID
+uint16_t cspFormatVv(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint16_t field0,
+                     uint16_t field1)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt16u(finger, field0);
+  packInt16u(finger + 2, field1);
+  length = (uint16_t)(finger + 4 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "vv", fetched by:
+//   EMBER_FREQUENCY_HOPPING_START_CLIENT_IPC_COMMAND_ID
+void cspFetchApiVv(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt16u(readPointer, field0);
+  fetchInt16u(readPointer + 2, field1);
+}
+
+// "vvbuuuubub", formatted by:
+//   EMBER_INCOMING_BEACON_HANDLER_IPC_COMMAND_ID
+uint16_t cspFormatVvbuuuubub(uint8_t *buffer,
+                             uint16_t bufferSize,
+                             uint16_t identifier,
+                             uint16_t field0,
+                             uint16_t field1,
+                             const void *field2,
+                             uint8_t field2Length,
+                             uint8_t field3,
+                             uint8_t field4,
+                             uint8_t field5,
+                             uint8_t field6,
+                             const void *field7,
+                             uint8_t field7Length,
+                             uint8_t field8,
+                             const void *field9,
+                             uint8_t field9Length)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt16u(finger, field0);
+  packInt16u(finger + 2, field1);
+  finger = packBlock(finger + 4, field2, field2Length);
+  packInt8u(finger, field3);
+  packInt8u(finger + 1, field4);
+  packInt8u(finger + 2, field5);
+  packInt8u(finger + 3, field6);
+  finger = packBlock(finger + 4, field7, field7Length);
+  packInt8u(finger, field8);
+  finger = packBlock(finger + 1, field9, field9Length);
+  length = (uint16_t)(finger - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "vvbuuuubub", fetched by:
+//   EMBER_INCOMING_BEACON_HANDLER_IPC_COMMAND_ID
+void cspFetchCallbackVvbuuuubub(uint8_t *callbackParams,
+                                void *field0,
+                                void *field1,
+                                void *field2,
+                                uint8_t *field2Length,
+                                uint8_t field2BufferSize,
+                                void *field3,
+                                void *field4,
+                                void *field5,
+                                void *field6,
+                                void *field7,
+                                uint8_t *field7Length,
+                                uint8_t field7BufferSize,
+                                void *field8,
+                                void *field9,
+                                uint8_t *field9Length,
+                                uint8_t field9BufferSize)
+{
+  uint8_t *readPointer = callbackParams;
+
+  fetchInt16u(readPointer, field0);
+  fetchInt16u(readPointer + 2, field1);
+  readPointer = fetchBlock(readPointer + 4, field2, field2Length, field2BufferSize);
+  fetchInt8u(readPointer, field3);
+  fetchInt8u(readPointer + 1, field4);
+  fetchInt8u(readPointer + 2, field5);
+  fetchInt8u(readPointer + 3, field6);
+  readPointer = fetchBlock(readPointer + 4, field7, field7Length, field7BufferSize);
+  fetchInt8u(readPointer, field8);
+  fetchBlock(readPointer + 1, field9, field9Length, field9BufferSize);
+}
+
+// "vvv", formatted by:
+//   EMBER_FORM_NETWORK_IPC_COMMAND_ID
+//   EMBER_MAC_FORM_NETWORK_IPC_COMMAND_ID
+uint16_t cspFormatVvv(uint8_t *buffer,
+                      uint16_t bufferSize,
+                      uint16_t identifier,
+                      uint16_t field0,
+                      uint16_t field1,
+                      uint16_t field2)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt16u(finger, field0);
+  packInt16u(finger + 2, field1);
+  packInt16u(finger + 4, field2);
+  length = (uint16_t)(finger + 6 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "vvv", fetched by:
+//   EMBER_FORM_NETWORK_IPC_COMMAND_ID
+//   EMBER_MAC_FORM_NETWORK_IPC_COMMAND_ID
+void cspFetchApiVvv(uint8_t *apiCommandData,
+                    void *field0,
+                    void *field1,
+                    void *field2)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt16u(readPointer, field0);
+  fetchInt16u(readPointer + 2, field1);
+  fetchInt16u(readPointer + 4, field2);
+}
+
+// "w", formatted by:
+//   EMBER_APPLY_IR_CALIBRATION_IPC_COMMAND_ID
+//   EMBER_CALIBRATE_CURRENT_CHANNEL_EXTENDED_IPC_COMMAND_ID
+//   EMBER_GET_CAL_TYPE_IPC_COMMAND_ID
+//   EMBER_GET_KEY_ID_IPC_COMMAND_ID
+//   EMBER_SET_INDIRECT_QUEUE_TIMEOUT_IPC_COMMAND_ID
+//   EMBER_SET_PSA_SECURITY_KEY_IPC_COMMAND_ID
+uint16_t cspFormatW(uint8_t *buffer,
+                    uint16_t bufferSize,
+                    uint16_t identifier,
+                    uint32_t field0)
+{
+  uint8_t *finger = buffer + sizeof(uint16_t);
+  uint16_t length;
+
+  packInt16u(buffer, identifier);
+  packInt32u(finger, field0);
+  length = (uint16_t)(finger + 4 - buffer);
+  // sanity check
+  assert(length <= bufferSize);
+  return length;
+}
+
+// "w", fetched by:
+//   EMBER_APPLY_IR_CALIBRATION_IPC_COMMAND_ID
+//   EMBER_CALIBRATE_CURRENT_CHANNEL_EXTENDED_IPC_COMMAND_ID
+//   EMBER_GET_CAL_TYPE_IPC_COMMAND_ID
+//   EMBER_GET_KEY_ID_IPC_COMMAND_ID
+//   EMBER_SET_INDIRECT_QUEUE_TIMEOUT_IPC_COMMAND_ID
+//   EMBER_SET_PSA_SECURITY_KEY_IPC_COMMAND_ID
+void cspFetchApiW(uint8_t *apiCommandData,
+                  void *field0)
+{
+  // Start fetching right after the command ID
+  uint8_t *readPointer = apiCommandData + 2;
+
+  fetchInt32u(readPointer, field0);
+}
+
+//------------------------------------------------------------------------------
+// Argument list adapters, only built into the host checks comparing every
+// routine with the format string interpreter.
+
+#ifdef CSP_CODEC_GEN_CHECKS
+
+#include <stdarg.h>
+
+static uint16_t checkFormatEmpty(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  (void)argumentList;
+  return cspFormatEmpty(buffer, bufferSize, identifier);
+}
+
+static uint16_t checkFormatB(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  const void *field0 = va_arg(*argumentList, const void *);
+  uint8_t field0Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatB(buffer, bufferSize, identifier, field0, field0Length);
+}
+
+static void checkFetchApiB(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  uint8_t *field0Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field0BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  cspFetchApiB(data, field0, field0Length, field0BufferSize);
+}
+
+static void checkFetchApiP(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  uint8_t *field0Length = va_arg(*argumentList, uint8_t *);
+  cspFetchApiP(data, field0, field0Length);
+}
+
+static uint16_t checkFormatSuuuvvuwv(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  int8_t field0 = (int8_t)va_arg(*argumentList, int);
+  uint8_t field1 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field2 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field3 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field4 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field5 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint8_t field6 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint32_t field7 = va_arg(*argumentList, uint32_t);
+  uint16_t field8 = (uint16_t)va_arg(*argumentList, unsigned int);
+  return cspFormatSuuuvvuwv(buffer, bufferSize, identifier, field0, field1, field2, field3, field4, field5, field6, field7, field8);
+}
+
+static void checkFetchApiSuuuvvuwv(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  void *field4 = va_arg(*argumentList, void *);
+  void *field5 = va_arg(*argumentList, void *);
+  void *field6 = va_arg(*argumentList, void *);
+  void *field7 = va_arg(*argumentList, void *);
+  void *field8 = va_arg(*argumentList, void *);
+  cspFetchApiSuuuvvuwv(data, field0, field1, field2, field3, field4, field5, field6, field7, field8);
+}
+
+static uint16_t checkFormatU(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatU(buffer, bufferSize, identifier, field0);
+}
+
+static void checkFetchApiU(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  cspFetchApiU(data, field0);
+}
+
+static void checkFetchCallbackU(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  cspFetchCallbackU(data, field0);
+}
+
+static uint16_t checkFormatUb(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  const void *field1 = va_arg(*argumentList, const void *);
+  uint8_t field1Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUb(buffer, bufferSize, identifier, field0, field1, field1Length);
+}
+
+static void checkFetchApiUb(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  uint8_t *field1Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field1BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  cspFetchApiUb(data, field0, field1, field1Length, field1BufferSize);
+}
+
+static uint16_t checkFormatUu(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field1 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUu(buffer, bufferSize, identifier, field0, field1);
+}
+
+static void checkFetchApiUu(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  cspFetchApiUu(data, field0, field1);
+}
+
+static uint16_t checkFormatUuuu(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field1 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field2 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field3 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUuuu(buffer, bufferSize, identifier, field0, field1, field2, field3);
+}
+
+static void checkFetchApiUuuu(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  cspFetchApiUuuu(data, field0, field1, field2, field3);
+}
+
+static uint16_t checkFormatUuuv(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field1 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field2 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field3 = (uint16_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUuuv(buffer, bufferSize, identifier, field0, field1, field2, field3);
+}
+
+static void checkFetchCallbackUuuv(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  cspFetchCallbackUuuv(data, field0, field1, field2, field3);
+}
+
+static uint16_t checkFormatUuvbuvbuvvuuuwubuw(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field1 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field2 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field3 = va_arg(*argumentList, const void *);
+  uint8_t field3Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field4 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field5 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field6 = va_arg(*argumentList, const void *);
+  uint8_t field6Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field7 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field8 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field9 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint8_t field10 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field11 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field12 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint32_t field13 = va_arg(*argumentList, uint32_t);
+  uint8_t field14 = (uint8_t)va_arg(*argumentList, unsigned int);
+  const void *field15 = va_arg(*argumentList, const void *);
+  uint8_t field15Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field16 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint32_t field17 = va_arg(*argumentList, uint32_t);
+  return cspFormatUuvbuvbuvvuuuwubuw(buffer, bufferSize, identifier, field0, field1, field2, field3, field3Length, field4, field5, field6, field6Length, field7, field8, field9, field10, field11, field12, field13, field14, field15, field15Length, field16, field17);
+}
+
+static void checkFetchCallbackUuvbuvbuvvuuuwubuw(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  uint8_t *field3Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field3BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field4 = va_arg(*argumentList, void *);
+  void *field5 = va_arg(*argumentList, void *);
+  void *field6 = va_arg(*argumentList, void *);
+  uint8_t *field6Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field6BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field7 = va_arg(*argumentList, void *);
+  void *field8 = va_arg(*argumentList, void *);
+  void *field9 = va_arg(*argumentList, void *);
+  void *field10 = va_arg(*argumentList, void *);
+  void *field11 = va_arg(*argumentList, void *);
+  void *field12 = va_arg(*argumentList, void *);
+  void *field13 = va_arg(*argumentList, void *);
+  void *field14 = va_arg(*argumentList, void *);
+  void *field15 = va_arg(*argumentList, void *);
+  uint8_t *field15Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field15BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field16 = va_arg(*argumentList, void *);
+  void *field17 = va_arg(*argumentList, void *);
+  cspFetchCallbackUuvbuvbuvvuuuwubuw(data, field0, field1, field2, field3, field3Length, field3BufferSize, field4, field5, field6, field6Length, field6BufferSize, field7, field8, field9, field10, field11, field12, field13, field14, field15, field15Length, field15BufferSize, field16, field17);
+}
+
+static uint16_t checkFormatUuvuuubuw(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field1 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field2 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint8_t field3 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field4 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field5 = (uint8_t)va_arg(*argumentList, unsigned int);
+  const void *field6 = va_arg(*argumentList, const void *);
+  uint8_t field6Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field7 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint32_t field8 = va_arg(*argumentList, uint32_t);
+  return cspFormatUuvuuubuw(buffer, bufferSize, identifier, field0, field1, field2, field3, field4, field5, field6, field6Length, field7, field8);
+}
+
+static void checkFetchCallbackUuvuuubuw(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  void *field4 = va_arg(*argumentList, void *);
+  void *field5 = va_arg(*argumentList, void *);
+  void *field6 = va_arg(*argumentList, void *);
+  uint8_t *field6Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field6BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field7 = va_arg(*argumentList, void *);
+  void *field8 = va_arg(*argumentList, void *);
+  cspFetchCallbackUuvuuubuw(data, field0, field1, field2, field3, field4, field5, field6, field6Length, field6BufferSize, field7, field8);
+}
+
+static uint16_t checkFormatUv(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUv(buffer, bufferSize, identifier, field0, field1);
+}
+
+static void checkFetchApiUv(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  cspFetchApiUv(data, field0, field1);
+}
+
+static void checkFetchCallbackUv(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  cspFetchCallbackUv(data, field0, field1);
+}
+
+static uint16_t checkFormatUvbu(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field2 = va_arg(*argumentList, const void *);
+  uint8_t field2Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field3 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUvbu(buffer, bufferSize, identifier, field0, field1, field2, field2Length, field3);
+}
+
+static void checkFetchApiUvbu(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  uint8_t *field2Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field2BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field3 = va_arg(*argumentList, void *);
+  cspFetchApiUvbu(data, field0, field1, field2, field2Length, field2BufferSize, field3);
+}
+
+static uint16_t checkFormatUvbuu(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field2 = va_arg(*argumentList, const void *);
+  uint8_t field2Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field3 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field4 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUvbuu(buffer, bufferSize, identifier, field0, field1, field2, field2Length, field3, field4);
+}
+
+static void checkFetchApiUvbuu(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  uint8_t *field2Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field2BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field3 = va_arg(*argumentList, void *);
+  void *field4 = va_arg(*argumentList, void *);
+  cspFetchApiUvbuu(data, field0, field1, field2, field2Length, field2BufferSize, field3, field4);
+}
+
+static uint16_t checkFormatUvbuvbuvvuuuuwubw(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field2 = va_arg(*argumentList, const void *);
+  uint8_t field2Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field3 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field4 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field5 = va_arg(*argumentList, const void *);
+  uint8_t field5Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field6 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field7 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field8 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint8_t field9 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field10 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field11 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field12 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint32_t field13 = va_arg(*argumentList, uint32_t);
+  uint8_t field14 = (uint8_t)va_arg(*argumentList, unsigned int);
+  const void *field15 = va_arg(*argumentList, const void *);
+  uint8_t field15Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint32_t field16 = va_arg(*argumentList, uint32_t);
+  return cspFormatUvbuvbuvvuuuuwubw(buffer, bufferSize, identifier, field0, field1, field2, field2Length, field3, field4, field5, field5Length, field6, field7, field8, field9, field10, field11, field12, field13, field14, field15, field15Length, field16);
+}
+
+static void checkFetchCallbackUvbuvbuvvuuuuwubw(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  uint8_t *field2Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field2BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field3 = va_arg(*argumentList, void *);
+  void *field4 = va_arg(*argumentList, void *);
+  void *field5 = va_arg(*argumentList, void *);
+  uint8_t *field5Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field5BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field6 = va_arg(*argumentList, void *);
+  void *field7 = va_arg(*argumentList, void *);
+  void *field8 = va_arg(*argumentList, void *);
+  void *field9 = va_arg(*argumentList, void *);
+  void *field10 = va_arg(*argumentList, void *);
+  void *field11 = va_arg(*argumentList, void *);
+  void *field12 = va_arg(*argumentList, void *);
+  void *field13 = va_arg(*argumentList, void *);
+  void *field14 = va_arg(*argumentList, void *);
+  void *field15 = va_arg(*argumentList, void *);
+  uint8_t *field15Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field15BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field16 = va_arg(*argumentList, void *);
+  cspFetchCallbackUvbuvbuvvuuuuwubw(data, field0, field1, field2, field2Length, field2BufferSize, field3, field4, field5, field5Length, field5BufferSize, field6, field7, field8, field9, field10, field11, field12, field13, field14, field15, field15Length, field15BufferSize, field16);
+}
+
+static uint16_t checkFormatUvuuubwu(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint8_t field2 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field3 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field4 = (uint8_t)va_arg(*argumentList, unsigned int);
+  const void *field5 = va_arg(*argumentList, const void *);
+  uint8_t field5Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint32_t field6 = va_arg(*argumentList, uint32_t);
+  uint8_t field7 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUvuuubwu(buffer, bufferSize, identifier, field0, field1, field2, field3, field4, field5, field5Length, field6, field7);
+}
+
+static void checkFetchCallbackUvuuubwu(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  void *field4 = va_arg(*argumentList, void *);
+  void *field5 = va_arg(*argumentList, void *);
+  uint8_t *field5Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field5BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field6 = va_arg(*argumentList, void *);
+  void *field7 = va_arg(*argumentList, void *);
+  cspFetchCallbackUvuuubwu(data, field0, field1, field2, field3, field4, field5, field5Length, field5BufferSize, field6, field7);
+}
+
+static uint16_t checkFormatUvvv(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field2 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field3 = (uint16_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUvvv(buffer, bufferSize, identifier, field0, field1, field2, field3);
+}
+
+static void checkFetchApiUvvv(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  cspFetchApiUvvv(data, field0, field1, field2, field3);
+}
+
+static uint16_t checkFormatUvvvv(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field2 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field3 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field4 = (uint16_t)va_arg(*argumentList, unsigned int);
+  return cspFormatUvvvv(buffer, bufferSize, identifier, field0, field1, field2, field3, field4);
+}
+
+static void checkFetchApiUvvvv(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  void *field4 = va_arg(*argumentList, void *);
+  cspFetchApiUvvvv(data, field0, field1, field2, field3, field4);
+}
+
+static uint16_t checkFormatUw(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint8_t field0 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint32_t field1 = va_arg(*argumentList, uint32_t);
+  return cspFormatUw(buffer, bufferSize, identifier, field0, field1);
+}
+
+static void checkFetchApiUw(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  cspFetchApiUw(data, field0, field1);
+}
+
+static uint16_t checkFormatV(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint16_t field0 = (uint16_t)va_arg(*argumentList, unsigned int);
+  return cspFormatV(buffer, bufferSize, identifier, field0);
+}
+
+static void checkFetchApiV(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  cspFetchApiV(data, field0);
+}
+
+static uint16_t checkFormatVb(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint16_t field0 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field1 = va_arg(*argumentList, const void *);
+  uint8_t field1Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatVb(buffer, bufferSize, identifier, field0, field1, field1Length);
+}
+
+static void checkFetchApiVb(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  uint8_t *field1Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field1BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  cspFetchApiVb(data, field0, field1, field1Length, field1BufferSize);
+}
+
+static uint16_t checkFormatVbu(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint16_t field0 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field1 = va_arg(*argumentList, const void *);
+  uint8_t field1Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field2 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatVbu(buffer, bufferSize, identifier, field0, field1, field1Length, field2);
+}
+
+static void checkFetchApiVbu(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  uint8_t *field1Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field1BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field2 = va_arg(*argumentList, void *);
+  cspFetchApiVbu(data, field0, field1, field1Length, field1BufferSize, field2);
+}
+
+static uint16_t checkFormatVbuvbuvvuuuubu(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint16_t field0 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field1 = va_arg(*argumentList, const void *);
+  uint8_t field1Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field2 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field3 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field4 = va_arg(*argumentList, const void *);
+  uint8_t field4Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field5 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint16_t field6 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field7 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint8_t field8 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field9 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field10 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field11 = (uint8_t)va_arg(*argumentList, unsigned int);
+  const void *field12 = va_arg(*argumentList, const void *);
+  uint8_t field12Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field13 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatVbuvbuvvuuuubu(buffer, bufferSize, identifier, field0, field1, field1Length, field2, field3, field4, field4Length, field5, field6, field7, field8, field9, field10, field11, field12, field12Length, field13);
+}
+
+static void checkFetchApiVbuvbuvvuuuupu(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  uint8_t *field1Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field1BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  void *field4 = va_arg(*argumentList, void *);
+  uint8_t *field4Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field4BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field5 = va_arg(*argumentList, void *);
+  void *field6 = va_arg(*argumentList, void *);
+  void *field7 = va_arg(*argumentList, void *);
+  void *field8 = va_arg(*argumentList, void *);
+  void *field9 = va_arg(*argumentList, void *);
+  void *field10 = va_arg(*argumentList, void *);
+  void *field11 = va_arg(*argumentList, void *);
+  void *field12 = va_arg(*argumentList, void *);
+  uint8_t *field12Length = va_arg(*argumentList, uint8_t *);
+  void *field13 = va_arg(*argumentList, void *);
+  cspFetchApiVbuvbuvvuuuupu(data, field0, field1, field1Length, field1BufferSize, field2, field3, field4, field4Length, field4BufferSize, field5, field6, field7, field8, field9, field10, field11, field12, field12Length, field13);
+}
+
+static uint16_t checkFormatVu(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint16_t field0 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint8_t field1 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatVu(buffer, bufferSize, identifier, field0, field1);
+}
+
+static void checkFetchApiVu(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  cspFetchApiVu(data, field0, field1);
+}
+
+static uint16_t checkFormatVuuubu(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint16_t field0 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint8_t field1 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field2 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field3 = (uint8_t)va_arg(*argumentList, unsigned int);
+  const void *field4 = va_arg(*argumentList, const void *);
+  uint8_t field4Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field5 = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatVuuubu(buffer, bufferSize, identifier, field0, field1, field2, field3, field4, field4Length, field5);
+}
+
+static void checkFetchApiVuuupu(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  void *field3 = va_arg(*argumentList, void *);
+  void *field4 = va_arg(*argumentList, void *);
+  uint8_t *field4Length = va_arg(*argumentList, uint8_t *);
+  void *field5 = va_arg(*argumentList, void *);
+  cspFetchApiVuuupu(data, field0, field1, field2, field3, field4, field4Length, field5);
+}
+
+static uint16_t checkFormatVv(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint16_t field0 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  return cspFormatVv(buffer, bufferSize, identifier, field0, field1);
+}
+
+static void checkFetchApiVv(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  cspFetchApiVv(data, field0, field1);
+}
+
+static uint16_t checkFormatVvbuuuubub(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint16_t field0 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  const void *field2 = va_arg(*argumentList, const void *);
+  uint8_t field2Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field3 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field4 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field5 = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field6 = (uint8_t)va_arg(*argumentList, unsigned int);
+  const void *field7 = va_arg(*argumentList, const void *);
+  uint8_t field7Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  uint8_t field8 = (uint8_t)va_arg(*argumentList, unsigned int);
+  const void *field9 = va_arg(*argumentList, const void *);
+  uint8_t field9Length = (uint8_t)va_arg(*argumentList, unsigned int);
+  return cspFormatVvbuuuubub(buffer, bufferSize, identifier, field0, field1, field2, field2Length, field3, field4, field5, field6, field7, field7Length, field8, field9, field9Length);
+}
+
+static void checkFetchCallbackVvbuuuubub(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  uint8_t *field2Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field2BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field3 = va_arg(*argumentList, void *);
+  void *field4 = va_arg(*argumentList, void *);
+  void *field5 = va_arg(*argumentList, void *);
+  void *field6 = va_arg(*argumentList, void *);
+  void *field7 = va_arg(*argumentList, void *);
+  uint8_t *field7Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field7BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  void *field8 = va_arg(*argumentList, void *);
+  void *field9 = va_arg(*argumentList, void *);
+  uint8_t *field9Length = va_arg(*argumentList, uint8_t *);
+  uint8_t field9BufferSize = (uint8_t)va_arg(*argumentList, unsigned int);
+  cspFetchCallbackVvbuuuubub(data, field0, field1, field2, field2Length, field2BufferSize, field3, field4, field5, field6, field7, field7Length, field7BufferSize, field8, field9, field9Length, field9BufferSize);
+}
+
+static uint16_t checkFormatVvv(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint16_t field0 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field1 = (uint16_t)va_arg(*argumentList, unsigned int);
+  uint16_t field2 = (uint16_t)va_arg(*argumentList, unsigned int);
+  return cspFormatVvv(buffer, bufferSize, identifier, field0, field1, field2);
+}
+
+static void checkFetchApiVvv(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  void *field1 = va_arg(*argumentList, void *);
+  void *field2 = va_arg(*argumentList, void *);
+  cspFetchApiVvv(data, field0, field1, field2);
+}
+
+static uint16_t checkFormatW(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier, va_list *argumentList)
+{
+  uint32_t field0 = va_arg(*argumentList, uint32_t);
+  return cspFormatW(buffer, bufferSize, identifier, field0);
+}
+
+static void checkFetchApiW(uint8_t *data, va_list *argumentList)
+{
+  void *field0 = va_arg(*argumentList, void *);
+  cspFetchApiW(data, field0);
+}
+
+typedef struct {
+  const char *format;
+  // NULL if the layout is never formatted or fetched that way.
+  uint16_t (*pack)(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier,
+                   va_list *argumentList);
+  // Called with the command, command ID included.
+  void (*fetchApi)(uint8_t *data, va_list *argumentList);
+  // Called with the parameters following the command ID.
+  void (*fetchCallback)(uint8_t *data, va_list *argumentList);
+} CspCodecCheck;
+
+static const CspCodecCheck cspCodecChecks[] = {
+  { "", checkFormatEmpty, NULL, NULL },
+  { "b", checkFormatB, checkFetchApiB, NULL },
+  { "p", NULL, checkFetchApiP, NULL },
+  { "suuuvvuwv", checkFormatSuuuvvuwv, checkFetchApiSuuuvvuwv, NULL },
+  { "u", checkFormatU, checkFetchApiU, checkFetchCallbackU },
+  { "ub", checkFormatUb, checkFetchApiUb, NULL },
+  { "uu", checkFormatUu, checkFetchApiUu, NULL },
+  { "uuuu", checkFormatUuuu, checkFetchApiUuuu, NULL },
+  { "uuuv", checkFormatUuuv, NULL, checkFetchCallbackUuuv },
+  { "uuvbuvbuvvuuuwubuw", checkFormatUuvbuvbuvvuuuwubuw, NULL, checkFetchCallbackUuvbuvbuvvuuuwubuw },
+  { "uuvuuubuw", checkFormatUuvuuubuw, NULL, checkFetchCallbackUuvuuubuw },
+  { "uv", checkFormatUv, checkFetchApiUv, checkFetchCallbackUv },
+  { "uvbu", checkFormatUvbu, checkFetchApiUvbu, NULL },
+  { "uvbuu", checkFormatUvbuu, checkFetchApiUvbuu, NULL },
+  { "uvbuvbuvvuuuuwubw", checkFormatUvbuvbuvvuuuuwubw, NULL, checkFetchCallbackUvbuvbuvvuuuuwubw },
+  { "uvuuubwu", checkFormatUvuuubwu, NULL, checkFetchCallbackUvuuubwu },
+  { "uvvv", checkFormatUvvv, checkFetchApiUvvv, NULL },
+  { "uvvvv", checkFormatUvvvv, checkFetchApiUvvvv, NULL },
+  { "uw", checkFormatUw, checkFetchApiUw, NULL },
+  { "v", checkFormatV, checkFetchApiV, NULL },
+  { "vb", checkFormatVb, checkFetchApiVb, NULL },
+  { "vbu", checkFormatVbu, checkFetchApiVbu, NULL },
+  { "vbuvbuvvuuuubu", checkFormatVbuvbuvvuuuubu, NULL, NULL },
+  { "vbuvbuvvuuuupu", NULL, checkFetchApiVbuvbuvvuuuupu, NULL },
+  { "vu", checkFormatVu, checkFetchApiVu, NULL },
+  { "vuuubu", checkFormatVuuubu, NULL, NULL },
+  { "vuuupu", NULL, checkFetchApiVuuupu, NULL },
+  { "vv", checkFormatVv, checkFetchApiVv, NULL },
+  { "vvbuuuubub", checkFormatVvbuuuubub, NULL, checkFetchCallbackVvbuuuubub },
+  { "vvv", checkFormatVvv, checkFetchApiVvv, NULL },
+  { "w", checkFormatW, checkFetchApiW, NULL },
+};
+
+#endif // CSP_CODEC_GEN_CHECKS
@@ -0,0 +1,567 @@
+/***************************************************************************//**
+ * @brief Specialized serializers and deserializers of the CSP commands.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+// *** Generated file. Do not edit! ***
+// Generated by csp-codec-gen.py from the command code and csp-api-enum-gen.h.
+
+#ifndef __CSP_CODEC_GEN_H__
+#define __CSP_CODEC_GEN_H__
+
+// 31 layouts cover the command code of every command ID, except:
+//   EMBER_GET_CSP_VERSION_IPC_COMMAND_ID
+//   EMBER_GET_STANDALONE_BOOTLOADER_INFO_IPC_COMMAND_ID
+//   EMBER_LAUNCH_STANDALONE_BOOTLOADER_IPC_COMMAND_ID
+//   EMBER_GET_STANDALONE_BOOTLOADER_INFO_RETURN_IPC_COMMAND_ID
+//   EMBER_LAUNCH_STANDALONE_BOOTLOADER_RETURN_IPC_COMMAND_ID
+//   EMBER_ECHO_IPC_COMMAND_ID
+//   EMBER_ECHO_RETURN_IPC_COMMAND_ID
+//   EMBER_START_XON_XOFF_TEST_IPC_COMMAND_ID
+// which no command code formats or fetches in this build.
+
+// Each routine does what formatResponseCommand(), fetchApiParams() or
+// fetchCallbackParams() do with the format string its name ends with, and
+// takes the same arguments minus the format.
+
+//------------------------------------------------------------------------------
+// Formatting
+
+uint16_t cspFormatEmpty(uint8_t *buffer,
+                        uint16_t bufferSize,
+                        uint16_t identifier);
+
+uint16_t cspFormatB(uint8_t *buffer,
+                    uint16_t bufferSize,
+                    uint16_t identifier,
+                    const void *field0,
+                    uint8_t field0Length);
+
+uint16_t cspFormatSuuuvvuwv(uint8_t *buffer,
+                            uint16_t bufferSize,
+                            uint16_t identifier,
+                            int8_t field0,
+                            uint8_t field1,
+                            uint8_t field2,
+                            uint8_t field3,
+                            uint16_t field4,
+                            uint16_t field5,
+                            uint8_t field6,
+                            uint32_t field7,
+                            uint16_t field8);
+
+uint16_t cspFormatU(uint8_t *buffer,
+                    uint16_t bufferSize,
+                    uint16_t identifier,
+                    uint8_t field0);
+
+uint16_t cspFormatUb(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint8_t field0,
+                     const void *field1,
+                     uint8_t field1Length);
+
+uint16_t cspFormatUu(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint8_t field0,
+                     uint8_t field1);
+
+uint16_t cspFormatUuuu(uint8_t *buffer,
+                       uint16_t bufferSize,
+                       uint16_t identifier,
+                       uint8_t field0,
+                       uint8_t field1,
+                       uint8_t field2,
+                       uint8_t field3);
+
+uint16_t cspFormatUuuv(uint8_t *buffer,
+                       uint16_t bufferSize,
+                       uint16_t identifier,
+                       uint8_t field0,
+                       uint8_t field1,
+                       uint8_t field2,
+                       uint16_t field3);
+
+uint16_t cspFormatUuvbuvbuvvuuuwubuw(uint8_t *buffer,
+                                     uint16_t bufferSize,
+                                     uint16_t identifier,
+                                     uint8_t field0,
+                                     uint8_t field1,
+                                     uint16_t field2,
+                                     const void *field3,
+                                     uint8_t field3Length,
+                                     uint8_t field4,
+                                     uint16_t field5,
+                                     const void *field6,
+                                     uint8_t field6Length,
+                                     uint8_t field7,
+                                     uint16_t field8,
+                                     uint16_t field9,
+                                     uint8_t field10,
+                                     uint8_t field11,
+                                     uint8_t field12,
+                                     uint32_t field13,
+                                     uint8_t field14,
+                                     const void *field15,
+                                     uint8_t field15Length,
+                                     uint8_t field16,
+                                     uint32_t field17);
+
+uint16_t cspFormatUuvuuubuw(uint8_t *buffer,
+                            uint16_t bufferSize,
+                            uint16_t identifier,
+                            uint8_t field0,
+                            uint8_t field1,
+                            uint16_t field2,
+                            uint8_t field3,
+                            uint8_t field4,
+                            uint8_t field5,
+                            const void *field6,
+                            uint8_t field6Length,
+                            uint8_t field7,
+                            uint32_t field8);
+
+uint16_t cspFormatUv(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint8_t field0,
+                     uint16_t field1);
+
+uint16_t cspFormatUvbu(uint8_t *buffer,
+                       uint16_t bufferSize,
+                       uint16_t identifier,
+                       uint8_t field0,
+                       uint16_t field1,
+                       const void *field2,
+                       uint8_t field2Length,
+                       uint8_t field3);
+
+uint16_t cspFormatUvbuu(uint8_t *buffer,
+                        uint16_t bufferSize,
+                        uint16_t identifier,
+                        uint8_t field0,
+                        uint16_t field1,
+                        const void *field2,
+                        uint8_t field2Length,
+                        uint8_t field3,
+                        uint8_t field4);
+
+uint16_t cspFormatUvbuvbuvvuuuuwubw(uint8_t *buffer,
+                                    uint16_t bufferSize,
+                                    uint16_t identifier,
+                                    uint8_t field0,
+                                    uint16_t field1,
+                                    const void *field2,
+                                    uint8_t field2Length,
+                                    uint8_t field3,
+                                    uint16_t field4,
+                                    const void *field5,
+                                    uint8_t field5Length,
+                                    uint8_t field6,
+                                    uint16_t field7,
+                                    uint16_t field8,
+                                    uint8_t field9,
+                                    uint8_t field10,
+                                    uint8_t field11,
+                                    uint8_t field12,
+                                    uint32_t field13,
+                                    uint8_t field14,
+                                    const void *field15,
+                                    uint8_t field15Length,
+                                    uint32_t field16);
+
+uint16_t cspFormatUvuuubwu(uint8_t *buffer,
+                           uint16_t bufferSize,
+                           uint16_t identifier,
+                           uint8_t field0,
+                           uint16_t field1,
+                           uint8_t field2,
+                           uint8_t field3,
+                           uint8_t field4,
+                           const void *field5,
+                           uint8_t field5Length,
+                           uint32_t field6,
+                           uint8_t field7);
+
+uint16_t cspFormatUvvv(uint8_t *buffer,
+                       uint16_t bufferSize,
+                       uint16_t identifier,
+                       uint8_t field0,
+                       uint16_t field1,
+                       uint16_t field2,
+                       uint16_t field3);
+
+uint16_t cspFormatUvvvv(uint8_t *buffer,
+                        uint16_t bufferSize,
+                        uint16_t identifier,
+                        uint8_t field0,
+                        uint16_t field1,
+                        uint16_t field2,
+                        uint16_t field3,
+                        uint16_t field4);
+
+uint16_t cspFormatUw(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint8_t field0,
+                     uint32_t field1);
+
+uint16_t cspFormatV(uint8_t *buffer,
+                    uint16_t bufferSize,
+                    uint16_t identifier,
+                    uint16_t field0);
+
+uint16_t cspFormatVb(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint16_t field0,
+                     const void *field1,
+                     uint8_t field1Length);
+
+uint16_t cspFormatVbu(uint8_t *buffer,
+                      uint16_t bufferSize,
+                      uint16_t identifier,
+                      uint16_t field0,
+                      const void *field1,
+                      uint8_t field1Length,
+                      uint8_t field2);
+
+uint16_t cspFormatVbuvbuvvuuuubu(uint8_t *buffer,
+                                 uint16_t bufferSize,
+                                 uint16_t identifier,
+                                 uint16_t field0,
+                                 const void *field1,
+                                 uint8_t field1Length,
+                                 uint8_t field2,
+                                 uint16_t field3,
+                                 const void *field4,
+                                 uint8_t field4Length,
+                                 uint8_t field5,
+                                 uint16_t field6,
+                                 uint16_t field7,
+                                 uint8_t field8,
+                                 uint8_t field9,
+                                 uint8_t field10,
+                                 uint8_t field11,
+                                 const void *field12,
+                                 uint8_t field12Length,
+                                 uint8_t field13);
+
+uint16_t cspFormatVu(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint16_t field0,
+                     uint8_t field1);
+
+uint16_t cspFormatVuuubu(uint8_t *buffer,
+                         uint16_t bufferSize,
+                         uint16_t identifier,
+                         uint16_t field0,
+                         uint8_t field1,
+                         uint8_t field2,
+                         uint8_t field3,
+                         const void *field4,
+                         uint8_t field4Length,
+                         uint8_t field5);
+
+uint16_t cspFormatVv(uint8_t *buffer,
+                     uint16_t bufferSize,
+                     uint16_t identifier,
+                     uint16_t field0,
+                     uint16_t field1);
+
+uint16_t cspFormatVvbuuuubub(uint8_t *buffer,
+                             uint16_t bufferSize,
+                             uint16_t identifier,
+                             uint16_t field0,
+                             uint16_t field1,
+                             const void *field2,
+                             uint8_t field2Length,
+                             uint8_t field3,
+                             uint8_t field4,
+                             uint8_t field5,
+                             uint8_t field6,
+                             const void *field7,
+                             uint8_t field7Length,
+                             uint8_t field8,
+                             const void *field9,
+                             uint8_t field9Length);
+
+uint16_t cspFormatVvv(uint8_t *buffer,
+                      uint16_t bufferSize,
+                      uint16_t identifier,
+                      uint16_t field0,
+                      uint16_t field1,
+                      uint16_t field2);
+
+uint16_t cspFormatW(uint8_t *buffer,
+                    uint16_t bufferSize,
+                    uint16_t identifier,
+                    uint32_t field0);
+
+//------------------------------------------------------------------------------
+// Fetching API commands and responses
+
+void cspFetchApiB(uint8_t *apiCommandData,
+                  void *field0,
+                  uint8_t *field0Length,
+                  uint8_t field0BufferSize);
+
+void cspFetchApiP(uint8_t *apiCommandData,
+                  void *field0,
+                  uint8_t *field0Length);
+
+void cspFetchApiSuuuvvuwv(uint8_t *apiCommandData,
+                          void *field0,
+                          void *field1,
+                          void *field2,
+                          void *field3,
+                          void *field4,
+                          void *field5,
+                          void *field6,
+                          void *field7,
+                          void *field8);
+
+void cspFetchApiU(uint8_t *apiCommandData,
+                  void *field0);
+
+void cspFetchApiUb(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1,
+                   uint8_t *field1Length,
+                   uint8_t field1BufferSize);
+
+void cspFetchApiUu(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1);
+
+void cspFetchApiUuuu(uint8_t *apiCommandData,
+                     void *field0,
+                     void *field1,
+                     void *field2,
+                     void *field3);
+
+void cspFetchApiUv(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1);
+
+void cspFetchApiUvbu(uint8_t *apiCommandData,
+                     void *field0,
+                     void *field1,
+                     void *field2,
+                     uint8_t *field2Length,
+                     uint8_t field2BufferSize,
+                     void *field3);
+
+void cspFetchApiUvbuu(uint8_t *apiCommandData,
+                      void *field0,
+                      void *field1,
+                      void *field2,
+                      uint8_t *field2Length,
+                      uint8_t field2BufferSize,
+                      void *field3,
+                      void *field4);
+
+void cspFetchApiUvvv(uint8_t *apiCommandData,
+                     void *field0,
+                     void *field1,
+                     void *field2,
+                     void *field3);
+
+void cspFetchApiUvvvv(uint8_t *apiCommandData,
+                      void *field0,
+                      void *field1,
+                      void *field2,
+                      void *field3,
+                      void *field4);
+
+void cspFetchApiUw(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1);
+
+void cspFetchApiV(uint8_t *apiCommandData,
+                  void *field0);
+
+void cspFetchApiVb(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1,
+                   uint8_t *field1Length,
+                   uint8_t field1BufferSize);
+
+void cspFetchApiVbu(uint8_t *apiCommandData,
+                    void *field0,
+                    void *field1,
+                    uint8_t *field1Length,
+                    uint8_t field1BufferSize,
+                    void *field2);
+
+void cspFetchApiVbuvbuvvuuuupu(uint8_t *apiCommandData,
+                               void *field0,
+                               void *field1,
+                               uint8_t *field1Length,
+                               uint8_t field1BufferSize,
+                               void *field2,
+                               void *field3,
+                               void *field4,
+                               uint8_t *field4Length,
+                               uint8_t field4BufferSize,
+                               void *field5,
+                               void *field6,
+                               void *field7,
+                               void *field8,
+                               void *field9,
+                               void *field10,
+                               void *field11,
+                               void *field12,
+                               uint8_t *field12Length,
+                               void *field13);
+
+void cspFetchApiVu(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1);
+
+void cspFetchApiVuuupu(uint8_t *apiCommandData,
+                       void *field0,
+                       void *field1,
+                       void *field2,
+                       void *field3,
+                       void *field4,
+                       uint8_t *field4Length,
+                       void *field5);
+
+void cspFetchApiVv(uint8_t *apiCommandData,
+                   void *field0,
+                   void *field1);
+
+void cspFetchApiVvv(uint8_t *apiCommandData,
+                    void *field0,
+                    void *field1,
+                    void *field2);
+
+void cspFetchApiW(uint8_t *apiCommandData,
+                  void *field0);
+
+//------------------------------------------------------------------------------
+// Fetching callbacks
+
+void cspFetchCallbackU(uint8_t *callbackParams,
+                       void *field0);
+
+void cspFetchCallbackUuuv(uint8_t *callbackParams,
+                          void *field0,
+                          void *field1,
+                          void *field2,
+                          void *field3);
+
+void cspFetchCallbackUuvbuvbuvvuuuwubuw(uint8_t *callbackParams,
+                                        void *field0,
+                                        void *field1,
+                                        void *field2,
+                                        void *field3,
+                                        uint8_t *field3Length,
+                                        uint8_t field3BufferSize,
+                                        void *field4,
+                                        void *field5,
+                                        void *field6,
+                                        uint8_t *field6Length,
+                                        uint8_t field6BufferSize,
+                                        void *field7,
+                                        void *field8,
+                                        void *field9,
+                                        void *field10,
+                                        void *field11,
+                                        void *field12,
+                                        void *field13,
+                                        void *field14,
+                                        void *field15,
+                                        uint8_t *field15Length,
+                                        uint8_t field15BufferSize,
+                                        void *field16,
+                                        void *field17);
+
+void cspFetchCallbackUuvuuubuw(uint8_t *callbackParams,
+                               void *field0,
+                               void *field1,
+                               void *field2,
+                               void *field3,
+                               void *field4,
+                               void *field5,
+                               void *field6,
+                               uint8_t *field6Length,
+                               uint8_t field6BufferSize,
+                               void *field7,
+                               void *field8);
+
+void cspFetchCallbackUv(uint8_t *callbackParams,
+                        void *field0,
+                        void *field1);
+
+void cspFetchCallbackUvbuvbuvvuuuuwubw(uint8_t *callbackParams,
+                                       void *field0,
+                                       void *field1,
+                                       void *field2,
+                                       uint8_t *field2Length,
+                                       uint8_t field2BufferSize,
+                                       void *field3,
+                                       void *field4,
+                                       void *field5,
+                                       uint8_t *field5Length,
+                                       uint8_t field5BufferSize,
+                                       void *field6,
+                                       void *field7,
+                                       void *field8,
+                                       void *field9,
+                                       void *field10,
+                                       void *field11,
+                                       void *field12,
+                                       void *field13,
+                                       void *field14,
+                                       void *field15,
+                                       uint8_t *field15Length,
+                                       uint8_t field15BufferSize,
+                                       void *field16);
+
+void cspFetchCallbackUvuuubwu(uint8_t *callbackParams,
+                              void *field0,
+                              void *field1,
+                              void *field2,
+                              void *field3,
+                              void *field4,
+                              void *field5,
+                              uint8_t *field5Length,
+                              uint8_t field5BufferSize,
+                              void *field6,
+                              void *field7);
+
+void cspFetchCallbackVvbuuuubub(uint8_t *callbackParams,
+                                void *field0,
+                                void *field1,
+                                void *field2,
+                                uint8_t *field2Length,
+                                uint8_t field2BufferSize,
+                                void *field3,
+                                void *field4,
+                                void *field5,
+                                void *field6,
+                                void *field7,
+                                uint8_t *field7Length,
+                                uint8_t field7BufferSize,
+                                void *field8,
+                                void *field9,
+                                uint8_t *field9Length,
+                                uint8_t field9BufferSize);
+
+#endif // __CSP_CODEC_GEN_H__
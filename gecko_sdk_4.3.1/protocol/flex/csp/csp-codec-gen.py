@@ -0,0 +1,690 @@
+#!/usr/bin/env python3
+# Generates csp-codec-gen.c and csp-codec-gen.h, the specialized serializers
+# and deserializers of the CSP commands.
+#
+# Every IPC command and stack callback is (de)serialized by the command code
+# through formatResponseCommand(), fetchApiParams() and fetchCallbackParams(),
+# with a format string describing its layout. This script collects, for every
+# command ID of csp-api-enum-gen.h, the layouts its command code uses and emits
+# one typed routine per distinct layout and direction: straight-line stores
+# and loads at fixed offsets, taking the fields as parameters. Commands with
+# the same layout share their routine.
+#
+# The calls of the command code passing a literal format are then rewritten
+# into direct calls of those routines, with the same arguments minus the
+# format:
+#
+#   formatResponseCommand(buffer, size, id, "vu", a, b) -> cspFormatVu(buffer, size, id, a, b)
+#   fetchApiParams(data, "vu", &a, &b)                  -> cspFetchApiVu(data, &a, &b)
+#   fetchCallbackParams(params, "vu", &a, &b)           -> cspFetchCallbackVu(params, &a, &b)
+#
+# so that nothing looks the format up or walks it at run time. The routine
+# names carry the layout, which is how the rewritten calls are found again on
+# the next run. Calls with a format only known at run time are left alone and
+# go through the interpreter of csp-format.c.
+#
+# The getters of csp-command-app.c listed in STACK_STATE_GETTERS are also
+# given a prologue answering them from the stack state snapshot of
+# csp-stack-state.h, before they claim a command slot. Tasks calling them are
+# then never held up by the other tasks using the slots.
+#
+# Run it again whenever the command code changes, in particular after the
+# command code was regenerated:
+#
+#   python3 csp-codec-gen.py [--check]
+#
+# --check only verifies that the generated files and the command code are up
+# to date.
+
+import argparse
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+ENUM_HEADER = 'csp-api-enum-gen.h'
+# Files calling the formatting functions. The generated command code comes
+# first, the hand written users follow.
+COMMAND_SOURCES = [
+  'csp-command-app.c',
+  'csp-command-vncp.c',
+  'csp-command-callbacks.c',
+  'csp-command-async.c',
+  'csp-stack-state.c',
+  '../cmsis-stack-ipc/cmsis-rtos-ipc-common.c',
+]
+APP_SOURCE = 'csp-command-app.c'
+OUTPUT_SOURCE = 'csp-codec-gen.c'
+OUTPUT_HEADER = 'csp-codec-gen.h'
+
+# The interpreted calls, the position of their format argument and the prefix
+# of the routines replacing them.
+CALLS = {
+  'formatResponseCommand': (3, 'cspFormat'),
+  'fetchApiParams': (1, 'cspFetchApi'),
+  'fetchCallbackParams': (1, 'cspFetchCallback'),
+}
+PACK_CALL = 'formatResponseCommand'
+FETCH_CALLS = ('fetchApiParams', 'fetchCallbackParams')
+
+# Getters answered from the stack state snapshot: the CMSIS_RTOS_STACK_STATE_
+# bit selecting each of them and its CspStackState field.
+STACK_STATE_GETTERS = {
+  'emberNetworkState': ('CMSIS_RTOS_STACK_STATE_NETWORK_STATE', 'networkState'),
+  'emberStackIsUp': ('CMSIS_RTOS_STACK_STATE_STACK_IS_UP', 'stackIsUp'),
+  'emberGetRadioChannel': ('CMSIS_RTOS_STACK_STATE_RADIO_CHANNEL', 'radioChannel'),
+  'emberGetRadioPower': ('CMSIS_RTOS_STACK_STATE_RADIO_POWER', 'radioPower'),
+  'emberGetNodeId': ('CMSIS_RTOS_STACK_STATE_NODE_ID', 'nodeId'),
+  'emberGetPanId': ('CMSIS_RTOS_STACK_STATE_PAN_ID', 'panId'),
+  'emberGetNodeType': ('CMSIS_RTOS_STACK_STATE_NODE_TYPE', 'nodeType'),
+}
+STACK_STATE_HEADER = '#include "csp-stack-state.h"\n'
+
+# Fixed size of each format character on the wire, None for the variable
+# length ones (a length byte followed by that many bytes).
+FIELD_SIZES = {'u': 1, 's': 1, 'v': 2, 'w': 4, 'b': None, 'p': None}
+
+# Parameter type of each format character when formatting.
+PACK_TYPES = {'u': 'uint8_t', 's': 'int8_t', 'v': 'uint16_t', 'w': 'uint32_t'}
+
+LICENSE = """\
+/***************************************************************************//**
+ * @brief {brief}
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+// *** Generated file. Do not edit! ***
+// Generated by csp-codec-gen.py from the command code and {enum}.
+"""
+
+
+class Layout:
+  def __init__(self, fmt):
+    self.format = fmt
+    self.users = dict((call, set()) for call in CALLS)
+
+  @property
+  def name(self):
+    return self.format.capitalize() if self.format else 'Empty'
+
+  def routine(self, call):
+    return CALLS[call][1] + self.name
+
+
+def layout_of(name):
+  return '' if name == 'Empty' else name.lower()
+
+
+def read(name):
+  with open(os.path.join(HERE, name), newline='') as f:
+    return f.read()
+
+
+def parse_command_ids(text):
+  return re.findall(r'^\s*(\w+_IPC_COMMAND_ID)\s*=', text, re.M)
+
+
+def split_functions(text):
+  """Yields (name, body) for every top level function definition."""
+  pattern = re.compile(r'^[A-Za-z][\w \*]*?\b(\w+)\s*\([^;{]*?\)\s*\n\{\n(.*?)^\}',
+                       re.M | re.S)
+  for match in pattern.finditer(text):
+    yield match.group(1), match.group(2)
+
+
+#------------------------------------------------------------------------------
+# Rewriting the command code
+
+def split_arguments(text, start):
+  """Splits the arguments of the call whose opening parenthesis is at start.
+  Returns the stripped (begin, end) spans of the arguments and the position
+  of the closing parenthesis, or None if the call does not close."""
+  spans = []
+  depth = 0
+  begin = start + 1
+  position = start + 1
+  while position < len(text):
+    c = text[position]
+    if c in '"\'':
+      position += 1
+      while text[position] != c:
+        position += 2 if text[position] == '\\' else 1
+    elif c in '([{':
+      depth += 1
+    elif c in ')]}' and depth > 0:
+      depth -= 1
+    elif c == ')' or (c == ',' and depth == 0):
+      argument = text[begin:position]
+      if argument.strip():
+        left = begin + len(argument) - len(argument.lstrip())
+        spans.append((left, begin + len(argument.rstrip())))
+      if c == ')':
+        return spans, position
+      begin = position + 1
+    position += 1
+  return None
+
+
+def column(text, position):
+  return position - (text.rfind('\n', 0, position) + 1)
+
+
+def rewrite_calls(text, layout):
+  """Replaces the interpreted calls passing a literal format by calls of the
+  generated routines, keeping the continuation lines aligned."""
+  out = []
+  done = 0
+  pattern = re.compile(r'\b(%s)(\s*)\(' % '|'.join(CALLS))
+  for match in pattern.finditer(text):
+    call = match.group(1)
+    parsed = split_arguments(text, match.end() - 1)
+    if parsed is None:
+      continue
+    spans, close = parsed
+    index = CALLS[call][0]
+    if len(spans) <= index:
+      continue
+    literal = text[spans[index][0]:spans[index][1]]
+    if not re.match(r'^"[a-z]*"$', literal):
+      continue
+    routine = layout(literal[1:-1]).routine(call)
+    # Drop the format, from the end of the argument before it.
+    call_text = (text[match.end():spans[index - 1][1]]
+                 + text[spans[index][1]:close + 1])
+    shift = len(routine) - len(call)
+    indent = column(text, match.start()) + len(call) + len(match.group(2)) + 1
+    lines = call_text.split('\n')
+    for i in range(1, len(lines)):
+      spaces = len(lines[i]) - len(lines[i].lstrip(' '))
+      if spaces >= indent:
+        lines[i] = ' ' * (spaces + shift) + lines[i].lstrip(' ')
+    out.append(text[done:match.start()])
+    out.append(routine + match.group(2) + '(' + '\n'.join(lines))
+    done = close + 1
+  out.append(text[done:])
+  return ''.join(out)
+
+
+STACK_STATE_PROLOGUE = """\
+  CspStackState state;
+  if (cspGetStackState(%s, &state)) {
+    return state.%s;
+  }
+"""
+
+
+def add_stack_state_getters(text):
+  """Gives the getters of STACK_STATE_GETTERS their snapshot prologue, ahead
+  of acquireCommandMutex(). Prologues of getters no longer listed are
+  removed."""
+  prologue = re.compile(r'^  CspStackState state;\n  if \(cspGetStackState\(\w+, &state\)\) \{\n'
+                        r'    return state\.\w+;\n  \}\n', re.M)
+  text = prologue.sub('', text)
+  for name, (getter, field) in STACK_STATE_GETTERS.items():
+    pattern = re.compile(r'^(\w[\w \*]*\b%s\(void\)\n\{\n)(  acquireCommandMutex\(\);)' % name,
+                         re.M)
+    text, count = pattern.subn(lambda m: m.group(1) + STACK_STATE_PROLOGUE % (getter, field)
+                               + m.group(2), text)
+    if count != 1:
+      sys.exit('getter %s() not found in %s' % (name, APP_SOURCE))
+  if STACK_STATE_HEADER not in text:
+    text = text.replace('#include "csp-api-enum-gen.h"\n',
+                        '#include "csp-api-enum-gen.h"\n' + STACK_STATE_HEADER, 1)
+  return text
+
+
+#------------------------------------------------------------------------------
+# Collecting the layouts
+
+def collect_layouts(ids):
+  layouts = {}
+  used_ids = set()
+  known = set(ids)
+  sources = {}
+
+  def layout(fmt):
+    if fmt not in layouts:
+      bad = set(fmt) - set(FIELD_SIZES)
+      if bad:
+        sys.exit('unknown format character(s) %s in "%s"' % (''.join(bad), fmt))
+      layouts[fmt] = Layout(fmt)
+    return layouts[fmt]
+
+  routines = dict((prefix, call) for call, (_, prefix) in CALLS.items())
+  routine_pattern = re.compile(r'\b(%s)(Empty|[A-Z][a-z]*)\s*\('
+                               % '|'.join(sorted(routines, key=len, reverse=True)))
+
+  for source in COMMAND_SOURCES:
+    text = rewrite_calls(read(source), layout)
+    if source == APP_SOURCE:
+      text = add_stack_state_getters(text)
+    sources[source] = text
+    # Stack side command handlers and app side callback handlers are found
+    # through their dispatcher.
+    dispatched = dict((handler, command_id) for command_id, handler in
+                      re.findall(r'case (\w+_IPC_COMMAND_ID):\s*(\w+)\(', text))
+    for name, body in split_functions(text):
+      if name in dispatched:
+        command_ids = [dispatched[name]]
+      else:
+        command_ids = [i for i in re.findall(r'\b\w+_IPC_COMMAND_ID\b', body)
+                       if i in known]
+      for prefix, suffix in routine_pattern.findall(body):
+        users = layout(layout_of(suffix)).users[routines[prefix]]
+        if not command_ids:
+          users.add(name + '()')
+        for command_id in command_ids:
+          users.add(command_id)
+          used_ids.add(command_id)
+
+  for fmt, entry in layouts.items():
+    if 'p' in fmt and entry.users[PACK_CALL]:
+      sys.exit('"%s" can not be formatted, "p" is only valid when fetching' % fmt)
+
+  return ([layouts[f] for f in sorted(layouts)],
+          [i for i in ids if i not in used_ids],
+          sources)
+
+
+#------------------------------------------------------------------------------
+# Emitting the routines
+
+def users_comment(users):
+  lines = []
+  for user in sorted(users):
+    lines.append('//   %s' % user)
+  return lines
+
+
+def offset(base, value):
+  return base if value == 0 else '%s + %d' % (base, value)
+
+
+def parameters(entry, fetching):
+  """The (type, name) of the parameters taking the fields of a layout."""
+  out = []
+  for index, c in enumerate(entry.format):
+    field = 'field%d' % index
+    if not fetching:
+      if c == 'b':
+        out.append(('const void *', field))
+        out.append(('uint8_t', field + 'Length'))
+      else:
+        out.append((PACK_TYPES[c], field))
+    else:
+      # The outputs keep the loose typing of the argument list, the command
+      # code passes the addresses of enums and typedefs of all kinds.
+      out.append(('void *', field))
+      if c in 'bp':
+        out.append(('uint8_t *', field + 'Length'))
+      if c == 'b':
+        out.append(('uint8_t', field + 'BufferSize'))
+  return out
+
+
+def declare(kind, name):
+  return kind + name if kind.endswith('*') else '%s %s' % (kind, name)
+
+
+def signature(result, name, first, fields, declaration):
+  head = '%s %s(' % (result, name)
+  items = first + [declare(kind, field) for kind, field in fields]
+  separator = ',\n' + ' ' * len(head)
+  return head + separator.join(items) + (');' if declaration else ')')
+
+
+def pack_signature(entry, declaration=False):
+  return signature('uint16_t', entry.routine(PACK_CALL),
+                   ['uint8_t *buffer', 'uint16_t bufferSize', 'uint16_t identifier'],
+                   parameters(entry, False), declaration)
+
+
+def fetch_signature(entry, call, declaration=False):
+  first = 'uint8_t *apiCommandData' if call == 'fetchApiParams' else 'uint8_t *callbackParams'
+  return signature('void', entry.routine(call), [first],
+                   parameters(entry, True), declaration)
+
+
+def emit_pack(entry):
+  out = ['// "%s", formatted by:' % entry.format]
+  out += users_comment(entry.users[PACK_CALL])
+  out.append(pack_signature(entry))
+  out.append('{')
+  out.append('  uint8_t *finger = buffer + sizeof(uint16_t);')
+  out.append('  uint16_t length;')
+  out.append('')
+  out.append('  packInt16u(buffer, identifier);')
+  position = 0
+  for index, c in enumerate(entry.format):
+    size = FIELD_SIZES[c]
+    field = 'field%d' % index
+    if c == 'u':
+      out.append('  packInt8u(%s, %s);' % (offset('finger', position), field))
+    elif c == 's':
+      out.append('  packInt8(%s, %s);' % (offset('finger', position), field))
+    elif c == 'v':
+      out.append('  packInt16u(%s, %s);' % (offset('finger', position), field))
+    elif c == 'w':
+      out.append('  packInt32u(%s, %s);' % (offset('finger', position), field))
+    elif c == 'b':
+      out.append('  finger = packBlock(%s, %s, %sLength);'
+                 % (offset('finger', position), field, field))
+      position = 0
+    if size is not None:
+      position += size
+  out.append('  length = (uint16_t)(%s - buffer);' % offset('finger', position))
+  out.append('  // sanity check')
+  out.append('  assert(length <= bufferSize);')
+  out.append('  return length;')
+  out.append('}')
+  return out
+
+
+def emit_fetch(entry, call):
+  out = ['// "%s", fetched by:' % entry.format]
+  out += users_comment(entry.users[call])
+  out.append(fetch_signature(entry, call))
+  out.append('{')
+  if call == 'fetchApiParams':
+    out.append('  // Start fetching right after the command ID')
+    out.append('  uint8_t *readPointer = apiCommandData + 2;')
+  else:
+    out.append('  uint8_t *readPointer = callbackParams;')
+  if entry.format:
+    out.append('')
+  else:
+    out.append('  (void)readPointer;')
+  position = 0
+  for index, c in enumerate(entry.format):
+    size = FIELD_SIZES[c]
+    field = 'field%d' % index
+    last = index == len(entry.format) - 1
+    if c in 'us':
+      out.append('  fetchInt8u(%s, %s);' % (offset('readPointer', position), field))
+    elif c == 'v':
+      out.append('  fetchInt16u(%s, %s);' % (offset('readPointer', position), field))
+    elif c == 'w':
+      out.append('  fetchInt32u(%s, %s);' % (offset('readPointer', position), field))
+    else:
+      if c == 'b':
+        helper = 'fetchBlock(%s, %s, %sLength, %sBufferSize)' % (
+          offset('readPointer', position), field, field, field)
+      else:
+        helper = 'fetchPointer(%s, %s, %sLength)' % (
+          offset('readPointer', position), field, field)
+      out.append(('  %s;' if last else '  readPointer = %s;') % helper)
+      position = 0
+    if size is not None:
+      position += size
+  out.append('}')
+  return out
+
+
+def adapter(entry, call):
+  return 'check' + entry.routine(call)[len('csp'):]
+
+
+def emit_check_adapters(entry):
+  """Argument list adapters of the routines of a layout, so that the host
+  checks can drive them with the arguments they pass the interpreter."""
+  out = []
+  for call in CALLS:
+    if not entry.users[call]:
+      continue
+    fields = parameters(entry, call in FETCH_CALLS)
+    if call == PACK_CALL:
+      out.append('static uint16_t %s(uint8_t *buffer, uint16_t bufferSize, '
+                 'uint16_t identifier, va_list *argumentList)' % adapter(entry, call))
+    else:
+      out.append('static void %s(uint8_t *data, va_list *argumentList)'
+                 % adapter(entry, call))
+    out.append('{')
+    for kind, name in fields:
+      # What the interpreter reads the argument as.
+      promoted = {'uint8_t': 'unsigned int', 'uint16_t': 'unsigned int',
+                  'int8_t': 'int'}.get(kind, kind)
+      if promoted == kind:
+        out.append('  %s = va_arg(*argumentList, %s);' % (declare(kind, name), kind))
+      else:
+        out.append('  %s = (%s)va_arg(*argumentList, %s);'
+                   % (declare(kind, name), kind, promoted))
+    if not fields:
+      out.append('  (void)argumentList;')
+    names = [name for _, name in fields]
+    if call == PACK_CALL:
+      out.append('  return %s(%s);' % (entry.routine(call), ', '.join(
+        ['buffer', 'bufferSize', 'identifier'] + names)))
+    else:
+      out.append('  %s(%s);' % (entry.routine(call), ', '.join(['data'] + names)))
+    out.append('}')
+    out.append('')
+  return out
+
+
+HELPERS = """\
+//------------------------------------------------------------------------------
+// Field helpers, matching formatResponseCommandFromArgList() and fetchParams()
+// in csp-format.c character for character.
+
+static inline void packInt8u(uint8_t *finger, uint8_t value)
+{
+  finger[0] = value;
+}
+
+static inline void packInt8(uint8_t *finger, int8_t value)
+{
+  finger[0] = (uint8_t)value;
+}
+
+static inline void packInt16u(uint8_t *finger, uint16_t value)
+{
+  finger[0] = HIGH_BYTE(value);
+  finger[1] = LOW_BYTE(value);
+}
+
+static inline void packInt32u(uint8_t *finger, uint32_t value)
+{
+  finger[0] = (uint8_t)(value >> 24);
+  finger[1] = (uint8_t)(value >> 16);
+  finger[2] = (uint8_t)(value >> 8);
+  finger[3] = (uint8_t)value;
+}
+
+static uint8_t *packBlock(uint8_t *finger, const void *data, uint8_t dataSize)
+{
+  *finger++ = dataSize;
+  if (dataSize > 0) {
+    // A NULL block is sent as zeroes.
+    if (data != NULL) {
+      MEMCOPY(finger, data, dataSize);
+    } else {
+      MEMSET(finger, 0, dataSize);
+    }
+  }
+  return finger + dataSize;
+}
+
+static inline void fetchInt8u(const uint8_t *readPointer, void *realPointer)
+{
+  if (realPointer != NULL) {
+    *(uint8_t *)realPointer = readPointer[0];
+  }
+}
+
+static inline void fetchInt16u(const uint8_t *readPointer, void *realPointer)
+{
+  *(uint16_t *)realPointer = HIGH_LOW_TO_INT(readPointer[0], readPointer[1]);
+}
+
+static inline void fetchInt32u(const uint8_t *readPointer, void *realPointer)
+{
+  if (realPointer != NULL) {
+    *(uint32_t *)realPointer = (((uint32_t)readPointer[0] << 24)
+                                | ((uint32_t)readPointer[1] << 16)
+                                | ((uint32_t)readPointer[2] << 8)
+                                | readPointer[3]);
+  }
+}
+
+static uint8_t *fetchBlock(uint8_t *readPointer,
+                           void *realArray,
+                           uint8_t *lengthPointer,
+                           uint8_t bufferSize)
+{
+  uint8_t length = *readPointer++;
+
+  if (realArray != NULL) {
+    MEMMOVE(realArray, readPointer, (length <= bufferSize) ? length : bufferSize);
+  }
+  // Report the length actually copied, the read pointer skips the whole block.
+  *lengthPointer = (length <= bufferSize) ? length : bufferSize;
+  return readPointer + length;
+}
+
+static uint8_t *fetchPointer(uint8_t *readPointer,
+                             void *realPointer,
+                             uint8_t *lengthPointer)
+{
+  uint8_t length = *readPointer++;
+
+  *lengthPointer = length;
+  if (realPointer != NULL) {
+    *(uint8_t **)realPointer = readPointer;
+  }
+  return readPointer + length;
+}
+"""
+
+
+def generate_source(layouts):
+  out = [LICENSE.format(brief='Specialized serializers and deserializers of the CSP commands.',
+                        enum=ENUM_HEADER)]
+  out.append('#include PLATFORM_HEADER')
+  out.append('')
+  out.append('#include "stack/include/ember.h"')
+  out.append('')
+  out.append('#include "csp-codec-gen.h"')
+  out.append('')
+  out.append(HELPERS)
+  out.append('//------------------------------------------------------------------------------')
+  out.append('// Layouts')
+  out.append('')
+  for entry in layouts:
+    if entry.users[PACK_CALL]:
+      out += emit_pack(entry)
+      out.append('')
+    for call in FETCH_CALLS:
+      if entry.users[call]:
+        out += emit_fetch(entry, call)
+        out.append('')
+
+  out.append('//------------------------------------------------------------------------------')
+  out.append('// Argument list adapters, only built into the host checks comparing every')
+  out.append('// routine with the format string interpreter.')
+  out.append('')
+  out.append('#ifdef CSP_CODEC_GEN_CHECKS')
+  out.append('')
+  out.append('#include <stdarg.h>')
+  out.append('')
+  for entry in layouts:
+    out += emit_check_adapters(entry)
+  out.append('typedef struct {')
+  out.append('  const char *format;')
+  out.append('  // NULL if the layout is never formatted or fetched that way.')
+  out.append('  uint16_t (*pack)(uint8_t *buffer, uint16_t bufferSize, uint16_t identifier,')
+  out.append('                   va_list *argumentList);')
+  out.append('  // Called with the command, command ID included.')
+  out.append('  void (*fetchApi)(uint8_t *data, va_list *argumentList);')
+  out.append('  // Called with the parameters following the command ID.')
+  out.append('  void (*fetchCallback)(uint8_t *data, va_list *argumentList);')
+  out.append('} CspCodecCheck;')
+  out.append('')
+  out.append('static const CspCodecCheck cspCodecChecks[] = {')
+  for entry in layouts:
+    row = ['"%s"' % entry.format]
+    for call in CALLS:
+      row.append(adapter(entry, call) if entry.users[call] else 'NULL')
+    out.append('  { %s },' % ', '.join(row))
+  out.append('};')
+  out.append('')
+  out.append('#endif // CSP_CODEC_GEN_CHECKS')
+  return '\n'.join(out) + '\n'
+
+
+def generate_header(layouts, unused_ids):
+  out = [LICENSE.format(brief='Specialized serializers and deserializers of the CSP commands.',
+                        enum=ENUM_HEADER)]
+  out.append('#ifndef __CSP_CODEC_GEN_H__')
+  out.append('#define __CSP_CODEC_GEN_H__')
+  out.append('')
+  out.append('// %d layouts cover the command code of every command ID, except:'
+             % len(layouts))
+  if unused_ids:
+    for command_id in unused_ids:
+      out.append('//   %s' % command_id)
+    out.append('// which no command code formats or fetches in this build.')
+  else:
+    out.append('//   (none)')
+  out.append("""
+// Each routine does what formatResponseCommand(), fetchApiParams() or
+// fetchCallbackParams() do with the format string its name ends with, and
+// takes the same arguments minus the format.""")
+  sections = [(PACK_CALL, 'Formatting', pack_signature)]
+  sections += [(call, title, lambda entry, declaration, call=call:
+                fetch_signature(entry, call, declaration))
+               for call, title in (('fetchApiParams', 'Fetching API commands and responses'),
+                                   ('fetchCallbackParams', 'Fetching callbacks'))]
+  for call, title, emit in sections:
+    out.append('')
+    out.append('//------------------------------------------------------------------------------')
+    out.append('// %s' % title)
+    for entry in layouts:
+      if entry.users[call]:
+        out.append('')
+        out.append(emit(entry, True))
+  out.append('')
+  out.append('#endif // __CSP_CODEC_GEN_H__')
+  return '\n'.join(out) + '\n'
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('--check', action='store_true',
+                      help='fail if the generated files or the command code are '
+                           'not up to date')
+  args = parser.parse_args()
+
+  ids = parse_command_ids(read(ENUM_HEADER))
+  layouts, unused_ids, sources = collect_layouts(ids)
+
+  outputs = dict(sources)
+  outputs[OUTPUT_SOURCE] = generate_source(layouts)
+  outputs[OUTPUT_HEADER] = generate_header(layouts, unused_ids)
+  stale = []
+  for name, content in outputs.items():
+    path = os.path.join(HERE, name)
+    current = read(name) if os.path.exists(path) else None
+    if current != content:
+      stale.append(name)
+      if not args.check:
+        with open(path, 'w', newline='') as f:
+          f.write(content)
+
+  if args.check and stale:
+    sys.exit('out of date: %s' % ', '.join(stale))
+
+
+if __name__ == '__main__':
+  main()
@@ -25,22 +25,25 @@
 #include "csp-format.h"
 #include "csp-command-utils.h"
 #include "csp-api-enum-gen.h"
+#include "csp-stack-state.h"
 
 // networkState
 EmberNetworkStatus emberNetworkState(void)
 {
+  CspStackState state;
+  if (cspGetStackState(CMSIS_RTOS_STACK_STATE_NETWORK_STATE, &state)) {
+    return state.networkState;
+  }
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_NETWORK_STATE_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_NETWORK_STATE_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberNetworkStatus networkStatus;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &networkStatus);
+  cspFetchApiU(apiCommandData,
+               &networkStatus);
   releaseCommandMutex();
   return networkStatus;
 }
@@ -48,18 +51,20 @@ EmberNetworkStatus emberNetworkState(void)
 // stackIsUp
 bool emberStackIsUp(void)
 {
+  CspStackState state;
+  if (cspGetStackState(CMSIS_RTOS_STACK_STATE_STACK_IS_UP, &state)) {
+    return state.stackIsUp;
+  }
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_STACK_IS_UP_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_STACK_IS_UP_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   bool stackIsUp;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &stackIsUp);
+  cspFetchApiU(apiCommandData,
+               &stackIsUp);
   releaseCommandMutex();
   return stackIsUp;
 }
@@ -69,18 +74,16 @@ EmberStatus emberSetSecurityKey(EmberKeyData *key)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_SECURITY_KEY_IPC_COMMAND_ID,
-                        "b",
-                        key,
-                        EMBER_ENCRYPTION_KEY_SIZE);
+  cspFormatB(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_SET_SECURITY_KEY_IPC_COMMAND_ID,
+             key,
+             EMBER_ENCRYPTION_KEY_SIZE);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -90,23 +93,21 @@ EmberStatus emberGetSecurityKey(EmberKeyData *key)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_SECURITY_KEY_IPC_COMMAND_ID,
-                        "b",
-                        key->contents,
-                        EMBER_ENCRYPTION_KEY_SIZE);
+  cspFormatB(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_GET_SECURITY_KEY_IPC_COMMAND_ID,
+             key->contents,
+             EMBER_ENCRYPTION_KEY_SIZE);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
 
   uint8_t Size = EMBER_ENCRYPTION_KEY_SIZE;
-  fetchApiParams(apiCommandData,
-                 "ub",
-                 &status,
-                 key->contents,
-                 &Size,
-                 EMBER_ENCRYPTION_KEY_SIZE);
+  cspFetchApiUb(apiCommandData,
+                &status,
+                key->contents,
+                &Size,
+                EMBER_ENCRYPTION_KEY_SIZE);
   releaseCommandMutex();
   return status;
 }
@@ -117,17 +118,15 @@ EmberStatus emberSetPsaSecurityKey(mbedtls_svc_key_id_t key_id)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_PSA_SECURITY_KEY_IPC_COMMAND_ID,
-                        "w",
-                        key_id);
+  cspFormatW(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_SET_PSA_SECURITY_KEY_IPC_COMMAND_ID,
+             key_id);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -140,16 +139,14 @@ EmberStatus emberRemovePsaSecurityKey(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_REMOVE_PSA_SECURITY_KEY_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_REMOVE_PSA_SECURITY_KEY_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -163,18 +160,16 @@ EmberStatus emberSetNcpSecurityKey(uint8_t *key,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_NCP_SECURITY_KEY_IPC_COMMAND_ID,
-                        "b",
-                        key,
-                        keyLength);
+  cspFormatB(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_SET_NCP_SECURITY_KEY_IPC_COMMAND_ID,
+             key,
+             keyLength);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -187,16 +182,14 @@ mbedtls_svc_key_id_t emberGetKeyId(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_KEY_ID_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_KEY_ID_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   mbedtls_svc_key_id_t key_id;
-  fetchApiParams(apiCommandData,
-                 "w",
-                 &key_id);
+  cspFetchApiW(apiCommandData,
+               &key_id);
   releaseCommandMutex();
   return key_id;
 }
@@ -209,19 +202,17 @@ EmberStatus emberGetCounter(EmberCounterType counterType,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_COUNTER_IPC_COMMAND_ID,
-                        "u",
-                        counterType);
+  cspFormatU(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_GET_COUNTER_IPC_COMMAND_ID,
+             counterType);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
 
-  fetchApiParams(apiCommandData,
-                 "uw",
-                 &status,
-                 count);
+  cspFetchApiUw(apiCommandData,
+                &status,
+                count);
   releaseCommandMutex();
   return status;
 }
@@ -232,18 +223,16 @@ EmberStatus emberSetRadioChannelExtended(uint16_t channel,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_RADIO_CHANNEL_EXTENDED_IPC_COMMAND_ID,
-                        "vu",
-                        channel,
-                        persistent);
+  cspFormatVu(apiCommandBuffer,
+              MAX_STACK_API_COMMAND_SIZE,
+              EMBER_SET_RADIO_CHANNEL_EXTENDED_IPC_COMMAND_ID,
+              channel,
+              persistent);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -253,17 +242,15 @@ EmberStatus emberSetRadioChannel(uint16_t channel)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_RADIO_CHANNEL_IPC_COMMAND_ID,
-                        "v",
-                        channel);
+  cspFormatV(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_SET_RADIO_CHANNEL_IPC_COMMAND_ID,
+             channel);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -271,18 +258,20 @@ EmberStatus emberSetRadioChannel(uint16_t channel)
 // getRadioChannel
 uint16_t emberGetRadioChannel(void)
 {
+  CspStackState state;
+  if (cspGetStackState(CMSIS_RTOS_STACK_STATE_RADIO_CHANNEL, &state)) {
+    return state.radioChannel;
+  }
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_RADIO_CHANNEL_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_RADIO_CHANNEL_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   uint16_t channel;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &channel);
+  cspFetchApiV(apiCommandData,
+               &channel);
   releaseCommandMutex();
   return channel;
 }
@@ -293,18 +282,16 @@ EmberStatus emberSetRadioPower(int16_t power,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_RADIO_POWER_IPC_COMMAND_ID,
-                        "vu",
-                        power,
-                        persistent);
+  cspFormatVu(apiCommandBuffer,
+              MAX_STACK_API_COMMAND_SIZE,
+              EMBER_SET_RADIO_POWER_IPC_COMMAND_ID,
+              power,
+              persistent);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -312,18 +299,20 @@ EmberStatus emberSetRadioPower(int16_t power,
 // getRadioPower
 int16_t emberGetRadioPower(void)
 {
+  CspStackState state;
+  if (cspGetStackState(CMSIS_RTOS_STACK_STATE_RADIO_POWER, &state)) {
+    return state.radioPower;
+  }
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_RADIO_POWER_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_RADIO_POWER_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   int16_t power;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &power);
+  cspFetchApiV(apiCommandData,
+               &power);
   releaseCommandMutex();
   return power;
 }
@@ -333,17 +322,15 @@ EmberStatus emberSetRadioPowerMode(bool radioOn)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_RADIO_POWER_MODE_IPC_COMMAND_ID,
-                        "u",
-                        radioOn);
+  cspFormatU(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_SET_RADIO_POWER_MODE_IPC_COMMAND_ID,
+             radioOn);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -361,25 +348,23 @@ EmberStatus emberSetMacParams(int8_t ccaThreshold,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_MAC_PARAMS_IPC_COMMAND_ID,
-                        "suuuvvuwv",
-                        ccaThreshold,
-                        maxCcaAttempts,
-                        minBackoffExp,
-                        maxBackoffExp,
-                        ccaBackoff,
-                        ccaDuration,
-                        maxRetries,
-                        csmaTimeout,
-                        ackTimeout);
+  cspFormatSuuuvvuwv(apiCommandBuffer,
+                     MAX_STACK_API_COMMAND_SIZE,
+                     EMBER_SET_MAC_PARAMS_IPC_COMMAND_ID,
+                     ccaThreshold,
+                     maxCcaAttempts,
+                     minBackoffExp,
+                     maxBackoffExp,
+                     ccaBackoff,
+                     ccaDuration,
+                     maxRetries,
+                     csmaTimeout,
+                     ackTimeout);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -389,16 +374,14 @@ uint16_t emberCurrentStackTasks(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_CURRENT_STACK_TASKS_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_CURRENT_STACK_TASKS_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   uint16_t currentTasks;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &currentTasks);
+  cspFetchApiV(apiCommandData,
+               &currentTasks);
   releaseCommandMutex();
   return currentTasks;
 }
@@ -408,16 +391,14 @@ bool emberOkToNap(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_OK_TO_NAP_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_OK_TO_NAP_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   bool isOkToNap;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &isOkToNap);
+  cspFetchApiU(apiCommandData,
+               &isOkToNap);
   releaseCommandMutex();
   return isOkToNap;
 }
@@ -427,16 +408,14 @@ bool emberOkToHibernate(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_OK_TO_HIBERNATE_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_OK_TO_HIBERNATE_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   bool isOkToHibernate;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &isOkToHibernate);
+  cspFetchApiU(apiCommandData,
+               &isOkToHibernate);
   releaseCommandMutex();
   return isOkToHibernate;
 }
@@ -446,18 +425,17 @@ uint8_t* emberGetEui64(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_EUI64_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_EUI64_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   static uint8_t eui64[EUI64_SIZE];
   uint8_t eui64Size = EUI64_SIZE;
-  fetchApiParams(apiCommandData,
-                 "b",
-                 eui64,
-                 &eui64Size);
+  cspFetchApiB(apiCommandData,
+               eui64,
+               &eui64Size,
+               EUI64_SIZE);
   releaseCommandMutex();
   return eui64;
 }
@@ -467,27 +445,25 @@ EmberStatus emberMacGetParentAddress(EmberMacAddress *parentAddress)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_MAC_GET_PARENT_ADDRESS_IPC_COMMAND_ID,
-                        "vbu",
-                        parentAddress->addr.shortAddress,
-                        parentAddress->addr.longAddress,
-                        EUI64_SIZE,
-                        parentAddress->mode);
+  cspFormatVbu(apiCommandBuffer,
+               MAX_STACK_API_COMMAND_SIZE,
+               EMBER_MAC_GET_PARENT_ADDRESS_IPC_COMMAND_ID,
+               parentAddress->addr.shortAddress,
+               parentAddress->addr.longAddress,
+               EUI64_SIZE,
+               parentAddress->mode);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
 
   uint8_t longAddressSize = EUI64_SIZE;
-  fetchApiParams(apiCommandData,
-                 "uvbu",
-                 &status,
-                 &parentAddress->addr.shortAddress,
-                 parentAddress->addr.longAddress,
-                 &longAddressSize,
-                 EUI64_SIZE,
-                 &parentAddress->mode);
+  cspFetchApiUvbu(apiCommandData,
+                  &status,
+                  &parentAddress->addr.shortAddress,
+                  parentAddress->addr.longAddress,
+                  &longAddressSize,
+                  EUI64_SIZE,
+                  &parentAddress->mode);
   releaseCommandMutex();
   return status;
 }
@@ -497,18 +473,16 @@ bool emberIsLocalEui64(EmberEUI64 eui64)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_IS_LOCAL_EUI64_IPC_COMMAND_ID,
-                        "b",
-                        eui64,
-                        EUI64_SIZE);
+  cspFormatB(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_IS_LOCAL_EUI64_IPC_COMMAND_ID,
+             eui64,
+             EUI64_SIZE);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   bool localEui64;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &localEui64);
+  cspFetchApiU(apiCommandData,
+               &localEui64);
   releaseCommandMutex();
   return localEui64;
 }
@@ -516,18 +490,20 @@ bool emberIsLocalEui64(EmberEUI64 eui64)
 // getNodeId
 EmberNodeId emberGetNodeId(void)
 {
+  CspStackState state;
+  if (cspGetStackState(CMSIS_RTOS_STACK_STATE_NODE_ID, &state)) {
+    return state.nodeId;
+  }
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_NODE_ID_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_NODE_ID_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberNodeId nodeId;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &nodeId);
+  cspFetchApiV(apiCommandData,
+               &nodeId);
   releaseCommandMutex();
   return nodeId;
 }
@@ -535,18 +511,20 @@ EmberNodeId emberGetNodeId(void)
 // getPanId
 EmberPanId emberGetPanId(void)
 {
+  CspStackState state;
+  if (cspGetStackState(CMSIS_RTOS_STACK_STATE_PAN_ID, &state)) {
+    return state.panId;
+  }
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_PAN_ID_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_PAN_ID_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberPanId panId;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &panId);
+  cspFetchApiV(apiCommandData,
+               &panId);
   releaseCommandMutex();
   return panId;
 }
@@ -556,16 +534,14 @@ EmberNodeId emberGetParentId(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_PARENT_ID_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_PARENT_ID_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberNodeId parentNodeId;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &parentNodeId);
+  cspFetchApiV(apiCommandData,
+               &parentNodeId);
   releaseCommandMutex();
   return parentNodeId;
 }
@@ -573,18 +549,20 @@ EmberNodeId emberGetParentId(void)
 // getNodeType
 EmberNodeType emberGetNodeType(void)
 {
+  CspStackState state;
+  if (cspGetStackState(CMSIS_RTOS_STACK_STATE_NODE_TYPE, &state)) {
+    return state.nodeType;
+  }
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_NODE_TYPE_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_NODE_TYPE_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberNodeType nodeType;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &nodeType);
+  cspFetchApiU(apiCommandData,
+               &nodeType);
   releaseCommandMutex();
   return nodeType;
 }
@@ -594,16 +572,14 @@ EmberStatus emberCalibrateCurrentChannel(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_CALIBRATE_CURRENT_CHANNEL_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_CALIBRATE_CURRENT_CHANNEL_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -614,19 +590,17 @@ EmberStatus emberCalibrateCurrentChannelExtended(uint32_t calValueIn,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_CALIBRATE_CURRENT_CHANNEL_EXTENDED_IPC_COMMAND_ID,
-                        "w",
-                        calValueIn);
+  cspFormatW(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_CALIBRATE_CURRENT_CHANNEL_EXTENDED_IPC_COMMAND_ID,
+             calValueIn);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
 
-  fetchApiParams(apiCommandData,
-                 "uw",
-                 &status,
-                 calValueOut);
+  cspFetchApiUw(apiCommandData,
+                &status,
+                calValueOut);
   releaseCommandMutex();
   return status;
 }
@@ -636,17 +610,15 @@ EmberStatus emberApplyIrCalibration(uint32_t calValue)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_APPLY_IR_CALIBRATION_IPC_COMMAND_ID,
-                        "w",
-                        calValue);
+  cspFormatW(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_APPLY_IR_CALIBRATION_IPC_COMMAND_ID,
+             calValue);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -656,16 +628,14 @@ EmberStatus emberTempCalibration(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_TEMP_CALIBRATION_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_TEMP_CALIBRATION_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -675,16 +645,14 @@ EmberCalType emberGetCalType(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_CAL_TYPE_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_CAL_TYPE_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberCalType calType;
-  fetchApiParams(apiCommandData,
-                 "w",
-                 &calType);
+  cspFetchApiW(apiCommandData,
+               &calType);
   releaseCommandMutex();
   return calType;
 }
@@ -697,20 +665,18 @@ uint8_t emberGetMaximumPayloadLength(EmberMacAddressMode srcAddressMode,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_MAXIMUM_PAYLOAD_LENGTH_IPC_COMMAND_ID,
-                        "uuuu",
-                        srcAddressMode,
-                        dstAddressMode,
-                        interpan,
-                        secured);
+  cspFormatUuuu(apiCommandBuffer,
+                MAX_STACK_API_COMMAND_SIZE,
+                EMBER_GET_MAXIMUM_PAYLOAD_LENGTH_IPC_COMMAND_ID,
+                srcAddressMode,
+                dstAddressMode,
+                interpan,
+                secured);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   uint8_t payloadLength;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &payloadLength);
+  cspFetchApiU(apiCommandData,
+               &payloadLength);
   releaseCommandMutex();
   return payloadLength;
 }
@@ -720,17 +686,15 @@ EmberStatus emberSetIndirectQueueTimeout(uint32_t timeoutMs)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_INDIRECT_QUEUE_TIMEOUT_IPC_COMMAND_ID,
-                        "w",
-                        timeoutMs);
+  cspFormatW(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_SET_INDIRECT_QUEUE_TIMEOUT_IPC_COMMAND_ID,
+             timeoutMs);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -745,23 +709,21 @@ EmberStatus emberMessageSend(EmberNodeId destination,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_MESSAGE_SEND_IPC_COMMAND_ID,
-                        "vuuubu",
-                        destination,
-                        endpoint,
-                        messageTag,
-                        messageLength,
-                        message,
-                        messageLength,
-                        options);
+  cspFormatVuuubu(apiCommandBuffer,
+                  MAX_STACK_API_COMMAND_SIZE,
+                  EMBER_MESSAGE_SEND_IPC_COMMAND_ID,
+                  destination,
+                  endpoint,
+                  messageTag,
+                  messageLength,
+                  message,
+                  messageLength,
+                  options);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -771,16 +733,14 @@ EmberStatus emberPollForData(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_POLL_FOR_DATA_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_POLL_FOR_DATA_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -794,33 +754,31 @@ EmberStatus emberMacMessageSend(EmberMacFrame *macFrame,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_MAC_MESSAGE_SEND_IPC_COMMAND_ID,
-                        "vbuvbuvvuuuubu",
-                        macFrame->srcAddress.addr.shortAddress,
-                        macFrame->srcAddress.addr.longAddress,
-                        EUI64_SIZE,
-                        macFrame->srcAddress.mode,
-                        macFrame->dstAddress.addr.shortAddress,
-                        macFrame->dstAddress.addr.longAddress,
-                        EUI64_SIZE,
-                        macFrame->dstAddress.mode,
-                        macFrame->srcPanId,
-                        macFrame->dstPanId,
-                        macFrame->srcPanIdSpecified,
-                        macFrame->dstPanIdSpecified,
-                        messageTag,
-                        messageLength,
-                        message,
-                        messageLength,
-                        options);
+  cspFormatVbuvbuvvuuuubu(apiCommandBuffer,
+                          MAX_STACK_API_COMMAND_SIZE,
+                          EMBER_MAC_MESSAGE_SEND_IPC_COMMAND_ID,
+                          macFrame->srcAddress.addr.shortAddress,
+                          macFrame->srcAddress.addr.longAddress,
+                          EUI64_SIZE,
+                          macFrame->srcAddress.mode,
+                          macFrame->dstAddress.addr.shortAddress,
+                          macFrame->dstAddress.addr.longAddress,
+                          EUI64_SIZE,
+                          macFrame->dstAddress.mode,
+                          macFrame->srcPanId,
+                          macFrame->dstPanId,
+                          macFrame->srcPanIdSpecified,
+                          macFrame->dstPanIdSpecified,
+                          messageTag,
+                          messageLength,
+                          message,
+                          messageLength,
+                          options);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -830,17 +788,15 @@ EmberStatus emberMacSetPanCoordinator(bool isCoordinator)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_MAC_SET_PAN_COORDINATOR_IPC_COMMAND_ID,
-                        "u",
-                        isCoordinator);
+  cspFormatU(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_MAC_SET_PAN_COORDINATOR_IPC_COMMAND_ID,
+             isCoordinator);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -850,20 +806,18 @@ EmberStatus emberSetPollDestinationAddress(EmberMacAddress *destination)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_POLL_DESTINATION_ADDRESS_IPC_COMMAND_ID,
-                        "vbu",
-                        destination->addr.shortAddress,
-                        destination->addr.longAddress,
-                        EUI64_SIZE,
-                        destination->mode);
+  cspFormatVbu(apiCommandBuffer,
+               MAX_STACK_API_COMMAND_SIZE,
+               EMBER_SET_POLL_DESTINATION_ADDRESS_IPC_COMMAND_ID,
+               destination->addr.shortAddress,
+               destination->addr.longAddress,
+               EUI64_SIZE,
+               destination->mode);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -873,20 +827,18 @@ EmberStatus emberRemoveChild(EmberMacAddress *address)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_REMOVE_CHILD_IPC_COMMAND_ID,
-                        "vbu",
-                        address->addr.shortAddress,
-                        address->addr.longAddress,
-                        EUI64_SIZE,
-                        address->mode);
+  cspFormatVbu(apiCommandBuffer,
+               MAX_STACK_API_COMMAND_SIZE,
+               EMBER_REMOVE_CHILD_IPC_COMMAND_ID,
+               address->addr.shortAddress,
+               address->addr.longAddress,
+               EUI64_SIZE,
+               address->mode);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -897,22 +849,20 @@ EmberStatus emberGetChildFlags(EmberMacAddress *address,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_CHILD_FLAGS_IPC_COMMAND_ID,
-                        "vbu",
-                        address->addr.shortAddress,
-                        address->addr.longAddress,
-                        EUI64_SIZE,
-                        address->mode);
+  cspFormatVbu(apiCommandBuffer,
+               MAX_STACK_API_COMMAND_SIZE,
+               EMBER_GET_CHILD_FLAGS_IPC_COMMAND_ID,
+               address->addr.shortAddress,
+               address->addr.longAddress,
+               EUI64_SIZE,
+               address->mode);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
 
-  fetchApiParams(apiCommandData,
-                 "uu",
-                 &status,
-                 flags);
+  cspFetchApiUu(apiCommandData,
+                &status,
+                flags);
   releaseCommandMutex();
   return status;
 }
@@ -924,29 +874,27 @@ EmberStatus emberGetChildInfo(EmberMacAddress *address,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_CHILD_INFO_IPC_COMMAND_ID,
-                        "vbu",
-                        address->addr.shortAddress,
-                        address->addr.longAddress,
-                        EUI64_SIZE,
-                        address->mode);
+  cspFormatVbu(apiCommandBuffer,
+               MAX_STACK_API_COMMAND_SIZE,
+               EMBER_GET_CHILD_INFO_IPC_COMMAND_ID,
+               address->addr.shortAddress,
+               address->addr.longAddress,
+               EUI64_SIZE,
+               address->mode);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
 
   uint8_t longAddressSize = EUI64_SIZE;
 
-  fetchApiParams(apiCommandData,
-                 "uvbuu",
-                 &status,
-                 &addressResp->addr.shortAddress,
-                 addressResp->addr.longAddress,
-                 &longAddressSize,
-                 EUI64_SIZE,
-                 &addressResp->mode,
-                 flags);
+  cspFetchApiUvbuu(apiCommandData,
+                   &status,
+                   &addressResp->addr.shortAddress,
+                   addressResp->addr.longAddress,
+                   &longAddressSize,
+                   EUI64_SIZE,
+                   &addressResp->mode,
+                   flags);
   releaseCommandMutex();
   return status;
 }
@@ -956,16 +904,14 @@ EmberStatus emberPurgeIndirectMessages(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_PURGE_INDIRECT_MESSAGES_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_PURGE_INDIRECT_MESSAGES_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -976,19 +922,17 @@ EmberStatus emberMacAddShortToLongAddressMapping(EmberNodeId shortId,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_MAC_ADD_SHORT_TO_LONG_ADDRESS_MAPPING_IPC_COMMAND_ID,
-                        "vb",
-                        shortId,
-                        longId,
-                        EUI64_SIZE);
+  cspFormatVb(apiCommandBuffer,
+              MAX_STACK_API_COMMAND_SIZE,
+              EMBER_MAC_ADD_SHORT_TO_LONG_ADDRESS_MAPPING_IPC_COMMAND_ID,
+              shortId,
+              longId,
+              EUI64_SIZE);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -998,16 +942,14 @@ EmberStatus emberMacClearShortToLongAddressMappings(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_MAC_CLEAR_SHORT_TO_LONG_ADDRESS_MAPPINGS_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_MAC_CLEAR_SHORT_TO_LONG_ADDRESS_MAPPINGS_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1017,16 +959,14 @@ EmberStatus emberNetworkLeave(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_NETWORK_LEAVE_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_NETWORK_LEAVE_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1036,16 +976,14 @@ EmberStatus emberNetworkInit(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_NETWORK_INIT_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_NETWORK_INIT_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1055,17 +993,15 @@ EmberStatus emberStartActiveScan(uint16_t channel)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_START_ACTIVE_SCAN_IPC_COMMAND_ID,
-                        "v",
-                        channel);
+  cspFormatV(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_START_ACTIVE_SCAN_IPC_COMMAND_ID,
+             channel);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1076,18 +1012,16 @@ EmberStatus emberStartEnergyScan(uint16_t channel,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_START_ENERGY_SCAN_IPC_COMMAND_ID,
-                        "vu",
-                        channel,
-                        samples);
+  cspFormatVu(apiCommandBuffer,
+              MAX_STACK_API_COMMAND_SIZE,
+              EMBER_START_ENERGY_SCAN_IPC_COMMAND_ID,
+              channel,
+              samples);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1098,18 +1032,16 @@ EmberStatus emberSetApplicationBeaconPayload(uint8_t payloadLength,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_APPLICATION_BEACON_PAYLOAD_IPC_COMMAND_ID,
-                        "b",
-                        payload,
-                        payloadLength);
+  cspFormatB(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_SET_APPLICATION_BEACON_PAYLOAD_IPC_COMMAND_ID,
+             payload,
+             payloadLength);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1120,18 +1052,16 @@ EmberStatus emberSetSelectiveJoinPayload(uint8_t payloadLength,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID,
-                        "b",
-                        payload,
-                        payloadLength);
+  cspFormatB(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_SET_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID,
+             payload,
+             payloadLength);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1141,16 +1071,14 @@ EmberStatus emberClearSelectiveJoinPayload(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_CLEAR_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_CLEAR_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1160,19 +1088,17 @@ EmberStatus emberFormNetwork(EmberNetworkParameters *parameters)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_FORM_NETWORK_IPC_COMMAND_ID,
-                        "vvv",
-                        parameters->panId,
-                        parameters->radioTxPower,
-                        parameters->radioChannel);
+  cspFormatVvv(apiCommandBuffer,
+               MAX_STACK_API_COMMAND_SIZE,
+               EMBER_FORM_NETWORK_IPC_COMMAND_ID,
+               parameters->panId,
+               parameters->radioTxPower,
+               parameters->radioChannel);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1184,21 +1110,19 @@ EmberStatus emberJoinNetworkExtended(EmberNodeType nodeType,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_JOIN_NETWORK_EXTENDED_IPC_COMMAND_ID,
-                        "uvvvv",
-                        nodeType,
-                        nodeId,
-                        parameters->panId,
-                        parameters->radioTxPower,
-                        parameters->radioChannel);
+  cspFormatUvvvv(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_JOIN_NETWORK_EXTENDED_IPC_COMMAND_ID,
+                 nodeType,
+                 nodeId,
+                 parameters->panId,
+                 parameters->radioTxPower,
+                 parameters->radioChannel);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1209,20 +1133,18 @@ EmberStatus emberJoinNetwork(EmberNodeType nodeType,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_JOIN_NETWORK_IPC_COMMAND_ID,
-                        "uvvv",
-                        nodeType,
-                        parameters->panId,
-                        parameters->radioTxPower,
-                        parameters->radioChannel);
+  cspFormatUvvv(apiCommandBuffer,
+                MAX_STACK_API_COMMAND_SIZE,
+                EMBER_JOIN_NETWORK_IPC_COMMAND_ID,
+                nodeType,
+                parameters->panId,
+                parameters->radioTxPower,
+                parameters->radioChannel);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1232,19 +1154,17 @@ EmberStatus emberMacFormNetwork(EmberNetworkParameters *parameters)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_MAC_FORM_NETWORK_IPC_COMMAND_ID,
-                        "vvv",
-                        parameters->panId,
-                        parameters->radioTxPower,
-                        parameters->radioChannel);
+  cspFormatVvv(apiCommandBuffer,
+               MAX_STACK_API_COMMAND_SIZE,
+               EMBER_MAC_FORM_NETWORK_IPC_COMMAND_ID,
+               parameters->panId,
+               parameters->radioTxPower,
+               parameters->radioChannel);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1254,17 +1174,15 @@ EmberStatus emberPermitJoining(uint8_t duration)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_PERMIT_JOINING_IPC_COMMAND_ID,
-                        "u",
-                        duration);
+  cspFormatU(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_PERMIT_JOINING_IPC_COMMAND_ID,
+             duration);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1276,21 +1194,19 @@ EmberStatus emberJoinCommissioned(EmberNodeType nodeType,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_JOIN_COMMISSIONED_IPC_COMMAND_ID,
-                        "uvvvv",
-                        nodeType,
-                        nodeId,
-                        parameters->panId,
-                        parameters->radioTxPower,
-                        parameters->radioChannel);
+  cspFormatUvvvv(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_JOIN_COMMISSIONED_IPC_COMMAND_ID,
+                 nodeType,
+                 nodeId,
+                 parameters->panId,
+                 parameters->radioTxPower,
+                 parameters->radioChannel);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1300,10 +1216,9 @@ void emberResetNetworkState(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_RESET_NETWORK_STATE_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_RESET_NETWORK_STATE_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
   releaseCommandMutex();
 }
@@ -1314,18 +1229,16 @@ EmberStatus emberFrequencyHoppingSetChannelMask(uint8_t channelMaskLength,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_FREQUENCY_HOPPING_SET_CHANNEL_MASK_IPC_COMMAND_ID,
-                        "b",
-                        channelMask,
-                        channelMaskLength);
+  cspFormatB(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_FREQUENCY_HOPPING_SET_CHANNEL_MASK_IPC_COMMAND_ID,
+             channelMask,
+             channelMaskLength);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1335,16 +1248,14 @@ EmberStatus emberFrequencyHoppingStartServer(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_FREQUENCY_HOPPING_START_SERVER_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_FREQUENCY_HOPPING_START_SERVER_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1355,18 +1266,16 @@ EmberStatus emberFrequencyHoppingStartClient(EmberNodeId serverNodeId,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_FREQUENCY_HOPPING_START_CLIENT_IPC_COMMAND_ID,
-                        "vv",
-                        serverNodeId,
-                        serverPanId);
+  cspFormatVv(apiCommandBuffer,
+              MAX_STACK_API_COMMAND_SIZE,
+              EMBER_FREQUENCY_HOPPING_START_CLIENT_IPC_COMMAND_ID,
+              serverNodeId,
+              serverPanId);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1376,16 +1285,14 @@ EmberStatus emberFrequencyHoppingStop(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_FREQUENCY_HOPPING_STOP_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_FREQUENCY_HOPPING_STOP_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1396,18 +1303,16 @@ EmberStatus emberSetAuxiliaryAddressFilteringEntry(EmberNodeId nodeId,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID,
-                        "vu",
-                        nodeId,
-                        entryIndex);
+  cspFormatVu(apiCommandBuffer,
+              MAX_STACK_API_COMMAND_SIZE,
+              EMBER_SET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID,
+              nodeId,
+              entryIndex);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1417,17 +1322,15 @@ EmberNodeId emberGetAuxiliaryAddressFilteringEntry(uint8_t entryIndex)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID,
-                        "u",
-                        entryIndex);
+  cspFormatU(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_GET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID,
+             entryIndex);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberNodeId nodeId;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &nodeId);
+  cspFetchApiV(apiCommandData,
+               &nodeId);
   releaseCommandMutex();
   return nodeId;
 }
@@ -1438,18 +1341,16 @@ EmberStatus emberStartTxStream(EmberTxStreamParameters parameters,
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_START_TX_STREAM_IPC_COMMAND_ID,
-                        "uv",
-                        parameters,
-                        channel);
+  cspFormatUv(apiCommandBuffer,
+              MAX_STACK_API_COMMAND_SIZE,
+              EMBER_START_TX_STREAM_IPC_COMMAND_ID,
+              parameters,
+              channel);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1459,16 +1360,14 @@ EmberStatus emberStopTxStream(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_STOP_TX_STREAM_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_STOP_TX_STREAM_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1478,17 +1377,15 @@ EmberStatus emberSetActiveScanDuration(uint16_t durationMs)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_SET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID,
-                        "v",
-                        durationMs);
+  cspFormatV(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_SET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID,
+             durationMs);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   EmberStatus status;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &status);
+  cspFetchApiU(apiCommandData,
+               &status);
   releaseCommandMutex();
   return status;
 }
@@ -1498,16 +1395,14 @@ uint16_t emberGetActiveScanDuration(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   uint16_t durationMs;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &durationMs);
+  cspFetchApiV(apiCommandData,
+               &durationMs);
   releaseCommandMutex();
   return durationMs;
 }
@@ -1517,16 +1412,14 @@ uint16_t emberGetDefaultChannel(void)
 {
   acquireCommandMutex();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  formatResponseCommand(apiCommandBuffer,
-                        MAX_STACK_API_COMMAND_SIZE,
-                        EMBER_GET_DEFAULT_CHANNEL_IPC_COMMAND_ID,
-                        "");
+  cspFormatEmpty(apiCommandBuffer,
+                 MAX_STACK_API_COMMAND_SIZE,
+                 EMBER_GET_DEFAULT_CHANNEL_IPC_COMMAND_ID);
   uint8_t *apiCommandData = sendBlockingCommand(apiCommandBuffer);
 
   uint16_t firstChannel;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &firstChannel);
+  cspFetchApiV(apiCommandData,
+               &firstChannel);
   releaseCommandMutex();
   return firstChannel;
 }
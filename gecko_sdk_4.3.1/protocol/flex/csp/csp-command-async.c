@@ -0,0 +1,98 @@
+/***************************************************************************//**
+ * @brief Non-blocking variants of Connect stack APIs for application tasks
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#include PLATFORM_HEADER
+
+#include "stack/include/ember.h"
+
+#include "csp-format.h"
+#include "csp-command-utils.h"
+#include "csp-api-enum-gen.h"
+#include "csp-command-async.h"
+
+// The commands are serialized exactly like their blocking counterparts in
+// csp-command-app.c, so the stack side handlers in csp-command-vncp.c serve
+// both. Only APIs whose response is a single EmberStatus can be posted this
+// way, the status is what the completion callback receives.
+
+// Command ID and fixed fields of the emberMessageSend() command.
+#define MESSAGE_SEND_FIXED_LENGTH 9
+
+EmberStatus emberMessageSendAsync(EmberNodeId destination,
+                                  uint8_t endpoint,
+                                  uint8_t messageTag,
+                                  EmberMessageLength messageLength,
+                                  uint8_t *message,
+                                  EmberMessageOptions options,
+                                  EmberAsyncCommandCompleteCallback complete,
+                                  EmberAsyncCommandToken *token)
+{
+  if (MESSAGE_SEND_FIXED_LENGTH + messageLength
+      > MAX_STACK_API_COMMAND_SIZE) {
+    return EMBER_MESSAGE_TOO_LONG;
+  }
+
+  uint8_t *apiCommandBuffer = allocateAsyncCommandPointer(complete, token);
+  if (apiCommandBuffer == NULL) {
+    return EMBER_NO_BUFFERS;
+  }
+  cspFormatVuuubu(apiCommandBuffer,
+                  MAX_STACK_API_COMMAND_SIZE,
+                  EMBER_MESSAGE_SEND_IPC_COMMAND_ID,
+                  destination,
+                  endpoint,
+                  messageTag,
+                  messageLength,
+                  message,
+                  messageLength,
+                  options);
+  sendAsyncCommand(apiCommandBuffer);
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emberSetRadioPowerAsync(int16_t power,
+                                    bool persistent,
+                                    EmberAsyncCommandCompleteCallback complete,
+                                    EmberAsyncCommandToken *token)
+{
+  uint8_t *apiCommandBuffer = allocateAsyncCommandPointer(complete, token);
+  if (apiCommandBuffer == NULL) {
+    return EMBER_NO_BUFFERS;
+  }
+  cspFormatVu(apiCommandBuffer,
+              MAX_STACK_API_COMMAND_SIZE,
+              EMBER_SET_RADIO_POWER_IPC_COMMAND_ID,
+              power,
+              persistent);
+  sendAsyncCommand(apiCommandBuffer);
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emberPermitJoiningAsync(uint8_t duration,
+                                    EmberAsyncCommandCompleteCallback complete,
+                                    EmberAsyncCommandToken *token)
+{
+  uint8_t *apiCommandBuffer = allocateAsyncCommandPointer(complete, token);
+  if (apiCommandBuffer == NULL) {
+    return EMBER_NO_BUFFERS;
+  }
+  cspFormatU(apiCommandBuffer,
+             MAX_STACK_API_COMMAND_SIZE,
+             EMBER_PERMIT_JOINING_IPC_COMMAND_ID,
+             duration);
+  sendAsyncCommand(apiCommandBuffer);
+  return EMBER_SUCCESS;
+}
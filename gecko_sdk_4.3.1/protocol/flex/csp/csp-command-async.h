@@ -0,0 +1,89 @@
+/***************************************************************************//**
+ * @brief Non-blocking variants of Connect stack APIs for application tasks
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef __CSP_COMMAND_ASYNC_H__
+#define __CSP_COMMAND_ASYNC_H__
+
+/**
+ * @brief Identifies a posted asynchronous command until its completion
+ * callback has run.
+ */
+typedef uint16_t EmberAsyncCommandToken;
+
+/** @brief Never returned for a successfully posted command. */
+#define EMBER_ASYNC_COMMAND_TOKEN_NULL                  0xFFFF
+
+/**
+ * @brief Called from the application framework task once the stack task has
+ * executed an asynchronous command.
+ *
+ * @param[in] token   The token returned when the command was posted.
+ *
+ * @param[in] status  The ::EmberStatus the blocking variant of the API would
+ * have returned.
+ */
+typedef void (*EmberAsyncCommandCompleteCallback)(EmberAsyncCommandToken token,
+                                                  EmberStatus status);
+
+/**
+ * @brief Post an ::emberMessageSend() call to the stack task and return
+ * without waiting for it to execute.
+ *
+ * Commands posted this way are executed in the order they were posted. The
+ * message payload is copied, so it can be reused as soon as this returns.
+ *
+ * @param[in] complete  Called with the status of the send, can be NULL.
+ *
+ * @param[out] token    Set to the token identifying the command, can be NULL.
+ *
+ * @return an ::EmberStatus value of:
+ * - ::EMBER_SUCCESS if the command was posted.
+ * - ::EMBER_NO_BUFFERS if all the asynchronous command slots are in use.
+ * - ::EMBER_MESSAGE_TOO_LONG if the message does not fit in a command.
+ */
+EmberStatus emberMessageSendAsync(EmberNodeId destination,
+                                  uint8_t endpoint,
+                                  uint8_t messageTag,
+                                  EmberMessageLength messageLength,
+                                  uint8_t *message,
+                                  EmberMessageOptions options,
+                                  EmberAsyncCommandCompleteCallback complete,
+                                  EmberAsyncCommandToken *token);
+
+/**
+ * @brief Post an ::emberSetRadioPower() call to the stack task and return
+ * without waiting for it to execute.
+ *
+ * @return ::EMBER_SUCCESS if the command was posted, ::EMBER_NO_BUFFERS if all
+ * the asynchronous command slots are in use.
+ */
+EmberStatus emberSetRadioPowerAsync(int16_t power,
+                                    bool persistent,
+                                    EmberAsyncCommandCompleteCallback complete,
+                                    EmberAsyncCommandToken *token);
+
+/**
+ * @brief Post an ::emberPermitJoining() call to the stack task and return
+ * without waiting for it to execute.
+ *
+ * @return ::EMBER_SUCCESS if the command was posted, ::EMBER_NO_BUFFERS if all
+ * the asynchronous command slots are in use.
+ */
+EmberStatus emberPermitJoiningAsync(uint8_t duration,
+                                    EmberAsyncCommandCompleteCallback complete,
+                                    EmberAsyncCommandToken *token);
+
+#endif // __CSP_COMMAND_ASYNC_H__
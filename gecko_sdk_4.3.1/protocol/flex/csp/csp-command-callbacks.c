@@ -30,19 +30,17 @@
 void emberStackStatusHandler(EmberStatus status)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_STACK_STATUS_HANDLER_IPC_COMMAND_ID,
-                                          "u",
-                                          status);
+  uint16_t length = cspFormatU(callbackCommandBuffer,
+                               MAX_STACK_API_COMMAND_SIZE,
+                               EMBER_STACK_STATUS_HANDLER_IPC_COMMAND_ID,
+                               status);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void stackStatusCommandHandler(uint8_t *callbackParams)
 {
   EmberStatus status;
-  fetchCallbackParams(callbackParams,
-                      "u",
-                      &status);
+  cspFetchCallbackU(callbackParams,
+                    &status);
 
   emberAfStackStatusCallback(status);
   emberAfStackStatus(status);
@@ -52,22 +50,20 @@ void emberChildJoinHandler(EmberNodeType nodeType,
                            EmberNodeId nodeId)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_CHILD_JOIN_HANDLER_IPC_COMMAND_ID,
-                                          "uv",
-                                          nodeType,
-                                          nodeId);
+  uint16_t length = cspFormatUv(callbackCommandBuffer,
+                                MAX_STACK_API_COMMAND_SIZE,
+                                EMBER_CHILD_JOIN_HANDLER_IPC_COMMAND_ID,
+                                nodeType,
+                                nodeId);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void childJoinCommandHandler(uint8_t *callbackParams)
 {
   EmberNodeType nodeType;
   EmberNodeId nodeId;
-  fetchCallbackParams(callbackParams,
-                      "uv",
-                      &nodeType,
-                      &nodeId);
+  cspFetchCallbackUv(callbackParams,
+                     &nodeType,
+                     &nodeId);
 
   emberAfChildJoinCallback(nodeType,
                            nodeId);
@@ -78,10 +74,9 @@ static void childJoinCommandHandler(uint8_t *callbackParams)
 void emberRadioNeedsCalibratingHandler(void)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_RADIO_NEEDS_CALIBRATING_HANDLER_IPC_COMMAND_ID,
-                                          "");
+  uint16_t length = cspFormatEmpty(callbackCommandBuffer,
+                                   MAX_STACK_API_COMMAND_SIZE,
+                                   EMBER_RADIO_NEEDS_CALIBRATING_HANDLER_IPC_COMMAND_ID);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void radioNeedsCalibratingCommandHandler(uint8_t *callbackParams)
@@ -96,20 +91,19 @@ void emberMessageSentHandler(EmberStatus status,
                              EmberOutgoingMessage *message)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_MESSAGE_SENT_HANDLER_IPC_COMMAND_ID,
-                                          "uuvuuubuw",
-                                          status,
-                                          message->options,
-                                          message->destination,
-                                          message->endpoint,
-                                          message->tag,
-                                          message->length,
-                                          message->payload,
-                                          message->length,
-                                          message->ackRssi,
-                                          message->timestamp);
+  uint16_t length = cspFormatUuvuuubuw(callbackCommandBuffer,
+                                       MAX_STACK_API_COMMAND_SIZE,
+                                       EMBER_MESSAGE_SENT_HANDLER_IPC_COMMAND_ID,
+                                       status,
+                                       message->options,
+                                       message->destination,
+                                       message->endpoint,
+                                       message->tag,
+                                       message->length,
+                                       message->payload,
+                                       message->length,
+                                       message->ackRssi,
+                                       message->timestamp);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void messageSentCommandHandler(uint8_t *callbackParams)
@@ -118,19 +112,18 @@ static void messageSentCommandHandler(uint8_t *callbackParams)
   EmberOutgoingMessage message;
   uint8_t payload[127];
   message.payload = payload;
-  fetchCallbackParams(callbackParams,
-                      "uuvuuubuw",
-                      &status,
-                      &message.options,
-                      &message.destination,
-                      &message.endpoint,
-                      &message.tag,
-                      &message.length,
-                      message.payload,
-                      &message.length,
-                      127,
-                      &message.ackRssi,
-                      &message.timestamp);
+  cspFetchCallbackUuvuuubuw(callbackParams,
+                            &status,
+                            &message.options,
+                            &message.destination,
+                            &message.endpoint,
+                            &message.tag,
+                            &message.length,
+                            message.payload,
+                            &message.length,
+                            127,
+                            &message.ackRssi,
+                            &message.timestamp);
 
   emberAfMessageSentCallback(status,
                              &message);
@@ -141,19 +134,18 @@ static void messageSentCommandHandler(uint8_t *callbackParams)
 void emberIncomingMessageHandler(EmberIncomingMessage *message)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_INCOMING_MESSAGE_HANDLER_IPC_COMMAND_ID,
-                                          "uvuuubwu",
-                                          message->options,
-                                          message->source,
-                                          message->endpoint,
-                                          message->rssi,
-                                          message->length,
-                                          message->payload,
-                                          message->length,
-                                          message->timestamp,
-                                          message->lqi);
+  uint16_t length = cspFormatUvuuubwu(callbackCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_INCOMING_MESSAGE_HANDLER_IPC_COMMAND_ID,
+                                      message->options,
+                                      message->source,
+                                      message->endpoint,
+                                      message->rssi,
+                                      message->length,
+                                      message->payload,
+                                      message->length,
+                                      message->timestamp,
+                                      message->lqi);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void incomingMessageCommandHandler(uint8_t *callbackParams)
@@ -161,18 +153,17 @@ static void incomingMessageCommandHandler(uint8_t *callbackParams)
   EmberIncomingMessage message;
   uint8_t payload[127];
   message.payload = payload;
-  fetchCallbackParams(callbackParams,
-                      "uvuuubwu",
-                      &message.options,
-                      &message.source,
-                      &message.endpoint,
-                      &message.rssi,
-                      &message.length,
-                      message.payload,
-                      &message.length,
-                      127,
-                      &message.timestamp,
-                      &message.lqi);
+  cspFetchCallbackUvuuubwu(callbackParams,
+                           &message.options,
+                           &message.source,
+                           &message.endpoint,
+                           &message.rssi,
+                           &message.length,
+                           message.payload,
+                           &message.length,
+                           127,
+                           &message.timestamp,
+                           &message.lqi);
 
   emberAfIncomingMessageCallback(&message);
   emberAfIncomingMessage(&message);
@@ -181,30 +172,29 @@ static void incomingMessageCommandHandler(uint8_t *callbackParams)
 void emberIncomingMacMessageHandler(EmberIncomingMacMessage *message)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_INCOMING_MAC_MESSAGE_HANDLER_IPC_COMMAND_ID,
-                                          "uvbuvbuvvuuuuwubw",
-                                          message->options,
-                                          message->macFrame.srcAddress.addr.shortAddress,
-                                          message->macFrame.srcAddress.addr.longAddress,
-                                          EUI64_SIZE,
-                                          message->macFrame.srcAddress.mode,
-                                          message->macFrame.dstAddress.addr.shortAddress,
-                                          message->macFrame.dstAddress.addr.longAddress,
-                                          EUI64_SIZE,
-                                          message->macFrame.dstAddress.mode,
-                                          message->macFrame.srcPanId,
-                                          message->macFrame.dstPanId,
-                                          message->macFrame.srcPanIdSpecified,
-                                          message->macFrame.dstPanIdSpecified,
-                                          message->rssi,
-                                          message->lqi,
-                                          message->frameCounter,
-                                          message->length,
-                                          message->payload,
-                                          message->length,
-                                          message->timestamp);
+  uint16_t length = cspFormatUvbuvbuvvuuuuwubw(callbackCommandBuffer,
+                                               MAX_STACK_API_COMMAND_SIZE,
+                                               EMBER_INCOMING_MAC_MESSAGE_HANDLER_IPC_COMMAND_ID,
+                                               message->options,
+                                               message->macFrame.srcAddress.addr.shortAddress,
+                                               message->macFrame.srcAddress.addr.longAddress,
+                                               EUI64_SIZE,
+                                               message->macFrame.srcAddress.mode,
+                                               message->macFrame.dstAddress.addr.shortAddress,
+                                               message->macFrame.dstAddress.addr.longAddress,
+                                               EUI64_SIZE,
+                                               message->macFrame.dstAddress.mode,
+                                               message->macFrame.srcPanId,
+                                               message->macFrame.dstPanId,
+                                               message->macFrame.srcPanIdSpecified,
+                                               message->macFrame.dstPanIdSpecified,
+                                               message->rssi,
+                                               message->lqi,
+                                               message->frameCounter,
+                                               message->length,
+                                               message->payload,
+                                               message->length,
+                                               message->timestamp);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void incomingMacMessageCommandHandler(uint8_t *callbackParams)
@@ -213,31 +203,30 @@ static void incomingMacMessageCommandHandler(uint8_t *callbackParams)
   uint8_t eui64Size = EUI64_SIZE;
   uint8_t payload[127];
   message.payload = payload;
-  fetchCallbackParams(callbackParams,
-                      "uvbuvbuvvuuuuwubw",
-                      &message.options,
-                      &message.macFrame.srcAddress.addr.shortAddress,
-                      message.macFrame.srcAddress.addr.longAddress,
-                      &eui64Size,
-                      EUI64_SIZE,
-                      &message.macFrame.srcAddress.mode,
-                      &message.macFrame.dstAddress.addr.shortAddress,
-                      message.macFrame.dstAddress.addr.longAddress,
-                      &eui64Size,
-                      EUI64_SIZE,
-                      &message.macFrame.dstAddress.mode,
-                      &message.macFrame.srcPanId,
-                      &message.macFrame.dstPanId,
-                      &message.macFrame.srcPanIdSpecified,
-                      &message.macFrame.dstPanIdSpecified,
-                      &message.rssi,
-                      &message.lqi,
-                      &message.frameCounter,
-                      &message.length,
-                      message.payload,
-                      &message.length,
-                      127,
-                      &message.timestamp);
+  cspFetchCallbackUvbuvbuvvuuuuwubw(callbackParams,
+                                    &message.options,
+                                    &message.macFrame.srcAddress.addr.shortAddress,
+                                    message.macFrame.srcAddress.addr.longAddress,
+                                    &eui64Size,
+                                    EUI64_SIZE,
+                                    &message.macFrame.srcAddress.mode,
+                                    &message.macFrame.dstAddress.addr.shortAddress,
+                                    message.macFrame.dstAddress.addr.longAddress,
+                                    &eui64Size,
+                                    EUI64_SIZE,
+                                    &message.macFrame.dstAddress.mode,
+                                    &message.macFrame.srcPanId,
+                                    &message.macFrame.dstPanId,
+                                    &message.macFrame.srcPanIdSpecified,
+                                    &message.macFrame.dstPanIdSpecified,
+                                    &message.rssi,
+                                    &message.lqi,
+                                    &message.frameCounter,
+                                    &message.length,
+                                    message.payload,
+                                    &message.length,
+                                    127,
+                                    &message.timestamp);
 
   emberAfIncomingMacMessageCallback(&message);
   emberAfIncomingMacMessage(&message);
@@ -247,31 +236,30 @@ void emberMacMessageSentHandler(EmberStatus status,
                                 EmberOutgoingMacMessage *message)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_MAC_MESSAGE_SENT_HANDLER_IPC_COMMAND_ID,
-                                          "uuvbuvbuvvuuuwubuw",
-                                          status,
-                                          message->options,
-                                          message->macFrame.srcAddress.addr.shortAddress,
-                                          message->macFrame.srcAddress.addr.longAddress,
-                                          EUI64_SIZE,
-                                          message->macFrame.srcAddress.mode,
-                                          message->macFrame.dstAddress.addr.shortAddress,
-                                          message->macFrame.dstAddress.addr.longAddress,
-                                          EUI64_SIZE,
-                                          message->macFrame.dstAddress.mode,
-                                          message->macFrame.srcPanId,
-                                          message->macFrame.dstPanId,
-                                          message->macFrame.srcPanIdSpecified,
-                                          message->macFrame.dstPanIdSpecified,
-                                          message->tag,
-                                          message->frameCounter,
-                                          message->length,
-                                          message->payload,
-                                          message->length,
-                                          message->ackRssi,
-                                          message->timestamp);
+  uint16_t length = cspFormatUuvbuvbuvvuuuwubuw(callbackCommandBuffer,
+                                                MAX_STACK_API_COMMAND_SIZE,
+                                                EMBER_MAC_MESSAGE_SENT_HANDLER_IPC_COMMAND_ID,
+                                                status,
+                                                message->options,
+                                                message->macFrame.srcAddress.addr.shortAddress,
+                                                message->macFrame.srcAddress.addr.longAddress,
+                                                EUI64_SIZE,
+                                                message->macFrame.srcAddress.mode,
+                                                message->macFrame.dstAddress.addr.shortAddress,
+                                                message->macFrame.dstAddress.addr.longAddress,
+                                                EUI64_SIZE,
+                                                message->macFrame.dstAddress.mode,
+                                                message->macFrame.srcPanId,
+                                                message->macFrame.dstPanId,
+                                                message->macFrame.srcPanIdSpecified,
+                                                message->macFrame.dstPanIdSpecified,
+                                                message->tag,
+                                                message->frameCounter,
+                                                message->length,
+                                                message->payload,
+                                                message->length,
+                                                message->ackRssi,
+                                                message->timestamp);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void macMessageSentCommandHandler(uint8_t *callbackParams)
@@ -281,32 +269,31 @@ static void macMessageSentCommandHandler(uint8_t *callbackParams)
   uint8_t eui64Size = EUI64_SIZE;
   uint8_t payload[127];
   message.payload = payload;
-  fetchCallbackParams(callbackParams,
-                      "uuvbuvbuvvuuuwubuw",
-                      &status,
-                      &message.options,
-                      &message.macFrame.srcAddress.addr.shortAddress,
-                      message.macFrame.srcAddress.addr.longAddress,
-                      &eui64Size,
-                      EUI64_SIZE,
-                      &message.macFrame.srcAddress.mode,
-                      &message.macFrame.dstAddress.addr.shortAddress,
-                      message.macFrame.dstAddress.addr.longAddress,
-                      &eui64Size,
-                      EUI64_SIZE,
-                      &message.macFrame.dstAddress.mode,
-                      &message.macFrame.srcPanId,
-                      &message.macFrame.dstPanId,
-                      &message.macFrame.srcPanIdSpecified,
-                      &message.macFrame.dstPanIdSpecified,
-                      &message.tag,
-                      &message.frameCounter,
-                      &message.length,
-                      message.payload,
-                      &message.length,
-                      127,
-                      &message.ackRssi,
-                      &message.timestamp);
+  cspFetchCallbackUuvbuvbuvvuuuwubuw(callbackParams,
+                                     &status,
+                                     &message.options,
+                                     &message.macFrame.srcAddress.addr.shortAddress,
+                                     message.macFrame.srcAddress.addr.longAddress,
+                                     &eui64Size,
+                                     EUI64_SIZE,
+                                     &message.macFrame.srcAddress.mode,
+                                     &message.macFrame.dstAddress.addr.shortAddress,
+                                     message.macFrame.dstAddress.addr.longAddress,
+                                     &eui64Size,
+                                     EUI64_SIZE,
+                                     &message.macFrame.dstAddress.mode,
+                                     &message.macFrame.srcPanId,
+                                     &message.macFrame.dstPanId,
+                                     &message.macFrame.srcPanIdSpecified,
+                                     &message.macFrame.dstPanIdSpecified,
+                                     &message.tag,
+                                     &message.frameCounter,
+                                     &message.length,
+                                     message.payload,
+                                     &message.length,
+                                     127,
+                                     &message.ackRssi,
+                                     &message.timestamp);
 
   emberAfMacMessageSentCallback(status,
                                 &message);
@@ -324,23 +311,22 @@ void emberIncomingBeaconHandler(EmberPanId panId,
                                 uint8_t *beaconPayload)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_INCOMING_BEACON_HANDLER_IPC_COMMAND_ID,
-                                          "vvbuuuubub",
-                                          panId,
-                                          source->addr.shortAddress,
-                                          source->addr.longAddress,
-                                          EUI64_SIZE,
-                                          source->mode,
-                                          rssi,
-                                          permitJoining,
-                                          beaconFieldsLength,
-                                          beaconFields,
-                                          beaconFieldsLength,
-                                          beaconPayloadLength,
-                                          beaconPayload,
-                                          beaconPayloadLength);
+  uint16_t length = cspFormatVvbuuuubub(callbackCommandBuffer,
+                                        MAX_STACK_API_COMMAND_SIZE,
+                                        EMBER_INCOMING_BEACON_HANDLER_IPC_COMMAND_ID,
+                                        panId,
+                                        source->addr.shortAddress,
+                                        source->addr.longAddress,
+                                        EUI64_SIZE,
+                                        source->mode,
+                                        rssi,
+                                        permitJoining,
+                                        beaconFieldsLength,
+                                        beaconFields,
+                                        beaconFieldsLength,
+                                        beaconPayloadLength,
+                                        beaconPayload,
+                                        beaconPayloadLength);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void incomingBeaconCommandHandler(uint8_t *callbackParams)
@@ -354,24 +340,23 @@ static void incomingBeaconCommandHandler(uint8_t *callbackParams)
   uint8_t eui64Size = EUI64_SIZE;
   static uint8_t beaconFields[EMBER_MAC_MAX_BEACON_FIELDS_LENGTH];
   static uint8_t beaconPayload[EMBER_MAC_STACK_BEACON_PAYLOAD_LENGTH + EMBER_MAC_MAX_APP_BEACON_PAYLOAD_LENGTH];
-  fetchCallbackParams(callbackParams,
-                      "vvbuuuubub",
-                      &panId,
-                      &source.addr.shortAddress,
-                      source.addr.longAddress,
-                      &eui64Size,
-                      EUI64_SIZE,
-                      &source.mode,
-                      &rssi,
-                      &permitJoining,
-                      &beaconFieldsLength,
-                      beaconFields,
-                      &beaconFieldsLength,
-                      EMBER_MAC_MAX_BEACON_FIELDS_LENGTH,
-                      &beaconPayloadLength,
-                      beaconPayload,
-                      &beaconPayloadLength,
-                      EMBER_MAC_STACK_BEACON_PAYLOAD_LENGTH + EMBER_MAC_MAX_APP_BEACON_PAYLOAD_LENGTH);
+  cspFetchCallbackVvbuuuubub(callbackParams,
+                             &panId,
+                             &source.addr.shortAddress,
+                             source.addr.longAddress,
+                             &eui64Size,
+                             EUI64_SIZE,
+                             &source.mode,
+                             &rssi,
+                             &permitJoining,
+                             &beaconFieldsLength,
+                             beaconFields,
+                             &beaconFieldsLength,
+                             EMBER_MAC_MAX_BEACON_FIELDS_LENGTH,
+                             &beaconPayloadLength,
+                             beaconPayload,
+                             &beaconPayloadLength,
+                             EMBER_MAC_STACK_BEACON_PAYLOAD_LENGTH + EMBER_MAC_MAX_APP_BEACON_PAYLOAD_LENGTH);
 
   emberAfIncomingBeaconCallback(panId,
                                 &source,
@@ -394,10 +379,9 @@ static void incomingBeaconCommandHandler(uint8_t *callbackParams)
 void emberActiveScanCompleteHandler(void)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_ACTIVE_SCAN_COMPLETE_HANDLER_IPC_COMMAND_ID,
-                                          "");
+  uint16_t length = cspFormatEmpty(callbackCommandBuffer,
+                                   MAX_STACK_API_COMMAND_SIZE,
+                                   EMBER_ACTIVE_SCAN_COMPLETE_HANDLER_IPC_COMMAND_ID);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void activeScanCompleteCommandHandler(uint8_t *callbackParams)
@@ -414,14 +398,13 @@ void emberEnergyScanCompleteHandler(int8_t mean,
                                     uint16_t variance)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_ENERGY_SCAN_COMPLETE_HANDLER_IPC_COMMAND_ID,
-                                          "uuuv",
-                                          mean,
-                                          min,
-                                          max,
-                                          variance);
+  uint16_t length = cspFormatUuuv(callbackCommandBuffer,
+                                  MAX_STACK_API_COMMAND_SIZE,
+                                  EMBER_ENERGY_SCAN_COMPLETE_HANDLER_IPC_COMMAND_ID,
+                                  mean,
+                                  min,
+                                  max,
+                                  variance);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void energyScanCompleteCommandHandler(uint8_t *callbackParams)
@@ -430,12 +413,11 @@ static void energyScanCompleteCommandHandler(uint8_t *callbackParams)
   int8_t min;
   int8_t max;
   uint16_t variance;
-  fetchCallbackParams(callbackParams,
-                      "uuuv",
-                      &mean,
-                      &min,
-                      &max,
-                      &variance);
+  cspFetchCallbackUuuv(callbackParams,
+                       &mean,
+                       &min,
+                       &max,
+                       &variance);
 
   emberAfEnergyScanCompleteCallback(mean,
                                     min,
@@ -450,19 +432,17 @@ static void energyScanCompleteCommandHandler(uint8_t *callbackParams)
 void emberFrequencyHoppingStartClientCompleteHandler(EmberStatus status)
 {
   uint8_t *callbackCommandBuffer = allocateCallbackCommandPointer();
-  uint16_t length = formatResponseCommand(callbackCommandBuffer,
-                                          MAX_STACK_API_COMMAND_SIZE,
-                                          EMBER_FREQUENCY_HOPPING_START_CLIENT_COMPLETE_HANDLER_IPC_COMMAND_ID,
-                                          "u",
-                                          status);
+  uint16_t length = cspFormatU(callbackCommandBuffer,
+                               MAX_STACK_API_COMMAND_SIZE,
+                               EMBER_FREQUENCY_HOPPING_START_CLIENT_COMPLETE_HANDLER_IPC_COMMAND_ID,
+                               status);
   sendCallbackCommand(callbackCommandBuffer, length);
 }
 static void frequencyHoppingStartClientCompleteCommandHandler(uint8_t *callbackParams)
 {
   EmberStatus status;
-  fetchCallbackParams(callbackParams,
-                      "u",
-                      &status);
+  cspFetchCallbackU(callbackParams,
+                    &status);
 
   emberAfFrequencyHoppingStartClientCompleteCallback(status);
   emberAfFrequencyHoppingStartClientComplete(status);
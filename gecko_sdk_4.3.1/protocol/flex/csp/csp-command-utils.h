@@ -17,6 +17,8 @@
 #ifndef __CSP_COMMAND_UTILS_H__
 #define __CSP_COMMAND_UTILS_H__
 
+#include "csp-command-async.h"
+
 //------------------------------------------------------------------------------
 // Functions to implement in RTOS or NCP files
 
@@ -36,6 +38,11 @@ bool isCurrentTaskStackTask(void);
 
 void sendCallbackCommand(uint8_t *callbackCommandBuffer, uint16_t commandLength);
 
+uint8_t *allocateAsyncCommandPointer(EmberAsyncCommandCompleteCallback complete,
+                                     EmberAsyncCommandToken *token);
+
+void sendAsyncCommand(uint8_t *apiCommandBuffer);
+
 //------------------------------------------------------------------------------
 // Internal APIs defined in csp-command-vncp.c or csp-command-app.c
 void handleIncomingApiCommand(uint16_t commandId, uint8_t *apiCommandData);
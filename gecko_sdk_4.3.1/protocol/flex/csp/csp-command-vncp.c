@@ -32,11 +32,10 @@ static void networkStateCommandHandler(uint8_t *apiCommandData)
 {
   EmberNetworkStatus networkStatus = emApiNetworkState();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_NETWORK_STATE_IPC_COMMAND_ID,
-                                                 "u",
-                                                 networkStatus);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_NETWORK_STATE_IPC_COMMAND_ID,
+                                      networkStatus);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -45,11 +44,10 @@ static void stackIsUpCommandHandler(uint8_t *apiCommandData)
 {
   bool stackIsUp = emApiStackIsUp();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_STACK_IS_UP_IPC_COMMAND_ID,
-                                                 "u",
-                                                 stackIsUp);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_STACK_IS_UP_IPC_COMMAND_ID,
+                                      stackIsUp);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -58,18 +56,16 @@ static void setSecurityKeyCommandHandler(uint8_t *apiCommandData)
 {
   EmberKeyData key;
   uint8_t emberEncryptionKeySize = EMBER_ENCRYPTION_KEY_SIZE;
-  fetchApiParams(apiCommandData,
-                 "b",
-                 &key,
-                 &emberEncryptionKeySize,
-                 EMBER_ENCRYPTION_KEY_SIZE);
+  cspFetchApiB(apiCommandData,
+               &key,
+               &emberEncryptionKeySize,
+               EMBER_ENCRYPTION_KEY_SIZE);
   EmberStatus status = emApiSetSecurityKey(&key);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_SECURITY_KEY_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_SECURITY_KEY_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -78,20 +74,18 @@ static void GetSecurityKeyCommandHandler(uint8_t *apiCommandData)
 {
   EmberKeyData key;
   uint8_t emberEncryptionKeySize = EMBER_ENCRYPTION_KEY_SIZE;
-  fetchApiParams(apiCommandData,
-                 "b",
-                 &key.contents,
-                 &emberEncryptionKeySize,
-                 EMBER_ENCRYPTION_KEY_SIZE);
+  cspFetchApiB(apiCommandData,
+               &key.contents,
+               &emberEncryptionKeySize,
+               EMBER_ENCRYPTION_KEY_SIZE);
   EmberStatus status = emApiGetSecurityKey(&key);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_SECURITY_KEY_IPC_COMMAND_ID,
-                                                 "ub",
-                                                 status,
-                                                 key.contents,
-                                                 emberEncryptionKeySize);
+  uint16_t commandLength = cspFormatUb(apiCommandBuffer,
+                                       MAX_STACK_API_COMMAND_SIZE,
+                                       EMBER_GET_SECURITY_KEY_IPC_COMMAND_ID,
+                                       status,
+                                       key.contents,
+                                       emberEncryptionKeySize);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -100,16 +94,14 @@ static void GetSecurityKeyCommandHandler(uint8_t *apiCommandData)
 static void setPsaSecurityKeyCommandHandler(uint8_t *apiCommandData)
 {
   mbedtls_svc_key_id_t key_id;
-  fetchApiParams(apiCommandData,
-                 "w",
-                 &key_id);
+  cspFetchApiW(apiCommandData,
+               &key_id);
   EmberStatus status = emApiSetPsaSecurityKey(key_id);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_PSA_SECURITY_KEY_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_PSA_SECURITY_KEY_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -121,11 +113,10 @@ static void RemovePsaSecurityKeyCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiRemovePsaSecurityKey();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_REMOVE_PSA_SECURITY_KEY_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_REMOVE_PSA_SECURITY_KEY_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -136,18 +127,16 @@ static void setNcpSecurityKeyCommandHandler(uint8_t *apiCommandData)
 {
   uint8_t keyLength;
   uint8_t *key;
-  fetchApiParams(apiCommandData,
-                 "p",
-                 &key,
-                 &keyLength);
+  cspFetchApiP(apiCommandData,
+               &key,
+               &keyLength);
   EmberStatus status = emApiSetNcpSecurityKey(key,
                                               keyLength);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_NCP_SECURITY_KEY_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_NCP_SECURITY_KEY_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -157,11 +146,10 @@ static void getKeyIdCommandHandler(uint8_t *apiCommandData)
 {
   mbedtls_svc_key_id_t key_id = emApiGetKeyId();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_KEY_ID_IPC_COMMAND_ID,
-                                                 "w",
-                                                 key_id);
+  uint16_t commandLength = cspFormatW(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_KEY_ID_IPC_COMMAND_ID,
+                                      key_id);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -172,18 +160,16 @@ static void getCounterCommandHandler(uint8_t *apiCommandData)
 {
   EmberCounterType counterType;
   uint32_t count;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &counterType);
+  cspFetchApiU(apiCommandData,
+               &counterType);
   EmberStatus status = emApiGetCounter(counterType,
                                        &count);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_COUNTER_IPC_COMMAND_ID,
-                                                 "uw",
-                                                 status,
-                                                 count);
+  uint16_t commandLength = cspFormatUw(apiCommandBuffer,
+                                       MAX_STACK_API_COMMAND_SIZE,
+                                       EMBER_GET_COUNTER_IPC_COMMAND_ID,
+                                       status,
+                                       count);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -192,18 +178,16 @@ static void setRadioChannelExtendedCommandHandler(uint8_t *apiCommandData)
 {
   uint16_t channel;
   bool persistent;
-  fetchApiParams(apiCommandData,
-                 "vu",
-                 &channel,
-                 &persistent);
+  cspFetchApiVu(apiCommandData,
+                &channel,
+                &persistent);
   EmberStatus status = emApiSetRadioChannelExtended(channel,
                                                     persistent);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_RADIO_CHANNEL_EXTENDED_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_RADIO_CHANNEL_EXTENDED_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -211,16 +195,14 @@ static void setRadioChannelExtendedCommandHandler(uint8_t *apiCommandData)
 static void setRadioChannelCommandHandler(uint8_t *apiCommandData)
 {
   uint16_t channel;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &channel);
+  cspFetchApiV(apiCommandData,
+               &channel);
   EmberStatus status = emApiSetRadioChannel(channel);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_RADIO_CHANNEL_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_RADIO_CHANNEL_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -229,11 +211,10 @@ static void getRadioChannelCommandHandler(uint8_t *apiCommandData)
 {
   uint16_t channel = emApiGetRadioChannel();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_RADIO_CHANNEL_IPC_COMMAND_ID,
-                                                 "v",
-                                                 channel);
+  uint16_t commandLength = cspFormatV(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_RADIO_CHANNEL_IPC_COMMAND_ID,
+                                      channel);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -242,18 +223,16 @@ static void setRadioPowerCommandHandler(uint8_t *apiCommandData)
 {
   int16_t power;
   bool persistent;
-  fetchApiParams(apiCommandData,
-                 "vu",
-                 &power,
-                 &persistent);
+  cspFetchApiVu(apiCommandData,
+                &power,
+                &persistent);
   EmberStatus status = emApiSetRadioPower(power,
                                           persistent);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_RADIO_POWER_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_RADIO_POWER_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -262,11 +241,10 @@ static void getRadioPowerCommandHandler(uint8_t *apiCommandData)
 {
   int16_t power = emApiGetRadioPower();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_RADIO_POWER_IPC_COMMAND_ID,
-                                                 "v",
-                                                 power);
+  uint16_t commandLength = cspFormatV(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_RADIO_POWER_IPC_COMMAND_ID,
+                                      power);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -274,16 +252,14 @@ static void getRadioPowerCommandHandler(uint8_t *apiCommandData)
 static void setRadioPowerModeCommandHandler(uint8_t *apiCommandData)
 {
   bool radioOn;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &radioOn);
+  cspFetchApiU(apiCommandData,
+               &radioOn);
   EmberStatus status = emApiSetRadioPowerMode(radioOn);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_RADIO_POWER_MODE_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_RADIO_POWER_MODE_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -299,17 +275,16 @@ static void setMacParamsCommandHandler(uint8_t *apiCommandData)
   uint8_t maxRetries;
   uint32_t csmaTimeout;
   uint16_t ackTimeout;
-  fetchApiParams(apiCommandData,
-                 "suuuvvuwv",
-                 &ccaThreshold,
-                 &maxCcaAttempts,
-                 &minBackoffExp,
-                 &maxBackoffExp,
-                 &ccaBackoff,
-                 &ccaDuration,
-                 &maxRetries,
-                 &csmaTimeout,
-                 &ackTimeout);
+  cspFetchApiSuuuvvuwv(apiCommandData,
+                       &ccaThreshold,
+                       &maxCcaAttempts,
+                       &minBackoffExp,
+                       &maxBackoffExp,
+                       &ccaBackoff,
+                       &ccaDuration,
+                       &maxRetries,
+                       &csmaTimeout,
+                       &ackTimeout);
   EmberStatus status = emApiSetMacParams(ccaThreshold,
                                          maxCcaAttempts,
                                          minBackoffExp,
@@ -320,11 +295,10 @@ static void setMacParamsCommandHandler(uint8_t *apiCommandData)
                                          csmaTimeout,
                                          ackTimeout);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_MAC_PARAMS_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_MAC_PARAMS_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -333,11 +307,10 @@ static void currentStackTasksCommandHandler(uint8_t *apiCommandData)
 {
   uint16_t currentTasks = emApiCurrentStackTasks();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_CURRENT_STACK_TASKS_IPC_COMMAND_ID,
-                                                 "v",
-                                                 currentTasks);
+  uint16_t commandLength = cspFormatV(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_CURRENT_STACK_TASKS_IPC_COMMAND_ID,
+                                      currentTasks);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -346,11 +319,10 @@ static void okToNapCommandHandler(uint8_t *apiCommandData)
 {
   bool isOkToNap = emApiOkToNap();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_OK_TO_NAP_IPC_COMMAND_ID,
-                                                 "u",
-                                                 isOkToNap);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_OK_TO_NAP_IPC_COMMAND_ID,
+                                      isOkToNap);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -359,11 +331,10 @@ static void okToHibernateCommandHandler(uint8_t *apiCommandData)
 {
   bool isOkToHibernate = emApiOkToHibernate();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_OK_TO_HIBERNATE_IPC_COMMAND_ID,
-                                                 "u",
-                                                 isOkToHibernate);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_OK_TO_HIBERNATE_IPC_COMMAND_ID,
+                                      isOkToHibernate);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -373,12 +344,11 @@ static void getEui64CommandHandler(uint8_t *apiCommandData)
   uint8_t eui64Size = EUI64_SIZE;
   uint8_t* eui64 = emApiGetEui64();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_EUI64_IPC_COMMAND_ID,
-                                                 "b",
-                                                 eui64,
-                                                 eui64Size);
+  uint16_t commandLength = cspFormatB(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_EUI64_IPC_COMMAND_ID,
+                                      eui64,
+                                      eui64Size);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -387,8 +357,7 @@ static void macGetParentAddressCommandHandler(uint8_t *apiCommandData)
 {
   EmberMacAddress parentAddress;
   uint8_t eui64Size = EUI64_SIZE;
-  fetchApiParams(apiCommandData,
-                 "vbu",
+  cspFetchApiVbu(apiCommandData,
                  &parentAddress.addr.shortAddress,
                  &parentAddress.addr.longAddress,
                  &eui64Size,
@@ -396,15 +365,14 @@ static void macGetParentAddressCommandHandler(uint8_t *apiCommandData)
                  &parentAddress.mode);
   EmberStatus status = emApiMacGetParentAddress(&parentAddress);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_MAC_GET_PARENT_ADDRESS_IPC_COMMAND_ID,
-                                                 "uvbu",
-                                                 status,
-                                                 parentAddress.addr.shortAddress,
-                                                 parentAddress.addr.longAddress,
-                                                 eui64Size,
-                                                 parentAddress.mode);
+  uint16_t commandLength = cspFormatUvbu(apiCommandBuffer,
+                                         MAX_STACK_API_COMMAND_SIZE,
+                                         EMBER_MAC_GET_PARENT_ADDRESS_IPC_COMMAND_ID,
+                                         status,
+                                         parentAddress.addr.shortAddress,
+                                         parentAddress.addr.longAddress,
+                                         eui64Size,
+                                         parentAddress.mode);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -413,18 +381,16 @@ static void isLocalEui64CommandHandler(uint8_t *apiCommandData)
 {
   uint8_t eui64[EUI64_SIZE];
   uint8_t eui64Size = EUI64_SIZE;
-  fetchApiParams(apiCommandData,
-                 "b",
-                 &eui64,
-                 &eui64Size,
-                 EUI64_SIZE);
+  cspFetchApiB(apiCommandData,
+               &eui64,
+               &eui64Size,
+               EUI64_SIZE);
   bool localEui64 = emApiIsLocalEui64(eui64);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_IS_LOCAL_EUI64_IPC_COMMAND_ID,
-                                                 "u",
-                                                 localEui64);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_IS_LOCAL_EUI64_IPC_COMMAND_ID,
+                                      localEui64);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -433,11 +399,10 @@ static void getNodeIdCommandHandler(uint8_t *apiCommandData)
 {
   EmberNodeId nodeId = emApiGetNodeId();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_NODE_ID_IPC_COMMAND_ID,
-                                                 "v",
-                                                 nodeId);
+  uint16_t commandLength = cspFormatV(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_NODE_ID_IPC_COMMAND_ID,
+                                      nodeId);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -446,11 +411,10 @@ static void getPanIdCommandHandler(uint8_t *apiCommandData)
 {
   EmberPanId panId = emApiGetPanId();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_PAN_ID_IPC_COMMAND_ID,
-                                                 "v",
-                                                 panId);
+  uint16_t commandLength = cspFormatV(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_PAN_ID_IPC_COMMAND_ID,
+                                      panId);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -459,11 +423,10 @@ static void getParentIdCommandHandler(uint8_t *apiCommandData)
 {
   EmberNodeId parentNodeId = emApiGetParentId();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_PARENT_ID_IPC_COMMAND_ID,
-                                                 "v",
-                                                 parentNodeId);
+  uint16_t commandLength = cspFormatV(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_PARENT_ID_IPC_COMMAND_ID,
+                                      parentNodeId);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -472,11 +435,10 @@ static void getNodeTypeCommandHandler(uint8_t *apiCommandData)
 {
   EmberNodeType nodeType = emApiGetNodeType();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_NODE_TYPE_IPC_COMMAND_ID,
-                                                 "u",
-                                                 nodeType);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_NODE_TYPE_IPC_COMMAND_ID,
+                                      nodeType);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -485,11 +447,10 @@ static void calibrateCurrentChannelCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiCalibrateCurrentChannel();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_CALIBRATE_CURRENT_CHANNEL_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_CALIBRATE_CURRENT_CHANNEL_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -498,18 +459,16 @@ static void calibrateCurrentChannelExtendedCommandHandler(uint8_t *apiCommandDat
 {
   uint32_t calValueIn;
   uint32_t calValueOut;
-  fetchApiParams(apiCommandData,
-                 "w",
-                 &calValueIn);
+  cspFetchApiW(apiCommandData,
+               &calValueIn);
   EmberStatus status = emApiCalibrateCurrentChannelExtended(calValueIn,
                                                             &calValueOut);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_CALIBRATE_CURRENT_CHANNEL_EXTENDED_IPC_COMMAND_ID,
-                                                 "uw",
-                                                 status,
-                                                 calValueOut);
+  uint16_t commandLength = cspFormatUw(apiCommandBuffer,
+                                       MAX_STACK_API_COMMAND_SIZE,
+                                       EMBER_CALIBRATE_CURRENT_CHANNEL_EXTENDED_IPC_COMMAND_ID,
+                                       status,
+                                       calValueOut);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -517,16 +476,14 @@ static void calibrateCurrentChannelExtendedCommandHandler(uint8_t *apiCommandDat
 static void applyIrCalibrationCommandHandler(uint8_t *apiCommandData)
 {
   uint32_t calValue;
-  fetchApiParams(apiCommandData,
-                 "w",
-                 &calValue);
+  cspFetchApiW(apiCommandData,
+               &calValue);
   EmberStatus status = emApiApplyIrCalibration(calValue);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_APPLY_IR_CALIBRATION_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_APPLY_IR_CALIBRATION_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -535,11 +492,10 @@ static void tempCalibrationCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiTempCalibration();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_TEMP_CALIBRATION_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_TEMP_CALIBRATION_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -548,11 +504,10 @@ static void getCalTypeCommandHandler(uint8_t *apiCommandData)
 {
   EmberCalType calType = emApiGetCalType();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_CAL_TYPE_IPC_COMMAND_ID,
-                                                 "w",
-                                                 calType);
+  uint16_t commandLength = cspFormatW(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_CAL_TYPE_IPC_COMMAND_ID,
+                                      calType);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -563,22 +518,20 @@ static void getMaximumPayloadLengthCommandHandler(uint8_t *apiCommandData)
   EmberMacAddressMode dstAddressMode;
   bool interpan;
   bool secured;
-  fetchApiParams(apiCommandData,
-                 "uuuu",
-                 &srcAddressMode,
-                 &dstAddressMode,
-                 &interpan,
-                 &secured);
+  cspFetchApiUuuu(apiCommandData,
+                  &srcAddressMode,
+                  &dstAddressMode,
+                  &interpan,
+                  &secured);
   uint8_t payloadLength = emApiGetMaximumPayloadLength(srcAddressMode,
                                                        dstAddressMode,
                                                        interpan,
                                                        secured);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_MAXIMUM_PAYLOAD_LENGTH_IPC_COMMAND_ID,
-                                                 "u",
-                                                 payloadLength);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_MAXIMUM_PAYLOAD_LENGTH_IPC_COMMAND_ID,
+                                      payloadLength);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -586,16 +539,14 @@ static void getMaximumPayloadLengthCommandHandler(uint8_t *apiCommandData)
 static void setIndirectQueueTimeoutCommandHandler(uint8_t *apiCommandData)
 {
   uint32_t timeoutMs;
-  fetchApiParams(apiCommandData,
-                 "w",
-                 &timeoutMs);
+  cspFetchApiW(apiCommandData,
+               &timeoutMs);
   EmberStatus status = emApiSetIndirectQueueTimeout(timeoutMs);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_INDIRECT_QUEUE_TIMEOUT_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_INDIRECT_QUEUE_TIMEOUT_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -608,15 +559,14 @@ static void messageSendCommandHandler(uint8_t *apiCommandData)
   EmberMessageLength messageLength;
   EmberMessageOptions options;
   uint8_t *message;
-  fetchApiParams(apiCommandData,
-                 "vuuupu",
-                 &destination,
-                 &endpoint,
-                 &messageTag,
-                 &messageLength,
-                 &message,
-                 &messageLength,
-                 &options);
+  cspFetchApiVuuupu(apiCommandData,
+                    &destination,
+                    &endpoint,
+                    &messageTag,
+                    &messageLength,
+                    &message,
+                    &messageLength,
+                    &options);
   EmberStatus status = emApiMessageSend(destination,
                                         endpoint,
                                         messageTag,
@@ -624,11 +574,10 @@ static void messageSendCommandHandler(uint8_t *apiCommandData)
                                         message,
                                         options);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_MESSAGE_SEND_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_MESSAGE_SEND_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -637,11 +586,10 @@ static void pollForDataCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiPollForData();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_POLL_FOR_DATA_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_POLL_FOR_DATA_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -654,38 +602,36 @@ static void macMessageSendCommandHandler(uint8_t *apiCommandData)
   EmberMessageOptions options;
   uint8_t eui64Size = EUI64_SIZE;
   uint8_t *message;
-  fetchApiParams(apiCommandData,
-                 "vbuvbuvvuuuupu",
-                 &macFrame.srcAddress.addr.shortAddress,
-                 &macFrame.srcAddress.addr.longAddress,
-                 &eui64Size,
-                 EUI64_SIZE,
-                 &macFrame.srcAddress.mode,
-                 &macFrame.dstAddress.addr.shortAddress,
-                 &macFrame.dstAddress.addr.longAddress,
-                 &eui64Size,
-                 EUI64_SIZE,
-                 &macFrame.dstAddress.mode,
-                 &macFrame.srcPanId,
-                 &macFrame.dstPanId,
-                 &macFrame.srcPanIdSpecified,
-                 &macFrame.dstPanIdSpecified,
-                 &messageTag,
-                 &messageLength,
-                 &message,
-                 &messageLength,
-                 &options);
+  cspFetchApiVbuvbuvvuuuupu(apiCommandData,
+                            &macFrame.srcAddress.addr.shortAddress,
+                            &macFrame.srcAddress.addr.longAddress,
+                            &eui64Size,
+                            EUI64_SIZE,
+                            &macFrame.srcAddress.mode,
+                            &macFrame.dstAddress.addr.shortAddress,
+                            &macFrame.dstAddress.addr.longAddress,
+                            &eui64Size,
+                            EUI64_SIZE,
+                            &macFrame.dstAddress.mode,
+                            &macFrame.srcPanId,
+                            &macFrame.dstPanId,
+                            &macFrame.srcPanIdSpecified,
+                            &macFrame.dstPanIdSpecified,
+                            &messageTag,
+                            &messageLength,
+                            &message,
+                            &messageLength,
+                            &options);
   EmberStatus status = emApiMacMessageSend(&macFrame,
                                            messageTag,
                                            messageLength,
                                            message,
                                            options);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_MAC_MESSAGE_SEND_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_MAC_MESSAGE_SEND_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -693,16 +639,14 @@ static void macMessageSendCommandHandler(uint8_t *apiCommandData)
 static void macSetPanCoordinatorCommandHandler(uint8_t *apiCommandData)
 {
   bool isCoordinator;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &isCoordinator);
+  cspFetchApiU(apiCommandData,
+               &isCoordinator);
   EmberStatus status = emApiMacSetPanCoordinator(isCoordinator);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_MAC_SET_PAN_COORDINATOR_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_MAC_SET_PAN_COORDINATOR_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -711,8 +655,7 @@ static void setPollDestinationAddressCommandHandler(uint8_t *apiCommandData)
 {
   EmberMacAddress destination;
   uint8_t eui64Size = EUI64_SIZE;
-  fetchApiParams(apiCommandData,
-                 "vbu",
+  cspFetchApiVbu(apiCommandData,
                  &destination.addr.shortAddress,
                  &destination.addr.longAddress,
                  &eui64Size,
@@ -720,11 +663,10 @@ static void setPollDestinationAddressCommandHandler(uint8_t *apiCommandData)
                  &destination.mode);
   EmberStatus status = emApiSetPollDestinationAddress(&destination);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_POLL_DESTINATION_ADDRESS_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_POLL_DESTINATION_ADDRESS_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -733,8 +675,7 @@ static void removeChildCommandHandler(uint8_t *apiCommandData)
 {
   EmberMacAddress address;
   uint8_t eui64Size = EUI64_SIZE;
-  fetchApiParams(apiCommandData,
-                 "vbu",
+  cspFetchApiVbu(apiCommandData,
                  &address.addr.shortAddress,
                  &address.addr.longAddress,
                  &eui64Size,
@@ -742,11 +683,10 @@ static void removeChildCommandHandler(uint8_t *apiCommandData)
                  &address.mode);
   EmberStatus status = emApiRemoveChild(&address);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_REMOVE_CHILD_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_REMOVE_CHILD_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -756,8 +696,7 @@ static void getChildFlagsCommandHandler(uint8_t *apiCommandData)
   EmberMacAddress address;
   EmberChildFlags flags;
   uint8_t eui64Size = EUI64_SIZE;
-  fetchApiParams(apiCommandData,
-                 "vbu",
+  cspFetchApiVbu(apiCommandData,
                  &address.addr.shortAddress,
                  &address.addr.longAddress,
                  &eui64Size,
@@ -766,12 +705,11 @@ static void getChildFlagsCommandHandler(uint8_t *apiCommandData)
   EmberStatus status = emApiGetChildFlags(&address,
                                           &flags);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_CHILD_FLAGS_IPC_COMMAND_ID,
-                                                 "uu",
-                                                 status,
-                                                 flags);
+  uint16_t commandLength = cspFormatUu(apiCommandBuffer,
+                                       MAX_STACK_API_COMMAND_SIZE,
+                                       EMBER_GET_CHILD_FLAGS_IPC_COMMAND_ID,
+                                       status,
+                                       flags);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -782,8 +720,7 @@ static void getChildInfoCommandHandler(uint8_t *apiCommandData)
   EmberMacAddress addressResp;
   EmberChildFlags flags;
   uint8_t eui64Size = EUI64_SIZE;
-  fetchApiParams(apiCommandData,
-                 "vbu",
+  cspFetchApiVbu(apiCommandData,
                  &address.addr.shortAddress,
                  &address.addr.longAddress,
                  &eui64Size,
@@ -793,16 +730,15 @@ static void getChildInfoCommandHandler(uint8_t *apiCommandData)
                                          &addressResp,
                                          &flags);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_CHILD_INFO_IPC_COMMAND_ID,
-                                                 "uvbuu",
-                                                 status,
-                                                 addressResp.addr.shortAddress,
-                                                 addressResp.addr.longAddress,
-                                                 eui64Size,
-                                                 address.mode,
-                                                 flags);
+  uint16_t commandLength = cspFormatUvbuu(apiCommandBuffer,
+                                          MAX_STACK_API_COMMAND_SIZE,
+                                          EMBER_GET_CHILD_INFO_IPC_COMMAND_ID,
+                                          status,
+                                          addressResp.addr.shortAddress,
+                                          addressResp.addr.longAddress,
+                                          eui64Size,
+                                          address.mode,
+                                          flags);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -811,11 +747,10 @@ static void purgeIndirectMessagesCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiPurgeIndirectMessages();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_PURGE_INDIRECT_MESSAGES_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_PURGE_INDIRECT_MESSAGES_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -825,20 +760,18 @@ static void macAddShortToLongAddressMappingCommandHandler(uint8_t *apiCommandDat
   EmberNodeId shortId;
   uint8_t longId[EUI64_SIZE];
   uint8_t eui64Size = EUI64_SIZE;
-  fetchApiParams(apiCommandData,
-                 "vb",
-                 &shortId,
-                 &longId,
-                 &eui64Size,
-                 EUI64_SIZE);
+  cspFetchApiVb(apiCommandData,
+                &shortId,
+                &longId,
+                &eui64Size,
+                EUI64_SIZE);
   EmberStatus status = emApiMacAddShortToLongAddressMapping(shortId,
                                                             longId);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_MAC_ADD_SHORT_TO_LONG_ADDRESS_MAPPING_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_MAC_ADD_SHORT_TO_LONG_ADDRESS_MAPPING_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -847,11 +780,10 @@ static void macClearShortToLongAddressMappingsCommandHandler(uint8_t *apiCommand
 {
   EmberStatus status = emApiMacClearShortToLongAddressMappings();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_MAC_CLEAR_SHORT_TO_LONG_ADDRESS_MAPPINGS_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_MAC_CLEAR_SHORT_TO_LONG_ADDRESS_MAPPINGS_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -860,11 +792,10 @@ static void networkLeaveCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiNetworkLeave();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_NETWORK_LEAVE_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_NETWORK_LEAVE_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -873,11 +804,10 @@ static void networkInitCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiNetworkInit();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_NETWORK_INIT_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_NETWORK_INIT_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -885,16 +815,14 @@ static void networkInitCommandHandler(uint8_t *apiCommandData)
 static void startActiveScanCommandHandler(uint8_t *apiCommandData)
 {
   uint16_t channel;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &channel);
+  cspFetchApiV(apiCommandData,
+               &channel);
   EmberStatus status = emApiStartActiveScan(channel);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_START_ACTIVE_SCAN_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_START_ACTIVE_SCAN_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -903,18 +831,16 @@ static void startEnergyScanCommandHandler(uint8_t *apiCommandData)
 {
   uint16_t channel;
   uint8_t samples;
-  fetchApiParams(apiCommandData,
-                 "vu",
-                 &channel,
-                 &samples);
+  cspFetchApiVu(apiCommandData,
+                &channel,
+                &samples);
   EmberStatus status = emApiStartEnergyScan(channel,
                                             samples);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_START_ENERGY_SCAN_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_START_ENERGY_SCAN_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -923,18 +849,16 @@ static void setApplicationBeaconPayloadCommandHandler(uint8_t *apiCommandData)
 {
   uint8_t payloadLength;
   uint8_t *payload;
-  fetchApiParams(apiCommandData,
-                 "p",
-                 &payload,
-                 &payloadLength);
+  cspFetchApiP(apiCommandData,
+               &payload,
+               &payloadLength);
   EmberStatus status = emApiSetApplicationBeaconPayload(payloadLength,
                                                         payload);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_APPLICATION_BEACON_PAYLOAD_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_APPLICATION_BEACON_PAYLOAD_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -943,18 +867,16 @@ static void setSelectiveJoinPayloadCommandHandler(uint8_t *apiCommandData)
 {
   uint8_t payloadLength;
   uint8_t *payload;
-  fetchApiParams(apiCommandData,
-                 "p",
-                 &payload,
-                 &payloadLength);
+  cspFetchApiP(apiCommandData,
+               &payload,
+               &payloadLength);
   EmberStatus status = emApiSetSelectiveJoinPayload(payloadLength,
                                                     payload);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -963,11 +885,10 @@ static void clearSelectiveJoinPayloadCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiClearSelectiveJoinPayload();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_CLEAR_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_CLEAR_SELECTIVE_JOIN_PAYLOAD_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -975,18 +896,16 @@ static void clearSelectiveJoinPayloadCommandHandler(uint8_t *apiCommandData)
 static void formNetworkCommandHandler(uint8_t *apiCommandData)
 {
   EmberNetworkParameters parameters;
-  fetchApiParams(apiCommandData,
-                 "vvv",
+  cspFetchApiVvv(apiCommandData,
                  &parameters.panId,
                  &parameters.radioTxPower,
                  &parameters.radioChannel);
   EmberStatus status = emApiFormNetwork(&parameters);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_FORM_NETWORK_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_FORM_NETWORK_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -996,22 +915,20 @@ static void joinNetworkExtendedCommandHandler(uint8_t *apiCommandData)
   EmberNodeType nodeType;
   EmberNodeId nodeId;
   EmberNetworkParameters parameters;
-  fetchApiParams(apiCommandData,
-                 "uvvvv",
-                 &nodeType,
-                 &nodeId,
-                 &parameters.panId,
-                 &parameters.radioTxPower,
-                 &parameters.radioChannel);
+  cspFetchApiUvvvv(apiCommandData,
+                   &nodeType,
+                   &nodeId,
+                   &parameters.panId,
+                   &parameters.radioTxPower,
+                   &parameters.radioChannel);
   EmberStatus status = emApiJoinNetworkExtended(nodeType,
                                                 nodeId,
                                                 &parameters);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_JOIN_NETWORK_EXTENDED_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_JOIN_NETWORK_EXTENDED_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1020,20 +937,18 @@ static void joinNetworkCommandHandler(uint8_t *apiCommandData)
 {
   EmberNodeType nodeType;
   EmberNetworkParameters parameters;
-  fetchApiParams(apiCommandData,
-                 "uvvv",
-                 &nodeType,
-                 &parameters.panId,
-                 &parameters.radioTxPower,
-                 &parameters.radioChannel);
+  cspFetchApiUvvv(apiCommandData,
+                  &nodeType,
+                  &parameters.panId,
+                  &parameters.radioTxPower,
+                  &parameters.radioChannel);
   EmberStatus status = emApiJoinNetwork(nodeType,
                                         &parameters);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_JOIN_NETWORK_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_JOIN_NETWORK_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1041,18 +956,16 @@ static void joinNetworkCommandHandler(uint8_t *apiCommandData)
 static void macFormNetworkCommandHandler(uint8_t *apiCommandData)
 {
   EmberNetworkParameters parameters;
-  fetchApiParams(apiCommandData,
-                 "vvv",
+  cspFetchApiVvv(apiCommandData,
                  &parameters.panId,
                  &parameters.radioTxPower,
                  &parameters.radioChannel);
   EmberStatus status = emApiMacFormNetwork(&parameters);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_MAC_FORM_NETWORK_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_MAC_FORM_NETWORK_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1060,16 +973,14 @@ static void macFormNetworkCommandHandler(uint8_t *apiCommandData)
 static void permitJoiningCommandHandler(uint8_t *apiCommandData)
 {
   uint8_t duration;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &duration);
+  cspFetchApiU(apiCommandData,
+               &duration);
   EmberStatus status = emApiPermitJoining(duration);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_PERMIT_JOINING_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_PERMIT_JOINING_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1079,22 +990,20 @@ static void joinCommissionedCommandHandler(uint8_t *apiCommandData)
   EmberNodeType nodeType;
   EmberNodeId nodeId;
   EmberNetworkParameters parameters;
-  fetchApiParams(apiCommandData,
-                 "uvvvv",
-                 &nodeType,
-                 &nodeId,
-                 &parameters.panId,
-                 &parameters.radioTxPower,
-                 &parameters.radioChannel);
+  cspFetchApiUvvvv(apiCommandData,
+                   &nodeType,
+                   &nodeId,
+                   &parameters.panId,
+                   &parameters.radioTxPower,
+                   &parameters.radioChannel);
   EmberStatus status = emApiJoinCommissioned(nodeType,
                                              nodeId,
                                              &parameters);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_JOIN_COMMISSIONED_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_JOIN_COMMISSIONED_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1103,10 +1012,9 @@ static void resetNetworkStateCommandHandler(uint8_t *apiCommandData)
 {
   emApiResetNetworkState();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_RESET_NETWORK_STATE_IPC_COMMAND_ID,
-                                                 "");
+  uint16_t commandLength = cspFormatEmpty(apiCommandBuffer,
+                                          MAX_STACK_API_COMMAND_SIZE,
+                                          EMBER_RESET_NETWORK_STATE_IPC_COMMAND_ID);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1115,18 +1023,16 @@ static void frequencyHoppingSetChannelMaskCommandHandler(uint8_t *apiCommandData
 {
   uint8_t channelMaskLength;
   uint8_t *channelMask;
-  fetchApiParams(apiCommandData,
-                 "p",
-                 &channelMask,
-                 &channelMaskLength);
+  cspFetchApiP(apiCommandData,
+               &channelMask,
+               &channelMaskLength);
   EmberStatus status = emApiFrequencyHoppingSetChannelMask(channelMaskLength,
                                                            channelMask);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_FREQUENCY_HOPPING_SET_CHANNEL_MASK_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_FREQUENCY_HOPPING_SET_CHANNEL_MASK_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1135,11 +1041,10 @@ static void frequencyHoppingStartServerCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiFrequencyHoppingStartServer();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_FREQUENCY_HOPPING_START_SERVER_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_FREQUENCY_HOPPING_START_SERVER_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1148,18 +1053,16 @@ static void frequencyHoppingStartClientCommandHandler(uint8_t *apiCommandData)
 {
   EmberNodeId serverNodeId;
   EmberPanId serverPanId;
-  fetchApiParams(apiCommandData,
-                 "vv",
-                 &serverNodeId,
-                 &serverPanId);
+  cspFetchApiVv(apiCommandData,
+                &serverNodeId,
+                &serverPanId);
   EmberStatus status = emApiFrequencyHoppingStartClient(serverNodeId,
                                                         serverPanId);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_FREQUENCY_HOPPING_START_CLIENT_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_FREQUENCY_HOPPING_START_CLIENT_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1168,11 +1071,10 @@ static void frequencyHoppingStopCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiFrequencyHoppingStop();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_FREQUENCY_HOPPING_STOP_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_FREQUENCY_HOPPING_STOP_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1181,18 +1083,16 @@ static void setAuxiliaryAddressFilteringEntryCommandHandler(uint8_t *apiCommandD
 {
   EmberNodeId nodeId;
   uint8_t entryIndex;
-  fetchApiParams(apiCommandData,
-                 "vu",
-                 &nodeId,
-                 &entryIndex);
+  cspFetchApiVu(apiCommandData,
+                &nodeId,
+                &entryIndex);
   EmberStatus status = emApiSetAuxiliaryAddressFilteringEntry(nodeId,
                                                               entryIndex);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1200,16 +1100,14 @@ static void setAuxiliaryAddressFilteringEntryCommandHandler(uint8_t *apiCommandD
 static void getAuxiliaryAddressFilteringEntryCommandHandler(uint8_t *apiCommandData)
 {
   uint8_t entryIndex;
-  fetchApiParams(apiCommandData,
-                 "u",
-                 &entryIndex);
+  cspFetchApiU(apiCommandData,
+               &entryIndex);
   EmberNodeId nodeId = emApiGetAuxiliaryAddressFilteringEntry(entryIndex);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID,
-                                                 "v",
-                                                 nodeId);
+  uint16_t commandLength = cspFormatV(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_AUXILIARY_ADDRESS_FILTERING_ENTRY_IPC_COMMAND_ID,
+                                      nodeId);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1218,18 +1116,16 @@ static void startTxStreamCommandHandler(uint8_t *apiCommandData)
 {
   EmberTxStreamParameters parameters;
   uint16_t channel;
-  fetchApiParams(apiCommandData,
-                 "uv",
-                 &parameters,
-                 &channel);
+  cspFetchApiUv(apiCommandData,
+                &parameters,
+                &channel);
   EmberStatus status = emApiStartTxStream(parameters,
                                           channel);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_START_TX_STREAM_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_START_TX_STREAM_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1238,11 +1134,10 @@ static void stopTxStreamCommandHandler(uint8_t *apiCommandData)
 {
   EmberStatus status = emApiStopTxStream();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_STOP_TX_STREAM_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_STOP_TX_STREAM_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1250,16 +1145,14 @@ static void stopTxStreamCommandHandler(uint8_t *apiCommandData)
 static void setActiveScanDurationCommandHandler(uint8_t *apiCommandData)
 {
   uint16_t durationMs;
-  fetchApiParams(apiCommandData,
-                 "v",
-                 &durationMs);
+  cspFetchApiV(apiCommandData,
+               &durationMs);
   EmberStatus status = emApiSetActiveScanDuration(durationMs);
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_SET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID,
-                                                 "u",
-                                                 status);
+  uint16_t commandLength = cspFormatU(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_SET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID,
+                                      status);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1268,11 +1161,10 @@ static void getActiveScanDurationCommandHandler(uint8_t *apiCommandData)
 {
   uint16_t durationMs = emApiGetActiveScanDuration();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID,
-                                                 "v",
-                                                 durationMs);
+  uint16_t commandLength = cspFormatV(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_ACTIVE_SCAN_DURATION_IPC_COMMAND_ID,
+                                      durationMs);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -1281,11 +1173,10 @@ static void getDefaultChannelCommandHandler(uint8_t *apiCommandData)
 {
   uint16_t firstChannel = emApiGetDefaultChannel();
   uint8_t *apiCommandBuffer = getApiCommandPointer();
-  uint16_t commandLength = formatResponseCommand(apiCommandBuffer,
-                                                 MAX_STACK_API_COMMAND_SIZE,
-                                                 EMBER_GET_DEFAULT_CHANNEL_IPC_COMMAND_ID,
-                                                 "v",
-                                                 firstChannel);
+  uint16_t commandLength = cspFormatV(apiCommandBuffer,
+                                      MAX_STACK_API_COMMAND_SIZE,
+                                      EMBER_GET_DEFAULT_CHANNEL_IPC_COMMAND_ID,
+                                      firstChannel);
   sendResponse(apiCommandBuffer, commandLength);
 }
 
@@ -16,6 +16,10 @@
 
 #include "stack/include/ember.h"
 
+// The command code calls the routines generated in csp-codec-gen.c for the
+// layouts it knows, see csp-codec-gen.py. The interpreter below covers the
+// formats only known at run time.
+
 // TODO: the two functions below can be consolidated
 
 void fetchParams(uint8_t *readPointer, PGM_P format, va_list args)
@@ -158,8 +162,6 @@ uint16_t formatResponseCommandFromArgList(uint8_t *buffer,
   uint8_t *finger = buffer;
   const char *formatFinger;
 
-  MEMSET(buffer, 0, bufferSize);
-
   // store the identifier
   emberStoreHighLowInt16u(finger, identifier);
   finger += sizeof(uint16_t);
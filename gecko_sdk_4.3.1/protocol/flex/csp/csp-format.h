@@ -24,6 +24,10 @@
 #define MAX_STACK_API_COMMAND_SIZE                      160
 #define MAX_STACK_CALLBACK_COMMAND_SIZE                 160
 
+// The routines generated for the layouts of the command code, which stand for
+// the functions below called with a literal format.
+#include "csp-codec-gen.h"
+
 /**
  * Extract data from the buffer into va_list according to the format
  */
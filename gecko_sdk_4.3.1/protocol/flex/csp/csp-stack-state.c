@@ -0,0 +1,107 @@
+/***************************************************************************//**
+ * @brief Snapshot of read-mostly stack state shared with application tasks
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#include PLATFORM_HEADER
+
+#include "stack/include/ember.h"
+#include "stack/core/sli-connect-api.h"
+
+#include <em_core.h>
+
+#include "csp-api-enum-gen.h"
+#include "csp-stack-state.h"
+
+// A reader preempted by the stack task more often than this in a row gives
+// up and takes the blocking path. This also keeps a reader that runs above the
+// priority of the stack task from spinning on an update it preempted.
+#define STACK_STATE_READ_ATTEMPTS 4
+
+static CspStackState stackState;
+static volatile uint32_t stackStateSequence;
+
+void cspRefreshStackState(void)
+{
+  CspStackState state;
+
+  assert(isCurrentTaskStackTask());
+
+  state.valid = true;
+  state.stackIsUp = emApiStackIsUp();
+  state.networkState = emApiNetworkState();
+  state.nodeType = emApiGetNodeType();
+  state.nodeId = emApiGetNodeId();
+  state.panId = emApiGetPanId();
+  state.radioChannel = emApiGetRadioChannel();
+  state.radioPower = emApiGetRadioPower();
+
+  // Single writer: only the stack task gets here, so a plain increment is
+  // enough. The barriers order the snapshot stores between the two counter
+  // updates.
+  stackStateSequence++;
+  __DMB();
+  stackState = state;
+  __DMB();
+  stackStateSequence++;
+}
+
+bool cspGetStackState(uint8_t getter, CspStackState *state)
+{
+  uint8_t attempt;
+
+  if ((EMBER_AF_PLUGIN_CMSIS_RTOS_STACK_STATE_GETTERS & getter) == 0) {
+    return false;
+  }
+
+  for (attempt = 0; attempt < STACK_STATE_READ_ATTEMPTS; attempt++) {
+    uint32_t sequence = stackStateSequence;
+    if (sequence & 1) {
+      continue;
+    }
+    __DMB();
+    *state = stackState;
+    __DMB();
+    if (stackStateSequence == sequence) {
+      return state->valid;
+    }
+  }
+
+  return false;
+}
+
+void cspRefreshStackStateOnCommand(uint16_t commandId)
+{
+  switch (commandId) {
+    case EMBER_STACK_STATUS_HANDLER_IPC_COMMAND_ID:
+    case EMBER_SET_RADIO_CHANNEL_EXTENDED_IPC_COMMAND_ID:
+    case EMBER_SET_RADIO_CHANNEL_IPC_COMMAND_ID:
+    case EMBER_SET_RADIO_POWER_IPC_COMMAND_ID:
+    case EMBER_NETWORK_LEAVE_IPC_COMMAND_ID:
+    case EMBER_NETWORK_INIT_IPC_COMMAND_ID:
+    case EMBER_FORM_NETWORK_IPC_COMMAND_ID:
+    case EMBER_JOIN_NETWORK_EXTENDED_IPC_COMMAND_ID:
+    case EMBER_JOIN_NETWORK_IPC_COMMAND_ID:
+    case EMBER_MAC_FORM_NETWORK_IPC_COMMAND_ID:
+    case EMBER_JOIN_COMMISSIONED_IPC_COMMAND_ID:
+    case EMBER_RESET_NETWORK_STATE_IPC_COMMAND_ID:
+    case EMBER_FREQUENCY_HOPPING_START_SERVER_IPC_COMMAND_ID:
+    case EMBER_FREQUENCY_HOPPING_START_CLIENT_IPC_COMMAND_ID:
+    case EMBER_FREQUENCY_HOPPING_STOP_IPC_COMMAND_ID:
+      cspRefreshStackState();
+      break;
+    default:
+      break;
+  }
+}
@@ -0,0 +1,70 @@
+/***************************************************************************//**
+ * @brief Snapshot of read-mostly stack state shared with application tasks
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef __CSP_STACK_STATE_H__
+#define __CSP_STACK_STATE_H__
+
+// The stack task publishes this snapshot whenever the state it holds may have
+// changed: on every stack status change and after every API that modifies it.
+// The blocking commands of the matching getters are answered from the snapshot
+// in the calling task instead of doing a round trip to the stack task, if
+// selected in EMBER_AF_PLUGIN_CMSIS_RTOS_STACK_STATE_GETTERS. Until the first
+// refresh the snapshot is invalid and the getters take the blocking path.
+//
+// The getters read the snapshot before claiming a command slot, through the
+// prologue csp-codec-gen.py adds to them in csp-command-app.c: they are
+// answered even while every slot is taken by other tasks.
+//
+// The snapshot is guarded by a sequence counter rather than a critical
+// section: the stack task is the only writer and makes the counter odd while
+// it updates the snapshot, readers retry when the counter was odd or changed
+// during their copy. Neither side masks interrupts.
+
+#include "cmsis-rtos-ipc-config.h"
+
+typedef struct {
+  bool valid;
+  bool stackIsUp;
+  EmberNetworkStatus networkState;
+  EmberNodeType nodeType;
+  EmberNodeId nodeId;
+  EmberPanId panId;
+  uint16_t radioChannel;
+  int16_t radioPower;
+} CspStackState;
+
+/**
+ * Take a new snapshot of the stack state. Must be called from the stack task.
+ */
+void cspRefreshStackState(void);
+
+/**
+ * Copy the latest snapshot into state, on behalf of the getter identified by
+ * its CMSIS_RTOS_STACK_STATE_ bit. Returns false if that getter is not served
+ * from the snapshot, if no snapshot was taken yet or if the snapshot kept
+ * changing while being read; the caller then takes the blocking path and the
+ * content of state must not be used.
+ */
+bool cspGetStackState(uint8_t getter, CspStackState *state);
+
+/**
+ * Refresh the snapshot if the API command or stack callback identified by
+ * commandId may have changed the stack state. Must be called from the stack
+ * task, after the API ran and before its response or callback is posted.
+ */
+void cspRefreshStackStateOnCommand(uint16_t commandId);
+
+#endif // __CSP_STACK_STATE_H__
@@ -185,13 +185,36 @@
  */
 #define EMBER_TASK_COUNT (3)
 
+#if defined(SL_COMPONENT_CATALOG_PRESENT)
+#include "sl_component_catalog.h"
+#endif
+
+#if defined(SL_CATALOG_CONNECT_APP_FRAMEWORK_COMMON_PRESENT)
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+// The Application Framework keeps its events ordered by expiry time, so the
+// controls below report every change to it. Controls of other events are
+// ignored. Application event controls must only change through these macros:
+// one whose fields are written directly is not supported and never runs.
+void emAfEventControlScheduled(EmberEventControl *control, uint32_t delayMs);
+void emAfEventControlCancelled(EmberEventControl *control);
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+#define EM_EVENT_CONTROL_SCHEDULED(control, delayMs) \
+  emAfEventControlScheduled(&(control), (delayMs))
+#define EM_EVENT_CONTROL_CANCELLED(control) \
+  emAfEventControlCancelled(&(control))
+#else
+#define EM_EVENT_CONTROL_SCHEDULED(control, delayMs) ((void)0)
+#define EM_EVENT_CONTROL_CANCELLED(control) ((void)0)
+#endif
+
 /**
  * @brief Set ::EmberEventControl as inactive (no pending event).
  *
  * @param[in] control Control of the event to set inactive.
  */
-#define emberEventControlSetInactive(control) \
-  do { (control).status = EMBER_EVENT_INACTIVE; } while (0)
+#define emberEventControlSetInactive(control)         \
+  do { (control).status = EMBER_EVENT_INACTIVE;       \
+       EM_EVENT_CONTROL_CANCELLED(control); } while (0)
 
 /**
  * @brief Check whether ::EmberEventControl is currently active. An event
@@ -213,8 +236,9 @@
  *
  * @param[in] control Control of the event to set active.
  */
-#define emberEventControlSetActive(control) \
-  do { sli_event_control_set_active(&(control)); } while (0)
+#define emberEventControlSetActive(control)     \
+  do { sli_event_control_set_active(&(control)); \
+       EM_EVENT_CONTROL_SCHEDULED(control, 0); } while (0)
 
 /**
  * @copybrief emberEventControlSetActive
@@ -236,8 +260,9 @@ void sli_event_control_set_active(EmberEventControl *event);
  *   The delay in milliseconds. Must be less than
  *   @ref EMBER_MAX_EVENT_CONTROL_DELAY_MS
  */
-#define emberEventControlSetDelayMS(control, delay) \
-  do { emEventControlSetDelayMS(&(control), (delay)); } while (0)
+#define emberEventControlSetDelayMS(control, delay)    \
+  do { emEventControlSetDelayMS(&(control), (delay)); \
+       EM_EVENT_CONTROL_SCHEDULED(control, (delay)); } while (0)
 
 /**
  * @copybrief emberEventControlSetDelayMS
@@ -263,8 +288,9 @@ void emEventControlSetDelayMS(EmberEventControl*event, uint32_t delay);
  *   less than  @ref EMBER_MAX_EVENT_CONTROL_DELAY_QS
  * @warning Applications should use @ref emberEventControlSetDelayQS() instead.
  */
-#define emberEventControlSetDelayQS(control, delay) \
-  do { emEventControlSetDelayMS(&(control), (delay) << 8); } while (0)
+#define emberEventControlSetDelayQS(control, delay)         \
+  do { emEventControlSetDelayMS(&(control), (delay) << 8); \
+       EM_EVENT_CONTROL_SCHEDULED(control, (delay) << 8); } while (0)
 
 /** @brief The maximum delay that may be passed to
  * ::emberEventControlSetDelayMinutes().
@@ -278,8 +304,9 @@ void emEventControlSetDelayMS(EmberEventControl*event, uint32_t delay);
  *   The delay in minute. One minute is actually 65536 ms. Must be
  *   less than  @ref EMBER_MAX_EVENT_CONTROL_DELAY_MINUTES
  */
-#define emberEventControlSetDelayMinutes(control, delay) \
-  do { emEventControlSetDelayMS(&(control), (delay) << 16); } while (0)
+#define emberEventControlSetDelayMinutes(control, delay)     \
+  do { emEventControlSetDelayMS(&(control), (delay) << 16); \
+       EM_EVENT_CONTROL_SCHEDULED(control, (delay) << 16); } while (0)
 
 /**
  * @brief Check when the event is scheduled to run.
@@ -0,0 +1,822 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host checks and benchmark of the CMSIS IPC layer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include PLATFORM_HEADER
+#include "stack/include/ember.h"
+#include "app_framework_common.h"
+#include "app_framework_callback.h"
+#include "callback_dispatcher.h"
+#include "cmsis-rtos-ipc-config.h"
+#include "cmsis-rtos-support.h"
+#include "csp-api-enum-gen.h"
+#include "csp-command-utils.h"
+#include "sl_sleeptimer.h"
+#include "bench_util.h"
+#include "fake_stack.h"
+
+// The unmodified IPC layer, Connect and app framework tasks and CSP commands
+// run on POSIX threads through the CMSIS-RTOS2 shim. The fake stack answers
+// the API calls in the stack task and emits callbacks on request. The app
+// framework task dispatches them to the callbacks below, which record what
+// arrives and when. The harness can hold the app framework task, to fill the
+// callback queue up deterministically.
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define QUEUE_SIZE                   EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE
+#define WAIT_TIMEOUT_S               10
+
+#define CHECK_THREADS                (EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS + 2)
+#define CHECK_CALLS                  2000u
+#define CHECK_PAYLOAD                16u
+#define CHECK_OVERFLOW_INCOMING      (3u * QUEUE_SIZE)
+#define CHECK_OVERFLOW_SENT          (QUEUE_SIZE / 2u)
+
+#define BENCH_CALLS                  20000u
+#define BENCH_MAX_THREADS            4u
+#define BENCH_PAYLOAD                64u
+// Keeps the drops within the 16 bit drop counters.
+#define BENCH_CALLBACKS              50000u
+
+#define MAX_RECORDS                  (BENCH_CALLBACKS + 1000u)
+
+typedef enum {
+  BLOCKING_GET_COUNTER,
+  BLOCKING_MESSAGE_SEND,
+  BLOCKING_GET_NODE_ID,
+} blocking_call_t;
+
+typedef struct {
+  uint32_t index;
+  blocking_call_t call;
+  uint32_t calls;
+  uint64_t *samples;
+  osSemaphoreId_t done;
+} worker_t;
+
+typedef struct {
+  osSemaphoreId_t held;
+  osSemaphoreId_t release;
+} slot_holder_t;
+
+typedef struct {
+  const char *name;
+  void (*run)(void);
+} check_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static volatile uint32_t failure_count;
+
+// What the app framework task got, protected by af_lock.
+static pthread_mutex_t af_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t af_changed = PTHREAD_COND_INITIALIZER;
+static bool af_hold;
+static bool af_held;
+static uint32_t delivered_incoming;
+static uint32_t delivered_sent;
+static uint32_t delivered_sequences[MAX_RECORDS];
+static uint64_t delivered_latencies[MAX_RECORDS];
+static uint32_t delivered_count;
+static uint32_t delivered_statuses;
+static EmberStatus last_status;
+static osSemaphoreId_t done_getter;
+
+// -----------------------------------------------------------------------------
+//                                    Checks
+// -----------------------------------------------------------------------------
+#define CHECK(cond, ...)                              \
+  do {                                                \
+    if (!(cond)) {                                    \
+      failure_count++;                                \
+      printf("  FAIL %s:%d: ", __FILE__, __LINE__);   \
+      printf(__VA_ARGS__);                            \
+      printf("\n");                                   \
+      return;                                         \
+    }                                                 \
+  } while (0)
+
+void halInternalAssertFailed(const char *filename, int linenumber)
+{
+  printf("  ASSERT %s:%d\n", filename, linenumber);
+  abort();
+}
+
+// -----------------------------------------------------------------------------
+//                      Stand-in of the application framework
+// -----------------------------------------------------------------------------
+void connect_app_framework_init(void)
+{
+}
+
+// Parks the app framework task while the harness holds it. The task is then
+// between two dispatches and holds no callback slot.
+void connect_app_framework_tick(void)
+{
+  pthread_mutex_lock(&af_lock);
+  while (af_hold) {
+    af_held = true;
+    pthread_cond_broadcast(&af_changed);
+    pthread_cond_wait(&af_changed, &af_lock);
+  }
+  af_held = false;
+  pthread_mutex_unlock(&af_lock);
+}
+
+uint32_t emAfMsToNextEvent(uint32_t maxMs)
+{
+  return maxMs;
+}
+
+uint32_t sl_sleeptimer_get_tick_count(void)
+{
+  return osKernelGetTickCount();
+}
+
+static void record_delivery(const uint8_t *payload, bool incoming)
+{
+  uint64_t now = benchNowNs();
+  uint32_t sequence;
+  uint64_t stamp;
+
+  memcpy(&sequence, &payload[FAKE_STACK_PAYLOAD_SEQUENCE], sizeof(uint32_t));
+  memcpy(&stamp, &payload[FAKE_STACK_PAYLOAD_STAMP], sizeof(uint64_t));
+
+  pthread_mutex_lock(&af_lock);
+  if (delivered_count < MAX_RECORDS) {
+    delivered_sequences[delivered_count] = sequence;
+    delivered_latencies[delivered_count] = now - stamp;
+    delivered_count++;
+  }
+  if (incoming) {
+    delivered_incoming++;
+  } else {
+    delivered_sent++;
+  }
+  pthread_cond_broadcast(&af_changed);
+  pthread_mutex_unlock(&af_lock);
+}
+
+void emberAfIncomingMessageCallback(EmberIncomingMessage *message)
+{
+  record_delivery(message->payload, true);
+}
+
+void emberAfMessageSentCallback(EmberStatus status, EmberOutgoingMessage *message)
+{
+  record_delivery(message->payload, false);
+}
+
+void emberAfStackStatusCallback(EmberStatus status)
+{
+  pthread_mutex_lock(&af_lock);
+  delivered_statuses++;
+  last_status = status;
+  pthread_cond_broadcast(&af_changed);
+  pthread_mutex_unlock(&af_lock);
+}
+
+void emberAfIncomingMacMessageCallback(EmberIncomingMacMessage *message)
+{
+}
+
+void emberAfMacMessageSentCallback(EmberStatus status, EmberOutgoingMacMessage *message)
+{
+}
+
+void emberAfChildJoinCallback(EmberNodeType nodeType, EmberNodeId nodeId)
+{
+}
+
+void emberAfActiveScanCompleteCallback(void)
+{
+}
+
+void emberAfEnergyScanCompleteCallback(int8_t mean, int8_t min, int8_t max, uint16_t variance)
+{
+}
+
+void emberAfIncomingBeaconCallback(EmberPanId panId,
+                                   EmberMacAddress *source,
+                                   int8_t rssi,
+                                   bool permitJoining,
+                                   uint8_t beaconFieldsLength,
+                                   uint8_t *beaconFields,
+                                   uint8_t beaconPayloadLength,
+                                   uint8_t *beaconPayload)
+{
+}
+
+void emberAfFrequencyHoppingStartClientCompleteCallback(EmberStatus status)
+{
+}
+
+void emberAfRadioNeedsCalibratingCallback(void)
+{
+}
+
+// The generated dispatchers to the plugins, there are none here.
+void emberAfStackStatus(EmberStatus status)
+{
+}
+
+void emberAfChildJoin(EmberNodeType nodeType, EmberNodeId nodeId)
+{
+}
+
+void emberAfRadioNeedsCalibrating(void)
+{
+}
+
+void emberAfMessageSent(EmberStatus status, EmberOutgoingMessage *message)
+{
+}
+
+void emberAfMacMessageSent(EmberStatus status, EmberOutgoingMacMessage *message)
+{
+}
+
+void emberAfIncomingMessage(EmberIncomingMessage *message)
+{
+}
+
+void emberAfIncomingMacMessage(EmberIncomingMacMessage *message)
+{
+}
+
+void emberAfIncomingBeacon(EmberPanId panId,
+                           EmberMacAddress *source,
+                           int8_t rssi,
+                           bool permitJoining,
+                           uint8_t beaconFieldsLength,
+                           uint8_t *beaconFields,
+                           uint8_t beaconPayloadLength,
+                           uint8_t *beaconPayload)
+{
+}
+
+void emberAfActiveScanComplete(void)
+{
+}
+
+void emberAfEnergyScanComplete(int8_t mean, int8_t min, int8_t max, uint16_t variance)
+{
+}
+
+void emberAfFrequencyHoppingStartClientComplete(EmberStatus status)
+{
+}
+
+// -----------------------------------------------------------------------------
+//                                Harness Helpers
+// -----------------------------------------------------------------------------
+static void reset_deliveries(void)
+{
+  pthread_mutex_lock(&af_lock);
+  delivered_incoming = 0u;
+  delivered_sent = 0u;
+  delivered_count = 0u;
+  delivered_statuses = 0u;
+  pthread_mutex_unlock(&af_lock);
+  emberAfPluginCmsisRtosClearCallbackDropCounts();
+}
+
+static uint32_t dropped_incoming(void)
+{
+  return emberAfPluginCmsisRtosGetCallbackDropCount(EMBER_INCOMING_MESSAGE_HANDLER_IPC_COMMAND_ID);
+}
+
+static uint32_t dropped_sent(void)
+{
+  return emberAfPluginCmsisRtosGetCallbackDropCount(EMBER_MESSAGE_SENT_HANDLER_IPC_COMMAND_ID);
+}
+
+static uint32_t dropped_statuses(void)
+{
+  return emberAfPluginCmsisRtosGetCallbackDropCount(EMBER_STACK_STATUS_HANDLER_IPC_COMMAND_ID);
+}
+
+static void hold_app_framework(void)
+{
+  pthread_mutex_lock(&af_lock);
+  af_hold = true;
+  pthread_mutex_unlock(&af_lock);
+
+  emAfPluginCmsisRtosWakeUpAppFrameworkTask();
+
+  pthread_mutex_lock(&af_lock);
+  while (!af_held) {
+    pthread_cond_wait(&af_changed, &af_lock);
+  }
+  pthread_mutex_unlock(&af_lock);
+}
+
+static void release_app_framework(void)
+{
+  pthread_mutex_lock(&af_lock);
+  af_hold = false;
+  pthread_cond_broadcast(&af_changed);
+  pthread_mutex_unlock(&af_lock);
+}
+
+// Waits until every callback emitted was either delivered or dropped. Returns
+// false on timeout.
+static bool wait_callbacks(uint32_t emitted)
+{
+  struct timespec deadline;
+  bool complete = true;
+
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += WAIT_TIMEOUT_S;
+
+  pthread_mutex_lock(&af_lock);
+  while (delivered_incoming + delivered_sent + dropped_incoming() + dropped_sent() < emitted) {
+    if (pthread_cond_timedwait(&af_changed, &af_lock, &deadline) == ETIMEDOUT) {
+      complete = false;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&af_lock);
+  return complete;
+}
+
+// Waits until every stack status emitted was either delivered or superseded.
+// Returns false on timeout.
+static bool wait_stack_statuses(uint32_t emitted)
+{
+  struct timespec deadline;
+  bool complete = true;
+
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += WAIT_TIMEOUT_S;
+
+  pthread_mutex_lock(&af_lock);
+  while (delivered_statuses + dropped_statuses() < emitted) {
+    if (pthread_cond_timedwait(&af_changed, &af_lock, &deadline) == ETIMEDOUT) {
+      complete = false;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&af_lock);
+  return complete;
+}
+
+static EmberStatus blocking_call(blocking_call_t call, uint32_t index, uint32_t i, uint32_t *count)
+{
+  uint8_t message[BENCH_PAYLOAD];
+  uint8_t length;
+  uint8_t tag = (uint8_t)(index * 64u + i);
+  uint8_t j;
+
+  if (call == BLOCKING_GET_COUNTER) {
+    return emberGetCounter((EmberCounterType)(index + 1u), count);
+  }
+  if (call == BLOCKING_GET_NODE_ID) {
+    *count = emberGetNodeId();
+    return EMBER_SUCCESS;
+  }
+  length = (i % BENCH_PAYLOAD) + 1u;
+  for (j = 0; j < length; j++) {
+    message[j] = FAKE_STACK_MESSAGE_BYTE(tag, j);
+  }
+  return emberMessageSend(0x0001, 1, tag, length, message, EMBER_OPTIONS_NONE);
+}
+
+// -----------------------------------------------------------------------------
+//                                    Checks
+// -----------------------------------------------------------------------------
+// Each worker asks for its own counter and sends messages of its own. Every
+// answer must be the one for its own call, whatever the others do.
+static void run_check_worker(worker_t *worker)
+{
+  uint32_t first;
+  uint32_t count;
+  uint32_t i;
+
+  CHECK(blocking_call(BLOCKING_GET_COUNTER, worker->index, 0u, &first) == EMBER_SUCCESS,
+        "worker %u: counter failed", worker->index);
+  for (i = 1u; i < worker->calls; i++) {
+    EmberStatus status = blocking_call(BLOCKING_GET_COUNTER, worker->index, i, &count);
+
+    CHECK(status == EMBER_SUCCESS && count == first + i,
+          "worker %u: call %u got counter 0x%08x, 0x%08x expected",
+          worker->index, i, count, first + i);
+    status = blocking_call(BLOCKING_MESSAGE_SEND, worker->index, i, NULL);
+    CHECK(status == EMBER_SUCCESS, "worker %u: message %u failed with 0x%02x",
+          worker->index, i, status);
+  }
+}
+
+static void check_worker_task(void *argument)
+{
+  worker_t *worker = (worker_t *)argument;
+
+  run_check_worker(worker);
+  osSemaphoreRelease(worker->done);
+}
+
+static void check_blocking_calls(void)
+{
+  static worker_t workers[CHECK_THREADS];
+  osSemaphoreId_t done = osSemaphoreNew(CHECK_THREADS, 0, NULL);
+  uint32_t i;
+
+  for (i = 0u; i < CHECK_THREADS; i++) {
+    workers[i] = (worker_t){ .index = i, .calls = CHECK_CALLS, .done = done };
+    CHECK(osThreadNew(check_worker_task, &workers[i], NULL) != NULL, "thread %u not created", i);
+  }
+  for (i = 0u; i < CHECK_THREADS; i++) {
+    CHECK(osSemaphoreAcquire(done, WAIT_TIMEOUT_S * osKernelGetTickFreq()) == osOK,
+          "workers stuck");
+  }
+  CHECK(fakeStackGetCorruptMessageCount() == 0u, "%u messages corrupted",
+        fakeStackGetCorruptMessageCount());
+}
+
+// As many callbacks as the queue holds, all delivered in order.
+static void check_callback_burst(void)
+{
+  uint32_t first;
+  uint32_t i;
+
+  reset_deliveries();
+  hold_app_framework();
+  first = fakeStackEmit(QUEUE_SIZE, 0u, CHECK_PAYLOAD);
+  release_app_framework();
+
+  CHECK(wait_callbacks(QUEUE_SIZE), "callbacks lost");
+  CHECK(dropped_incoming() == 0u, "%u callbacks dropped", dropped_incoming());
+  for (i = 0u; i < QUEUE_SIZE; i++) {
+    CHECK(delivered_sequences[i] == first + i, "callback %u delivered as %u",
+          first + i, delivered_sequences[i]);
+  }
+}
+
+// Floods the full queue with incoming messages, then sends message sent
+// callbacks. The overflow policy decides which incoming messages stay, the
+// message sent callbacks must all make it, and first.
+static void check_callback_overflow(void)
+{
+  uint32_t expected[QUEUE_SIZE];
+  uint32_t expected_count = 0u;
+  uint32_t first;
+  uint32_t kept_first;
+  uint32_t i;
+
+  reset_deliveries();
+  hold_app_framework();
+  first = fakeStackEmit(CHECK_OVERFLOW_INCOMING, CHECK_OVERFLOW_SENT, CHECK_PAYLOAD);
+  release_app_framework();
+
+  for (i = 0u; i < CHECK_OVERFLOW_SENT; i++) {
+    expected[expected_count++] = first + CHECK_OVERFLOW_INCOMING + i;
+  }
+  // Each message sent callback took over the oldest incoming message queued.
+#if (EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_OVERFLOW_POLICY == CMSIS_RTOS_CALLBACK_DROP_OLDEST)
+  kept_first = first + CHECK_OVERFLOW_INCOMING - QUEUE_SIZE + CHECK_OVERFLOW_SENT;
+  for (i = kept_first; i < first + CHECK_OVERFLOW_INCOMING; i++) {
+    expected[expected_count++] = i;
+  }
+#elif (EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_OVERFLOW_POLICY == CMSIS_RTOS_CALLBACK_COALESCE)
+  kept_first = first + CHECK_OVERFLOW_SENT;
+  for (i = kept_first; i < first + QUEUE_SIZE - 1u; i++) {
+    expected[expected_count++] = i;
+  }
+  expected[expected_count++] = first + CHECK_OVERFLOW_INCOMING - 1u;
+#else
+  kept_first = first + CHECK_OVERFLOW_SENT;
+  for (i = kept_first; i < first + QUEUE_SIZE; i++) {
+    expected[expected_count++] = i;
+  }
+#endif
+
+  CHECK(wait_callbacks(CHECK_OVERFLOW_INCOMING + CHECK_OVERFLOW_SENT), "callbacks lost");
+  CHECK(dropped_sent() == 0u, "%u message sent callbacks dropped", dropped_sent());
+  CHECK(dropped_incoming() == CHECK_OVERFLOW_INCOMING + CHECK_OVERFLOW_SENT - QUEUE_SIZE,
+        "%u incoming messages dropped, %u expected", dropped_incoming(),
+        CHECK_OVERFLOW_INCOMING + CHECK_OVERFLOW_SENT - QUEUE_SIZE);
+  CHECK(delivered_count == expected_count, "%u callbacks delivered, %u expected",
+        delivered_count, expected_count);
+  for (i = 0u; i < expected_count; i++) {
+    CHECK(delivered_sequences[i] == expected[i], "callback %u delivered as %u, %u expected",
+          i, delivered_sequences[i], expected[i]);
+  }
+}
+
+// Fills the queue with message sent callbacks, which are high priority like
+// stack statuses, then has the network go down, up and down again. The first
+// stack status gets the reserved slot and each later one supersedes the one
+// queued: none of the message sent callbacks is lost, and the last stack
+// status is delivered after them.
+static void check_stack_status(void)
+{
+  static const EmberStatus statuses[] = {
+    EMBER_NETWORK_DOWN, EMBER_NETWORK_UP, EMBER_NETWORK_DOWN
+  };
+  const uint32_t status_count = sizeof(statuses) / sizeof(statuses[0]);
+  uint32_t first;
+  uint32_t i;
+
+  reset_deliveries();
+  hold_app_framework();
+  first = fakeStackEmit(0u, QUEUE_SIZE, CHECK_PAYLOAD);
+  fakeStackEmitStackStatus(statuses, status_count);
+  release_app_framework();
+
+  CHECK(wait_callbacks(QUEUE_SIZE), "callbacks lost");
+  CHECK(wait_stack_statuses(status_count), "stack statuses lost");
+  CHECK(dropped_sent() == 0u, "%u message sent callbacks dropped", dropped_sent());
+  for (i = 0u; i < QUEUE_SIZE; i++) {
+    CHECK(delivered_sequences[i] == first + i, "callback %u delivered as %u",
+          first + i, delivered_sequences[i]);
+  }
+  CHECK(delivered_statuses == 1u && dropped_statuses() == status_count - 1u,
+        "%u stack statuses delivered and %u superseded, 1 and %u expected",
+        delivered_statuses, dropped_statuses(), status_count - 1u);
+  CHECK(last_status == EMBER_NETWORK_DOWN, "stack status 0x%02x delivered", last_status);
+}
+
+// A subscriber gets a reference to the very slot the app framework task
+// dispatches from, and the slot is only freed once both are done with it.
+static void check_subscribers(void)
+{
+  osMessageQueueId_t queue = osMessageQueueNew(QUEUE_SIZE, sizeof(EmberAfPluginCmsisRtosCallbackRef), NULL);
+  EmberAfPluginCmsisRtosCallbackRef refs[QUEUE_SIZE];
+  uint32_t first;
+  uint32_t i;
+
+  CHECK(emberAfPluginCmsisRtosSubscribeCallback(EMBER_INCOMING_MESSAGE_HANDLER_IPC_COMMAND_ID,
+                                                queue) == EMBER_SUCCESS,
+        "subscription refused");
+  reset_deliveries();
+  hold_app_framework();
+  first = fakeStackEmit(QUEUE_SIZE / 2u, 0u, CHECK_PAYLOAD);
+  for (i = 0u; i < QUEUE_SIZE / 2u; i++) {
+    uint32_t sequence;
+
+    CHECK(osMessageQueueGet(queue, &refs[i], NULL, 0u) == osOK, "reference %u missing", i);
+    CHECK(emberAfPluginCmsisRtosGetCallbackCommandId(refs[i])
+          == EMBER_INCOMING_MESSAGE_HANDLER_IPC_COMMAND_ID,
+          "reference %u to another callback", i);
+    // options, source, endpoint, rssi, length and the block length come first.
+    memcpy(&sequence, emberAfPluginCmsisRtosGetCallbackParams(refs[i]) + 7u, sizeof(uint32_t));
+    CHECK(sequence == first + i, "reference %u to callback %u", i, sequence);
+  }
+  release_app_framework();
+  CHECK(wait_callbacks(QUEUE_SIZE / 2u), "callbacks lost");
+  emberAfPluginCmsisRtosUnsubscribeCallback(EMBER_INCOMING_MESSAGE_HANDLER_IPC_COMMAND_ID, queue);
+  for (i = 0u; i < QUEUE_SIZE / 2u; i++) {
+    emberAfPluginCmsisRtosReleaseCallback(refs[i]);
+  }
+
+  // Every slot must be back.
+  check_callback_burst();
+}
+
+static void slot_holder_task(void *argument)
+{
+  slot_holder_t *holder = (slot_holder_t *)argument;
+
+  acquireCommandMutex();
+  osSemaphoreRelease(holder->held);
+  osSemaphoreAcquire(holder->release, osWaitForever);
+  releaseCommandMutex();
+  osSemaphoreRelease(holder->held);
+}
+
+static void node_id_task(void *argument)
+{
+  uint32_t node_id;
+
+  blocking_call(BLOCKING_GET_NODE_ID, 0u, 0u, &node_id);
+  *(EmberNodeId *)argument = (EmberNodeId)node_id;
+  osSemaphoreRelease(done_getter);
+}
+
+// Once the network init published the stack state snapshot, a getter served
+// from it must answer while other tasks hold every command slot.
+static void check_snapshot_getters(void)
+{
+  const uint32_t timeout = WAIT_TIMEOUT_S * osKernelGetTickFreq();
+  slot_holder_t holder = {
+    .held = osSemaphoreNew(EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS, 0, NULL),
+    .release = osSemaphoreNew(EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS, 0, NULL),
+  };
+  EmberNodeId node_id = EMBER_NULL_NODE_ID;
+  bool answered;
+  uint32_t i;
+
+  done_getter = osSemaphoreNew(1, 0, NULL);
+  CHECK(emberNetworkInit() == EMBER_SUCCESS, "network init failed");
+  for (i = 0u; i < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS; i++) {
+    CHECK(osThreadNew(slot_holder_task, &holder, NULL) != NULL, "thread %u not created", i);
+    CHECK(osSemaphoreAcquire(holder.held, timeout) == osOK, "slot %u not claimed", i);
+  }
+  CHECK(osThreadNew(node_id_task, &node_id, NULL) != NULL, "getter thread not created");
+  answered = (osSemaphoreAcquire(done_getter, timeout) == osOK);
+
+  // The getter still completes through its slot if it waited for one.
+  for (i = 0u; i < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS; i++) {
+    osSemaphoreRelease(holder.release);
+  }
+  for (i = 0u; i < EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS; i++) {
+    CHECK(osSemaphoreAcquire(holder.held, timeout) == osOK, "slot %u not released", i);
+  }
+  if (!answered) {
+    osSemaphoreAcquire(done_getter, timeout);
+  }
+  CHECK(answered, "getter blocked while every command slot was held");
+  CHECK(node_id == 0x0001, "node ID 0x%04x, 0x0001 expected", node_id);
+}
+
+static const check_t checks[] = {
+  { "blocking calls", check_blocking_calls },
+  { "callback burst", check_callback_burst },
+  { "callback overflow", check_callback_overflow },
+  { "stack status", check_stack_status },
+  { "subscribers", check_subscribers },
+  { "snapshot getters", check_snapshot_getters },
+};
+
+static int run_checks(void)
+{
+  uint32_t i;
+
+  for (i = 0u; i < sizeof(checks) / sizeof(checks[0]); i++) {
+    uint32_t failures = failure_count;
+
+    checks[i].run();
+    printf("%s: %s\n", checks[i].name, (failure_count == failures) ? "ok" : "FAILED");
+  }
+  return (failure_count == 0u) ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+//                                  Benchmark
+// -----------------------------------------------------------------------------
+static void bench_worker_task(void *argument)
+{
+  worker_t *worker = (worker_t *)argument;
+  uint32_t count;
+  uint32_t i;
+
+  for (i = 0u; i < worker->calls; i++) {
+    uint64_t start = benchNowNs();
+
+    blocking_call(worker->call, worker->index, i, &count);
+    worker->samples[i] = benchNowNs() - start;
+  }
+  osSemaphoreRelease(worker->done);
+}
+
+// Round trip of blocking calls made by several tasks at once.
+static void bench_blocking(const char *name, blocking_call_t call, uint32_t thread_count, uint64_t *samples)
+{
+  static worker_t workers[BENCH_MAX_THREADS];
+  osSemaphoreId_t done = osSemaphoreNew(thread_count, 0, NULL);
+  uint64_t start = benchNowNs();
+  uint64_t elapsed;
+  uint32_t i;
+
+  for (i = 0u; i < thread_count; i++) {
+    workers[i] = (worker_t){
+      .index = i,
+      .call = call,
+      .calls = BENCH_CALLS,
+      .samples = &samples[i * BENCH_CALLS],
+      .done = done,
+    };
+    osThreadNew(bench_worker_task, &workers[i], NULL);
+  }
+  for (i = 0u; i < thread_count; i++) {
+    osSemaphoreAcquire(done, osWaitForever);
+  }
+  elapsed = benchNowNs() - start;
+
+  benchPrintLatency(name, thread_count, samples, thread_count * BENCH_CALLS);
+  printf("%-8s %7lu        %8llu calls/s\n", "", (unsigned long)thread_count,
+         (unsigned long long)((uint64_t)thread_count * BENCH_CALLS * 1000000000ull / elapsed));
+}
+
+// Latency from the stack task emitting an incoming message callback to the
+// app framework task dispatching it. Bursts are emitted back to back, paced
+// ones wait for the previous burst to be handled.
+static void bench_callbacks(const char *name, uint32_t burst, bool paced)
+{
+  uint32_t emitted = 0u;
+  uint64_t start;
+  uint64_t elapsed;
+
+  reset_deliveries();
+  start = benchNowNs();
+  while (emitted < BENCH_CALLBACKS) {
+    fakeStackEmit(burst, 0u, BENCH_PAYLOAD);
+    emitted += burst;
+    if (paced && !wait_callbacks(emitted)) {
+      break;
+    }
+  }
+  if (!wait_callbacks(emitted)) {
+    printf("%-8s %7lu        callbacks lost\n", name, (unsigned long)burst);
+    return;
+  }
+  elapsed = benchNowNs() - start;
+
+  pthread_mutex_lock(&af_lock);
+  benchPrintLatency(name, burst, delivered_latencies, delivered_count);
+  printf("%-8s %7lu        %8llu calls/s  %5.1f%% dropped\n", "", (unsigned long)burst,
+         (unsigned long long)((uint64_t)delivered_incoming * 1000000000ull / elapsed),
+         100.0 * dropped_incoming() / emitted);
+  pthread_mutex_unlock(&af_lock);
+}
+
+static int run_benchmark(void)
+{
+  static const uint32_t thread_counts[] = { 1u, 2u, BENCH_MAX_THREADS };
+  uint64_t *samples = malloc(BENCH_MAX_THREADS * BENCH_CALLS * sizeof(uint64_t));
+  uint32_t i;
+
+  printf("call     tasks, blocking round trip\n");
+  for (i = 0u; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+    bench_blocking("counter", BLOCKING_GET_COUNTER, thread_counts[i], samples);
+  }
+  for (i = 0u; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+    bench_blocking("msgsend", BLOCKING_MESSAGE_SEND, thread_counts[i], samples);
+  }
+  // The node ID getter does a round trip until the stack state snapshot is
+  // first published, which the network init does.
+  for (i = 0u; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+    bench_blocking("nodeid", BLOCKING_GET_NODE_ID, thread_counts[i], samples);
+  }
+  emberNetworkInit();
+  for (i = 0u; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+    bench_blocking("snapshot", BLOCKING_GET_NODE_ID, thread_counts[i], samples);
+  }
+
+  printf("flood    burst, incoming message to dispatch, %u byte payload\n", BENCH_PAYLOAD);
+  bench_callbacks("paced", 1u, true);
+  bench_callbacks("paced", QUEUE_SIZE, true);
+  bench_callbacks("paced", 4u * QUEUE_SIZE, true);
+  bench_callbacks("flood", 100u, false);
+
+  free(samples);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//                                     Main
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  setvbuf(stdout, NULL, _IONBF, 0);
+  printf("CMSIS IPC, %u callback slots, %u blocking command slots\n",
+         QUEUE_SIZE, EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_PENDING_COMMANDS);
+
+  osKernelInitialize();
+  emberAfPluginCmsisRtosIpcInit();
+  osKernelStart();
+
+  if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+    return run_benchmark();
+  }
+  return run_checks();
+}
@@ -0,0 +1,613 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fake Connect stack for the host build of the CMSIS IPC layer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <pthread.h>
+#include <string.h>
+
+#include PLATFORM_HEADER
+#include "stack/include/ember.h"
+#include "stack/core/sli-connect-api.h"
+#include "ncp/ncp-security.h"
+#include "app_framework_common.h"
+#include "cmsis-rtos-support.h"
+#include "bench_util.h"
+#include "fake_stack.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define IDLE_MS 1000u
+
+typedef struct {
+  uint32_t incoming_count;
+  uint32_t sent_count;
+  uint8_t payload_length;
+  const EmberStatus *statuses;
+  uint32_t status_count;
+  bool pending;
+} emit_request_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static pthread_mutex_t request_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t request_done = PTHREAD_COND_INITIALIZER;
+static emit_request_t request;
+
+// Only modified by the stack task, while the harness waits for it.
+static uint32_t next_sequence;
+// Only accessed by the stack task.
+static uint32_t counter_calls[256];
+static volatile uint32_t corrupt_message_count;
+
+static EmberEUI64 eui64 = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+// -----------------------------------------------------------------------------
+//                                Static Functions
+// -----------------------------------------------------------------------------
+static void fill_payload(uint8_t *payload, uint8_t length)
+{
+  uint64_t stamp = benchNowNs();
+  uint8_t i;
+
+  memcpy(&payload[FAKE_STACK_PAYLOAD_SEQUENCE], &next_sequence, sizeof(uint32_t));
+  memcpy(&payload[FAKE_STACK_PAYLOAD_STAMP], &stamp, sizeof(uint64_t));
+  for (i = FAKE_STACK_PAYLOAD_MIN_LENGTH; i < length; i++) {
+    payload[i] = i;
+  }
+  next_sequence++;
+}
+
+static void emit_callbacks(const emit_request_t *emit)
+{
+  uint8_t payload[127];
+  uint32_t i;
+
+  for (i = 0u; i < emit->incoming_count; i++) {
+    EmberIncomingMessage message = {
+      .options = EMBER_OPTIONS_NONE,
+      .source = 0x0001,
+      .endpoint = 1,
+      .rssi = -40,
+      .length = emit->payload_length,
+      .payload = payload,
+      .timestamp = 0,
+      .lqi = 255,
+    };
+
+    fill_payload(payload, emit->payload_length);
+    emberIncomingMessageHandler(&message);
+  }
+  for (i = 0u; i < emit->sent_count; i++) {
+    EmberOutgoingMessage message = {
+      .options = EMBER_OPTIONS_NONE,
+      .destination = 0x0001,
+      .endpoint = 1,
+      .tag = (uint8_t)next_sequence,
+      .length = emit->payload_length,
+      .payload = payload,
+      .ackRssi = -40,
+      .timestamp = 0,
+    };
+
+    fill_payload(payload, emit->payload_length);
+    emberMessageSentHandler(EMBER_SUCCESS, &message);
+  }
+  for (i = 0u; i < emit->status_count; i++) {
+    emberStackStatusHandler(emit->statuses[i]);
+  }
+}
+
+// Has the stack task run a request and waits until it is done.
+static void run_request(const emit_request_t *emit)
+{
+  pthread_mutex_lock(&request_lock);
+  request = *emit;
+  request.pending = true;
+  pthread_mutex_unlock(&request_lock);
+
+  emAfPluginCmsisRtosWakeUpConnectStackTask();
+
+  pthread_mutex_lock(&request_lock);
+  while (request.pending) {
+    pthread_cond_wait(&request_done, &request_lock);
+  }
+  pthread_mutex_unlock(&request_lock);
+}
+
+// -----------------------------------------------------------------------------
+//                                Harness Controls
+// -----------------------------------------------------------------------------
+uint32_t fakeStackEmit(uint32_t incoming_count, uint32_t sent_count, uint8_t payload_length)
+{
+  emit_request_t emit = {
+    .incoming_count = incoming_count,
+    .sent_count = sent_count,
+    .payload_length = payload_length,
+  };
+  uint32_t first_sequence = next_sequence;
+
+  run_request(&emit);
+  return first_sequence;
+}
+
+void fakeStackEmitStackStatus(const EmberStatus *statuses, uint32_t count)
+{
+  emit_request_t emit = {
+    .statuses = statuses,
+    .status_count = count,
+  };
+
+  run_request(&emit);
+}
+
+uint32_t fakeStackGetCorruptMessageCount(void)
+{
+  return corrupt_message_count;
+}
+
+// -----------------------------------------------------------------------------
+//                           Stack task entry points
+// -----------------------------------------------------------------------------
+void connect_stack_init(void)
+{
+}
+
+void connect_stack_tick(void)
+{
+  emit_request_t emit;
+
+  pthread_mutex_lock(&request_lock);
+  emit = request;
+  pthread_mutex_unlock(&request_lock);
+
+  if (emit.pending) {
+    emit_callbacks(&emit);
+
+    pthread_mutex_lock(&request_lock);
+    request.pending = false;
+    pthread_cond_broadcast(&request_done);
+    pthread_mutex_unlock(&request_lock);
+  }
+}
+
+uint32_t emApiStackIdleTimeMs(uint16_t *currentStackTasks)
+{
+  *currentStackTasks = 0;
+  return IDLE_MS;
+}
+
+uint16_t emApiCurrentStackTasks(void)
+{
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//                             Byte utilities
+// -----------------------------------------------------------------------------
+uint16_t emberFetchHighLowInt16u(const uint8_t *contents)
+{
+  return HIGH_LOW_TO_INT(contents[0], contents[1]);
+}
+
+void emberStoreHighLowInt16u(uint8_t *contents, uint16_t value)
+{
+  contents[0] = HIGH_BYTE(value);
+  contents[1] = LOW_BYTE(value);
+}
+
+uint32_t emFetchInt32u(bool lowHigh, const uint8_t *contents)
+{
+  uint32_t value = 0;
+  uint8_t i;
+
+  for (i = 0; i < 4; i++) {
+    value = (value << 8) | contents[lowHigh ? (3 - i) : i];
+  }
+  return value;
+}
+
+void emStoreInt32u(bool lowHigh, uint8_t *contents, uint32_t value)
+{
+  uint8_t i;
+
+  for (i = 0; i < 4; i++) {
+    contents[lowHigh ? i : (3 - i)] = (uint8_t)value;
+    value >>= 8;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//                                 Stack API
+// -----------------------------------------------------------------------------
+// Every counter type counts its own calls, so that concurrent callers each
+// using their own type can check they got their own answer.
+EmberStatus emApiGetCounter(EmberCounterType counterType, uint32_t *count)
+{
+  *count = ((uint32_t)counterType << 24) | (counter_calls[counterType & 0xFF]++ & 0xFFFFFF);
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiMessageSend(EmberNodeId destination,
+                             uint8_t endpoint,
+                             uint8_t messageTag,
+                             EmberMessageLength messageLength,
+                             uint8_t *message,
+                             EmberMessageOptions options)
+{
+  EmberMessageLength i;
+
+  for (i = 0; i < messageLength; i++) {
+    if (message[i] != FAKE_STACK_MESSAGE_BYTE(messageTag, i)) {
+      corrupt_message_count++;
+      return EMBER_BAD_ARGUMENT;
+    }
+  }
+  return EMBER_SUCCESS;
+}
+
+EmberNetworkStatus emApiNetworkState(void)
+{
+  return EMBER_JOINED_NETWORK;
+}
+
+bool emApiStackIsUp(void)
+{
+  return true;
+}
+
+uint8_t *emApiGetEui64(void)
+{
+  return eui64;
+}
+
+bool emApiIsLocalEui64(EmberEUI64 eui)
+{
+  return memcmp(eui, eui64, EUI64_SIZE) == 0;
+}
+
+EmberNodeId emApiGetNodeId(void)
+{
+  return 0x0001;
+}
+
+EmberPanId emApiGetPanId(void)
+{
+  return 0x01FF;
+}
+
+uint16_t emApiGetRadioChannel(void)
+{
+  return 0;
+}
+
+int16_t emApiGetRadioPower(void)
+{
+  return 0;
+}
+
+EmberNodeType emApiGetNodeType(void)
+{
+  return EMBER_STAR_RANGE_EXTENDER;
+}
+
+void emApiResetNetworkState(void)
+{
+}
+
+// Everything else succeeds and does nothing.
+EmberStatus emApiApplyIrCalibration(uint32_t calValue)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiCalibrateCurrentChannel(void)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiCalibrateCurrentChannelExtended(uint32_t calValueIn, uint32_t* calValueOut)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiClearSelectiveJoinPayload(void)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiFormNetwork(EmberNetworkParameters *parameters)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiFrequencyHoppingSetChannelMask(uint8_t channelMaskLength, uint8_t *channelMask)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiFrequencyHoppingStartClient(EmberNodeId serverNodeId, EmberPanId serverPanId)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiFrequencyHoppingStartServer(void)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiFrequencyHoppingStop(void)
+{
+  return EMBER_SUCCESS;
+}
+
+uint16_t emApiGetActiveScanDuration(void)
+{
+  return 0;
+}
+
+EmberNodeId emApiGetAuxiliaryAddressFilteringEntry(uint8_t entryIndex)
+{
+  return 0;
+}
+
+EmberCalType emApiGetCalType(void)
+{
+  return 0;
+}
+
+EmberStatus emApiGetChildFlags(EmberMacAddress *address, EmberChildFlags* flags)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiGetChildInfo(EmberMacAddress *address,
+                              EmberMacAddress *addressResp,
+                              EmberChildFlags* flags)
+{
+  return EMBER_SUCCESS;
+}
+
+uint16_t emApiGetDefaultChannel(void)
+{
+  return 0;
+}
+
+uint8_t emApiGetMaximumPayloadLength(EmberMacAddressMode srcAddressMode,
+                                     EmberMacAddressMode dstAddressMode,
+                                     bool interpan,
+                                     bool secured)
+{
+  return 0;
+}
+
+EmberNodeId emApiGetParentId(void)
+{
+  return 0;
+}
+
+EmberStatus emApiGetSecurityKey(EmberKeyData *key)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiJoinCommissioned(EmberNodeType nodeType,
+                                  EmberNodeId nodeId,
+                                  EmberNetworkParameters *parameters)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiJoinNetwork(EmberNodeType nodeType, EmberNetworkParameters *parameters)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiJoinNetworkExtended(EmberNodeType nodeType,
+                                     EmberNodeId nodeId,
+                                     EmberNetworkParameters *parameters)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiMacAddShortToLongAddressMapping(EmberNodeId shortId, EmberEUI64 longId)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiMacClearShortToLongAddressMappings(void)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiMacFormNetwork(EmberNetworkParameters *parameters)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiMacGetParentAddress(EmberMacAddress *parentAddress)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiMacMessageSend(EmberMacFrame *macFrame,
+                                uint8_t messageTag,
+                                EmberMessageLength messageLength,
+                                uint8_t *message,
+                                EmberMessageOptions options)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiMacSetPanCoordinator(bool isCoordinator)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiNetworkInit(void)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiNetworkLeave(void)
+{
+  return EMBER_SUCCESS;
+}
+
+bool emApiOkToHibernate(void)
+{
+  return false;
+}
+
+bool emApiOkToNap(void)
+{
+  return false;
+}
+
+EmberStatus emApiPermitJoining(uint8_t duration)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiPollForData(void)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiPurgeIndirectMessages(void)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiRemoveChild(EmberMacAddress *address)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetActiveScanDuration(uint16_t durationMs)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetApplicationBeaconPayload(uint8_t payloadLength, uint8_t *payload)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetAuxiliaryAddressFilteringEntry(EmberNodeId nodeId, uint8_t entryIndex)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetIndirectQueueTimeout(uint32_t timeoutMs)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetMacParams(int8_t ccaThreshold,
+                              uint8_t maxCcaAttempts,
+                              uint8_t minBackoffExp,
+                              uint8_t maxBackoffExp,
+                              uint16_t ccaBackoff,
+                              uint16_t ccaDuration,
+                              uint8_t maxRetries,
+                              uint32_t csmaTimeout,
+                              uint16_t ackTimeout)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetNcpSecurityKey(uint8_t *keyContents, uint8_t keyLength)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetPollDestinationAddress(EmberMacAddress *destination)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetRadioChannel(uint16_t channel)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetRadioChannelExtended(uint16_t channel, bool persistent)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetRadioPower(int16_t power, bool persistent)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetRadioPowerMode(bool radioOn)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetSecurityKey(EmberKeyData *key)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiSetSelectiveJoinPayload(uint8_t payloadLength, uint8_t *payload)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiStartActiveScan(uint16_t channel)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiStartEnergyScan(uint16_t channel, uint8_t samples)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiStartTxStream(EmberTxStreamParameters parameters, uint16_t channel)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiStopTxStream(void)
+{
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emApiTempCalibration(void)
+{
+  return EMBER_SUCCESS;
+}
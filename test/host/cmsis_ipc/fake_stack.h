@@ -0,0 +1,74 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fake Connect stack for the host build of the CMSIS IPC layer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef FAKE_STACK_H
+#define FAKE_STACK_H
+
+#include <stdint.h>
+
+// The stack task runs the fake stack in place of the Connect stack library.
+// Its API calls answer right away, and it emits the callbacks the harness
+// asks for from the stack task, through the unmodified callback senders of
+// csp-command-callbacks.c.
+
+// Payload of the emitted callbacks: sequence number, then the emission time.
+#define FAKE_STACK_PAYLOAD_SEQUENCE      0u
+#define FAKE_STACK_PAYLOAD_STAMP         4u
+#define FAKE_STACK_PAYLOAD_MIN_LENGTH    12u
+
+// Filler byte i of a message sent with emberMessageSend() and a given tag.
+#define FAKE_STACK_MESSAGE_BYTE(tag, i)  ((uint8_t)((tag) + (i)))
+
+/**************************************************************************//**
+ * Has the stack task emit incoming message callbacks followed by message sent
+ * callbacks, back to back, and waits until they are all sent. Returns the
+ * sequence number of the first one, the others follow.
+ *
+ * @param incoming_count Number of incoming message callbacks.
+ * @param sent_count Number of message sent callbacks.
+ * @param payload_length Payload length of every callback, at least
+ *   FAKE_STACK_PAYLOAD_MIN_LENGTH.
+ *****************************************************************************/
+uint32_t fakeStackEmit(uint32_t incoming_count, uint32_t sent_count, uint8_t payload_length);
+
+/**************************************************************************//**
+ * Has the stack task emit stack status callbacks, back to back, and waits
+ * until they are all sent.
+ *
+ * @param statuses The status of each callback.
+ * @param count Number of stack status callbacks.
+ *****************************************************************************/
+void fakeStackEmitStackStatus(const EmberStatus *statuses, uint32_t count);
+
+/**************************************************************************//**
+ * Number of emberMessageSend() calls whose payload did not match its tag.
+ *****************************************************************************/
+uint32_t fakeStackGetCorruptMessageCount(void);
+
+#endif // FAKE_STACK_H
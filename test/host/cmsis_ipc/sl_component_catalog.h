@@ -0,0 +1,40 @@
+/***************************************************************************//**
+ * @file
+ * @brief Component catalog of the host build of the CMSIS IPC layer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef SL_COMPONENT_CATALOG_H
+#define SL_COMPONENT_CATALOG_H
+
+// The components of the application the IPC layer and the CSP commands look
+// for. There is no power manager on the host.
+#define SL_CATALOG_CONNECT_AES_SECURITY_PRESENT
+#define SL_CATALOG_CONNECT_APP_FRAMEWORK_COMMON_PRESENT
+#define SL_CATALOG_CONNECT_CMSIS_STACK_IPC_PRESENT
+#define SL_CATALOG_KERNEL_PRESENT
+
+#endif // SL_COMPONENT_CATALOG_H
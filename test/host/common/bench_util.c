@@ -0,0 +1,82 @@
+/***************************************************************************//**
+ * @file
+ * @brief Timing helpers shared by the host benchmarks
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench_util.h"
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+static int compare_samples(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+uint64_t benchNowNs(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+}
+
+uint64_t benchPercentile(uint64_t *samples, uint32_t count, uint32_t percentile)
+{
+  if (count == 0u) {
+    return 0u;
+  }
+  qsort(samples, count, sizeof(samples[0]), compare_samples);
+  return samples[((uint64_t)(count - 1u) * percentile) / 100u];
+}
+
+void benchPrintLatency(const char *name, uint32_t size, uint64_t *samples, uint32_t count)
+{
+  uint64_t p50 = benchPercentile(samples, count, 50u);
+  uint64_t p99 = benchPercentile(samples, count, 99u);
+  uint64_t max = benchPercentile(samples, count, 100u);
+
+  printf("%-8s %7lu        p50 %8llu ns  p99 %8llu ns  max %8llu ns\n",
+         name,
+         (unsigned long)size,
+         (unsigned long long)p50,
+         (unsigned long long)p99,
+         (unsigned long long)max);
+}
@@ -0,0 +1,59 @@
+/***************************************************************************//**
+ * @file
+ * @brief Timing helpers shared by the host benchmarks
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <stdint.h>
+
+/**************************************************************************//**
+ * Monotonic time of the host in nanoseconds.
+ *****************************************************************************/
+uint64_t benchNowNs(void);
+
+/**************************************************************************//**
+ * Returns the given percentile of a set of samples. Sorts the samples.
+ *
+ * @param samples Samples, sorted in place.
+ * @param count Number of samples.
+ * @param percentile Percentile from 0 to 100.
+ *****************************************************************************/
+uint64_t benchPercentile(uint64_t *samples, uint32_t count, uint32_t percentile);
+
+/**************************************************************************//**
+ * Prints one line with the p50, p99 and maximum of a set of latencies.
+ *
+ * @param name Name of the measured operation.
+ * @param size Size of the workload, printed next to the name.
+ * @param samples Latencies in nanoseconds, sorted in place.
+ * @param count Number of samples.
+ *****************************************************************************/
+void benchPrintLatency(const char *name, uint32_t size, uint64_t *samples, uint32_t count);
+
+#endif // BENCH_UTIL_H
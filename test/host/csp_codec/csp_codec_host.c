@@ -0,0 +1,571 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host checks and benchmark of the generated CSP codecs
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "stack/include/ember.h"
+#include "csp-format.h"
+#include "bench_util.h"
+
+// The generated file is built into the harness with its argument list
+// adapters, so that the checks can walk its table of layouts. The format
+// string interpreter of the unmodified csp-format.c is the reference the
+// routines are checked against.
+#define CSP_CODEC_GEN_CHECKS
+#include "csp-codec-gen.c"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define CHECK_ITERATIONS             2000u
+#define CHECK_MAX_BLOCK              40u
+#define CHECK_BUFFER_SIZE            1024u
+
+// Every layout is called with this many arguments, the ones past the format
+// are ignored. On the host ABI each of them takes its own slot, whatever the
+// type the callee reads it as.
+#define MAX_ARGUMENTS                64u
+#define ARGUMENTS(a)                                                        \
+  a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11], \
+  a[12], a[13], a[14], a[15], a[16], a[17], a[18], a[19], a[20], a[21],     \
+  a[22], a[23], a[24], a[25], a[26], a[27], a[28], a[29], a[30], a[31],     \
+  a[32], a[33], a[34], a[35], a[36], a[37], a[38], a[39], a[40], a[41],     \
+  a[42], a[43], a[44], a[45], a[46], a[47], a[48], a[49], a[50], a[51],     \
+  a[52], a[53], a[54], a[55], a[56], a[57], a[58], a[59], a[60], a[61],     \
+  a[62], a[63]
+
+#define MAX_FIELDS                   32u
+
+#define BENCH_SAMPLES                20000u
+#define BENCH_BATCH                  32u
+#define BENCH_PAYLOAD                64u
+
+// The outputs of one fetched field.
+typedef struct {
+  uint8_t int8u;
+  uint16_t int16u;
+  uint32_t int32u;
+  uint8_t array[256];
+  uint8_t length;
+  uint8_t *pointer;
+} fetched_field_t;
+
+typedef struct {
+  const char *name;
+  void (*run)(void);
+} check_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static uint32_t failure_count;
+
+static uint8_t block_source[CHECK_MAX_BLOCK];
+
+// -----------------------------------------------------------------------------
+//                   Stand-in of the stack byte utilities
+// -----------------------------------------------------------------------------
+uint16_t emberFetchHighLowInt16u(const uint8_t *contents)
+{
+  return HIGH_LOW_TO_INT(contents[0], contents[1]);
+}
+
+void emberStoreHighLowInt16u(uint8_t *contents, uint16_t value)
+{
+  contents[0] = HIGH_BYTE(value);
+  contents[1] = LOW_BYTE(value);
+}
+
+uint32_t emberFetchHighLowInt32u(uint8_t *contents)
+{
+  return ((uint32_t)contents[0] << 24) | ((uint32_t)contents[1] << 16)
+         | ((uint32_t)contents[2] << 8) | (uint32_t)contents[3];
+}
+
+void emberStoreHighLowInt32u(uint8_t *contents, uint32_t value)
+{
+  contents[0] = (uint8_t)(value >> 24);
+  contents[1] = (uint8_t)(value >> 16);
+  contents[2] = (uint8_t)(value >> 8);
+  contents[3] = (uint8_t)value;
+}
+
+// -----------------------------------------------------------------------------
+//                    Format string interpreter entry points
+// -----------------------------------------------------------------------------
+// What formatResponseCommand() and fetchCallbackParams() did before the
+// generated routines.
+static uint16_t interpreter_format(uint8_t *buffer,
+                                   uint16_t bufferSize,
+                                   uint16_t identifier,
+                                   PGM_P format,
+                                   ...)
+{
+  uint16_t length;
+  va_list argumentList;
+
+  va_start(argumentList, format);
+  length = formatResponseCommandFromArgList(buffer, bufferSize, identifier, format, argumentList);
+  va_end(argumentList);
+  return length;
+}
+
+static void interpreter_fetch(uint8_t *callbackParams, PGM_P format, ...)
+{
+  va_list argumentList;
+
+  va_start(argumentList, format);
+  fetchParams(callbackParams, format, argumentList);
+  va_end(argumentList);
+}
+
+// The generated routines, driven with the same arguments.
+static uint16_t generated_format(const CspCodecCheck *codec,
+                                 uint8_t *buffer,
+                                 uint16_t bufferSize,
+                                 uint16_t identifier,
+                                 ...)
+{
+  uint16_t length;
+  va_list argumentList;
+
+  va_start(argumentList, identifier);
+  length = codec->pack(buffer, bufferSize, identifier, &argumentList);
+  va_end(argumentList);
+  return length;
+}
+
+static void generated_fetch(void (*fetch)(uint8_t *, va_list *), uint8_t *data, ...)
+{
+  va_list argumentList;
+
+  va_start(argumentList, data);
+  fetch(data, &argumentList);
+  va_end(argumentList);
+}
+
+// -----------------------------------------------------------------------------
+//                                    Checks
+// -----------------------------------------------------------------------------
+#define CHECK(cond, ...)                              \
+  do {                                                \
+    if (!(cond)) {                                    \
+      failure_count++;                                \
+      printf("  FAIL %s:%d: ", __FILE__, __LINE__);   \
+      printf(__VA_ARGS__);                            \
+      printf("\n");                                   \
+      return;                                         \
+    }                                                 \
+  } while (0)
+
+static uint32_t random_u32(void)
+{
+  return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+// Random arguments of formatResponseCommand() for a format.
+static void random_format_arguments(const char *format, uintptr_t *arguments)
+{
+  uint32_t count = 0u;
+
+  memset(arguments, 0, MAX_ARGUMENTS * sizeof(uintptr_t));
+  for (; *format != '\0'; format++) {
+    switch (*format) {
+      case 'u':
+        arguments[count++] = (uintptr_t)(rand() & 0xFF);
+        break;
+      case 's':
+        arguments[count++] = (uintptr_t)(unsigned int)((rand() & 0xFF) - 128);
+        break;
+      case 'v':
+        arguments[count++] = (uintptr_t)(rand() & 0xFFFF);
+        break;
+      case 'w':
+        arguments[count++] = (uintptr_t)random_u32();
+        break;
+      case 'b':
+      case 'p':
+        // The interpreter sends zeroes in place of a NULL block.
+        arguments[count++] = ((rand() & 7) == 0) ? (uintptr_t)NULL : (uintptr_t)block_source;
+        arguments[count++] = (uintptr_t)(rand() % (CHECK_MAX_BLOCK + 1u));
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+// Random output arguments of fetchCallbackParams() for a format, pointing to
+// fields. The fields the fetch may leave alone are set to the same garbage.
+static void random_fetch_arguments(const char *format,
+                                   const uint8_t *buffer,
+                                   fetched_field_t *fields,
+                                   uintptr_t *arguments)
+{
+  uint32_t count = 0u;
+  uint32_t field = 0u;
+
+  memset(arguments, 0, MAX_ARGUMENTS * sizeof(uintptr_t));
+  memset(fields, 0xA5, MAX_FIELDS * sizeof(fetched_field_t));
+  for (; *format != '\0'; format++, field++) {
+    fetched_field_t *out = &fields[field];
+    // Any field but a 16-bit one may be skipped with a NULL pointer.
+    bool skip = ((rand() & 3) == 0);
+
+    switch (*format) {
+      case 'u':
+      case 's':
+        arguments[count++] = skip ? (uintptr_t)NULL : (uintptr_t)&out->int8u;
+        buffer++;
+        break;
+      case 'v':
+        arguments[count++] = (uintptr_t)&out->int16u;
+        buffer += 2;
+        break;
+      case 'w':
+        arguments[count++] = skip ? (uintptr_t)NULL : (uintptr_t)&out->int32u;
+        buffer += 4;
+        break;
+      case 'b':
+        arguments[count++] = skip ? (uintptr_t)NULL : (uintptr_t)out->array;
+        arguments[count++] = (uintptr_t)&out->length;
+        // Smaller than the block at times, to check the clamping.
+        arguments[count++] = (uintptr_t)(rand() % (buffer[0] + 4u));
+        buffer += 1u + buffer[0];
+        break;
+      case 'p':
+        arguments[count++] = skip ? (uintptr_t)NULL : (uintptr_t)&out->pointer;
+        arguments[count++] = (uintptr_t)&out->length;
+        buffer += 1u + buffer[0];
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+// The layout of a format, with the blocks fetched in place formatted as
+// blocks.
+static void formatted_layout(const char *format, char *layout)
+{
+  for (; *format != '\0'; format++) {
+    *layout++ = (*format == 'p') ? 'b' : *format;
+  }
+  *layout = '\0';
+}
+
+// Every generated formatting routine must write what the interpreter writes.
+static void check_format(void)
+{
+  static uint8_t expected[CHECK_BUFFER_SIZE];
+  static uint8_t actual[CHECK_BUFFER_SIZE];
+  uintptr_t arguments[MAX_ARGUMENTS];
+  uint32_t i;
+  uint32_t iteration;
+
+  srand(1);
+  for (i = 0u; i < sizeof(cspCodecChecks) / sizeof(cspCodecChecks[0]); i++) {
+    const CspCodecCheck *codec = &cspCodecChecks[i];
+    const char *format = codec->format;
+
+    if (codec->pack == NULL) {
+      continue;
+    }
+    for (iteration = 0u; iteration < CHECK_ITERATIONS; iteration++) {
+      uint16_t identifier = (uint16_t)rand();
+      uint16_t expected_length;
+      uint16_t actual_length;
+      uint32_t j;
+
+      for (j = 0u; j < CHECK_MAX_BLOCK; j++) {
+        block_source[j] = (uint8_t)rand();
+      }
+      random_format_arguments(format, arguments);
+      memset(expected, 0x5A, sizeof(expected));
+      memset(actual, 0x5A, sizeof(actual));
+      expected_length = interpreter_format(expected, sizeof(expected), identifier, format,
+                                           ARGUMENTS(arguments));
+      actual_length = generated_format(codec, actual, sizeof(actual), identifier,
+                                       ARGUMENTS(arguments));
+      CHECK(actual_length == expected_length, "\"%s\": %u bytes formatted, %u expected",
+            format, actual_length, expected_length);
+      CHECK(memcmp(actual, expected, sizeof(actual)) == 0, "\"%s\": bytes differ", format);
+    }
+  }
+}
+
+// Every generated fetching routine must read what the interpreter reads, skip
+// the same NULL outputs, and clamp the blocks the same way.
+static void check_fetch(void)
+{
+  static uint8_t command[CHECK_BUFFER_SIZE];
+  static fetched_field_t expected[MAX_FIELDS];
+  static fetched_field_t actual[MAX_FIELDS];
+  uintptr_t arguments[MAX_ARGUMENTS];
+  uint32_t i;
+  uint32_t iteration;
+
+  srand(2);
+  for (i = 0u; i < sizeof(cspCodecChecks) / sizeof(cspCodecChecks[0]); i++) {
+    const CspCodecCheck *codec = &cspCodecChecks[i];
+    const char *format = codec->format;
+    char layout[MAX_FIELDS + 1u];
+
+    if ((codec->fetchApi == NULL) && (codec->fetchCallback == NULL)) {
+      continue;
+    }
+    formatted_layout(format, layout);
+    for (iteration = 0u; iteration < CHECK_ITERATIONS; iteration++) {
+      uint32_t seed = (uint32_t)rand();
+      uint32_t j;
+      uint32_t field;
+
+      for (j = 0u; j < CHECK_MAX_BLOCK; j++) {
+        block_source[j] = (uint8_t)rand();
+      }
+      random_format_arguments(layout, arguments);
+      interpreter_format(command, sizeof(command), (uint16_t)rand(), layout, ARGUMENTS(arguments));
+
+      // Same outputs on both sides.
+      srand(seed);
+      random_fetch_arguments(format, command + 2, expected, arguments);
+      interpreter_fetch(command + 2, format, ARGUMENTS(arguments));
+      srand(seed);
+      random_fetch_arguments(format, command + 2, actual, arguments);
+      // Both routines of the layout take turns, when there are two.
+      if ((codec->fetchApi == NULL)
+          || ((codec->fetchCallback != NULL) && ((iteration & 1u) == 0u))) {
+        generated_fetch(codec->fetchCallback, command + 2, ARGUMENTS(arguments));
+      } else {
+        generated_fetch(codec->fetchApi, command, ARGUMENTS(arguments));
+      }
+
+      for (field = 0u; format[field] != '\0'; field++) {
+        CHECK(actual[field].int8u == expected[field].int8u
+              && actual[field].int16u == expected[field].int16u
+              && actual[field].int32u == expected[field].int32u
+              && actual[field].length == expected[field].length
+              && actual[field].pointer == expected[field].pointer
+              && memcmp(actual[field].array, expected[field].array,
+                        sizeof(actual[field].array)) == 0,
+              "\"%s\": field %u differs", format, field);
+      }
+    }
+  }
+}
+
+static const check_t checks[] = {
+  { "format", check_format },
+  { "fetch", check_fetch },
+};
+
+static int run_checks(void)
+{
+  uint32_t i;
+
+  for (i = 0u; i < sizeof(checks) / sizeof(checks[0]); i++) {
+    uint32_t failures = failure_count;
+
+    checks[i].run();
+    printf("%s: %s\n", checks[i].name, (failure_count == failures) ? "ok" : "FAILED");
+  }
+  return (failure_count == 0u) ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+//                                  Benchmark
+// -----------------------------------------------------------------------------
+// The layouts on the path of a message: emberMessageSend() and its status
+// sent to the stack, the message sent and incoming message callbacks sent
+// back, and one byte commands like most of the getters and setters.
+typedef enum {
+  BENCH_MESSAGE_SEND,
+  BENCH_STATUS,
+  BENCH_MESSAGE_SENT,
+  BENCH_INCOMING_MESSAGE,
+} bench_layout_t;
+
+static volatile uint32_t bench_sink;
+
+static void bench_format(bench_layout_t layout, bool generated, uint8_t *buffer, const uint8_t *payload)
+{
+  uint16_t length = 0u;
+
+  switch (layout) {
+    case BENCH_MESSAGE_SEND:
+      length = generated
+               ? cspFormatVuuubu(buffer, CHECK_BUFFER_SIZE, 0x0101,
+                                 0x1234, 1, 2, 3, payload, BENCH_PAYLOAD, 4)
+               : interpreter_format(buffer, CHECK_BUFFER_SIZE, 0x0101, "vuuubu",
+                                    0x1234, 1, 2, 3, payload, BENCH_PAYLOAD, 4);
+      break;
+    case BENCH_STATUS:
+      length = generated
+               ? cspFormatU(buffer, CHECK_BUFFER_SIZE, 0x0102, 0)
+               : interpreter_format(buffer, CHECK_BUFFER_SIZE, 0x0102, "u", 0);
+      break;
+    case BENCH_MESSAGE_SENT:
+      length = generated
+               ? cspFormatUuvuuubuw(buffer, CHECK_BUFFER_SIZE, 0x0103,
+                                    0, 1, 0x1234, 2, 3, 4, payload, BENCH_PAYLOAD, 5, 0x12345678)
+               : interpreter_format(buffer, CHECK_BUFFER_SIZE, 0x0103, "uuvuuubuw",
+                                    0, 1, 0x1234, 2, 3, 4, payload, BENCH_PAYLOAD, 5, 0x12345678);
+      break;
+    case BENCH_INCOMING_MESSAGE:
+      length = generated
+               ? cspFormatUvuuubwu(buffer, CHECK_BUFFER_SIZE, 0x0104,
+                                   1, 0x1234, 2, 3, 4, payload, BENCH_PAYLOAD, 0x12345678, 5)
+               : interpreter_format(buffer, CHECK_BUFFER_SIZE, 0x0104, "uvuuubwu",
+                                    1, 0x1234, 2, 3, 4, payload, BENCH_PAYLOAD, 0x12345678, 5);
+      break;
+  }
+  bench_sink += length;
+}
+
+// The command is fetched the way its command code does: the message and the
+// status on the stack side as API commands, the callbacks on the app side.
+static void bench_fetch(bench_layout_t layout, bool generated, uint8_t *command)
+{
+  uint8_t *params = command + 2;
+  uint8_t int8u[5];
+  uint16_t int16u;
+  uint32_t int32u;
+  uint8_t length = 0u;
+  uint8_t *pointer;
+  uint8_t array[BENCH_PAYLOAD];
+
+  switch (layout) {
+    case BENCH_MESSAGE_SEND:
+      if (generated) {
+        cspFetchApiVuuupu(command, &int16u, &int8u[0], &int8u[1], &int8u[2], &pointer, &length,
+                          &int8u[3]);
+      } else {
+        interpreter_fetch(params, "vuuupu", &int16u, &int8u[0], &int8u[1], &int8u[2], &pointer,
+                          &length, &int8u[3]);
+      }
+      break;
+    case BENCH_STATUS:
+      if (generated) {
+        cspFetchApiU(command, &int8u[0]);
+      } else {
+        interpreter_fetch(params, "u", &int8u[0]);
+      }
+      break;
+    case BENCH_MESSAGE_SENT:
+      if (generated) {
+        cspFetchCallbackUuvuuubuw(params, &int8u[0], &int8u[1], &int16u, &int8u[2], &int8u[3],
+                                  &int8u[4], array, &length, sizeof(array), &int8u[4], &int32u);
+      } else {
+        interpreter_fetch(params, "uuvuuubuw", &int8u[0], &int8u[1], &int16u, &int8u[2],
+                          &int8u[3], &int8u[4], array, &length, sizeof(array), &int8u[4], &int32u);
+      }
+      break;
+    case BENCH_INCOMING_MESSAGE:
+      if (generated) {
+        cspFetchCallbackUvuuubwu(params, &int8u[0], &int16u, &int8u[1], &int8u[2], &int8u[3],
+                                 array, &length, sizeof(array), &int32u, &int8u[4]);
+      } else {
+        interpreter_fetch(params, "uvuuubwu", &int8u[0], &int16u, &int8u[1], &int8u[2],
+                          &int8u[3], array, &length, sizeof(array), &int32u, &int8u[4]);
+      }
+      break;
+  }
+  bench_sink += int8u[0] + length;
+}
+
+// Latency of one formatting or fetching, averaged over a batch so that the
+// clock does not dominate.
+static void bench_layout(bench_layout_t layout, const char *format, uint32_t size, uint64_t *samples)
+{
+  static uint8_t buffer[CHECK_BUFFER_SIZE];
+  static uint8_t payload[BENCH_PAYLOAD];
+  static const char *const names[2][2] = {
+    { "fmt/itp", "fmt/gen" },
+    { "ftc/itp", "ftc/gen" },
+  };
+  uint32_t fetching;
+  uint32_t generated;
+
+  printf("\"%s\"\n", format);
+  for (fetching = 0u; fetching < 2u; fetching++) {
+    for (generated = 0u; generated < 2u; generated++) {
+      uint32_t i;
+      uint32_t j;
+
+      bench_format(layout, true, buffer, payload);
+      for (i = 0u; i < BENCH_SAMPLES; i++) {
+        uint64_t start = benchNowNs();
+
+        for (j = 0u; j < BENCH_BATCH; j++) {
+          if (fetching) {
+            bench_fetch(layout, generated, buffer);
+          } else {
+            bench_format(layout, generated, buffer, payload);
+          }
+        }
+        samples[i] = (benchNowNs() - start) / BENCH_BATCH;
+      }
+      benchPrintLatency(names[fetching][generated], size, samples, BENCH_SAMPLES);
+    }
+  }
+}
+
+static int run_benchmark(void)
+{
+  uint64_t *samples = malloc(BENCH_SAMPLES * sizeof(uint64_t));
+
+  printf("layout   payload bytes, one call averaged over %u\n", BENCH_BATCH);
+  bench_layout(BENCH_MESSAGE_SEND, "vuuubu", BENCH_PAYLOAD, samples);
+  bench_layout(BENCH_STATUS, "u", 0u, samples);
+  bench_layout(BENCH_MESSAGE_SENT, "uuvuuubuw", BENCH_PAYLOAD, samples);
+  bench_layout(BENCH_INCOMING_MESSAGE, "uvuuubwu", BENCH_PAYLOAD, samples);
+
+  free(samples);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//                                     Main
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  setvbuf(stdout, NULL, _IONBF, 0);
+  printf("CSP codecs, %u layouts generated\n",
+         (unsigned)(sizeof(cspCodecChecks) / sizeof(cspCodecChecks[0])));
+  if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+    return run_benchmark();
+  }
+  return run_checks();
+}
@@ -0,0 +1,57 @@
+/***************************************************************************//**
+ * @file
+ * @brief Platform header for the host build of the CSP codecs
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef PLATFORM_HEADER_H
+#define PLATFORM_HEADER_H
+
+// The part of platform-header.h the CSP serializers use, with the memory
+// utilities of a build that does not define EMBER_STACK_CORTEXM3.
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PGM
+#define PGM_P   const char *
+
+#define LOW_BYTE(n)                     ((uint8_t)((n) & 0xFF))
+#define HIGH_BYTE(n)                    ((uint8_t)(LOW_BYTE((n) >> 8)))
+#define HIGH_LOW_TO_INT(high, low) (                              \
+    (((uint16_t) (((uint16_t) (high)) << 8))                      \
+     + ((uint16_t) ((low) & 0xFF)))                               \
+    )
+
+#define MEMSET(d, v, l)  memset(d, v, l)
+#define MEMCOPY(d, s, l) memcpy(d, s, l)
+#define MEMMOVE(d, s, l) memmove(d, s, l)
+
+#endif // PLATFORM_HEADER_H
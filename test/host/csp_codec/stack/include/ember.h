@@ -0,0 +1,46 @@
+/***************************************************************************//**
+ * @file
+ * @brief Stack API subset for the host build of the CSP codecs
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef EMBER_H
+#define EMBER_H
+
+// The part of the stack API the CSP serializers use. The byte utilities are
+// the ones of byte-utilities.h, implemented by the harness in place of the
+// stack library.
+
+#include PLATFORM_HEADER
+
+typedef uint8_t EmberStatus;
+
+uint16_t emberFetchHighLowInt16u(const uint8_t *contents);
+void emberStoreHighLowInt16u(uint8_t *contents, uint16_t value);
+uint32_t emberFetchHighLowInt32u(uint8_t *contents);
+void emberStoreHighLowInt32u(uint8_t *contents, uint32_t value);
+
+#endif // EMBER_H
@@ -0,0 +1,41 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application framework configuration of the host event scheduler build
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef APP_FRAMEWORK_COMMON_CONFIG_H
+#define APP_FRAMEWORK_COMMON_CONFIG_H
+
+// The largest event table the scheduler supports, table sizes below it are
+// picked at runtime.
+#ifndef EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS
+#define EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS                (127)
+#endif
+
+#define EMBER_AF_EVENT_PROFILER                            (0)
+
+#endif // APP_FRAMEWORK_COMMON_CONFIG_H
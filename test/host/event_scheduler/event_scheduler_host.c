@@ -0,0 +1,502 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host checks and benchmark of the application framework event scheduler
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "app_framework_common.h"
+#include "app_framework_common_config.h"
+#include "hal.h"
+#include "bench_util.h"
+
+// The unmodified app_framework_event_scheduler.c runs on top of a stand-in of
+// the event core of the stack library and a simulated millisecond tick. The
+// benchmark compares it with a model of what emberRunTask() and
+// emberMsToNextEvent() do: walk the whole event table.
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define CHECK_EVENT_COUNT            100u
+#define CHECK_ITERATIONS             200000u
+#define IDLE_MAX_MS                  1000u
+
+#define BENCH_DURATION_MS            200000u
+#define BENCH_MIN_PERIOD_MS          5u
+#define BENCH_MAX_PERIOD_MS          500u
+
+typedef enum {
+  // The handler leaves the event inactive.
+  ON_RUN_STOP,
+  // The handler schedules the event again.
+  ON_RUN_RESCHEDULE,
+} on_run_t;
+
+typedef struct {
+  EmberEventControl *control;
+  bool scheduled;
+  uint32_t expiry_ms;
+  uint32_t period_ms;
+  on_run_t on_run;
+  uint32_t run_count;
+  uint32_t run_order;
+} checked_event_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static uint32_t now_ms;
+static uint32_t failure_count;
+static uint32_t run_order;
+
+static checked_event_t checked_events[EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS];
+
+EmberTaskId emAppTask = 1;
+
+// -----------------------------------------------------------------------------
+//                      Stand-in of the stack event core
+// -----------------------------------------------------------------------------
+uint32_t halCommonGetInt32uMillisecondTick(void)
+{
+  return now_ms;
+}
+
+void sli_event_control_set_active(EmberEventControl *event)
+{
+  event->status = EMBER_EVENT_ZERO_DELAY;
+  event->timeToExecute = now_ms;
+}
+
+void emEventControlSetDelayMS(EmberEventControl *event, uint32_t delay)
+{
+  event->status = EMBER_EVENT_MS_TIME;
+  event->timeToExecute = now_ms + delay;
+}
+
+uint32_t emEventControlGetRemainingMS(EmberEventControl *event)
+{
+  int32_t remaining = (int32_t)(event->timeToExecute - now_ms);
+
+  if (event->status == EMBER_EVENT_INACTIVE) {
+    return MAX_INT32U_VALUE;
+  }
+  return (remaining > 0) ? (uint32_t)remaining : 0u;
+}
+
+// -----------------------------------------------------------------------------
+//                                    Checks
+// -----------------------------------------------------------------------------
+#define CHECK(cond, ...)                              \
+  do {                                                \
+    if (!(cond)) {                                    \
+      failure_count++;                                \
+      printf("  FAIL %s:%d: ", __FILE__, __LINE__);   \
+      printf(__VA_ARGS__);                            \
+      printf("\n");                                   \
+      return;                                         \
+    }                                                 \
+  } while (0)
+
+static void checked_event_handler(void *context)
+{
+  checked_event_t *event = (checked_event_t *)context;
+
+  event->run_count++;
+  event->run_order = run_order++;
+  if (!event->scheduled || ((int32_t)(now_ms - event->expiry_ms) != 0)) {
+    failure_count++;
+    printf("  FAIL event %u ran at %lu, %s %lu\n",
+           (unsigned)(event - checked_events),
+           (unsigned long)now_ms,
+           event->scheduled ? "due at" : "not scheduled, last due at",
+           (unsigned long)event->expiry_ms);
+  }
+
+  if (event->on_run == ON_RUN_RESCHEDULE) {
+    event->expiry_ms = now_ms + event->period_ms;
+    emberEventControlSetDelayMS(*event->control, event->period_ms);
+  } else {
+    event->scheduled = false;
+    emberEventControlSetInactive(*event->control);
+  }
+}
+
+static void schedule_checked_event(checked_event_t *event, uint32_t delay_ms)
+{
+  event->scheduled = true;
+  event->expiry_ms = now_ms + delay_ms;
+  if (delay_ms == 0u) {
+    emberEventControlSetActive(*event->control);
+  } else {
+    emberEventControlSetDelayMS(*event->control, delay_ms);
+  }
+}
+
+static void cancel_checked_event(checked_event_t *event)
+{
+  event->scheduled = false;
+  emberEventControlSetInactive(*event->control);
+}
+
+static void reset_checked_events(uint32_t count)
+{
+  static const EmberEventData empty_table[] = { { NULL, NULL } };
+  uint32_t i;
+
+  emAfEventSchedulerInit(empty_table, 0u);
+  memset(checked_events, 0, sizeof(checked_events));
+  for (i = 0u; i < count; i++) {
+    emberAfEventRegister(&checked_events[i].control, checked_event_handler, &checked_events[i]);
+  }
+}
+
+// Runs the framework for one millisecond: the events run when the scheduler
+// says one is due, like the application framework task does.
+static void tick(void)
+{
+  if (emAfMsToNextEvent(IDLE_MAX_MS) == 0u) {
+    emAfRunEvents();
+  }
+  now_ms++;
+}
+
+// Random schedules, reschedules and cancels. Every event must run exactly
+// when it is due, and the idle time must match the first event due.
+static void check_random_operations(void)
+{
+  uint32_t iteration;
+  uint32_t i;
+
+  srand(1);
+  now_ms = 0xFFFF0000u;
+  reset_checked_events(CHECK_EVENT_COUNT);
+
+  for (iteration = 0u; iteration < CHECK_ITERATIONS; iteration++) {
+    checked_event_t *event = &checked_events[(uint32_t)rand() % CHECK_EVENT_COUNT];
+    int operation = rand() % 100;
+    uint32_t expected_idle_ms = IDLE_MAX_MS;
+
+    if (operation < 40) {
+      event->on_run = ((rand() % 2) == 0) ? ON_RUN_STOP : ON_RUN_RESCHEDULE;
+      event->period_ms = 1u + (uint32_t)(rand() % 300);
+      schedule_checked_event(event, ((rand() % 10) == 0) ? 0u : (uint32_t)(rand() % 300));
+    } else if (operation < 50) {
+      cancel_checked_event(event);
+    } else {
+      tick();
+    }
+    if (failure_count != 0u) {
+      return;
+    }
+
+    for (i = 0u; i < CHECK_EVENT_COUNT; i++) {
+      int32_t remaining = (int32_t)(checked_events[i].expiry_ms - now_ms);
+
+      if (!checked_events[i].scheduled) {
+        continue;
+      }
+      CHECK(remaining >= 0, "event %u due at %lu did not run by %lu",
+            (unsigned)i, (unsigned long)checked_events[i].expiry_ms,
+            (unsigned long)now_ms);
+      if ((uint32_t)remaining < expected_idle_ms) {
+        expected_idle_ms = (uint32_t)remaining;
+      }
+    }
+    CHECK(emAfMsToNextEvent(IDLE_MAX_MS) == expected_idle_ms,
+          "idle time %lu ms, expected %lu ms",
+          (unsigned long)emAfMsToNextEvent(IDLE_MAX_MS),
+          (unsigned long)expected_idle_ms);
+  }
+}
+
+// Events due at the same time run in the order they were scheduled.
+static void check_ties(void)
+{
+  uint32_t i;
+
+  reset_checked_events(8u);
+  now_ms = 1000u;
+  for (i = 0u; i < 8u; i++) {
+    checked_events[7u - i].on_run = ON_RUN_STOP;
+    schedule_checked_event(&checked_events[7u - i], 10u);
+  }
+  for (i = 0u; i < 20u; i++) {
+    tick();
+  }
+  for (i = 0u; i < 8u; i++) {
+    CHECK(checked_events[i].run_count == 1u, "event %u ran %lu times",
+          (unsigned)i, (unsigned long)checked_events[i].run_count);
+    CHECK(checked_events[7u - i].run_order == checked_events[0].run_order - 7u + i,
+          "event %u did not run in schedule order", (unsigned)(7u - i));
+  }
+}
+
+static uint32_t table_handler_runs;
+
+static void table_handler(void)
+{
+  table_handler_runs++;
+  emberEventControlSetInactive(*checked_events[0].control);
+}
+
+// Events of the generated table scheduled before the table is registered run.
+// The allocateEventN placeholders ending the table take no entry of the pool.
+static void check_table(void)
+{
+  static EmberEventControl table_control;
+  static EmberEventControl placeholder_control;
+  const EmberEventData table[] = {
+    { &table_control, table_handler },
+    { &placeholder_control, table_handler },
+    { NULL, NULL }
+  };
+  EmberEventControl *control;
+  uint32_t registered = 0u;
+
+  now_ms = 5000u;
+  table_handler_runs = 0u;
+  emEventControlSetDelayMS(&table_control, 5u);
+  emAfEventSchedulerInit(table, 1u);
+  checked_events[0].control = &table_control;
+  for (uint32_t i = 0u; i < 10u; i++) {
+    tick();
+  }
+  CHECK(table_handler_runs == 1u, "table event ran %lu times",
+        (unsigned long)table_handler_runs);
+
+  while (emberAfEventRegister(&control, checked_event_handler, NULL) == EMBER_SUCCESS) {
+    registered++;
+  }
+  CHECK(registered == EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS - 1u,
+        "%lu pool events next to the table, %lu expected",
+        (unsigned long)registered, (unsigned long)(EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS - 1u));
+}
+
+// Pool events given back never run again, and their entry serves again.
+static void check_pool(void)
+{
+  EmberEventControl *controls[EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS];
+  EmberEventControl *extra = NULL;
+  uint32_t i;
+
+  reset_checked_events(0u);
+  for (i = 0u; i < EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS; i++) {
+    checked_events[i].on_run = ON_RUN_STOP;
+    CHECK(emberAfEventRegister(&controls[i], checked_event_handler, &checked_events[i])
+          == EMBER_SUCCESS, "register %u failed", (unsigned)i);
+    checked_events[i].control = controls[i];
+    schedule_checked_event(&checked_events[i], 10u + i);
+  }
+  CHECK(emberAfEventRegister(&extra, checked_event_handler, NULL) == EMBER_TABLE_FULL,
+        "register past the pool size succeeded");
+
+  for (i = 0u; i < EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS; i += 2u) {
+    CHECK(emberAfEventUnregister(controls[i]) == EMBER_SUCCESS, "unregister failed");
+    checked_events[i].scheduled = false;
+  }
+  CHECK(emberAfEventRegister(&extra, checked_event_handler, &checked_events[0])
+        == EMBER_SUCCESS, "register after unregister failed");
+  CHECK(emberAfEventUnregister(extra) == EMBER_SUCCESS, "unregister failed");
+
+  for (i = 0u; i < 2u * EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS; i++) {
+    tick();
+  }
+  for (i = 0u; i < EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS; i++) {
+    CHECK(checked_events[i].run_count == ((i % 2u) ? 1u : 0u),
+          "event %u ran %lu times", (unsigned)i, (unsigned long)checked_events[i].run_count);
+  }
+}
+
+typedef struct {
+  const char *name;
+  void (*run)(void);
+} check_t;
+
+static const check_t checks[] = {
+  { "random operations", check_random_operations },
+  { "ties", check_ties },
+  { "table", check_table },
+  { "pool", check_pool },
+};
+
+static int run_checks(void)
+{
+  uint32_t i;
+
+  for (i = 0u; i < sizeof(checks) / sizeof(checks[0]); i++) {
+    uint32_t failures = failure_count;
+
+    checks[i].run();
+    printf("%s: %s\n", checks[i].name, (failure_count == failures) ? "ok" : "FAILED");
+  }
+  return (failure_count == 0u) ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+//                                  Benchmark
+// -----------------------------------------------------------------------------
+typedef struct {
+  EmberEventControl control;
+  uint32_t period_ms;
+} bench_event_t;
+
+static bench_event_t bench_events[EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS];
+static EmberEventControl *bench_controls[EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS];
+
+static void bench_handler(void *context)
+{
+  bench_event_t *event = (bench_event_t *)context;
+  uint32_t index = (uint32_t)(event - bench_events);
+
+  emberEventControlSetDelayMS(*bench_controls[index], event->period_ms);
+}
+
+// What the stack library does for the table: walk every event to run the due
+// ones, and to find the first one due.
+static void linear_run_events(uint32_t count)
+{
+  uint32_t i;
+
+  for (i = 0u; i < count; i++) {
+    if (bench_events[i].control.status != EMBER_EVENT_INACTIVE
+        && emEventControlGetRemainingMS(&bench_events[i].control) == 0u) {
+      emEventControlSetDelayMS(&bench_events[i].control, bench_events[i].period_ms);
+    }
+  }
+}
+
+static uint32_t linear_ms_to_next_event(uint32_t count, uint32_t max_ms)
+{
+  uint32_t result = max_ms;
+  uint32_t i;
+
+  for (i = 0u; i < count; i++) {
+    uint32_t remaining = emEventControlGetRemainingMS(&bench_events[i].control);
+
+    if (remaining < result) {
+      result = remaining;
+    }
+  }
+  return result;
+}
+
+typedef struct {
+  uint64_t *idle_ns;
+  uint64_t *run_ns;
+  uint32_t idle_count;
+  uint32_t run_count;
+} bench_samples_t;
+
+// Simulates BENCH_DURATION_MS of the framework task with count periodic
+// events, timing every idle time computation and every run of the due events.
+static void bench_events_run(uint32_t count, bool scheduler, bench_samples_t *samples)
+{
+  static const EmberEventData empty_table[] = { { NULL, NULL } };
+  uint32_t i;
+
+  srand(2);
+  now_ms = 0u;
+  samples->idle_count = 0u;
+  samples->run_count = 0u;
+  emAfEventSchedulerInit(empty_table, 0u);
+
+  for (i = 0u; i < count; i++) {
+    bench_events[i].period_ms = BENCH_MIN_PERIOD_MS
+                                + (uint32_t)(rand() % (BENCH_MAX_PERIOD_MS - BENCH_MIN_PERIOD_MS));
+    if (scheduler) {
+      emberAfEventRegister(&bench_controls[i], bench_handler, &bench_events[i]);
+      emberEventControlSetDelayMS(*bench_controls[i], bench_events[i].period_ms);
+    } else {
+      emEventControlSetDelayMS(&bench_events[i].control, bench_events[i].period_ms);
+    }
+  }
+
+  while (now_ms < BENCH_DURATION_MS) {
+    uint64_t begin = benchNowNs();
+    uint32_t idle_ms = scheduler
+                       ? emAfMsToNextEvent(IDLE_MAX_MS)
+                       : linear_ms_to_next_event(count, IDLE_MAX_MS);
+
+    samples->idle_ns[samples->idle_count++] = benchNowNs() - begin;
+    if (idle_ms > 0u) {
+      now_ms += idle_ms;
+      continue;
+    }
+    begin = benchNowNs();
+    if (scheduler) {
+      emAfRunEvents();
+    } else {
+      linear_run_events(count);
+    }
+    samples->run_ns[samples->run_count++] = benchNowNs() - begin;
+  }
+}
+
+static int run_benchmark(void)
+{
+  static const uint32_t event_counts[] = { 16u, 32u, 64u, EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS };
+  bench_samples_t samples;
+  uint32_t i;
+
+  samples.idle_ns = malloc(BENCH_DURATION_MS * sizeof(uint64_t));
+  samples.run_ns = malloc(BENCH_DURATION_MS * sizeof(uint64_t));
+
+  printf("events   calls over %u s of periodic events, %u to %u ms\n",
+         BENCH_DURATION_MS / 1000u, BENCH_MIN_PERIOD_MS, BENCH_MAX_PERIOD_MS);
+  for (i = 0u; i < sizeof(event_counts) / sizeof(event_counts[0]); i++) {
+    bench_events_run(event_counts[i], false, &samples);
+    benchPrintLatency("idle/tbl", event_counts[i], samples.idle_ns, samples.idle_count);
+    benchPrintLatency("run/tbl", event_counts[i], samples.run_ns, samples.run_count);
+    bench_events_run(event_counts[i], true, &samples);
+    benchPrintLatency("idle/heap", event_counts[i], samples.idle_ns, samples.idle_count);
+    benchPrintLatency("run/heap", event_counts[i], samples.run_ns, samples.run_count);
+  }
+
+  free(samples.idle_ns);
+  free(samples.run_ns);
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//                                     Main
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  setvbuf(stdout, NULL, _IONBF, 0);
+  printf("application framework event scheduler, %u events at most\n",
+         EMBER_AF_EVENT_SCHEDULER_MAX_EVENTS);
+  if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+    return run_benchmark();
+  }
+  return run_checks();
+}
@@ -0,0 +1,43 @@
+/***************************************************************************//**
+ * @file
+ * @brief HAL subset for the host build of the event scheduler
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef HAL_H
+#define HAL_H
+
+#include <assert.h>
+#include <string.h>
+
+#include "stack/include/ember.h"
+
+#define MEMSET(d, v, l)  memset(d, v, l)
+
+// Simulated millisecond tick, moved forward by the harness.
+uint32_t halCommonGetInt32uMillisecondTick(void);
+
+#endif // HAL_H
@@ -0,0 +1,74 @@
+/***************************************************************************//**
+ * @file
+ * @brief Stack API subset for the host build of the event scheduler
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef EMBER_H
+#define EMBER_H
+
+// The part of the stack API the application framework event scheduler uses.
+// The types are the ones of ember-types.h, the event control macros come from
+// the unmodified event.h.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define PGM
+
+#define MAX_INT32U_VALUE      (0xFFFFFFFFUL)
+#define HALF_MAX_INT32U_VALUE (0x80000000UL)
+
+#include "stack/include/error-def.h"
+
+typedef uint8_t EmberStatus;
+
+typedef uint8_t EmberEventUnits;
+enum {
+  EMBER_EVENT_INACTIVE = 0,
+  EMBER_EVENT_MS_TIME,
+  EMBER_EVENT_QS_TIME,
+  EMBER_EVENT_MINUTE_TIME,
+  EMBER_EVENT_ZERO_DELAY
+};
+
+typedef uint8_t EmberTaskId;
+
+typedef struct {
+  EmberEventUnits status;
+  EmberTaskId taskid;
+  uint32_t timeToExecute;
+} EmberEventControl;
+
+typedef PGM struct EmberEventData_S {
+  EmberEventControl *control;
+  void (*handler)(void);
+} EmberEventData;
+
+#include "stack/include/event.h"
+
+#endif // EMBER_H
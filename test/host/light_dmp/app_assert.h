@@ -0,0 +1,52 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application assert for the light simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef APP_ASSERT_H
+#define APP_ASSERT_H
+
+#include "sl_status.h"
+
+// A failed application assert ends the simulation.
+void app_assert_host(const char *file, int line, const char *format, ...)
+__attribute__((format(printf, 3, 4), noreturn));
+
+#define app_assert(expr, ...)                             \
+  do {                                                    \
+    if (!(expr)) {                                        \
+      app_assert_host(__FILE__, __LINE__, __VA_ARGS__);   \
+    }                                                     \
+  } while (0)
+
+#define app_assert_status(sc) \
+  app_assert((sc) == SL_STATUS_OK, "[E: 0x%04x]\n", (int)(sc))
+
+#define app_assert_status_f(sc, ...) \
+  app_assert((sc) == SL_STATUS_OK, __VA_ARGS__)
+
+#endif // APP_ASSERT_H
@@ -0,0 +1,48 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application log for the light simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef APP_LOG_H
+#define APP_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// The log lines of the application are counted, and only printed when the
+// simulator runs verbose.
+void app_log_host(bool new_line, const char *format, ...)
+__attribute__((format(printf, 2, 3)));
+
+#define app_log_debug(...)    app_log_host(true, __VA_ARGS__)
+#define app_log_info(...)     app_log_host(true, __VA_ARGS__)
+#define app_log_warning(...)  app_log_host(true, __VA_ARGS__)
+#define app_log_error(...)    app_log_host(true, __VA_ARGS__)
+#define app_log_critical(...) app_log_host(true, __VA_ARGS__)
+#define app_log_append(...)   app_log_host(false, __VA_ARGS__)
+
+#endif // APP_LOG_H
@@ -0,0 +1,584 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fake Bluetooth stack and phones of the light DMP simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sl_bluetooth.h"
+#include "sl_bluetooth_connection_config.h"
+#include "gatt_db.h"
+#include "light_sim.h"
+#include "fake_bluetooth.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define MAX_PHONES                   SL_BT_CONFIG_MAX_CONNECTIONS
+#define MAX_EVENTS                   (8u * MAX_PHONES)
+#define MAX_WRITES                   64u
+// Time from the start of the stack to its boot event.
+#define BOOT_DELAY_NS                LIGHT_SIM_MS(1)
+
+#define FNV_OFFSET_BASIS             0xCBF29CE484222325ull
+#define FNV_PRIME                    0x00000100000001B3ull
+
+typedef enum {
+  EVENT_BOOT,
+  EVENT_OPENED,
+  EVENT_CLOSED,
+  EVENT_CLIENT_CONFIG,
+  EVENT_CONFIRMATION,
+  EVENT_WRITE,
+} event_type_t;
+
+typedef struct {
+  bool used;
+  uint64_t atNs;
+  // Events due at the same time run in the order they were scheduled.
+  uint32_t order;
+  event_type_t type;
+  uint8_t connection;
+  uint16_t characteristic;
+  uint8_t config;
+} event_t;
+
+typedef struct {
+  uint16_t characteristic;
+  bool indication;
+  uint8_t length;
+  uint8_t value[FAKE_BT_MAX_VALUE_LENGTH];
+  uint64_t queuedNs;
+} packet_t;
+
+typedef struct {
+  bool open;
+  FakeBtPhoneConfig config;
+  uint64_t anchorNs;
+  // Values waiting for the next connection event, oldest first.
+  packet_t tx[FAKE_BT_MAX_TX_BUFFERS];
+  uint8_t txHead;
+  uint8_t txCount;
+  bool indicationUnconfirmed;
+  bool statusSeen;
+  uint16_t statusSequence;
+  // Writes waiting for the previous one to be answered.
+  uint64_t writes[MAX_WRITES];
+  uint8_t writeHead;
+  uint8_t writeCount;
+  bool writeOutstanding;
+  uint64_t writeAnsweredNs;
+  FakeBtPhoneStats stats;
+} phone_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static phone_t phones[MAX_PHONES];
+static event_t events[MAX_EVENTS];
+static uint32_t event_order;
+static FakeBtStats stats = { .digest = FNV_OFFSET_BASIS };
+static sl_bt_msg_t message;
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+static phone_t *find_phone(uint8_t connection)
+{
+  if ((connection == 0u) || (connection > MAX_PHONES) || !phones[connection - 1u].open) {
+    return NULL;
+  }
+  return &phones[connection - 1u];
+}
+
+static uint8_t phone_handle(const phone_t *phone)
+{
+  return (uint8_t)(phone - phones) + 1u;
+}
+
+static uint64_t interval_ns(const phone_t *phone)
+{
+  return (uint64_t)phone->config.intervalUs * 1000u;
+}
+
+// First connection event strictly after the given time.
+static uint64_t event_after(const phone_t *phone, uint64_t timeNs)
+{
+  if (timeNs < phone->anchorNs) {
+    return phone->anchorNs;
+  }
+  return phone->anchorNs
+         + ((((timeNs - phone->anchorNs) / interval_ns(phone)) + 1u) * interval_ns(phone));
+}
+
+static void schedule_event(uint64_t atNs,
+                           event_type_t type,
+                           uint8_t connection,
+                           uint16_t characteristic,
+                           uint8_t config)
+{
+  for (uint32_t i = 0u; i < MAX_EVENTS; i++) {
+    if (!events[i].used) {
+      events[i].used = true;
+      events[i].atNs = atNs;
+      events[i].order = event_order++;
+      events[i].type = type;
+      events[i].connection = connection;
+      events[i].characteristic = characteristic;
+      events[i].config = config;
+      return;
+    }
+  }
+  printf("  FAIL %s:%d: more than %u Bluetooth events pending\n",
+         __FILE__, __LINE__, (unsigned)MAX_EVENTS);
+  abort();
+}
+
+static event_t *next_event(void)
+{
+  event_t *next = NULL;
+
+  for (uint32_t i = 0u; i < MAX_EVENTS; i++) {
+    if (events[i].used
+        && ((next == NULL)
+            || (events[i].atNs < next->atNs)
+            || ((events[i].atNs == next->atNs) && (events[i].order < next->order)))) {
+      next = &events[i];
+    }
+  }
+  return next;
+}
+
+// Connection event that carries the oldest waiting value of a phone.
+static uint64_t next_transmission(const phone_t *phone)
+{
+  if (!phone->open || (phone->txCount == 0u)) {
+    return LIGHT_SIM_NEVER;
+  }
+  return event_after(phone, phone->tx[phone->txHead].queuedNs);
+}
+
+static void schedule_next_write(phone_t *phone)
+{
+  uint64_t earliest;
+
+  if (phone->writeOutstanding || (phone->writeCount == 0u)) {
+    return;
+  }
+  earliest = phone->writes[phone->writeHead];
+  if (earliest < phone->writeAnsweredNs) {
+    earliest = phone->writeAnsweredNs;
+  }
+  phone->writeHead = (phone->writeHead + 1u) % MAX_WRITES;
+  phone->writeCount--;
+  phone->writeOutstanding = true;
+  schedule_event(event_after(phone, earliest), EVENT_WRITE, phone_handle(phone),
+                 gattdb_light_state_connect, 0u);
+}
+
+static void digest(const void *data, size_t length)
+{
+  const uint8_t *bytes = (const uint8_t *)data;
+
+  for (size_t i = 0u; i < length; i++) {
+    stats.digest = (stats.digest ^ bytes[i]) * FNV_PRIME;
+  }
+}
+
+static void receive(phone_t *phone, const packet_t *packet, uint64_t atNs)
+{
+  uint8_t connection = phone_handle(phone);
+
+  digest(&connection, sizeof(connection));
+  digest(&atNs, sizeof(atNs));
+  digest(&packet->characteristic, sizeof(packet->characteristic));
+  digest(packet->value, packet->length);
+
+  if ((packet->characteristic == gattdb_light_status_connect)
+      && (packet->length == FAKE_BT_STATUS_LENGTH)) {
+    uint16_t sequence = (uint16_t)(packet->value[FAKE_BT_STATUS_SEQUENCE]
+                                   | (packet->value[FAKE_BT_STATUS_SEQUENCE + 1u] << 8));
+
+    if (phone->statusSeen && ((int16_t)(sequence - phone->statusSequence) <= 0)) {
+      phone->stats.sequenceErrors++;
+    }
+    phone->statusSeen = true;
+    phone->statusSequence = sequence;
+    phone->stats.statusReceived++;
+    memcpy(phone->stats.lastStatus, packet->value, FAKE_BT_STATUS_LENGTH);
+  } else if ((packet->characteristic == gattdb_light_state_connect)
+             && (packet->length == 1u)) {
+    phone->stats.stateReceived++;
+    phone->stats.lastState = packet->value[0];
+  }
+  lightDmpOnPhoneReceived(connection, packet->characteristic, packet->value,
+                          packet->length, atNs);
+  // The phone confirms at the next connection event.
+  if (packet->indication) {
+    schedule_event(atNs + interval_ns(phone), EVENT_CONFIRMATION, connection,
+                   packet->characteristic, 0u);
+  }
+}
+
+static void transmit(phone_t *phone)
+{
+  uint64_t atNs = next_transmission(phone);
+
+  while ((phone->txCount > 0u) && (phone->tx[phone->txHead].queuedNs < atNs)) {
+    packet_t packet = phone->tx[phone->txHead];
+
+    phone->txHead = (phone->txHead + 1u) % FAKE_BT_MAX_TX_BUFFERS;
+    phone->txCount--;
+    receive(phone, &packet, atNs);
+  }
+}
+
+static void run_event(event_t *event)
+{
+  phone_t *phone = find_phone(event->connection);
+  event_t due = *event;
+
+  event->used = false;
+  if ((due.type != EVENT_BOOT) && (phone == NULL)) {
+    return;
+  }
+  memset(&message, 0, sizeof(message));
+  switch (due.type) {
+    case EVENT_BOOT:
+      message.header = sl_bt_evt_system_boot_id;
+      break;
+    case EVENT_OPENED:
+      message.header = sl_bt_evt_connection_opened_id;
+      memcpy(message.data.evt_connection_opened.address.addr, phone->config.address,
+             sizeof(message.data.evt_connection_opened.address.addr));
+      message.data.evt_connection_opened.connection = due.connection;
+      message.data.evt_connection_opened.advertiser = 0u;
+      // The stack stops connectable advertising when a connection opens.
+      stats.advertising = false;
+      break;
+    case EVENT_CLOSED:
+      message.header = sl_bt_evt_connection_closed_id;
+      message.data.evt_connection_closed.connection = due.connection;
+      message.data.evt_connection_closed.reason = SL_STATUS_BT_CTRL_REMOTE_USER_TERMINATED;
+      phone->open = false;
+      break;
+    case EVENT_CLIENT_CONFIG:
+      message.header = sl_bt_evt_gatt_server_characteristic_status_id;
+      message.data.evt_gatt_server_characteristic_status.connection = due.connection;
+      message.data.evt_gatt_server_characteristic_status.characteristic = due.characteristic;
+      message.data.evt_gatt_server_characteristic_status.status_flags =
+        sl_bt_gatt_server_client_config;
+      message.data.evt_gatt_server_characteristic_status.client_config_flags = due.config;
+      break;
+    case EVENT_CONFIRMATION:
+      message.header = sl_bt_evt_gatt_server_characteristic_status_id;
+      message.data.evt_gatt_server_characteristic_status.connection = due.connection;
+      message.data.evt_gatt_server_characteristic_status.characteristic = due.characteristic;
+      message.data.evt_gatt_server_characteristic_status.status_flags =
+        sl_bt_gatt_server_confirmation;
+      phone->indicationUnconfirmed = false;
+      phone->stats.confirmations++;
+      break;
+    case EVENT_WRITE:
+      message.header = sl_bt_evt_gatt_server_user_write_request_id;
+      message.data.evt_gatt_server_user_write_request.connection = due.connection;
+      message.data.evt_gatt_server_user_write_request.characteristic = due.characteristic;
+      message.data.evt_gatt_server_user_write_request.att_opcode = sl_bt_gatt_write_request;
+      message.data.evt_gatt_server_user_write_request.value.len = 1u;
+      message.data.evt_gatt_server_user_write_request.value.data[0] = 1u;
+      phone->stats.writes++;
+      break;
+  }
+
+  if (due.type == EVENT_WRITE) {
+    lightDmpOnPhoneWrite(due.connection, due.atNs);
+  }
+  lightSimCharge(lightSimGetCosts()->btEventNs);
+  sl_bt_on_event(&message);
+}
+
+static sl_status_t send_value(uint8_t connection,
+                              uint16_t characteristic,
+                              size_t value_len,
+                              const uint8_t *value,
+                              bool indication)
+{
+  phone_t *phone = find_phone(connection);
+  packet_t *packet;
+
+  if (phone == NULL) {
+    return SL_STATUS_BT_CTRL_UNKNOWN_CONNECTION_IDENTIFIER;
+  }
+  lightSimCharge(lightSimGetCosts()->gattSendNs);
+  if (indication && phone->indicationUnconfirmed) {
+    phone->stats.protocolErrors++;
+    return SL_STATUS_INVALID_STATE;
+  }
+  if (phone->txCount >= phone->config.txBuffers) {
+    phone->stats.sendFailures++;
+    return SL_STATUS_NO_MORE_RESOURCE;
+  }
+  packet = &phone->tx[(phone->txHead + phone->txCount) % FAKE_BT_MAX_TX_BUFFERS];
+  phone->txCount++;
+  packet->characteristic = characteristic;
+  packet->indication = indication;
+  packet->length = (value_len < FAKE_BT_MAX_VALUE_LENGTH) ? (uint8_t)value_len
+                   : FAKE_BT_MAX_VALUE_LENGTH;
+  memcpy(packet->value, value, packet->length);
+  packet->queuedNs = lightSimNowNs();
+  if (indication) {
+    phone->indicationUnconfirmed = true;
+    phone->stats.indications++;
+  } else {
+    phone->stats.notifications++;
+  }
+  lightDmpOnGattSent(connection, characteristic);
+  return SL_STATUS_OK;
+}
+
+// -----------------------------------------------------------------------------
+//                                   Harness
+// -----------------------------------------------------------------------------
+uint8_t fakeBtConnect(const FakeBtPhoneConfig *config)
+{
+  for (uint8_t i = 0u; i < MAX_PHONES; i++) {
+    phone_t *phone = &phones[i];
+
+    if (phone->open) {
+      continue;
+    }
+    memset(phone, 0, sizeof(*phone));
+    phone->open = true;
+    phone->config = *config;
+    if (phone->config.txBuffers > FAKE_BT_MAX_TX_BUFFERS) {
+      phone->config.txBuffers = FAKE_BT_MAX_TX_BUFFERS;
+    }
+    phone->anchorNs = lightSimNowNs();
+    schedule_event(phone->anchorNs, EVENT_OPENED, i + 1u, 0u, 0u);
+    // The phone subscribes at the first connection event.
+    if (config->statusConfig != 0u) {
+      schedule_event(event_after(phone, phone->anchorNs), EVENT_CLIENT_CONFIG, i + 1u,
+                     gattdb_light_status_connect, config->statusConfig);
+    }
+    if (config->stateConfig != 0u) {
+      schedule_event(event_after(phone, phone->anchorNs), EVENT_CLIENT_CONFIG, i + 1u,
+                     gattdb_light_state_connect, config->stateConfig);
+    }
+    return i + 1u;
+  }
+  return 0u;
+}
+
+void fakeBtDisconnect(uint8_t connection)
+{
+  if (find_phone(connection) != NULL) {
+    schedule_event(lightSimNowNs(), EVENT_CLOSED, connection, 0u, 0u);
+  }
+}
+
+bool fakeBtWrite(uint8_t connection, uint64_t atNs)
+{
+  phone_t *phone = find_phone(connection);
+
+  if ((phone == NULL) || (phone->writeCount == MAX_WRITES)) {
+    return false;
+  }
+  phone->writes[(phone->writeHead + phone->writeCount) % MAX_WRITES] = atNs;
+  phone->writeCount++;
+  schedule_next_write(phone);
+  return true;
+}
+
+uint64_t fakeBtNextNs(void)
+{
+  event_t *event = next_event();
+  uint64_t next = (event != NULL) ? event->atNs : LIGHT_SIM_NEVER;
+
+  for (uint8_t i = 0u; i < MAX_PHONES; i++) {
+    uint64_t transmission = next_transmission(&phones[i]);
+
+    if (transmission < next) {
+      next = transmission;
+    }
+  }
+  return next;
+}
+
+void fakeBtRunDue(void)
+{
+  while (true) {
+    event_t *event = next_event();
+    phone_t *transmitting = NULL;
+    uint64_t next = (event != NULL) ? event->atNs : LIGHT_SIM_NEVER;
+
+    // A connection event first sends what was queued before it, then
+    // reports what the phone sent.
+    for (uint8_t i = 0u; i < MAX_PHONES; i++) {
+      uint64_t transmission = next_transmission(&phones[i]);
+
+      if (transmission <= next) {
+        next = transmission;
+        transmitting = &phones[i];
+      }
+    }
+    if (next > lightSimNowNs()) {
+      return;
+    }
+    if (transmitting != NULL) {
+      transmit(transmitting);
+    } else {
+      run_event(event);
+    }
+  }
+}
+
+void fakeBtGetPhoneStats(uint8_t connection, FakeBtPhoneStats *out)
+{
+  if ((connection == 0u) || (connection > MAX_PHONES)) {
+    memset(out, 0, sizeof(*out));
+    return;
+  }
+  *out = phones[connection - 1u].stats;
+}
+
+void fakeBtGetStats(FakeBtStats *out)
+{
+  *out = stats;
+}
+
+// -----------------------------------------------------------------------------
+//                                Bluetooth API
+// -----------------------------------------------------------------------------
+sl_status_t sl_bt_system_start_bluetooth()
+{
+  schedule_event(lightSimNowNs() + BOOT_DELAY_NS, EVENT_BOOT, 0u, 0u, 0u);
+  return SL_STATUS_OK;
+}
+
+void sl_bt_system_reset(uint8_t dfu)
+{
+  (void)dfu;
+  stats.resets++;
+}
+
+sl_status_t sl_bt_advertiser_create_set(uint8_t *handle)
+{
+  *handle = 0u;
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_bt_advertiser_set_timing(uint8_t advertising_set,
+                                        uint32_t interval_min,
+                                        uint32_t interval_max,
+                                        uint16_t duration,
+                                        uint8_t maxevents)
+{
+  (void)advertising_set;
+  (void)interval_min;
+  (void)interval_max;
+  (void)duration;
+  (void)maxevents;
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_bt_legacy_advertiser_generate_data(uint8_t advertising_set,
+                                                  uint8_t discover)
+{
+  (void)advertising_set;
+  (void)discover;
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_bt_legacy_advertiser_start(uint8_t advertising_set,
+                                          uint8_t connect)
+{
+  (void)advertising_set;
+  (void)connect;
+  if (stats.advertising) {
+    return SL_STATUS_INVALID_STATE;
+  }
+  stats.advertising = true;
+  stats.advertisingStarts++;
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_bt_gatt_server_send_user_read_response(uint8_t connection,
+                                                      uint16_t characteristic,
+                                                      uint8_t att_errorcode,
+                                                      size_t value_len,
+                                                      const uint8_t* value,
+                                                      uint16_t *sent_len)
+{
+  (void)characteristic;
+  (void)att_errorcode;
+  (void)value;
+  if (find_phone(connection) == NULL) {
+    return SL_STATUS_BT_CTRL_UNKNOWN_CONNECTION_IDENTIFIER;
+  }
+  *sent_len = (uint16_t)value_len;
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_bt_gatt_server_send_user_write_response(uint8_t connection,
+                                                       uint16_t characteristic,
+                                                       uint8_t att_errorcode)
+{
+  phone_t *phone = find_phone(connection);
+
+  (void)characteristic;
+  (void)att_errorcode;
+  if ((phone == NULL) || !phone->writeOutstanding) {
+    return SL_STATUS_INVALID_STATE;
+  }
+  phone->stats.writeResponses++;
+  phone->writeOutstanding = false;
+  phone->writeAnsweredNs = lightSimNowNs();
+  schedule_next_write(phone);
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_bt_gatt_server_send_notification(uint8_t connection,
+                                                uint16_t characteristic,
+                                                size_t value_len,
+                                                const uint8_t* value)
+{
+  return send_value(connection, characteristic, value_len, value, false);
+}
+
+sl_status_t sl_bt_gatt_server_send_indication(uint8_t connection,
+                                              uint16_t characteristic,
+                                              size_t value_len,
+                                              const uint8_t* value)
+{
+  return send_value(connection, characteristic, value_len, value, true);
+}
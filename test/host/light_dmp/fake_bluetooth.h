@@ -0,0 +1,125 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fake Bluetooth stack and phones of the light DMP simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef FAKE_BLUETOOTH_H
+#define FAKE_BLUETOOTH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Each connection is a phone. Data only moves at the connection events, one
+// connection interval apart from the opening of the connection. Values the
+// application sends go out at the next connection event, and a phone confirms
+// an indication at the connection event after it got it. The stack holds a
+// few values per connection until they go out, and refuses more. A phone has
+// one write outstanding at a time, the next one goes out at the connection
+// event after the write response.
+
+// Length of the light status value, and offsets of its fields.
+#define FAKE_BT_STATUS_LENGTH            20u
+#define FAKE_BT_STATUS_SEQUENCE          0u
+#define FAKE_BT_STATUS_STATE             2u
+#define FAKE_BT_STATUS_SOURCE            3u
+#define FAKE_BT_STATUS_ADDRESS           4u
+#define FAKE_BT_STATUS_LAMPS             12u
+#define FAKE_BT_STATUS_CHANGED           16u
+
+#define FAKE_BT_MAX_TX_BUFFERS           8u
+#define FAKE_BT_MAX_VALUE_LENGTH         32u
+
+typedef struct {
+  uint8_t address[6];
+  uint32_t intervalUs;
+  // Client configuration of the light status and of the light state:
+  // sl_bt_gatt_notification, sl_bt_gatt_indication or 0.
+  uint8_t statusConfig;
+  uint8_t stateConfig;
+  // Values the stack holds for the connection, up to FAKE_BT_MAX_TX_BUFFERS.
+  uint8_t txBuffers;
+} FakeBtPhoneConfig;
+
+typedef struct {
+  uint32_t notifications;
+  uint32_t indications;
+  uint32_t confirmations;
+  // Sends refused because every buffer of the connection was taken.
+  uint32_t sendFailures;
+  // Indications sent while one was not confirmed yet.
+  uint32_t protocolErrors;
+  uint32_t writes;
+  uint32_t writeResponses;
+  uint32_t statusReceived;
+  // Light status values whose sequence number did not increase.
+  uint32_t sequenceErrors;
+  uint8_t lastStatus[FAKE_BT_STATUS_LENGTH];
+  uint32_t stateReceived;
+  uint8_t lastState;
+} FakeBtPhoneStats;
+
+typedef struct {
+  bool advertising;
+  uint32_t advertisingStarts;
+  uint32_t resets;
+  // FNV-1a of every value the phones received, with its time.
+  uint64_t digest;
+} FakeBtStats;
+
+/**************************************************************************//**
+ * Opens a connection from a phone, which then subscribes as configured.
+ * Returns the connection handle, 0 if every connection is taken.
+ *****************************************************************************/
+uint8_t fakeBtConnect(const FakeBtPhoneConfig *phone);
+
+/**************************************************************************//**
+ * Closes the connection of a phone.
+ *****************************************************************************/
+void fakeBtDisconnect(uint8_t connection);
+
+/**************************************************************************//**
+ * Has a phone write the light state, at the first connection event it can.
+ * Returns false if too many writes of the phone are waiting already.
+ *****************************************************************************/
+bool fakeBtWrite(uint8_t connection, uint64_t atNs);
+
+/**************************************************************************//**
+ * Time the Bluetooth stack has work next, or LIGHT_SIM_NEVER.
+ *****************************************************************************/
+uint64_t fakeBtNextNs(void);
+
+/**************************************************************************//**
+ * Runs the Bluetooth stack for everything due, in time order.
+ *****************************************************************************/
+void fakeBtRunDue(void);
+
+void fakeBtGetPhoneStats(uint8_t connection, FakeBtPhoneStats *stats);
+
+void fakeBtGetStats(FakeBtStats *stats);
+
+#endif // FAKE_BLUETOOTH_H
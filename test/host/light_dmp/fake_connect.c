@@ -0,0 +1,528 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fake Connect stack and platform services of the light DMP simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include PLATFORM_HEADER
+#include "stack/include/ember.h"
+#include "hal.h"
+#include "em_chip.h"
+#include "nvm3_default.h"
+#include "psa/crypto.h"
+#include "sl_cli.h"
+#include "sl_simple_led_instances.h"
+#include "sl_sleeptimer.h"
+#include "cmsis-rtos-ipc-stats.h"
+#include "app_assert.h"
+#include "app_log.h"
+#include "light_sim.h"
+#include "fake_connect.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define MAX_FRAME_LENGTH             127u
+#define DEFAULT_CHANNEL              11u
+// Time the stack takes to report a network change.
+#define STACK_STATUS_DELAY_NS        LIGHT_SIM_MS(1)
+#define SLEEPTIMER_FREQUENCY         32768u
+#define FRAME_RSSI                   (-40)
+
+#define NVM3_MAX_OBJECTS             4u
+#define NVM3_MAX_OBJECT_SIZE         256u
+
+typedef struct {
+  uint64_t atNs;
+  // Frame, else stack status.
+  bool frame;
+  EmberStatus status;
+  EmberNodeId source;
+  uint8_t endpoint;
+  uint8_t length;
+  uint8_t payload[MAX_FRAME_LENGTH];
+  uint32_t tag;
+} arrival_t;
+
+typedef struct {
+  bool used;
+  nvm3_ObjectKey_t key;
+  size_t length;
+  uint8_t data[NVM3_MAX_OBJECT_SIZE];
+} nvm3_object_t;
+
+struct nvm3_Handle {
+  nvm3_object_t objects[NVM3_MAX_OBJECTS];
+};
+
+// -----------------------------------------------------------------------------
+//                          Static Function Declarations
+// -----------------------------------------------------------------------------
+static void led_turn_on(void *context);
+static void led_turn_off(void *context);
+static void led_toggle(void *context);
+static sl_led_state_t led_get_state(void *context);
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+// Oldest arrival first.
+static arrival_t arrivals[FAKE_CONNECT_MAX_FRAMES];
+static uint32_t arrival_head;
+static uint32_t arrival_count;
+static FakeConnectStats stats;
+static EmberNetworkStatus network_state = EMBER_NO_NETWORK;
+static EmberNodeId node_id = EMBER_NULL_NODE_ID;
+static int16_t radio_power;
+static nvm3_Handle_t nvm3_default_instance;
+static psa_key_id_t next_key_id = 1u;
+static bool verbose;
+
+// -----------------------------------------------------------------------------
+//                                Global Variables
+// -----------------------------------------------------------------------------
+EmberTaskId emAppTask;
+nvm3_Handle_t *nvm3_defaultHandle = &nvm3_default_instance;
+const sl_led_t sl_led_led0 = {
+  .context = NULL,
+  .init = NULL,
+  .turn_on = led_turn_on,
+  .turn_off = led_turn_off,
+  .toggle = led_toggle,
+  .get_state = led_get_state,
+};
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+static arrival_t *schedule_arrival(uint64_t atNs)
+{
+  uint32_t index;
+
+  if (arrival_count == FAKE_CONNECT_MAX_FRAMES) {
+    printf("  FAIL %s:%d: more than %u frames scheduled\n",
+           __FILE__, __LINE__, FAKE_CONNECT_MAX_FRAMES);
+    abort();
+  }
+  // Insertion sort from the back, frames come mostly in order.
+  index = arrival_count++;
+  while ((index > 0u)
+         && (arrivals[(arrival_head + index - 1u) % FAKE_CONNECT_MAX_FRAMES].atNs > atNs)) {
+    arrivals[(arrival_head + index) % FAKE_CONNECT_MAX_FRAMES] =
+      arrivals[(arrival_head + index - 1u) % FAKE_CONNECT_MAX_FRAMES];
+    index--;
+  }
+  index = (arrival_head + index) % FAKE_CONNECT_MAX_FRAMES;
+  memset(&arrivals[index], 0, sizeof(arrivals[index]));
+  arrivals[index].atNs = atNs;
+  return &arrivals[index];
+}
+
+static void schedule_stack_status(EmberStatus status)
+{
+  arrival_t *arrival = schedule_arrival(lightSimNowNs() + STACK_STATUS_DELAY_NS);
+
+  arrival->status = status;
+}
+
+static nvm3_object_t *find_object(nvm3_ObjectKey_t key)
+{
+  for (uint32_t i = 0u; i < NVM3_MAX_OBJECTS; i++) {
+    if (nvm3_default_instance.objects[i].used
+        && (nvm3_default_instance.objects[i].key == key)) {
+      return &nvm3_default_instance.objects[i];
+    }
+  }
+  return NULL;
+}
+
+static void led_turn_on(void *context)
+{
+  (void)context;
+  stats.ledChanges += stats.ledOn ? 0u : 1u;
+  stats.ledOn = true;
+  lightDmpOnLampsApplied();
+}
+
+static void led_turn_off(void *context)
+{
+  (void)context;
+  stats.ledChanges += stats.ledOn ? 1u : 0u;
+  stats.ledOn = false;
+  lightDmpOnLampsApplied();
+}
+
+static void led_toggle(void *context)
+{
+  stats.ledOn ? led_turn_off(context) : led_turn_on(context);
+}
+
+static sl_led_state_t led_get_state(void *context)
+{
+  (void)context;
+  return stats.ledOn ? SL_LED_CURRENT_STATE_ON : SL_LED_CURRENT_STATE_OFF;
+}
+
+// -----------------------------------------------------------------------------
+//                                   Harness
+// -----------------------------------------------------------------------------
+void fakeConnectScheduleFrame(uint64_t atNs,
+                              uint16_t source,
+                              uint8_t endpoint,
+                              const uint8_t *payload,
+                              uint8_t length,
+                              uint32_t tag)
+{
+  arrival_t *arrival = schedule_arrival(atNs);
+
+  arrival->frame = true;
+  arrival->source = source;
+  arrival->endpoint = endpoint;
+  arrival->length = (length < MAX_FRAME_LENGTH) ? length : MAX_FRAME_LENGTH;
+  memcpy(arrival->payload, payload, arrival->length);
+  arrival->tag = tag;
+}
+
+uint64_t fakeConnectNextNs(void)
+{
+  return (arrival_count > 0u) ? arrivals[arrival_head].atNs : LIGHT_SIM_NEVER;
+}
+
+void fakeConnectRunDue(void)
+{
+  while ((arrival_count > 0u) && (arrivals[arrival_head].atNs <= lightSimNowNs())) {
+    arrival_t *arrival = &arrivals[arrival_head];
+
+    arrival_head = (arrival_head + 1u) % FAKE_CONNECT_MAX_FRAMES;
+    arrival_count--;
+    if (!arrival->frame) {
+      lightSimPostStackStatus(arrival->status);
+      continue;
+    }
+    stats.framesReceived++;
+    lightSimCharge(lightSimGetCosts()->stackRxNs);
+    // The radio stamps the frame when it ends, whenever the task gets to it.
+    lightSimPostIncomingMessage(arrival->source,
+                                arrival->endpoint,
+                                FRAME_RSSI,
+                                (uint32_t)(arrival->atNs / 1000000u),
+                                arrival->payload,
+                                arrival->length,
+                                arrival->tag);
+  }
+}
+
+bool fakeConnectReadNvm3(uint32_t key, void *value, size_t length)
+{
+  return nvm3_readData(nvm3_defaultHandle, key, value, length) == ECODE_NVM3_OK;
+}
+
+void fakeConnectSetVerbose(bool enabled)
+{
+  verbose = enabled;
+}
+
+void fakeConnectGetStats(FakeConnectStats *out)
+{
+  *out = stats;
+  out->networkUp = (network_state == EMBER_JOINED_NETWORK);
+}
+
+// -----------------------------------------------------------------------------
+//                          Connect stack and event core
+// -----------------------------------------------------------------------------
+EmberStatus emberNetworkInit(void)
+{
+  return (network_state == EMBER_JOINED_NETWORK) ? EMBER_SUCCESS : EMBER_NOT_JOINED;
+}
+
+EmberStatus emberFormNetwork(EmberNetworkParameters *parameters)
+{
+  if (network_state == EMBER_JOINED_NETWORK) {
+    return EMBER_INVALID_CALL;
+  }
+  stats.panId = parameters->panId;
+  stats.channel = parameters->radioChannel;
+  radio_power = parameters->radioTxPower;
+  network_state = EMBER_JOINED_NETWORK;
+  node_id = 0x0000u;
+  schedule_stack_status(EMBER_NETWORK_UP);
+  return EMBER_SUCCESS;
+}
+
+EmberStatus emberPermitJoining(uint8_t duration)
+{
+  stats.permitJoiningDuration = duration;
+  return (network_state == EMBER_JOINED_NETWORK) ? EMBER_SUCCESS : EMBER_INVALID_CALL;
+}
+
+void emberResetNetworkState(void)
+{
+  if (network_state == EMBER_JOINED_NETWORK) {
+    schedule_stack_status(EMBER_NETWORK_DOWN);
+  }
+  network_state = EMBER_NO_NETWORK;
+  node_id = EMBER_NULL_NODE_ID;
+}
+
+EmberNetworkStatus emberNetworkState(void)
+{
+  return network_state;
+}
+
+EmberNodeId emberGetNodeId(void)
+{
+  return node_id;
+}
+
+EmberNodeType emberGetNodeType(void)
+{
+  return (network_state == EMBER_JOINED_NETWORK) ? EMBER_STAR_COORDINATOR : EMBER_UNKNOWN_DEVICE;
+}
+
+EmberPanId emberGetPanId(void)
+{
+  return stats.panId;
+}
+
+uint16_t emberGetRadioChannel(void)
+{
+  return stats.channel;
+}
+
+uint16_t emberGetDefaultChannel(void)
+{
+  return DEFAULT_CHANNEL;
+}
+
+int16_t emberGetRadioPower(void)
+{
+  return radio_power;
+}
+
+EmberStatus emberSetPsaSecurityKey(mbedtls_svc_key_id_t key_id)
+{
+  return (key_id != 0u) ? EMBER_SUCCESS : EMBER_INVALID_CALL;
+}
+
+EmberStatus emberRemovePsaSecurityKey(void)
+{
+  return EMBER_SUCCESS;
+}
+
+uint32_t emFetchInt32u(bool lowHigh, const uint8_t *contents)
+{
+  uint32_t value = 0u;
+
+  for (uint8_t i = 0u; i < 4u; i++) {
+    value |= (uint32_t)contents[lowHigh ? i : (3u - i)] << (8u * i);
+  }
+  return value;
+}
+
+void sli_event_control_set_active(EmberEventControl *event)
+{
+  event->status = EMBER_EVENT_ZERO_DELAY;
+  event->timeToExecute = halCommonGetInt32uMillisecondTick();
+}
+
+void emEventControlSetDelayMS(EmberEventControl *event, uint32_t delay)
+{
+  event->status = EMBER_EVENT_MS_TIME;
+  event->timeToExecute = halCommonGetInt32uMillisecondTick() + delay;
+}
+
+uint32_t emEventControlGetRemainingMS(EmberEventControl *event)
+{
+  int32_t remaining = (int32_t)(event->timeToExecute - halCommonGetInt32uMillisecondTick());
+
+  if (event->status == EMBER_EVENT_INACTIVE) {
+    return MAX_INT32U_VALUE;
+  }
+  return (remaining > 0) ? (uint32_t)remaining : 0u;
+}
+
+// The IPC layer is modeled, it keeps no statistics.
+bool emberAfPluginCmsisRtosGetIpcStats(uint8_t index,
+                                       EmberAfPluginCmsisRtosIpcStats *ipcStats)
+{
+  (void)index;
+  (void)ipcStats;
+  return false;
+}
+
+uint32_t emberAfPluginCmsisRtosGetIpcStatsUntracked(void)
+{
+  return 0u;
+}
+
+void emberAfPluginCmsisRtosResetIpcStats(void)
+{
+}
+
+// -----------------------------------------------------------------------------
+//                               Platform services
+// -----------------------------------------------------------------------------
+uint32_t halCommonGetInt32uMillisecondTick(void)
+{
+  return (uint32_t)(lightSimNowNs() / 1000000u);
+}
+
+void halReboot(void)
+{
+  stats.reboots++;
+}
+
+void halInternalAssertFailed(const char *filename, int linenumber)
+{
+  printf("  ASSERT %s:%d\n", filename, linenumber);
+  abort();
+}
+
+uint32_t sl_sleeptimer_get_tick_count(void)
+{
+  return (uint32_t)((lightSimNowNs() * SLEEPTIMER_FREQUENCY) / 1000000000u);
+}
+
+uint32_t sl_sleeptimer_get_timer_frequency(void)
+{
+  return SLEEPTIMER_FREQUENCY;
+}
+
+sl_status_t sl_sleeptimer_ms32_to_tick(uint32_t time_ms, uint32_t *tick)
+{
+  uint64_t ticks = ((uint64_t)time_ms * SLEEPTIMER_FREQUENCY) / 1000u;
+
+  if (ticks > UINT32_MAX) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  *tick = (uint32_t)ticks;
+  return SL_STATUS_OK;
+}
+
+uint64_t SYSTEM_GetUnique(void)
+{
+  return 0x000B57FFFE0C1D00ull;
+}
+
+Ecode_t nvm3_readData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, void *value, size_t len)
+{
+  nvm3_object_t *object = find_object(key);
+
+  (void)h;
+  if (object == NULL) {
+    return ECODE_NVM3_ERR_KEY_NOT_FOUND;
+  }
+  if (object->length != len) {
+    return ECODE_NVM3_ERR_READ_DATA_SIZE;
+  }
+  memcpy(value, object->data, len);
+  return ECODE_NVM3_OK;
+}
+
+Ecode_t nvm3_writeData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, const void *value, size_t len)
+{
+  nvm3_object_t *object = find_object(key);
+
+  (void)h;
+  for (uint32_t i = 0u; (object == NULL) && (i < NVM3_MAX_OBJECTS); i++) {
+    if (!nvm3_default_instance.objects[i].used) {
+      object = &nvm3_default_instance.objects[i];
+    }
+  }
+  if ((object == NULL) || (len > NVM3_MAX_OBJECT_SIZE)) {
+    return ECODE_NVM3_ERR_WRITE_FAILED;
+  }
+  lightSimCharge(lightSimGetCosts()->nvm3WriteNs);
+  object->used = true;
+  object->key = key;
+  object->length = len;
+  memcpy(object->data, value, len);
+  stats.nvm3Writes++;
+  return ECODE_NVM3_OK;
+}
+
+psa_status_t psa_crypto_init(void)
+{
+  return PSA_SUCCESS;
+}
+
+psa_status_t psa_import_key(const psa_key_attributes_t *attributes,
+                            const uint8_t *data,
+                            size_t data_length,
+                            psa_key_id_t *key)
+{
+  if ((data == NULL) || ((data_length * 8u) != attributes->bits)) {
+    return PSA_ERROR_INVALID_ARGUMENT;
+  }
+  *key = next_key_id++;
+  return PSA_SUCCESS;
+}
+
+psa_status_t psa_destroy_key(psa_key_id_t key)
+{
+  return ((key != 0u) && (key < next_key_id)) ? PSA_SUCCESS : PSA_ERROR_INVALID_HANDLE;
+}
+
+uint8_t *sl_cli_get_argument_hex(sl_cli_command_arg_t *a, int n, size_t *l)
+{
+  uint8_t *argument = (uint8_t *)a->argv[n];
+
+  *l = argument[0];
+  return &argument[1];
+}
+
+void app_log_host(bool new_line, const char *format, ...)
+{
+  va_list arguments;
+
+  stats.logLines += new_line ? 1u : 0u;
+  if (verbose) {
+    va_start(arguments, format);
+    vprintf(format, arguments);
+    va_end(arguments);
+  }
+}
+
+void app_assert_host(const char *file, int line, const char *format, ...)
+{
+  va_list arguments;
+
+  printf("  ASSERT %s:%d: ", file, line);
+  va_start(arguments, format);
+  vprintf(format, arguments);
+  va_end(arguments);
+  abort();
+}
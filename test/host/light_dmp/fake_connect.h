@@ -0,0 +1,95 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fake Connect stack and platform services of the light DMP simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef FAKE_CONNECT_H
+#define FAKE_CONNECT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The Connect stack task receives the frames the harness schedules and posts
+// their incoming message callbacks. Forming and leaving the network post the
+// matching stack status. NVM3, the LED, the logs and the hal services the
+// application uses are kept in memory.
+
+// Frames scheduled and not received yet.
+#define FAKE_CONNECT_MAX_FRAMES          4096u
+
+typedef struct {
+  uint32_t framesReceived;
+  uint32_t nvm3Writes;
+  uint32_t ledChanges;
+  bool ledOn;
+  bool networkUp;
+  uint16_t panId;
+  uint16_t channel;
+  uint8_t permitJoiningDuration;
+  uint32_t reboots;
+  uint32_t logLines;
+} FakeConnectStats;
+
+/**************************************************************************//**
+ * Schedules a frame for the light. Frames may be scheduled out of order.
+ *
+ * @param atNs Reception time of the frame.
+ * @param tag Identifies the frame to the lightDmpOnFrame hooks.
+ *****************************************************************************/
+void fakeConnectScheduleFrame(uint64_t atNs,
+                              uint16_t source,
+                              uint8_t endpoint,
+                              const uint8_t *payload,
+                              uint8_t length,
+                              uint32_t tag);
+
+/**************************************************************************//**
+ * Time the Connect stack task has work next, or LIGHT_SIM_NEVER.
+ *****************************************************************************/
+uint64_t fakeConnectNextNs(void);
+
+/**************************************************************************//**
+ * Runs the Connect stack task for everything due.
+ *****************************************************************************/
+void fakeConnectRunDue(void);
+
+/**************************************************************************//**
+ * Copies an NVM3 object of the default instance. Returns false if there is
+ * none of that size.
+ *****************************************************************************/
+bool fakeConnectReadNvm3(uint32_t key, void *value, size_t length);
+
+/**************************************************************************//**
+ * Prints the application logs as they come.
+ *****************************************************************************/
+void fakeConnectSetVerbose(bool verbose);
+
+void fakeConnectGetStats(FakeConnectStats *stats);
+
+#endif // FAKE_CONNECT_H
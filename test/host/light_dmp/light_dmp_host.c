@@ -0,0 +1,837 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host checks and benchmark of the light DMP application
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include PLATFORM_HEADER
+#include "stack/include/ember.h"
+#include "sl_bluetooth.h"
+#include "gatt_db.h"
+#include "sl_cli.h"
+#include "sl_light_switch.h"
+#include "app_process.h"
+#include "bench_util.h"
+#include "light_sim.h"
+#include "fake_connect.h"
+#include "fake_bluetooth.h"
+
+// The unmodified application, the light switch component and the application
+// framework event scheduler run on the simulation of light_sim.c, behind the
+// fake Connect and Bluetooth stacks. The harness schedules switch frames and
+// phone writes, and follows every toggle the light accepts until each phone
+// got a light status that includes it.
+//
+// The application keeps its state in statics, so every check and benchmark
+// runs in a child process of its own.
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define SWITCH_COUNT                 8u
+#define MAX_PHONES                   4u
+#define MAX_TOGGLES                  65536u
+#define MAX_PENDING                  64u
+#define MAX_IN_FLIGHT                16u
+// Phones writing the light state add to the toggles of the switches.
+#define MAX_APPLIED                  (MAX_TOGGLES + 4096u)
+#define MAX_SAMPLES                  (MAX_APPLIED * MAX_PHONES)
+
+// Tag bit of the retransmissions of a frame.
+#define TAG_COPY                     0x80000000u
+
+#define SWITCH_FRAME_LENGTH          10u
+#define SWITCH_SEQUENCE_BYTE         9u
+
+#define NETWORK_UP_NS                LIGHT_SIM_MS(20)
+#define SUBSCRIBED_NS                LIGHT_SIM_MS(200)
+// Time given to the light to report everything once the frames stop.
+#define DRAIN_NS                     LIGHT_SIM_MS(2000)
+
+#define BENCH_DURATION_NS            LIGHT_SIM_MS(2000)
+#define BENCH_CHUNK_NS               LIGHT_SIM_MS(10)
+// Share of the frames a switch sends twice, in percent.
+#define BENCH_COPY_PERCENT           5u
+#define BENCH_WRITE_INTERVAL_NS      LIGHT_SIM_MS(50)
+
+typedef struct {
+  const char *name;
+  void (*run)(void);
+} check_t;
+
+typedef struct {
+  uint64_t atNs;
+  uint8_t switchIndex;
+} toggle_t;
+
+typedef struct {
+  bool connected;
+  // Toggles applied before the phone connected are not expected.
+  uint32_t receivedUpTo;
+  // Toggles covered by each light status handed to the stack, oldest first.
+  uint32_t inFlight[MAX_IN_FLIGHT];
+  uint8_t inFlightHead;
+  uint8_t inFlightCount;
+} phone_t;
+
+typedef struct {
+  const char *name;
+  uint32_t framesPerSecond;
+  uint8_t phones;
+  uint8_t config;
+  bool writes;
+} scenario_t;
+
+// The light settings object, as sl_light_switch.c writes it.
+typedef struct {
+  sl_lamp_mask_t lamp_states;
+  sl_lamp_mask_t scenes[SL_LIGHT_SWITCH_SCENE_COUNT];
+  uint16_t pan_id;
+  uint16_t channel;
+} light_settings_t;
+
+typedef struct {
+  uint32_t injected;
+  uint32_t copies;
+  uint32_t accepted;
+  uint32_t dropped;
+  uint32_t overflowed;
+  uint32_t rejected;
+} frame_stats_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static volatile uint32_t failure_count;
+// Sent back to the parent by a child process.
+static uint64_t isolated_result;
+
+static const uint8_t switch_euis[SWITCH_COUNT][EUI64_SIZE] = {
+  { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 },
+  { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 },
+  { 0xA0, 0xB1, 0xC2, 0xD3, 0xE4, 0xF5, 0x06, 0x17 },
+  { 0x3C, 0x4D, 0x5E, 0x6F, 0x70, 0x81, 0x92, 0xA3 },
+  { 0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10 },
+  { 0x0F, 0x1E, 0x2D, 0x3C, 0x4B, 0x5A, 0x69, 0x78 },
+  { 0x55, 0xAA, 0x55, 0xAA, 0x12, 0x34, 0x56, 0x78 },
+  { 0x90, 0x81, 0x72, 0x63, 0x54, 0x45, 0x36, 0x27 },
+};
+static uint8_t switch_sequences[SWITCH_COUNT];
+
+static const uint8_t phone_addresses[MAX_PHONES][6] = {
+  { 0x01, 0x00, 0x00, 0x0B, 0x57, 0x90 },
+  { 0x02, 0x00, 0x00, 0x0B, 0x57, 0x90 },
+  { 0x03, 0x00, 0x00, 0x0B, 0x57, 0x90 },
+  { 0x04, 0x00, 0x00, 0x0B, 0x57, 0x90 },
+};
+// Typical connection intervals of phones.
+static const uint32_t phone_intervals_us[MAX_PHONES] = { 30000u, 15000u, 45000u, 7500u };
+
+static toggle_t toggles[MAX_TOGGLES];
+static uint32_t toggle_count;
+static frame_stats_t frames;
+// Counters of the application when the last frame was dispatched.
+static uint32_t accepted_counts[SWITCH_COUNT];
+static uint32_t overflow_count;
+
+// Toggles accepted by the light and not applied to the lamps yet.
+static uint32_t pending[MAX_PENDING];
+static uint32_t pending_count;
+// Time the toggle behind each lamp change was made, in the order applied.
+static uint64_t applied[MAX_APPLIED];
+static uint32_t applied_count;
+// Write of a phone being handled.
+static bool write_under_way;
+static uint64_t write_ns;
+
+static phone_t phones[MAX_PHONES + 1u];
+// Toggle to phone latencies, one per toggle and phone.
+static uint64_t *samples;
+static uint32_t sample_count;
+
+static uint64_t random_state = 0x9E3779B97F4A7C15ull;
+
+extern light_switch_state_machine_t state;
+extern void cli_form(sl_cli_command_arg_t *arguments);
+
+// -----------------------------------------------------------------------------
+//                                   Hooks
+// -----------------------------------------------------------------------------
+static const switch_entry_t *find_switch(uint8_t switchIndex)
+{
+  for (uint8_t i = 0u; i < SWITCH_TABLE_SIZE; i++) {
+    const switch_entry_t *entry = get_switch_entry(i);
+
+    if ((entry != NULL)
+        && (memcmp(entry->eui, switch_euis[switchIndex], EUI64_SIZE) == 0)) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+// Frames are dispatched one at a time, so the counters of the switch tell
+// what the application did with it.
+void lightDmpOnFrameDispatched(uint32_t tag)
+{
+  uint32_t index = tag & ~TAG_COPY;
+  const switch_entry_t *entry;
+  uint32_t overflows = get_switch_command_overflow_count();
+
+  if (index >= toggle_count) {
+    return;
+  }
+  entry = find_switch(toggles[index].switchIndex);
+  if ((entry != NULL) && (entry->accepted_count != accepted_counts[toggles[index].switchIndex])) {
+    accepted_counts[toggles[index].switchIndex] = entry->accepted_count;
+    frames.accepted++;
+    if (pending_count < MAX_PENDING) {
+      pending[pending_count++] = index;
+    }
+  } else if (overflows != overflow_count) {
+    frames.overflowed++;
+  } else {
+    frames.rejected++;
+  }
+  overflow_count = overflows;
+}
+
+void lightDmpOnFrameDropped(uint32_t tag)
+{
+  frames.dropped++;
+}
+
+void lightDmpOnPhoneWrite(uint8_t connection, uint64_t atNs)
+{
+  write_under_way = true;
+  write_ns = atNs;
+}
+
+// A phone write toggles the light on the Bluetooth side, the switch commands
+// wait for the state machine, which applies all of them at once.
+void lightDmpOnLampsApplied(void)
+{
+  if (write_under_way) {
+    write_under_way = false;
+    if (applied_count < MAX_APPLIED) {
+      applied[applied_count++] = write_ns;
+    }
+    return;
+  }
+  for (uint32_t i = 0u; (i < pending_count) && (applied_count < MAX_APPLIED); i++) {
+    applied[applied_count++] = toggles[pending[i]].atNs;
+  }
+  pending_count = 0u;
+}
+
+// The stack sends the latest light status the application reported.
+void lightDmpOnGattSent(uint8_t connection, uint16_t characteristic)
+{
+  phone_t *phone = &phones[connection];
+
+  if ((characteristic != gattdb_light_status_connect) || (phone->inFlightCount == MAX_IN_FLIGHT)) {
+    return;
+  }
+  phone->inFlight[(phone->inFlightHead + phone->inFlightCount) % MAX_IN_FLIGHT] = applied_count;
+  phone->inFlightCount++;
+}
+
+void lightDmpOnPhoneReceived(uint8_t connection,
+                             uint16_t characteristic,
+                             const uint8_t *value,
+                             size_t length,
+                             uint64_t atNs)
+{
+  phone_t *phone = &phones[connection];
+  uint32_t upTo;
+
+  if ((characteristic != gattdb_light_status_connect) || (phone->inFlightCount == 0u)) {
+    return;
+  }
+  upTo = phone->inFlight[phone->inFlightHead];
+  phone->inFlightHead = (phone->inFlightHead + 1u) % MAX_IN_FLIGHT;
+  phone->inFlightCount--;
+  for (; phone->receivedUpTo < upTo; phone->receivedUpTo++) {
+    if ((samples != NULL) && (sample_count < MAX_SAMPLES)) {
+      samples[sample_count++] = atNs - applied[phone->receivedUpTo];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//                                  Scenarios
+// -----------------------------------------------------------------------------
+static uint32_t next_random(void)
+{
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 7;
+  random_state ^= random_state << 17;
+  return (uint32_t)(random_state >> 32);
+}
+
+static void start_light(const LightSimCosts *costs)
+{
+  lightSimInit(costs);
+  lightSimRunUntil(LIGHT_SIM_MS(10));
+  cli_form(NULL);
+  lightSimRunUntil(NETWORK_UP_NS);
+}
+
+static uint8_t connect_phone(uint8_t index, uint8_t config)
+{
+  FakeBtPhoneConfig phone;
+  uint8_t connection;
+
+  memcpy(phone.address, phone_addresses[index], sizeof(phone.address));
+  phone.intervalUs = phone_intervals_us[index];
+  phone.statusConfig = config;
+  phone.stateConfig = 0u;
+  phone.txBuffers = 4u;
+  connection = fakeBtConnect(&phone);
+  if (connection != 0u) {
+    memset(&phones[connection], 0, sizeof(phones[connection]));
+    phones[connection].connected = true;
+    phones[connection].receivedUpTo = applied_count;
+  }
+  return connection;
+}
+
+static void send_frame(uint64_t atNs, uint8_t switchIndex, uint8_t sequence, uint32_t tag)
+{
+  uint8_t payload[SWITCH_FRAME_LENGTH];
+
+  payload[LIGHT_SWITCH_MESSAGE_CONTROL_BYTE] = LIGHT_SWITCH_CONTROL_TOGGLE
+                                               | LIGHT_SWITCH_CONTROL_SEQUENCE;
+  memcpy(&payload[LIGHT_SWITCH_MESSAGE_CONTROL_BYTE + 1u], switch_euis[switchIndex], EUI64_SIZE);
+  payload[SWITCH_SEQUENCE_BYTE] = sequence;
+  fakeConnectScheduleFrame(atNs, 0x0010u + switchIndex, LIGHT_SWITCH_ENDPOINT,
+                           payload, sizeof(payload), tag);
+  frames.injected++;
+}
+
+// Returns the tag of the toggle, to send it again.
+static uint32_t send_toggle(uint64_t atNs, uint8_t switchIndex)
+{
+  uint32_t index = toggle_count++;
+
+  toggles[index].atNs = atNs;
+  toggles[index].switchIndex = switchIndex;
+  send_frame(atNs, switchIndex, ++switch_sequences[switchIndex], index);
+  return index;
+}
+
+static void send_copy(uint64_t atNs, uint32_t index)
+{
+  send_frame(atNs, toggles[index].switchIndex, switch_sequences[toggles[index].switchIndex],
+             index | TAG_COPY);
+  frames.copies++;
+}
+
+// Toggles at a steady rate with some jitter, round robin over the switches.
+static void send_toggles(uint64_t startNs, uint64_t endNs, uint32_t framesPerSecond)
+{
+  uint64_t period = 1000000000ull / framesPerSecond;
+
+  for (uint64_t atNs = startNs; atNs < endNs; atNs += period) {
+    uint64_t jitter = next_random() % (period / 2u + 1u);
+    uint32_t index;
+
+    if (toggle_count == MAX_TOGGLES) {
+      return;
+    }
+    index = send_toggle(atNs + jitter, (uint8_t)(toggle_count % SWITCH_COUNT));
+    if ((next_random() % 100u) < BENCH_COPY_PERCENT) {
+      send_copy(atNs + jitter + LIGHT_SIM_MS(2) + next_random() % 3000000u, index);
+    }
+  }
+}
+
+static void run_toggles(uint64_t startNs, uint64_t endNs, uint32_t framesPerSecond)
+{
+  for (uint64_t chunk = startNs; chunk < endNs; chunk += BENCH_CHUNK_NS) {
+    uint64_t chunkEnd = (chunk + BENCH_CHUNK_NS < endNs) ? chunk + BENCH_CHUNK_NS : endNs;
+
+    send_toggles(chunk, chunkEnd, framesPerSecond);
+    lightSimRunUntil(chunkEnd);
+  }
+}
+
+// Toggles applied that a connected phone has not received.
+static uint32_t lost_toggles(void)
+{
+  uint32_t lost = 0u;
+
+  for (uint8_t i = 1u; i <= MAX_PHONES; i++) {
+    if (phones[i].connected) {
+      lost += applied_count - phones[i].receivedUpTo;
+    }
+  }
+  return lost;
+}
+
+static uint32_t status_field(const uint8_t *status, uint8_t offset)
+{
+  return (uint32_t)status[offset]
+         | ((uint32_t)status[offset + 1u] << 8)
+         | ((uint32_t)status[offset + 2u] << 16)
+         | ((uint32_t)status[offset + 3u] << 24);
+}
+
+// Runs a check or a benchmark in a child process, with a clean application.
+static bool run_isolated(void (*run)(void), uint64_t *result)
+{
+  int fds[2];
+  pid_t pid;
+  int status;
+  uint64_t value = 0u;
+
+  fflush(stdout);
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    failure_count = 0u;
+    run();
+    if (write(fds[1], &isolated_result, sizeof(isolated_result)) != sizeof(isolated_result)) {
+      _exit(1);
+    }
+    _exit((failure_count == 0u) ? 0 : 1);
+  }
+  close(fds[1]);
+  if ((pid < 0)
+      || (read(fds[0], &value, sizeof(value)) != sizeof(value))) {
+    value = 0u;
+  }
+  close(fds[0]);
+  if ((pid < 0) || (waitpid(pid, &status, 0) != pid)) {
+    return false;
+  }
+  if (result != NULL) {
+    *result = value;
+  }
+  return WIFEXITED(status) && (WEXITSTATUS(status) == 0);
+}
+
+// -----------------------------------------------------------------------------
+//                                    Checks
+// -----------------------------------------------------------------------------
+#define CHECK(cond, ...)                              \
+  do {                                                \
+    if (!(cond)) {                                    \
+      failure_count++;                                \
+      printf("  FAIL %s:%d: ", __FILE__, __LINE__);   \
+      printf(__VA_ARGS__);                            \
+      printf("\n");                                   \
+      return;                                         \
+    }                                                 \
+  } while (0)
+
+// The light advertises once booted, and operates once the network is formed.
+static void check_network(void)
+{
+  FakeConnectStats connect;
+  FakeBtStats bluetooth;
+
+  lightSimInit(&lightSimDefaultCosts);
+  lightSimRunUntil(LIGHT_SIM_MS(10));
+  fakeBtGetStats(&bluetooth);
+  CHECK(state == S_STANDBY, "state %u before forming", state);
+  CHECK(bluetooth.advertising, "not advertising");
+
+  cli_form(NULL);
+  lightSimRunUntil(NETWORK_UP_NS);
+  fakeConnectGetStats(&connect);
+  CHECK(state == S_OPERATE, "state %u after forming", state);
+  CHECK(connect.networkUp, "network down");
+  CHECK(connect.panId == DEFAULT_LIGHT_SWITCH_PAN_ID, "PAN ID 0x%04X", connect.panId);
+  CHECK(connect.channel == 11u, "channel %u", connect.channel);
+  CHECK(connect.permitJoiningDuration == 0xFFu, "permit joining %u",
+        connect.permitJoiningDuration);
+}
+
+// One toggle reaches the LED and the light status of a subscribed phone.
+static void check_switch_toggle(void)
+{
+  FakeConnectStats connect;
+  FakeBtPhoneStats phone;
+  uint8_t connection;
+  uint8_t address[EUI64_SIZE];
+
+  start_light(&lightSimDefaultCosts);
+  connection = connect_phone(0u, sl_bt_gatt_indication);
+  lightSimRunUntil(SUBSCRIBED_NS);
+  send_toggle(lightSimNowNs(), 0u);
+  lightSimRunUntil(lightSimNowNs() + LIGHT_SIM_MS(200));
+
+  fakeConnectGetStats(&connect);
+  fakeBtGetPhoneStats(connection, &phone);
+  for (uint8_t i = 0u; i < EUI64_SIZE; i++) {
+    address[i] = (uint8_t)((switch_euis[0][i] >> 4) | (switch_euis[0][i] << 4));
+  }
+  CHECK(connect.ledOn, "LED off");
+  CHECK(phone.statusReceived == 1u, "%lu light status", (unsigned long)phone.statusReceived);
+  CHECK(phone.lastStatus[FAKE_BT_STATUS_STATE] == DEMO_LIGHT_ON, "state %u",
+        phone.lastStatus[FAKE_BT_STATUS_STATE]);
+  CHECK(phone.lastStatus[FAKE_BT_STATUS_SOURCE] == 1u, "source %u",
+        phone.lastStatus[FAKE_BT_STATUS_SOURCE]);
+  CHECK(memcmp(&phone.lastStatus[FAKE_BT_STATUS_ADDRESS], address, EUI64_SIZE) == 0,
+        "switch address");
+  CHECK(status_field(phone.lastStatus, FAKE_BT_STATUS_LAMPS) == 0x01u, "lamps 0x%08lX",
+        (unsigned long)status_field(phone.lastStatus, FAKE_BT_STATUS_LAMPS));
+  CHECK(status_field(phone.lastStatus, FAKE_BT_STATUS_CHANGED) == 0x01u, "changed lamps 0x%08lX",
+        (unsigned long)status_field(phone.lastStatus, FAKE_BT_STATUS_CHANGED));
+  CHECK(phone.confirmations == phone.indications, "%lu of %lu indications confirmed",
+        (unsigned long)phone.confirmations, (unsigned long)phone.indications);
+  CHECK(lost_toggles() == 0u, "%lu toggles lost", (unsigned long)lost_toggles());
+}
+
+// Retransmissions and older sequence numbers do not toggle again.
+static void check_duplicates(void)
+{
+  FakeConnectStats connect;
+  const switch_entry_t *entry;
+  uint32_t index;
+
+  start_light(&lightSimDefaultCosts);
+  index = send_toggle(lightSimNowNs(), 0u);
+  send_copy(lightSimNowNs() + LIGHT_SIM_MS(5), index);
+  send_frame(lightSimNowNs() + LIGHT_SIM_MS(10), 0u, (uint8_t)(switch_sequences[0] - 1u),
+             index | TAG_COPY);
+  lightSimRunUntil(lightSimNowNs() + LIGHT_SIM_MS(100));
+
+  fakeConnectGetStats(&connect);
+  entry = find_switch(0u);
+  CHECK(entry != NULL, "switch unknown");
+  CHECK(entry->accepted_count == 1u, "%lu frames accepted", (unsigned long)entry->accepted_count);
+  CHECK(entry->duplicate_count == 2u, "%lu duplicates", (unsigned long)entry->duplicate_count);
+  CHECK(frames.rejected == 2u, "%lu frames rejected", (unsigned long)frames.rejected);
+  CHECK(connect.ledOn, "LED off");
+}
+
+// Toggles faster than a slow phone takes indications are reported together,
+// and the last report has them all.
+static void check_coalescing(void)
+{
+  FakeConnectStats connect;
+  FakeBtPhoneStats phone;
+  FakeBtPhoneConfig config;
+  uint8_t connection;
+
+  start_light(&lightSimDefaultCosts);
+  memcpy(config.address, phone_addresses[0], sizeof(config.address));
+  config.intervalUs = 100000u;
+  config.statusConfig = sl_bt_gatt_indication;
+  config.stateConfig = 0u;
+  config.txBuffers = 4u;
+  connection = fakeBtConnect(&config);
+  phones[connection].connected = true;
+  lightSimRunUntil(SUBSCRIBED_NS);
+  for (uint32_t i = 0u; i < 20u; i++) {
+    send_toggle(lightSimNowNs() + LIGHT_SIM_MS(i), (uint8_t)(i % SWITCH_COUNT));
+  }
+  lightSimRunUntil(lightSimNowNs() + LIGHT_SIM_MS(1000));
+
+  fakeConnectGetStats(&connect);
+  fakeBtGetPhoneStats(connection, &phone);
+  CHECK(frames.accepted == 20u, "%lu toggles accepted", (unsigned long)frames.accepted);
+  CHECK(phone.statusReceived < 20u, "%lu light status for 20 toggles",
+        (unsigned long)phone.statusReceived);
+  CHECK(lost_toggles() == 0u, "%lu toggles lost", (unsigned long)lost_toggles());
+  CHECK(phone.sequenceErrors == 0u, "%lu sequence errors", (unsigned long)phone.sequenceErrors);
+  CHECK(phone.protocolErrors == 0u, "%lu indications not waiting for their confirmation",
+        (unsigned long)phone.protocolErrors);
+  CHECK(status_field(phone.lastStatus, FAKE_BT_STATUS_LAMPS) == sl_get_lamp_states(),
+        "last lamps 0x%08lX", (unsigned long)status_field(phone.lastStatus, FAKE_BT_STATUS_LAMPS));
+  CHECK(!connect.ledOn, "LED on after an even number of toggles");
+}
+
+// While the light settings are written to flash, the frames pile up in the
+// callback queue, whose overflow policy drops some. The switch command queue
+// behind it never overflows, and what is accepted is reported.
+static void check_flash_busy(void)
+{
+  LightSimCosts costs = lightSimDefaultCosts;
+  FakeConnectStats connect;
+  LightSimStats sim;
+  uint32_t writes;
+
+  costs.nvm3WriteNs = 50000000u;
+  start_light(&costs);
+  connect_phone(0u, sl_bt_gatt_indication);
+  lightSimRunUntil(SUBSCRIBED_NS);
+  fakeConnectGetStats(&connect);
+  writes = connect.nvm3Writes;
+  run_toggles(LIGHT_SIM_MS(9500), LIGHT_SIM_MS(10500), 1000u);
+  lightSimRunUntil(LIGHT_SIM_MS(10500) + DRAIN_NS);
+
+  fakeConnectGetStats(&connect);
+  lightSimGetStats(&sim);
+  CHECK(connect.nvm3Writes == writes + 1u, "%lu settings writes",
+        (unsigned long)(connect.nvm3Writes - writes));
+  CHECK(frames.dropped > 0u, "no frame dropped while writing");
+  CHECK(sim.callbacksDropped == frames.dropped, "%lu drops counted, %lu seen",
+        (unsigned long)sim.callbacksDropped, (unsigned long)frames.dropped);
+  CHECK(frames.accepted + frames.dropped + frames.rejected == frames.injected,
+        "%lu accepted, %lu dropped, %lu rejected of %lu", (unsigned long)frames.accepted,
+        (unsigned long)frames.dropped, (unsigned long)frames.rejected,
+        (unsigned long)frames.injected);
+  CHECK(frames.overflowed == 0u, "%lu switch commands overflowed",
+        (unsigned long)frames.overflowed);
+  CHECK(lost_toggles() == 0u, "%lu toggles lost", (unsigned long)lost_toggles());
+}
+
+// A phone toggling the light is reported to the other phones as the source.
+static void check_phone_write(void)
+{
+  FakeConnectStats connect;
+  FakeBtPhoneStats writer;
+  FakeBtPhoneStats other;
+  uint8_t writing;
+  uint8_t watching;
+
+  start_light(&lightSimDefaultCosts);
+  writing = connect_phone(0u, sl_bt_gatt_indication);
+  watching = connect_phone(1u, sl_bt_gatt_notification);
+  lightSimRunUntil(SUBSCRIBED_NS);
+  CHECK(fakeBtWrite(writing, lightSimNowNs()), "write refused");
+  lightSimRunUntil(lightSimNowNs() + LIGHT_SIM_MS(200));
+
+  fakeConnectGetStats(&connect);
+  fakeBtGetPhoneStats(writing, &writer);
+  fakeBtGetPhoneStats(watching, &other);
+  CHECK(writer.writeResponses == 1u, "%lu write responses", (unsigned long)writer.writeResponses);
+  CHECK(connect.ledOn, "LED off");
+  CHECK(other.statusReceived > 0u, "no light status");
+  CHECK(other.lastStatus[FAKE_BT_STATUS_SOURCE] == 0u, "source %u",
+        other.lastStatus[FAKE_BT_STATUS_SOURCE]);
+  CHECK(memcmp(&other.lastStatus[FAKE_BT_STATUS_ADDRESS], phone_addresses[0], 6u) == 0,
+        "writer address");
+  CHECK(lost_toggles() == 0u, "%lu toggles lost", (unsigned long)lost_toggles());
+}
+
+// Steady toggles write the light settings at most once per persist interval,
+// and the last change is written once they stop. Writes that would not change
+// the settings are skipped.
+static void check_persist_rate(void)
+{
+  FakeConnectStats connect;
+  uint32_t writes;
+  light_settings_t stored;
+
+  start_light(&lightSimDefaultCosts);
+  fakeConnectGetStats(&connect);
+  writes = connect.nvm3Writes;
+  run_toggles(NETWORK_UP_NS, LIGHT_SIM_MS(25000), 100u);
+  fakeConnectGetStats(&connect);
+  CHECK(connect.nvm3Writes - writes >= 1u, "no settings write in 25 s");
+  CHECK(connect.nvm3Writes - writes <= 25000u / SL_LIGHT_SWITCH_PERSIST_INTERVAL_MS + 1u,
+        "%lu settings writes in 25 s", (unsigned long)(connect.nvm3Writes - writes));
+
+  // Make sure the lamps differ from the settings in flash.
+  CHECK(fakeConnectReadNvm3(SL_LIGHT_SWITCH_NVM3_KEY, &stored, sizeof(stored)),
+        "no light settings");
+  if (stored.lamp_states == sl_get_lamp_states()) {
+    send_toggle(lightSimNowNs(), 0u);
+  }
+  writes = connect.nvm3Writes;
+  lightSimRunUntil(LIGHT_SIM_MS(25000 + SL_LIGHT_SWITCH_PERSIST_INTERVAL_MS) + DRAIN_NS);
+  fakeConnectGetStats(&connect);
+  CHECK(connect.nvm3Writes == writes + 1u, "%lu settings writes after the toggles",
+        (unsigned long)(connect.nvm3Writes - writes));
+  CHECK(fakeConnectReadNvm3(SL_LIGHT_SWITCH_NVM3_KEY, &stored, sizeof(stored)),
+        "no light settings");
+  CHECK(stored.lamp_states == sl_get_lamp_states(), "lamps 0x%08lX stored, 0x%08lX on",
+        (unsigned long)stored.lamp_states, (unsigned long)sl_get_lamp_states());
+}
+
+// Several phones and a flood of toggles, with the digest of what the phones
+// got as the result.
+static void run_stressed(void)
+{
+  FakeBtStats bluetooth;
+
+  start_light(&lightSimDefaultCosts);
+  for (uint8_t i = 0u; i < MAX_PHONES; i++) {
+    connect_phone(i, (i & 1u) ? sl_bt_gatt_notification : sl_bt_gatt_indication);
+  }
+  lightSimRunUntil(SUBSCRIBED_NS);
+  run_toggles(SUBSCRIBED_NS, SUBSCRIBED_NS + LIGHT_SIM_MS(300), 20000u);
+  for (uint8_t i = 1u; i <= MAX_PHONES; i++) {
+    fakeBtWrite(i, lightSimNowNs());
+  }
+  lightSimRunUntil(lightSimNowNs() + DRAIN_NS);
+  fakeBtGetStats(&bluetooth);
+  CHECK(lost_toggles() == 0u, "%lu toggles lost", (unsigned long)lost_toggles());
+  isolated_result = bluetooth.digest;
+}
+
+// The same run gives the same phones the same values at the same times.
+static void check_determinism(void)
+{
+  uint64_t first;
+  uint64_t second;
+
+  CHECK(run_isolated(run_stressed, &first), "first run failed");
+  CHECK(run_isolated(run_stressed, &second), "second run failed");
+  CHECK(first != 0u, "nothing received");
+  CHECK(first == second, "digests 0x%016llX and 0x%016llX differ",
+        (unsigned long long)first, (unsigned long long)second);
+}
+
+static const check_t checks[] = {
+  { "network", check_network },
+  { "switch toggle", check_switch_toggle },
+  { "duplicates", check_duplicates },
+  { "coalescing", check_coalescing },
+  { "flash busy", check_flash_busy },
+  { "phone write", check_phone_write },
+  { "persist rate", check_persist_rate },
+  { "determinism", check_determinism },
+};
+
+static int run_checks(void)
+{
+  uint32_t i;
+
+  for (i = 0u; i < sizeof(checks) / sizeof(checks[0]); i++) {
+    bool passed = run_isolated(checks[i].run, NULL);
+
+    if (!passed) {
+      failure_count++;
+    }
+    printf("%s: %s\n", checks[i].name, passed ? "ok" : "FAILED");
+  }
+  return (failure_count == 0u) ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+//                                  Benchmark
+// -----------------------------------------------------------------------------
+static const scenario_t scenarios[] = {
+  { "ind1", 1000u, 1u, sl_bt_gatt_indication, false },
+  { "ind1", 5000u, 1u, sl_bt_gatt_indication, false },
+  { "ind1", 20000u, 1u, sl_bt_gatt_indication, false },
+  { "ind4", 1000u, 4u, sl_bt_gatt_indication, false },
+  { "ind4", 5000u, 4u, sl_bt_gatt_indication, false },
+  { "ind4", 20000u, 4u, sl_bt_gatt_indication, false },
+  { "ntf4", 1000u, 4u, sl_bt_gatt_notification, false },
+  { "ntf4", 5000u, 4u, sl_bt_gatt_notification, false },
+  { "ntf4", 20000u, 4u, sl_bt_gatt_notification, false },
+  { "write4", 5000u, 4u, sl_bt_gatt_indication, true },
+};
+static const scenario_t *scenario;
+
+// Toggles from the switches, and writes from the phones if the scenario has
+// them, then the time for the light to report all of them.
+static void bench_scenario(void)
+{
+  uint64_t endNs = SUBSCRIBED_NS + BENCH_DURATION_NS;
+  uint32_t sendFailures = 0u;
+  uint32_t updates = 0u;
+  uint64_t start;
+  uint64_t elapsed;
+
+  samples = malloc(MAX_SAMPLES * sizeof(uint64_t));
+  start_light(&lightSimDefaultCosts);
+  for (uint8_t i = 0u; i < scenario->phones; i++) {
+    connect_phone(i, scenario->config);
+  }
+  lightSimRunUntil(SUBSCRIBED_NS);
+
+  start = benchNowNs();
+  for (uint64_t chunk = SUBSCRIBED_NS; chunk < endNs; chunk += BENCH_CHUNK_NS) {
+    send_toggles(chunk, chunk + BENCH_CHUNK_NS, scenario->framesPerSecond);
+    if (scenario->writes && (((chunk - SUBSCRIBED_NS) % BENCH_WRITE_INTERVAL_NS) == 0u)) {
+      for (uint8_t i = 1u; i <= scenario->phones; i++) {
+        fakeBtWrite(i, chunk + next_random() % BENCH_CHUNK_NS);
+      }
+    }
+    lightSimRunUntil(chunk + BENCH_CHUNK_NS);
+  }
+  lightSimRunUntil(endNs + DRAIN_NS);
+  elapsed = benchNowNs() - start;
+
+  for (uint8_t i = 1u; i <= scenario->phones; i++) {
+    FakeBtPhoneStats phone;
+
+    fakeBtGetPhoneStats(i, &phone);
+    sendFailures += phone.sendFailures;
+    updates += phone.statusReceived;
+  }
+  benchPrintLatency(scenario->name, scenario->framesPerSecond, samples, sample_count);
+  printf("%-8s %7lu        %5.1f%% dropped  %5.1f toggles/update  %lu send failures"
+         "  %lu lost  %6.0f host ns/frame\n",
+         "", (unsigned long)scenario->framesPerSecond,
+         100.0 * (frames.injected - frames.copies - frames.accepted) / (frames.injected - frames.copies),
+         (updates > 0u) ? (double)sample_count / updates : 0.0,
+         (unsigned long)sendFailures, (unsigned long)lost_toggles(),
+         (double)elapsed / frames.injected);
+  free(samples);
+}
+
+static int run_benchmark(void)
+{
+  uint32_t i;
+
+  printf("phones     fps, toggle to light status on the phones, %u%% of the frames sent twice\n",
+         BENCH_COPY_PERCENT);
+  for (i = 0u; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+    scenario = &scenarios[i];
+    if (!run_isolated(bench_scenario, NULL)) {
+      printf("%-8s %7lu        failed\n", scenario->name,
+             (unsigned long)scenario->framesPerSecond);
+      failure_count++;
+    }
+  }
+  return (failure_count == 0u) ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+//                                     Main
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  setvbuf(stdout, NULL, _IONBF, 0);
+  printf("Light DMP, %u switches, up to %u phones, simulated time\n",
+         SWITCH_COUNT, MAX_PHONES);
+
+  if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+    return run_benchmark();
+  }
+  return run_checks();
+}
@@ -0,0 +1,307 @@
+/***************************************************************************//**
+ * @file
+ * @brief Simulated CPU and application framework task of the light DMP
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <string.h>
+
+#include PLATFORM_HEADER
+#include "stack/include/ember.h"
+#include "app_framework_common.h"
+#include "app_framework_callback.h"
+#include "cmsis-rtos-ipc-config.h"
+#include "cmsis-rtos-support.h"
+#include "light_sim.h"
+#include "fake_connect.h"
+#include "fake_bluetooth.h"
+
+// The application framework task follows the loop of cmsis-rtos-af-task.c:
+// run the due events, then dispatch at most one stack callback, and yield
+// until the next event when there is no callback. The callback queue between
+// the Connect stack task and this task stands in for the IPC layer, with its
+// configured size and overflow policy.
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define QUEUE_SIZE                   EMBER_AF_PLUGIN_CMSIS_RTOS_MAX_CALLBACK_QUEUE_SIZE
+#define OVERFLOW_POLICY              EMBER_AF_PLUGIN_CMSIS_RTOS_CALLBACK_OVERFLOW_POLICY
+#define YIELD_TIMEOUT_MS             EMBER_AF_PLUGIN_CMSIS_RTOS_APP_FRAMEWORK_YIELD_TIMEOUT_MS
+#define MAX_PAYLOAD_LENGTH           127u
+
+typedef struct {
+  // Incoming message, else stack status.
+  bool incoming;
+  EmberStatus status;
+  EmberNodeId source;
+  uint8_t endpoint;
+  int8_t rssi;
+  uint32_t timestampMs;
+  uint8_t length;
+  uint8_t payload[MAX_PAYLOAD_LENGTH];
+  uint32_t tag;
+} queued_callback_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static uint64_t now_ns;
+static LightSimCosts costs;
+static LightSimStats stats;
+// Oldest callback first.
+static queued_callback_t callbacks[QUEUE_SIZE];
+static uint8_t callback_count;
+// The events are all allocated at run time.
+static const EmberEventData no_events[] = { { NULL, NULL } };
+
+// -----------------------------------------------------------------------------
+//                                Global Variables
+// -----------------------------------------------------------------------------
+const LightSimCosts lightSimDefaultCosts = {
+  .stackRxNs = 30000u,
+  .afPassNs = 5000u,
+  .dispatchNs = 20000u,
+  .btEventNs = 15000u,
+  .gattSendNs = 25000u,
+  .nvm3WriteNs = 2000000u,
+};
+
+extern void app_init(void);
+
+// -----------------------------------------------------------------------------
+//                          Static Function Definitions
+// -----------------------------------------------------------------------------
+static void drop_callback(uint8_t index)
+{
+  uint32_t tag = callbacks[index].tag;
+
+  memmove(&callbacks[index], &callbacks[index + 1],
+          (callback_count - index - 1u) * sizeof(callbacks[0]));
+  callback_count--;
+  stats.callbacksDropped++;
+  lightDmpOnFrameDropped(tag);
+}
+
+// Returns QUEUE_SIZE if no incoming message is queued.
+static uint8_t find_incoming(bool latest)
+{
+  uint8_t found = QUEUE_SIZE;
+
+  for (uint8_t i = 0u; i < callback_count; i++) {
+    if (callbacks[i].incoming) {
+      found = i;
+      if (!latest) {
+        break;
+      }
+    }
+  }
+  return found;
+}
+
+static void append_callback(const queued_callback_t *callback)
+{
+  callbacks[callback_count++] = *callback;
+  stats.callbacksPosted++;
+  if (callback_count > stats.maxQueueDepth) {
+    stats.maxQueueDepth = callback_count;
+  }
+}
+
+static void dispatch_callback(void)
+{
+  queued_callback_t callback = callbacks[0];
+  EmberIncomingMessage message;
+
+  memmove(&callbacks[0], &callbacks[1], (callback_count - 1u) * sizeof(callbacks[0]));
+  callback_count--;
+  stats.callbacksDispatched++;
+  lightSimCharge(costs.dispatchNs);
+
+  if (!callback.incoming) {
+    emberAfStackStatusCallback(callback.status);
+    return;
+  }
+  memset(&message, 0, sizeof(message));
+  message.source = callback.source;
+  message.endpoint = callback.endpoint;
+  message.rssi = callback.rssi;
+  message.length = callback.length;
+  message.payload = callback.payload;
+  message.timestamp = callback.timestampMs;
+  emberAfIncomingMessageCallback(&message);
+  lightDmpOnFrameDispatched(callback.tag);
+}
+
+static uint64_t next_event_ns(void)
+{
+  uint32_t idle_ms = emAfMsToNextEvent(YIELD_TIMEOUT_MS);
+
+  return ((now_ns / 1000000u) + idle_ms) * 1000000u;
+}
+
+static void run_app_framework_pass(void)
+{
+  stats.afPasses++;
+  lightSimCharge(costs.afPassNs);
+  emAfRunEvents();
+  // The Connect stack task gets the CPU first whenever it has frames.
+  fakeConnectRunDue();
+  if (callback_count > 0u) {
+    dispatch_callback();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//                          Public Function Definitions
+// -----------------------------------------------------------------------------
+void lightSimInit(const LightSimCosts *init_costs)
+{
+  now_ns = 0u;
+  costs = *init_costs;
+  memset(&stats, 0, sizeof(stats));
+  callback_count = 0u;
+
+  emAfEventSchedulerInit(no_events, 0u);
+  emberAfInitCallback();
+  app_init();
+}
+
+uint64_t lightSimNowNs(void)
+{
+  return now_ns;
+}
+
+const LightSimCosts *lightSimGetCosts(void)
+{
+  return &costs;
+}
+
+void lightSimCharge(uint32_t ns)
+{
+  now_ns += ns;
+}
+
+void lightSimRunUntil(uint64_t endNs)
+{
+  while (now_ns < endNs) {
+    uint64_t next;
+
+    fakeConnectRunDue();
+    fakeBtRunDue();
+    if ((callback_count > 0u) || (next_event_ns() <= now_ns)) {
+      run_app_framework_pass();
+      continue;
+    }
+    next = next_event_ns();
+    if (fakeConnectNextNs() < next) {
+      next = fakeConnectNextNs();
+    }
+    if (fakeBtNextNs() < next) {
+      next = fakeBtNextNs();
+    }
+    now_ns = (next < endNs) ? next : endNs;
+  }
+}
+
+void lightSimPostIncomingMessage(uint16_t source,
+                                 uint8_t endpoint,
+                                 int8_t rssi,
+                                 uint32_t timestampMs,
+                                 const uint8_t *payload,
+                                 uint8_t length,
+                                 uint32_t tag)
+{
+  queued_callback_t callback;
+  uint8_t replaced;
+
+  memset(&callback, 0, sizeof(callback));
+  callback.incoming = true;
+  callback.source = source;
+  callback.endpoint = endpoint;
+  callback.rssi = rssi;
+  callback.timestampMs = timestampMs;
+  callback.length = (length < MAX_PAYLOAD_LENGTH) ? length : MAX_PAYLOAD_LENGTH;
+  memcpy(callback.payload, payload, callback.length);
+  callback.tag = tag;
+
+  if (callback_count == QUEUE_SIZE) {
+#if (OVERFLOW_POLICY == CMSIS_RTOS_CALLBACK_DROP_OLDEST)
+    replaced = find_incoming(false);
+#elif (OVERFLOW_POLICY == CMSIS_RTOS_CALLBACK_COALESCE)
+    replaced = find_incoming(true);
+#else
+    replaced = QUEUE_SIZE;
+#endif
+    if (replaced == QUEUE_SIZE) {
+      stats.callbacksDropped++;
+      lightDmpOnFrameDropped(tag);
+      return;
+    }
+#if (OVERFLOW_POLICY == CMSIS_RTOS_CALLBACK_COALESCE)
+    // The new callback takes the place of the one it replaces.
+    stats.callbacksDropped++;
+    stats.callbacksPosted++;
+    lightDmpOnFrameDropped(callbacks[replaced].tag);
+    callbacks[replaced] = callback;
+    return;
+#else
+    drop_callback(replaced);
+#endif
+  }
+  append_callback(&callback);
+}
+
+void lightSimPostStackStatus(uint8_t status)
+{
+  queued_callback_t callback;
+  uint8_t oldest;
+
+  memset(&callback, 0, sizeof(callback));
+  callback.status = status;
+  if (callback_count == QUEUE_SIZE) {
+    oldest = find_incoming(false);
+    if (oldest == QUEUE_SIZE) {
+      return;
+    }
+    drop_callback(oldest);
+  }
+  append_callback(&callback);
+}
+
+void lightSimGetStats(LightSimStats *out)
+{
+  *out = stats;
+}
+
+// The task loop checks for work on every pass, there is nothing to wake up.
+void emAfPluginCmsisRtosWakeUpAppFrameworkTask(void)
+{
+}
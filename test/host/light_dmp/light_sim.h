@@ -0,0 +1,166 @@
+/***************************************************************************//**
+ * @file
+ * @brief Simulated CPU and application framework task of the light DMP
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef LIGHT_SIM_H
+#define LIGHT_SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// The light runs on one simulated CPU, in simulated time. Time moves when the
+// running code is charged the modeled cost of what it does, or when the CPU
+// idles until the next radio event. Tasks run to completion and do not
+// preempt each other: whenever the CPU is free, the Connect stack task runs
+// first, then the Bluetooth stack, then one pass of the application framework
+// task loop.
+
+#define LIGHT_SIM_NEVER                  UINT64_MAX
+#define LIGHT_SIM_MS(ms)                 ((uint64_t)(ms) * 1000000u)
+
+// Modeled CPU time, in nanoseconds.
+typedef struct {
+  // Connect stack task, per received frame, callback posting included.
+  uint32_t stackRxNs;
+  // Application framework task, per pass of its loop.
+  uint32_t afPassNs;
+  // Application framework task, per stack callback dispatched.
+  uint32_t dispatchNs;
+  // Bluetooth stack, per event handed to the application.
+  uint32_t btEventNs;
+  // Per GATT notification or indication call.
+  uint32_t gattSendNs;
+  // Per NVM3 object write.
+  uint32_t nvm3WriteNs;
+} LightSimCosts;
+
+typedef struct {
+  uint32_t afPasses;
+  uint32_t callbacksPosted;
+  uint32_t callbacksDispatched;
+  // Incoming message callbacks the callback queue overflow policy dropped.
+  uint32_t callbacksDropped;
+  uint8_t maxQueueDepth;
+} LightSimStats;
+
+extern const LightSimCosts lightSimDefaultCosts;
+
+/**************************************************************************//**
+ * Boots the light at time 0: registers the events, runs the application
+ * framework init callback and the application init.
+ *
+ * @param costs Cost model of the run.
+ *****************************************************************************/
+void lightSimInit(const LightSimCosts *costs);
+
+/**************************************************************************//**
+ * Current simulated time, in nanoseconds since the boot.
+ *****************************************************************************/
+uint64_t lightSimNowNs(void);
+
+/**************************************************************************//**
+ * Cost model of the run.
+ *****************************************************************************/
+const LightSimCosts *lightSimGetCosts(void);
+
+/**************************************************************************//**
+ * Takes the CPU for the running code, moving the time forward.
+ *****************************************************************************/
+void lightSimCharge(uint32_t ns);
+
+/**************************************************************************//**
+ * Runs the tasks until the given time, or later if a task runs past it.
+ *****************************************************************************/
+void lightSimRunUntil(uint64_t endNs);
+
+/**************************************************************************//**
+ * Posts an incoming message callback from the Connect stack task, applying
+ * the configured overflow policy when the callback queue is full.
+ *
+ * @param tag Identifies the frame to the lightDmpOnFrame hooks.
+ *****************************************************************************/
+void lightSimPostIncomingMessage(uint16_t source,
+                                 uint8_t endpoint,
+                                 int8_t rssi,
+                                 uint32_t timestampMs,
+                                 const uint8_t *payload,
+                                 uint8_t length,
+                                 uint32_t tag);
+
+/**************************************************************************//**
+ * Posts a stack status callback from the Connect stack task. It takes the
+ * slot of the oldest incoming message when the callback queue is full.
+ *****************************************************************************/
+void lightSimPostStackStatus(uint8_t status);
+
+void lightSimGetStats(LightSimStats *stats);
+
+// Hooks of the harness, called by the simulation.
+
+/**************************************************************************//**
+ * The incoming message callback of a frame returned.
+ *****************************************************************************/
+void lightDmpOnFrameDispatched(uint32_t tag);
+
+/**************************************************************************//**
+ * The callback queue dropped the incoming message callback of a frame.
+ *****************************************************************************/
+void lightDmpOnFrameDropped(uint32_t tag);
+
+/**************************************************************************//**
+ * The Bluetooth stack accepted a notification or an indication.
+ *****************************************************************************/
+void lightDmpOnGattSent(uint8_t connection, uint16_t characteristic);
+
+/**************************************************************************//**
+ * A phone received a notification or an indication.
+ *
+ * @param atNs Time of the connection event that carried it.
+ *****************************************************************************/
+void lightDmpOnPhoneReceived(uint8_t connection,
+                             uint16_t characteristic,
+                             const uint8_t *value,
+                             size_t length,
+                             uint64_t atNs);
+
+/**************************************************************************//**
+ * A light state write of a phone is handed to the application.
+ *
+ * @param atNs Time of the connection event that carried the write.
+ *****************************************************************************/
+void lightDmpOnPhoneWrite(uint8_t connection, uint64_t atNs);
+
+/**************************************************************************//**
+ * The application set the LED after changing the lamps, right before it
+ * reports the change to the phones.
+ *****************************************************************************/
+void lightDmpOnLampsApplied(void);
+
+#endif // LIGHT_SIM_H
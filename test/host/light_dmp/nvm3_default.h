@@ -0,0 +1,52 @@
+/***************************************************************************//**
+ * @file
+ * @brief NVM3 subset for the light simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef NVM3_DEFAULT_H
+#define NVM3_DEFAULT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The default NVM3 instance, kept in memory by the simulator.
+
+typedef uint32_t Ecode_t;
+typedef uint32_t nvm3_ObjectKey_t;
+typedef struct nvm3_Handle nvm3_Handle_t;
+
+#define ECODE_NVM3_OK                    0x00000000U
+#define ECODE_NVM3_ERR_KEY_NOT_FOUND     0xE1000010U
+#define ECODE_NVM3_ERR_READ_DATA_SIZE    0xE1000011U
+#define ECODE_NVM3_ERR_WRITE_FAILED      0xE1000016U
+
+extern nvm3_Handle_t *nvm3_defaultHandle;
+
+Ecode_t nvm3_readData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, void *value, size_t len);
+Ecode_t nvm3_writeData(nvm3_Handle_t *h, nvm3_ObjectKey_t key, const void *value, size_t len);
+
+#endif // NVM3_DEFAULT_H
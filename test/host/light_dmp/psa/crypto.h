@@ -0,0 +1,106 @@
+/***************************************************************************//**
+ * @file
+ * @brief PSA Crypto subset for the light simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef PSA_CRYPTO_H
+#define PSA_CRYPTO_H
+
+// The PSA Crypto calls the application makes to import its security key. The
+// simulator keeps one volatile key.
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int32_t psa_status_t;
+typedef uint32_t psa_key_id_t;
+typedef psa_key_id_t mbedtls_svc_key_id_t;
+typedef uint16_t psa_key_type_t;
+typedef uint32_t psa_key_usage_t;
+typedef uint32_t psa_algorithm_t;
+typedef uint32_t psa_key_lifetime_t;
+
+typedef struct {
+  psa_key_type_t type;
+  size_t bits;
+  psa_key_usage_t usage;
+  psa_algorithm_t alg;
+  psa_key_lifetime_t lifetime;
+} psa_key_attributes_t;
+
+#define PSA_SUCCESS                      ((psa_status_t)0)
+#define PSA_ERROR_INVALID_ARGUMENT       ((psa_status_t)-135)
+#define PSA_ERROR_INVALID_HANDLE         ((psa_status_t)-136)
+
+#define PSA_KEY_TYPE_AES                 ((psa_key_type_t)0x2400)
+#define PSA_KEY_USAGE_ENCRYPT            ((psa_key_usage_t)0x00000100)
+#define PSA_KEY_USAGE_DECRYPT            ((psa_key_usage_t)0x00000200)
+#define PSA_ALG_ECB_NO_PADDING           ((psa_algorithm_t)0x04404400)
+#define PSA_KEY_LIFETIME_VOLATILE        ((psa_key_lifetime_t)0x00000000)
+#define PSA_KEY_LOCATION_LOCAL_STORAGE   ((psa_key_lifetime_t)0x000000)
+#define PSA_KEY_LIFETIME_FROM_PERSISTENCE_AND_LOCATION(persistence, location) \
+  ((location) << 8 | (persistence))
+
+static inline psa_key_attributes_t psa_key_attributes_init(void)
+{
+  const psa_key_attributes_t attributes = { 0 };
+  return attributes;
+}
+
+static inline void psa_set_key_type(psa_key_attributes_t *attributes, psa_key_type_t type)
+{
+  attributes->type = type;
+}
+
+static inline void psa_set_key_bits(psa_key_attributes_t *attributes, size_t bits)
+{
+  attributes->bits = bits;
+}
+
+static inline void psa_set_key_usage_flags(psa_key_attributes_t *attributes, psa_key_usage_t usage)
+{
+  attributes->usage = usage;
+}
+
+static inline void psa_set_key_algorithm(psa_key_attributes_t *attributes, psa_algorithm_t alg)
+{
+  attributes->alg = alg;
+}
+
+static inline void psa_set_key_lifetime(psa_key_attributes_t *attributes, psa_key_lifetime_t lifetime)
+{
+  attributes->lifetime = lifetime;
+}
+
+psa_status_t psa_crypto_init(void);
+psa_status_t psa_import_key(const psa_key_attributes_t *attributes,
+                            const uint8_t *data,
+                            size_t data_length,
+                            psa_key_id_t *key);
+psa_status_t psa_destroy_key(psa_key_id_t key);
+
+#endif // PSA_CRYPTO_H
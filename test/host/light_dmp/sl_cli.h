@@ -0,0 +1,52 @@
+/***************************************************************************//**
+ * @file
+ * @brief CLI subset for the light simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef SL_CLI_H
+#define SL_CLI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The simulator calls the command handlers of the application directly, with
+// the arguments already parsed.
+
+typedef struct {
+  int argc;
+  void **argv;
+} sl_cli_command_arg_t;
+
+#define sl_cli_get_argument_uint8(a, n)  (*(uint8_t *)((a)->argv[(n)]))
+#define sl_cli_get_argument_uint16(a, n) (*(uint16_t *)((a)->argv[(n)]))
+#define sl_cli_get_argument_uint32(a, n) (*(uint32_t *)((a)->argv[(n)]))
+#define sl_cli_get_argument_string(a, n) ((char *)((a)->argv[(n)]))
+
+// The first byte of a hex argument is its length.
+uint8_t *sl_cli_get_argument_hex(sl_cli_command_arg_t *a, int n, size_t *l);
+
+#endif // SL_CLI_H
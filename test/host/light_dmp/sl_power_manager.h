@@ -0,0 +1,41 @@
+/***************************************************************************//**
+ * @file
+ * @brief Power manager types for the light simulator
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+#ifndef SL_POWER_MANAGER_H
+#define SL_POWER_MANAGER_H
+
+// The type sl_bluetooth.h declares its sleep hooks with. There is no power
+// manager on the host.
+typedef enum {
+  SL_POWER_MANAGER_IGNORE = (1UL << 0UL),
+  SL_POWER_MANAGER_SLEEP  = (1UL << 1UL),
+  SL_POWER_MANAGER_WAKEUP = (1UL << 2UL),
+} sl_power_manager_on_isr_exit_t;
+
+#endif // SL_POWER_MANAGER_H
@@ -0,0 +1,531 @@
+/***************************************************************************//**
+ * @file
+ * @brief CMSIS-RTOS2 subset on top of POSIX threads
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// Every thread created with osThreadNew() is a POSIX thread. Priorities are
+// not modeled, all the threads run concurrently on the host cores. Threads
+// created before osKernelStart() only start running once it is called, like
+// on target, but osKernelStart() returns so that the caller can keep driving
+// the build. Ticks are milliseconds. Interrupt contexts are not modeled.
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "cmsis_os2.h"
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define HOST_TICK_FREQ_HZ 1000u
+
+typedef struct {
+  osThreadFunc_t func;
+  void *argument;
+  pthread_t thread;
+} host_thread_t;
+
+typedef struct {
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+  uint32_t flags;
+} host_event_flags_t;
+
+typedef struct {
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+  uint32_t count;
+  uint32_t max_count;
+} host_semaphore_t;
+
+typedef struct {
+  pthread_mutex_t lock;
+} host_mutex_t;
+
+typedef struct {
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+  uint32_t msg_count;
+  uint32_t msg_size;
+  uint32_t head;
+  uint32_t count;
+  uint8_t *messages;
+} host_message_queue_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static pthread_mutex_t kernel_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t kernel_started_cond = PTHREAD_COND_INITIALIZER;
+static bool kernel_started;
+
+// The thread running, allocated on first use for the threads osThreadNew()
+// did not create.
+static __thread host_thread_t *current_thread;
+
+// -----------------------------------------------------------------------------
+//                                Static Functions
+// -----------------------------------------------------------------------------
+static void init_cond(pthread_cond_t *cond)
+{
+  pthread_condattr_t attr;
+
+  pthread_condattr_init(&attr);
+  pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+  pthread_cond_init(cond, &attr);
+  pthread_condattr_destroy(&attr);
+}
+
+static struct timespec deadline_of(uint32_t timeout)
+{
+  struct timespec deadline;
+
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+  deadline.tv_sec += timeout / HOST_TICK_FREQ_HZ;
+  deadline.tv_nsec += (long)(timeout % HOST_TICK_FREQ_HZ) * (1000000000L / HOST_TICK_FREQ_HZ);
+  if (deadline.tv_nsec >= 1000000000L) {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  return deadline;
+}
+
+// Waits for cond with lock held, returns false once the timeout expired.
+static bool wait_cond(pthread_cond_t *cond, pthread_mutex_t *lock, uint32_t timeout,
+                      const struct timespec *deadline)
+{
+  if (timeout == osWaitForever) {
+    pthread_cond_wait(cond, lock);
+    return true;
+  }
+  return pthread_cond_timedwait(cond, lock, deadline) != ETIMEDOUT;
+}
+
+static void *thread_entry(void *context)
+{
+  host_thread_t *thread = (host_thread_t *)context;
+
+  pthread_mutex_lock(&kernel_lock);
+  while (!kernel_started) {
+    pthread_cond_wait(&kernel_started_cond, &kernel_lock);
+  }
+  pthread_mutex_unlock(&kernel_lock);
+
+  current_thread = thread;
+  thread->func(thread->argument);
+  return NULL;
+}
+
+// -----------------------------------------------------------------------------
+//                                    Kernel
+// -----------------------------------------------------------------------------
+osStatus_t osKernelInitialize(void)
+{
+  return osOK;
+}
+
+osStatus_t osKernelStart(void)
+{
+  pthread_mutex_lock(&kernel_lock);
+  kernel_started = true;
+  pthread_cond_broadcast(&kernel_started_cond);
+  pthread_mutex_unlock(&kernel_lock);
+  return osOK;
+}
+
+uint32_t osKernelGetTickCount(void)
+{
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)((uint64_t)now.tv_sec * HOST_TICK_FREQ_HZ
+                    + (uint64_t)now.tv_nsec / (1000000000L / HOST_TICK_FREQ_HZ));
+}
+
+uint32_t osKernelGetTickFreq(void)
+{
+  return HOST_TICK_FREQ_HZ;
+}
+
+osStatus_t osDelay(uint32_t ticks)
+{
+  struct timespec delay = {
+    .tv_sec = ticks / HOST_TICK_FREQ_HZ,
+    .tv_nsec = (long)(ticks % HOST_TICK_FREQ_HZ) * (1000000000L / HOST_TICK_FREQ_HZ),
+  };
+
+  while (nanosleep(&delay, &delay) != 0) {
+  }
+  return osOK;
+}
+
+// -----------------------------------------------------------------------------
+//                                    Threads
+// -----------------------------------------------------------------------------
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument, const osThreadAttr_t *attr)
+{
+  host_thread_t *thread = calloc(1, sizeof(host_thread_t));
+
+  (void)attr;
+  thread->func = func;
+  thread->argument = argument;
+  if (pthread_create(&thread->thread, NULL, thread_entry, thread) != 0) {
+    free(thread);
+    return NULL;
+  }
+  pthread_detach(thread->thread);
+  return (osThreadId_t)thread;
+}
+
+osThreadId_t osThreadGetId(void)
+{
+  if (current_thread == NULL) {
+    current_thread = calloc(1, sizeof(host_thread_t));
+    current_thread->thread = pthread_self();
+  }
+  return (osThreadId_t)current_thread;
+}
+
+// -----------------------------------------------------------------------------
+//                                  Event Flags
+// -----------------------------------------------------------------------------
+osEventFlagsId_t osEventFlagsNew(const osEventFlagsAttr_t *attr)
+{
+  host_event_flags_t *ef = calloc(1, sizeof(host_event_flags_t));
+
+  (void)attr;
+  pthread_mutex_init(&ef->lock, NULL);
+  init_cond(&ef->changed);
+  return (osEventFlagsId_t)ef;
+}
+
+uint32_t osEventFlagsSet(osEventFlagsId_t ef_id, uint32_t flags)
+{
+  host_event_flags_t *ef = (host_event_flags_t *)ef_id;
+  uint32_t result;
+
+  if (ef == NULL || (flags & osFlagsError) != 0u) {
+    return osFlagsErrorParameter;
+  }
+  pthread_mutex_lock(&ef->lock);
+  ef->flags |= flags;
+  result = ef->flags;
+  pthread_cond_broadcast(&ef->changed);
+  pthread_mutex_unlock(&ef->lock);
+  return result;
+}
+
+uint32_t osEventFlagsClear(osEventFlagsId_t ef_id, uint32_t flags)
+{
+  host_event_flags_t *ef = (host_event_flags_t *)ef_id;
+  uint32_t result;
+
+  if (ef == NULL || (flags & osFlagsError) != 0u) {
+    return osFlagsErrorParameter;
+  }
+  pthread_mutex_lock(&ef->lock);
+  result = ef->flags;
+  ef->flags &= ~flags;
+  pthread_mutex_unlock(&ef->lock);
+  return result;
+}
+
+uint32_t osEventFlagsGet(osEventFlagsId_t ef_id)
+{
+  host_event_flags_t *ef = (host_event_flags_t *)ef_id;
+  uint32_t result;
+
+  pthread_mutex_lock(&ef->lock);
+  result = ef->flags;
+  pthread_mutex_unlock(&ef->lock);
+  return result;
+}
+
+uint32_t osEventFlagsWait(osEventFlagsId_t ef_id, uint32_t flags, uint32_t options, uint32_t timeout)
+{
+  host_event_flags_t *ef = (host_event_flags_t *)ef_id;
+  struct timespec deadline = deadline_of(timeout);
+  uint32_t result;
+
+  if (ef == NULL || (flags & osFlagsError) != 0u) {
+    return osFlagsErrorParameter;
+  }
+  pthread_mutex_lock(&ef->lock);
+  for (;;) {
+    bool satisfied = ((options & osFlagsWaitAll) != 0u)
+                     ? ((ef->flags & flags) == flags)
+                     : ((ef->flags & flags) != 0u);
+
+    if (satisfied) {
+      result = ef->flags;
+      if ((options & osFlagsNoClear) == 0u) {
+        ef->flags &= ~flags;
+      }
+      break;
+    }
+    if (timeout == 0u) {
+      result = osFlagsErrorResource;
+      break;
+    }
+    if (!wait_cond(&ef->changed, &ef->lock, timeout, &deadline)) {
+      result = osFlagsErrorTimeout;
+      break;
+    }
+  }
+  pthread_mutex_unlock(&ef->lock);
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//                                    Mutexes
+// -----------------------------------------------------------------------------
+osMutexId_t osMutexNew(const osMutexAttr_t *attr)
+{
+  host_mutex_t *mutex = calloc(1, sizeof(host_mutex_t));
+  pthread_mutexattr_t mutex_attr;
+
+  pthread_mutexattr_init(&mutex_attr);
+  if (attr != NULL && (attr->attr_bits & osMutexRecursive) != 0u) {
+    pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+  }
+  pthread_mutex_init(&mutex->lock, &mutex_attr);
+  pthread_mutexattr_destroy(&mutex_attr);
+  return (osMutexId_t)mutex;
+}
+
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
+{
+  host_mutex_t *mutex = (host_mutex_t *)mutex_id;
+
+  if (mutex == NULL) {
+    return osErrorParameter;
+  }
+  if (timeout == 0u) {
+    return (pthread_mutex_trylock(&mutex->lock) == 0) ? osOK : osErrorResource;
+  }
+  if (timeout == osWaitForever) {
+    pthread_mutex_lock(&mutex->lock);
+    return osOK;
+  }
+  // Timed acquisitions are rare, polling keeps them portable.
+  uint32_t start = osKernelGetTickCount();
+  while (pthread_mutex_trylock(&mutex->lock) != 0) {
+    if ((uint32_t)(osKernelGetTickCount() - start) >= timeout) {
+      return osErrorTimeout;
+    }
+    osDelay(1u);
+  }
+  return osOK;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id)
+{
+  host_mutex_t *mutex = (host_mutex_t *)mutex_id;
+
+  if (mutex == NULL) {
+    return osErrorParameter;
+  }
+  return (pthread_mutex_unlock(&mutex->lock) == 0) ? osOK : osErrorResource;
+}
+
+// -----------------------------------------------------------------------------
+//                                  Semaphores
+// -----------------------------------------------------------------------------
+osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr)
+{
+  host_semaphore_t *semaphore;
+
+  (void)attr;
+  if (max_count == 0u || initial_count > max_count) {
+    return NULL;
+  }
+  semaphore = calloc(1, sizeof(host_semaphore_t));
+  pthread_mutex_init(&semaphore->lock, NULL);
+  init_cond(&semaphore->changed);
+  semaphore->count = initial_count;
+  semaphore->max_count = max_count;
+  return (osSemaphoreId_t)semaphore;
+}
+
+osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+  host_semaphore_t *semaphore = (host_semaphore_t *)semaphore_id;
+  struct timespec deadline = deadline_of(timeout);
+  osStatus_t status = osOK;
+
+  if (semaphore == NULL) {
+    return osErrorParameter;
+  }
+  pthread_mutex_lock(&semaphore->lock);
+  while (semaphore->count == 0u) {
+    if (timeout == 0u) {
+      status = osErrorResource;
+      break;
+    }
+    if (!wait_cond(&semaphore->changed, &semaphore->lock, timeout, &deadline)) {
+      status = osErrorTimeout;
+      break;
+    }
+  }
+  if (status == osOK) {
+    semaphore->count--;
+  }
+  pthread_mutex_unlock(&semaphore->lock);
+  return status;
+}
+
+osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore_id)
+{
+  host_semaphore_t *semaphore = (host_semaphore_t *)semaphore_id;
+  osStatus_t status = osOK;
+
+  if (semaphore == NULL) {
+    return osErrorParameter;
+  }
+  pthread_mutex_lock(&semaphore->lock);
+  if (semaphore->count < semaphore->max_count) {
+    semaphore->count++;
+    pthread_cond_signal(&semaphore->changed);
+  } else {
+    status = osErrorResource;
+  }
+  pthread_mutex_unlock(&semaphore->lock);
+  return status;
+}
+
+uint32_t osSemaphoreGetCount(osSemaphoreId_t semaphore_id)
+{
+  host_semaphore_t *semaphore = (host_semaphore_t *)semaphore_id;
+  uint32_t count;
+
+  pthread_mutex_lock(&semaphore->lock);
+  count = semaphore->count;
+  pthread_mutex_unlock(&semaphore->lock);
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+//                                Message Queues
+// -----------------------------------------------------------------------------
+// Message priorities are ignored, messages come out in the order they went in.
+osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr)
+{
+  host_message_queue_t *queue;
+
+  (void)attr;
+  if (msg_count == 0u || msg_size == 0u) {
+    return NULL;
+  }
+  queue = calloc(1, sizeof(host_message_queue_t));
+  pthread_mutex_init(&queue->lock, NULL);
+  init_cond(&queue->changed);
+  queue->msg_count = msg_count;
+  queue->msg_size = msg_size;
+  queue->messages = calloc(msg_count, msg_size);
+  return (osMessageQueueId_t)queue;
+}
+
+osStatus_t osMessageQueuePut(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio, uint32_t timeout)
+{
+  host_message_queue_t *queue = (host_message_queue_t *)mq_id;
+  struct timespec deadline = deadline_of(timeout);
+  osStatus_t status = osOK;
+
+  (void)msg_prio;
+  if (queue == NULL || msg_ptr == NULL) {
+    return osErrorParameter;
+  }
+  pthread_mutex_lock(&queue->lock);
+  while (queue->count == queue->msg_count) {
+    if (timeout == 0u) {
+      status = osErrorResource;
+      break;
+    }
+    if (!wait_cond(&queue->changed, &queue->lock, timeout, &deadline)) {
+      status = osErrorTimeout;
+      break;
+    }
+  }
+  if (status == osOK) {
+    uint32_t tail = (queue->head + queue->count) % queue->msg_count;
+
+    memcpy(&queue->messages[tail * queue->msg_size], msg_ptr, queue->msg_size);
+    queue->count++;
+    pthread_cond_broadcast(&queue->changed);
+  }
+  pthread_mutex_unlock(&queue->lock);
+  return status;
+}
+
+osStatus_t osMessageQueueGet(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio, uint32_t timeout)
+{
+  host_message_queue_t *queue = (host_message_queue_t *)mq_id;
+  struct timespec deadline = deadline_of(timeout);
+  osStatus_t status = osOK;
+
+  if (queue == NULL || msg_ptr == NULL) {
+    return osErrorParameter;
+  }
+  pthread_mutex_lock(&queue->lock);
+  while (queue->count == 0u) {
+    if (timeout == 0u) {
+      status = osErrorResource;
+      break;
+    }
+    if (!wait_cond(&queue->changed, &queue->lock, timeout, &deadline)) {
+      status = osErrorTimeout;
+      break;
+    }
+  }
+  if (status == osOK) {
+    memcpy(msg_ptr, &queue->messages[queue->head * queue->msg_size], queue->msg_size);
+    queue->head = (queue->head + 1u) % queue->msg_count;
+    queue->count--;
+    if (msg_prio != NULL) {
+      *msg_prio = 0u;
+    }
+    pthread_cond_broadcast(&queue->changed);
+  }
+  pthread_mutex_unlock(&queue->lock);
+  return status;
+}
+
+uint32_t osMessageQueueGetCount(osMessageQueueId_t mq_id)
+{
+  host_message_queue_t *queue = (host_message_queue_t *)mq_id;
+  uint32_t count;
+
+  pthread_mutex_lock(&queue->lock);
+  count = queue->count;
+  pthread_mutex_unlock(&queue->lock);
+  return count;
+}
@@ -0,0 +1,56 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host stand-in for the core interrupt masking API
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef EM_CORE_GENERIC_H
+#define EM_CORE_GENERIC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Masking interrupts is modeled by a single recursive lock shared by every
+// thread of the host build, see host_core.c.
+
+typedef uint32_t CORE_irqState_t;
+
+void hostCoreEnter(void);
+void hostCoreExit(void);
+bool hostCoreInAtomic(void);
+
+#define CORE_DECLARE_IRQ_STATE        CORE_irqState_t irqState = 0
+#define CORE_ENTER_ATOMIC()           do { (void)irqState; hostCoreEnter(); } while (0)
+#define CORE_EXIT_ATOMIC()            hostCoreExit()
+#define CORE_ENTER_CRITICAL()         CORE_ENTER_ATOMIC()
+#define CORE_EXIT_CRITICAL()          CORE_EXIT_ATOMIC()
+#define CORE_ATOMIC_SECTION(yourcode) { hostCoreEnter(); { yourcode } hostCoreExit(); }
+#define CORE_CRITICAL_SECTION(yourcode) CORE_ATOMIC_SECTION(yourcode)
+#define CORE_InIrqContext()           false
+#define CORE_IrqIsBlocked(irqN)       false
+
+#endif // EM_CORE_GENERIC_H
@@ -0,0 +1,60 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host stand-in for the device header
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef EM_DEVICE_H
+#define EM_DEVICE_H
+
+#include <stdint.h>
+
+// Only the CMSIS intrinsics and attributes the host builds rely on.
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE  static inline
+#endif
+
+#ifndef __WEAK
+#define __WEAK           __attribute__((weak))
+#endif
+
+#ifndef __INLINE
+#define __INLINE         inline
+#endif
+
+__STATIC_INLINE void __DMB(void)
+{
+  __sync_synchronize();
+}
+
+__STATIC_INLINE uint32_t __CLZ(uint32_t value)
+{
+  return (value == 0u) ? 32u : (uint32_t)__builtin_clz(value);
+}
+
+#endif // EM_DEVICE_H
@@ -0,0 +1,64 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host implementation of the core interrupt masking API
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include <pthread.h>
+
+#include "em_core_generic.h"
+
+static pthread_mutex_t coreLock;
+static pthread_once_t coreLockOnce = PTHREAD_ONCE_INIT;
+static __thread uint32_t coreNesting;
+
+static void coreLockInit(void)
+{
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&coreLock, &attr);
+  pthread_mutexattr_destroy(&attr);
+}
+
+void hostCoreEnter(void)
+{
+  pthread_once(&coreLockOnce, coreLockInit);
+  pthread_mutex_lock(&coreLock);
+  coreNesting++;
+}
+
+void hostCoreExit(void)
+{
+  coreNesting--;
+  pthread_mutex_unlock(&coreLock);
+}
+
+bool hostCoreInAtomic(void)
+{
+  return coreNesting != 0u;
+}
@@ -0,0 +1,52 @@
+/***************************************************************************//**
+ * @file
+ * @brief Sleeptimer configuration of the host build
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SLEEPTIMER_CONFIG_H
+#define SLEEPTIMER_CONFIG_H
+
+#define SL_SLEEPTIMER_PERIPHERAL_DEFAULT  0
+#define SL_SLEEPTIMER_PERIPHERAL_SYSRTC   7
+
+#define SL_SLEEPTIMER_PERIPHERAL  SL_SLEEPTIMER_PERIPHERAL_DEFAULT
+
+#define SL_SLEEPTIMER_WALLCLOCK_CONFIG  0
+
+#define SL_SLEEPTIMER_FREQ_DIVIDER  1
+
+// The backend under test is selected on the command line.
+#ifndef SL_SLEEPTIMER_TIMING_WHEEL
+#define SL_SLEEPTIMER_TIMING_WHEEL  0
+#endif
+
+#ifndef SL_SLEEPTIMER_SLACK_TIMER_COUNT
+#define SL_SLEEPTIMER_SLACK_TIMER_COUNT  8
+#endif
+
+#endif /* SLEEPTIMER_CONFIG_H */
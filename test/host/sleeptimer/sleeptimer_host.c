@@ -0,0 +1,731 @@
+/***************************************************************************//**
+ * @file
+ * @brief Host checks and benchmark of the sleeptimer timer backends
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+// -----------------------------------------------------------------------------
+//                                   Includes
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "sl_sleeptimer.h"
+#include "sli_sleeptimer_hal.h"
+#include "bench_util.h"
+
+// The unmodified sl_sleeptimer.c runs on top of the simulated peripheral
+// below. Time only moves forward when the harness advances the counter, and
+// every compare match on the way is delivered as an interrupt, so the expiry
+// of every timer can be checked to the tick.
+
+// -----------------------------------------------------------------------------
+//                              Macros and Typedefs
+// -----------------------------------------------------------------------------
+#define TIMER_FREQUENCY              32768u
+// Same margin as the SYSRTC HAL applies when a compare is set too close.
+#define COMPARE_MIN_DIFF             (2u + 1u)
+// A timer due within the compare margin of another one fires that late.
+#define MAX_LATENESS                 (COMPARE_MIN_DIFF - 1u)
+
+#define CHECK_TIMER_COUNT            64u
+#define CHECK_ITERATIONS             200000u
+#define PERIODIC_MIN_TIMEOUT         1000u
+
+typedef struct {
+  sl_sleeptimer_timer_handle_t handle;
+  bool running;
+  uint32_t period;
+  uint32_t slack;
+  uint16_t option_flags;
+  uint32_t expected_tc;     // Start of the window the timer must fire in.
+  uint32_t fire_count;
+  bool failed;
+} checked_timer_t;
+
+// -----------------------------------------------------------------------------
+//                                Static Variables
+// -----------------------------------------------------------------------------
+static uint32_t counter;
+static uint32_t compare;
+static bool compare_enabled;
+static bool compare_pending;
+static uint32_t compare_interrupt_count;
+// When set, the duration of each compare interrupt is recorded there.
+static uint64_t *compare_interrupt_ns;
+static uint32_t compare_interrupt_capacity;
+
+static checked_timer_t checked_timers[CHECK_TIMER_COUNT];
+static uint32_t failure_count;
+
+// -----------------------------------------------------------------------------
+//                          Simulated peripheral (HAL)
+// -----------------------------------------------------------------------------
+void sleeptimer_hal_init_timer(void)
+{
+}
+
+uint32_t sleeptimer_hal_get_counter(void)
+{
+  return counter;
+}
+
+uint32_t sleeptimer_hal_get_compare(void)
+{
+  return compare;
+}
+
+void sleeptimer_hal_set_compare(uint32_t value)
+{
+  if ((value - counter) < COMPARE_MIN_DIFF) {
+    value = counter + COMPARE_MIN_DIFF;
+  }
+  compare = value;
+  compare_enabled = true;
+}
+
+void sleeptimer_hal_set_compare_prs_hfxo_startup(int32_t value)
+{
+  (void)value;
+}
+
+uint32_t sleeptimer_hal_get_timer_frequency(void)
+{
+  return TIMER_FREQUENCY;
+}
+
+void sleeptimer_hal_enable_int(uint8_t local_flag)
+{
+  if (local_flag & SLEEPTIMER_EVENT_COMP) {
+    compare_enabled = true;
+  }
+}
+
+void sleeptimer_hal_disable_int(uint8_t local_flag)
+{
+  if (local_flag & SLEEPTIMER_EVENT_COMP) {
+    compare_enabled = false;
+  }
+}
+
+void sleeptimer_hal_set_int(uint8_t local_flag)
+{
+  if (local_flag & SLEEPTIMER_EVENT_COMP) {
+    compare_pending = true;
+  }
+}
+
+bool sli_sleeptimer_hal_is_int_status_set(uint8_t local_flag)
+{
+  (void)local_flag;
+  return false;
+}
+
+uint16_t sleeptimer_hal_get_clock_accuracy(void)
+{
+  return 0u;
+}
+
+static void run_compare_interrupt(void)
+{
+  uint64_t begin = benchNowNs();
+
+  process_timer_irq(SLEEPTIMER_EVENT_COMP);
+  if (compare_interrupt_count < compare_interrupt_capacity) {
+    compare_interrupt_ns[compare_interrupt_count] = benchNowNs() - begin;
+  }
+  compare_interrupt_count++;
+}
+
+// Moves the counter forward by a number of ticks, stopping at every compare
+// match and counter overflow on the way to run the interrupt handler.
+static void advance(uint32_t ticks)
+{
+  for (;;) {
+    uint32_t step = ticks;
+    uint32_t to_overflow = 0u - counter;
+    bool compare_match = false;
+    bool overflow = false;
+
+    while (compare_pending && compare_enabled) {
+      compare_pending = false;
+      run_compare_interrupt();
+    }
+
+    if (ticks == 0u) {
+      return;
+    }
+
+    if (compare_enabled && ((compare - counter) != 0u) && ((compare - counter) <= step)) {
+      step = compare - counter;
+      compare_match = true;
+    }
+    if ((to_overflow != 0u) && (to_overflow <= step)) {
+      compare_match = compare_match && (to_overflow == step);
+      step = to_overflow;
+      overflow = true;
+    }
+
+    counter += step;
+    ticks -= step;
+
+    if (overflow) {
+      process_timer_irq(SLEEPTIMER_EVENT_OF);
+    }
+    if (compare_match) {
+      run_compare_interrupt();
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//                                    Checks
+// -----------------------------------------------------------------------------
+#define CHECK(cond, ...)               \
+  do {                                 \
+    if (!(cond)) {                     \
+      failure_count++;                 \
+      printf("  FAIL %s:%d: ", __FILE__, __LINE__); \
+      printf(__VA_ARGS__);             \
+      printf("\n");                    \
+      return;                          \
+    }                                  \
+  } while (0)
+
+static void checked_timer_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+  checked_timer_t *timer = (checked_timer_t *)data;
+  uint32_t lateness = counter - timer->expected_tc;
+
+  (void)handle;
+
+  timer->fire_count++;
+  // A timer firing out of its window may well keep firing from the same
+  // interrupt, stop there.
+  if (!timer->running
+      || ((int32_t)lateness < 0)
+      || (lateness > (timer->slack + MAX_LATENESS))) {
+    printf("  FAIL timer %u fired at %lu, expected [%lu, %lu]%s\n",
+           (unsigned)(timer - checked_timers),
+           (unsigned long)counter,
+           (unsigned long)timer->expected_tc,
+           (unsigned long)(timer->expected_tc + timer->slack + MAX_LATENESS),
+           timer->running ? "" : " while stopped");
+    exit(1);
+  }
+
+  if (timer->period != 0u) {
+    timer->expected_tc += timer->period;
+  } else {
+    timer->running = false;
+  }
+}
+
+static void check_timer_not_late(checked_timer_t *timer)
+{
+  if (timer->running && !timer->failed
+      && ((int32_t)(counter - (timer->expected_tc + timer->slack + MAX_LATENESS)) > 0)) {
+    failure_count++;
+    timer->failed = true;
+    printf("  FAIL timer %u did not fire by %lu\n",
+           (unsigned)(timer - checked_timers),
+           (unsigned long)(timer->expected_tc + timer->slack + MAX_LATENESS));
+  }
+}
+
+static uint32_t random_timeout(void)
+{
+  switch (rand() % 4) {
+    case 0:
+      return 1u + (uint32_t)(rand() % 40);
+    case 1:
+      return 1u + (uint32_t)(rand() % 2000);
+    case 2:
+      return 1u + (uint32_t)(rand() % 200000);
+    default:
+      return 1u + (uint32_t)(rand() % 0x10000000);
+  }
+}
+
+static void start_checked_timer(checked_timer_t *timer, bool periodic, uint32_t slack_divider)
+{
+  uint32_t timeout = random_timeout();
+  sl_status_t status;
+
+  // Keep periodic timers slow enough for long time jumps to stay cheap.
+  if (periodic) {
+    timeout = PERIODIC_MIN_TIMEOUT + (timeout % 0x100000u);
+  }
+
+  timer->period = periodic ? timeout : 0u;
+  timer->slack = (slack_divider != 0u) ? (timeout / slack_divider) : 0u;
+  timer->expected_tc = counter + timeout;
+  timer->running = true;
+  if (periodic) {
+    status = sl_sleeptimer_start_periodic_timer_with_slack(&timer->handle, timeout, timer->slack,
+                                                           checked_timer_callback, timer,
+                                                           0, timer->option_flags);
+  } else {
+    status = sl_sleeptimer_start_timer_with_slack(&timer->handle, timeout, timer->slack,
+                                                  checked_timer_callback, timer,
+                                                  0, timer->option_flags);
+  }
+  if (status != SL_STATUS_OK) {
+    failure_count++;
+    printf("  FAIL start returned 0x%lx\n", (unsigned long)status);
+  }
+}
+
+static void reset_checked_timers(void)
+{
+  uint32_t i;
+
+  for (i = 0u; i < CHECK_TIMER_COUNT; i++) {
+    if (checked_timers[i].running) {
+      sl_sleeptimer_stop_timer(&checked_timers[i].handle);
+    }
+  }
+  memset(checked_timers, 0, sizeof(checked_timers));
+}
+
+// Random starts, stops and time jumps, including counter overflows. Every
+// timer must fire within its window, once, and never after being stopped.
+static void check_random_operations(void)
+{
+  uint32_t iteration;
+  uint32_t i;
+
+  srand(1);
+  reset_checked_timers();
+  advance(0xFFF00000u - counter);
+
+  for (iteration = 0u; iteration < CHECK_ITERATIONS; iteration++) {
+    checked_timer_t *timer = &checked_timers[(uint32_t)rand() % CHECK_TIMER_COUNT];
+    int operation = rand() % 100;
+
+    if (operation < 30) {
+      if (timer->running) {
+        CHECK(sl_sleeptimer_stop_timer(&timer->handle) == SL_STATUS_OK,
+              "stop of a running timer failed");
+        timer->running = false;
+      }
+      // Timers past the slack timer count run without slack, which still
+      // fires them within their window.
+      start_checked_timer(timer, (operation % 5) == 0, ((operation % 3) == 0) ? 4u : 0u);
+    } else if (operation < 40) {
+      bool running = false;
+      sl_status_t status;
+
+      CHECK(sl_sleeptimer_is_timer_running(&timer->handle, &running) == SL_STATUS_OK,
+            "is_timer_running failed");
+      CHECK(running == timer->running, "is_timer_running says %d, expected %d",
+            running, timer->running);
+      status = sl_sleeptimer_stop_timer(&timer->handle);
+      CHECK((status == SL_STATUS_OK) == timer->running,
+            "stop returned 0x%lx for a %s timer", (unsigned long)status,
+            timer->running ? "running" : "stopped");
+      timer->running = false;
+    } else if (operation < 45) {
+      uint32_t remaining = 0u;
+      sl_status_t status = sl_sleeptimer_get_timer_time_remaining(&timer->handle, &remaining);
+
+      if (timer->running) {
+        CHECK(status == SL_STATUS_OK, "time remaining of a running timer failed");
+        CHECK(remaining <= (timer->expected_tc - counter + timer->slack),
+              "time remaining %lu past expiry", (unsigned long)remaining);
+      }
+    } else {
+      advance((rand() % 3) == 0 ? (uint32_t)(rand() % 100000) : (uint32_t)(rand() % 50));
+      for (i = 0u; i < CHECK_TIMER_COUNT; i++) {
+        check_timer_not_late(&checked_timers[i]);
+      }
+    }
+    if (failure_count != 0u) {
+      return;
+    }
+  }
+  reset_checked_timers();
+}
+
+// The time remaining until the first timer with some flags must match the
+// earliest expiry among the running timers with those flags.
+static void check_first_timer_time(void)
+{
+  uint32_t iteration;
+  uint32_t i;
+
+  srand(4);
+  reset_checked_timers();
+
+  for (iteration = 0u; iteration < CHECK_ITERATIONS; iteration++) {
+    checked_timer_t *timer = &checked_timers[(uint32_t)rand() % CHECK_TIMER_COUNT];
+    uint16_t option_flags = (uint16_t)((rand() % 3) == 0
+                                       ? SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+                                       : 0);
+    bool expected_found = false;
+    uint32_t expected_time = 0u;
+    uint32_t time = 0u;
+    sl_status_t status;
+    int operation = rand() % 100;
+
+    if (operation < 40) {
+      if (timer->running) {
+        sl_sleeptimer_stop_timer(&timer->handle);
+        timer->running = false;
+      }
+      timer->option_flags = (uint16_t)((rand() % 3) == 0
+                                       ? SL_SLEEPTIMER_NO_HIGH_PRECISION_HF_CLOCKS_REQUIRED_FLAG
+                                       : 0);
+      start_checked_timer(timer, (operation % 5) == 0, 0u);
+    } else if (operation < 50) {
+      if (timer->running) {
+        sl_sleeptimer_stop_timer(&timer->handle);
+        timer->running = false;
+      }
+    } else if (operation < 60) {
+      advance((uint32_t)(rand() % 5000));
+    }
+
+    for (i = 0u; i < CHECK_TIMER_COUNT; i++) {
+      checked_timer_t *current = &checked_timers[i];
+      uint32_t remaining = current->expected_tc + current->slack - counter;
+
+      if (current->running && (current->option_flags == option_flags)) {
+        if ((int32_t)remaining < 0) {
+          remaining = 0u;
+        }
+        if (!expected_found || (remaining < expected_time)) {
+          expected_time = remaining;
+        }
+        expected_found = true;
+      }
+    }
+
+    status = sl_sleeptimer_get_remaining_time_of_first_timer(option_flags, &time);
+    CHECK((status == SL_STATUS_OK) == expected_found,
+          "first timer with flags 0x%x %s", option_flags,
+          expected_found ? "not found" : "found while none runs");
+    if (expected_found) {
+      CHECK(time == expected_time,
+            "first timer with flags 0x%x due in %lu, expected %lu",
+            option_flags, (unsigned long)time, (unsigned long)expected_time);
+    }
+  }
+  reset_checked_timers();
+}
+
+// A lone timer must wake the system up once, whatever its length.
+static void check_single_wakeup(void)
+{
+  static const uint32_t timeouts[] = {
+    3u, TIMER_FREQUENCY, 60u * TIMER_FREQUENCY, 3600u * TIMER_FREQUENCY, 0x7FFFFFFFu
+  };
+  uint32_t i;
+
+  reset_checked_timers();
+  for (i = 0u; i < sizeof(timeouts) / sizeof(timeouts[0]); i++) {
+    checked_timer_t *timer = &checked_timers[0];
+
+    advance(0x12345678u * (i + 1u) - counter);
+    compare_interrupt_count = 0u;
+    timer->period = 0u;
+    timer->expected_tc = counter + timeouts[i];
+    timer->running = true;
+    CHECK(sl_sleeptimer_start_timer(&timer->handle, timeouts[i],
+                                    checked_timer_callback, timer, 0, 0) == SL_STATUS_OK,
+          "start failed");
+    advance(timeouts[i] + 10u);
+    CHECK(timer->fire_count == i + 1u, "timer of %lu ticks did not fire",
+          (unsigned long)timeouts[i]);
+    CHECK(compare_interrupt_count == 1u, "timer of %lu ticks took %lu compare interrupts",
+          (unsigned long)timeouts[i], (unsigned long)compare_interrupt_count);
+  }
+  reset_checked_timers();
+}
+
+// Periodic timers must not drift, even when other timers keep the list busy.
+static void check_periodic_drift(void)
+{
+  checked_timer_t *periodic = &checked_timers[0];
+  uint32_t i;
+
+  reset_checked_timers();
+  srand(2);
+  advance(0xFFFFF000u - counter);
+  periodic->period = 1000u;
+  periodic->expected_tc = counter + periodic->period;
+  periodic->running = true;
+  CHECK(sl_sleeptimer_start_periodic_timer(&periodic->handle, periodic->period,
+                                           checked_timer_callback, periodic, 0, 0) == SL_STATUS_OK,
+        "start failed");
+  for (i = 0u; i < 10000u; i++) {
+    checked_timer_t *other = &checked_timers[1u + (i % (CHECK_TIMER_COUNT - 1u))];
+
+    if (!other->running) {
+      start_checked_timer(other, false, 0u);
+    }
+    advance((uint32_t)(rand() % 500));
+    check_timer_not_late(periodic);
+    if (failure_count != 0u) {
+      return;
+    }
+  }
+  CHECK(periodic->fire_count == (uint32_t)((periodic->expected_tc - 0xFFFFF000u) / periodic->period) - 1u,
+        "periodic timer fired %lu times", (unsigned long)periodic->fire_count);
+  reset_checked_timers();
+}
+
+// A periodic timer with a slack must fire once per period, within the window
+// of each period, whether it fires at the end of its window or along with
+// another timer.
+static void check_periodic_slack(void)
+{
+  checked_timer_t *periodic = &checked_timers[0];
+  checked_timer_t *other = &checked_timers[1];
+  uint32_t start_tc;
+  uint32_t i;
+
+  reset_checked_timers();
+  srand(5);
+  advance(0xFFFF0000u - counter);
+  start_tc = counter;
+  periodic->period = 1000u;
+  periodic->slack = 300u;
+  periodic->expected_tc = counter + periodic->period;
+  periodic->running = true;
+  CHECK(sl_sleeptimer_start_periodic_timer_with_slack(&periodic->handle,
+                                                      periodic->period,
+                                                      periodic->slack,
+                                                      checked_timer_callback,
+                                                      periodic, 0, 0) == SL_STATUS_OK,
+        "start failed");
+  for (i = 0u; i < 2000u; i++) {
+    // Now and then another timer expires within the window.
+    if (!other->running && ((rand() % 2) == 0)) {
+      other->period = 0u;
+      other->slack = 0u;
+      other->expected_tc = counter + 1u + (uint32_t)(rand() % 1500);
+      other->running = true;
+      CHECK(sl_sleeptimer_start_timer(&other->handle, other->expected_tc - counter,
+                                      checked_timer_callback, other, 0, 0) == SL_STATUS_OK,
+            "start failed");
+    }
+    advance(1u + (uint32_t)(rand() % 200));
+    check_timer_not_late(periodic);
+    if (failure_count != 0u) {
+      return;
+    }
+  }
+  // Each period fires once, the current one may not have fired yet.
+  CHECK(periodic->fire_count == ((periodic->expected_tc - start_tc) / periodic->period) - 1u,
+        "periodic timer fired %lu times in %lu periods",
+        (unsigned long)periodic->fire_count,
+        (unsigned long)((periodic->expected_tc - start_tc) / periodic->period) - 1u);
+  reset_checked_timers();
+}
+
+// Timers whose windows overlap must be served by a single wake-up.
+static void check_slack_coalescing(void)
+{
+  checked_timer_t *early = &checked_timers[0];
+  checked_timer_t *late = &checked_timers[1];
+
+  reset_checked_timers();
+  advance(0x40000000u - counter);
+  compare_interrupt_count = 0u;
+
+  early->expected_tc = counter + 1000u;
+  early->slack = 500u;
+  early->running = true;
+  late->expected_tc = counter + 1200u;
+  late->slack = 300u;
+  late->running = true;
+  CHECK(sl_sleeptimer_start_timer_with_slack(&early->handle, 1000u, early->slack,
+                                             checked_timer_callback, early, 0, 0) == SL_STATUS_OK,
+        "start failed");
+  CHECK(sl_sleeptimer_start_timer_with_slack(&late->handle, 1200u, late->slack,
+                                             checked_timer_callback, late, 0, 0) == SL_STATUS_OK,
+        "start failed");
+  advance(2000u);
+  CHECK((early->fire_count == 1u) && (late->fire_count == 1u), "timers did not fire");
+  CHECK(compare_interrupt_count == 1u, "two timers with overlapping windows took %lu wake-ups",
+        (unsigned long)compare_interrupt_count);
+  reset_checked_timers();
+}
+
+// A timer with a slack and a window opening more than half the counter range
+// away must neither fire along with a short timer nor miss its window.
+static void check_long_slack(void)
+{
+  checked_timer_t *long_timer = &checked_timers[0];
+  checked_timer_t *short_timer = &checked_timers[1];
+  const uint32_t timeout = 0xC0000000u;
+
+  reset_checked_timers();
+  advance(0x10000000u - counter);
+
+  long_timer->expected_tc = counter + timeout;
+  long_timer->slack = 1000u;
+  long_timer->running = true;
+  short_timer->expected_tc = counter + 1000u;
+  short_timer->slack = 0u;
+  short_timer->running = true;
+  CHECK(sl_sleeptimer_start_timer_with_slack(&long_timer->handle, timeout, long_timer->slack,
+                                             checked_timer_callback, long_timer,
+                                             0, 0) == SL_STATUS_OK,
+        "start failed");
+  CHECK(sl_sleeptimer_start_timer(&short_timer->handle, 1000u,
+                                  checked_timer_callback, short_timer, 0, 0) == SL_STATUS_OK,
+        "start failed");
+  advance(2000u);
+  CHECK(short_timer->fire_count == 1u, "short timer did not fire");
+  CHECK(long_timer->fire_count == 0u, "long timer fired with the short one");
+  advance(timeout);
+  CHECK(long_timer->fire_count == 1u, "long timer did not fire");
+  reset_checked_timers();
+}
+
+typedef struct {
+  const char *name;
+  void (*run)(void);
+} check_t;
+
+static const check_t checks[] = {
+  { "random operations", check_random_operations },
+  { "first timer with flags", check_first_timer_time },
+  { "single wake-up per timer", check_single_wakeup },
+  { "periodic timer drift", check_periodic_drift },
+  { "periodic timer with slack", check_periodic_slack },
+  { "slack coalescing", check_slack_coalescing },
+  { "long timeout with slack", check_long_slack },
+};
+
+static int run_checks(void)
+{
+  uint32_t i;
+
+  for (i = 0u; i < sizeof(checks) / sizeof(checks[0]); i++) {
+    uint32_t failures = failure_count;
+
+    checks[i].run();
+    printf("%s: %s\n", checks[i].name, (failure_count == failures) ? "ok" : "FAILED");
+  }
+  return (failure_count == 0u) ? 0 : 1;
+}
+
+// -----------------------------------------------------------------------------
+//                                  Benchmark
+// -----------------------------------------------------------------------------
+static void bench_callback(sl_sleeptimer_timer_handle_t *handle, void *data)
+{
+  (void)handle;
+  (void)data;
+}
+
+// Restarts random timers among running_count ones, then lets them all expire.
+// Each timer expires on its own compare interrupt, whose duration is the cost
+// of expiring one timer.
+static void bench_timers(uint32_t running_count, uint32_t operation_count)
+{
+  sl_sleeptimer_timer_handle_t *handles = calloc(running_count, sizeof(*handles));
+  uint64_t *start_ns = malloc(operation_count * sizeof(uint64_t));
+  uint64_t *stop_ns = malloc(operation_count * sizeof(uint64_t));
+  uint64_t *expire_isr_ns = malloc(running_count * sizeof(uint64_t));
+  uint64_t begin;
+  uint64_t expire_ns;
+  uint32_t i;
+
+  srand(3);
+  for (i = 0u; i < running_count; i++) {
+    sl_sleeptimer_start_timer(&handles[i], 1000u + (uint32_t)(rand() % 0x1000000),
+                              bench_callback, NULL, 0, 0);
+  }
+
+  for (i = 0u; i < operation_count; i++) {
+    sl_sleeptimer_timer_handle_t *handle = &handles[(uint32_t)rand() % running_count];
+    uint32_t timeout = 1000u + (uint32_t)(rand() % 0x1000000);
+
+    begin = benchNowNs();
+    sl_sleeptimer_stop_timer(handle);
+    stop_ns[i] = benchNowNs() - begin;
+
+    begin = benchNowNs();
+    sl_sleeptimer_start_timer(handle, timeout, bench_callback, NULL, 0, 0);
+    start_ns[i] = benchNowNs() - begin;
+  }
+
+  compare_interrupt_count = 0u;
+  compare_interrupt_ns = expire_isr_ns;
+  compare_interrupt_capacity = running_count;
+  begin = benchNowNs();
+  advance(0x2000000u);
+  expire_ns = benchNowNs() - begin;
+  compare_interrupt_capacity = 0u;
+
+  benchPrintLatency("start", running_count, start_ns, operation_count);
+  benchPrintLatency("stop", running_count, stop_ns, operation_count);
+  benchPrintLatency("expire", running_count, expire_isr_ns,
+                    (compare_interrupt_count < running_count) ? compare_interrupt_count : running_count);
+  printf("%-8s %7lu timers %10.1f ns/timer, %lu compare interrupts\n",
+         "",
+         (unsigned long)running_count,
+         (double)expire_ns / running_count,
+         (unsigned long)compare_interrupt_count);
+
+  free(handles);
+  free(start_ns);
+  free(stop_ns);
+  free(expire_isr_ns);
+}
+
+static int run_benchmark(void)
+{
+  static const uint32_t running_counts[] = { 16u, 256u, 4096u };
+  uint32_t i;
+
+  printf("backend: %s\n", SL_SLEEPTIMER_TIMING_WHEEL ? "timing wheel" : "delta list");
+  for (i = 0u; i < sizeof(running_counts) / sizeof(running_counts[0]); i++) {
+    bench_timers(running_counts[i], 100000u);
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//                                     Main
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  setvbuf(stdout, NULL, _IONBF, 0);
+  sl_sleeptimer_init();
+
+  printf("sleeptimer, %s backend\n", SL_SLEEPTIMER_TIMING_WHEEL ? "timing wheel" : "delta list");
+  if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+    return run_benchmark();
+  }
+  return run_checks();
+}